@@ -0,0 +1,8 @@
+//
+//  AudioRecordAtomics.c
+//  AudioRecordKit
+//
+//  接口全部在头文件中以 static inline 实现；SwiftPM 的 C 目标至少需要一个源文件。
+//
+
+#include "AudioRecordAtomics.h"
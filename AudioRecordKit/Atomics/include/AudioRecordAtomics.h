@@ -0,0 +1,55 @@
+//
+//  AudioRecordAtomics.h
+//  AudioRecordKit
+//
+//  C11 <stdatomic.h> 薄封装，供 Swift 侧 AtomicInt64 / AtomicInt64Array 使用。
+//  全部为 static inline，不加锁、不分配内存，可在音频回调线程中调用。
+//
+
+#ifndef AUDIO_RECORD_ATOMICS_H
+#define AUDIO_RECORD_ATOMICS_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// 读取（顺序一致）
+static inline int64_t ark_atomic_load_i64(int64_t *p) {
+    return atomic_load_explicit((_Atomic(int64_t) *)p, memory_order_seq_cst);
+}
+
+/// 写入（顺序一致）
+static inline void ark_atomic_store_i64(int64_t *p, int64_t value) {
+    atomic_store_explicit((_Atomic(int64_t) *)p, value, memory_order_seq_cst);
+}
+
+/// 加法，返回相加后的新值
+static inline int64_t ark_atomic_add_i64(int64_t *p, int64_t delta) {
+    return atomic_fetch_add_explicit((_Atomic(int64_t) *)p, delta, memory_order_seq_cst) + delta;
+}
+
+/// 交换，返回旧值
+static inline int64_t ark_atomic_exchange_i64(int64_t *p, int64_t value) {
+    return atomic_exchange_explicit((_Atomic(int64_t) *)p, value, memory_order_seq_cst);
+}
+
+/// 比较并交换，成功返回 true
+static inline bool ark_atomic_compare_exchange_i64(int64_t *p, int64_t expected, int64_t desired) {
+    return atomic_compare_exchange_strong_explicit((_Atomic(int64_t) *)p, &expected, desired,
+                                                   memory_order_seq_cst, memory_order_seq_cst);
+}
+
+/// 完整内存屏障
+static inline void ark_atomic_thread_fence(void) {
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_RECORD_ATOMICS_H */
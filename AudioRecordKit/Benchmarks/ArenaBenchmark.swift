@@ -0,0 +1,141 @@
+import Foundation
+import Darwin
+import CoreAudio
+@_spi(Benchmarks) import AudioRecordKit
+
+// MARK: - ArenaBenchmark
+/// 会话内存区基准测试 - 比较节点缓冲区分配在堆上与会话内存区中的建图、释放与冷缓存渲染
+///
+/// 每次迭代构建一个与混合录制相同形状的处理图（推送源 + 环形缓冲源 → 混音 → 限幅 → 电平 / 写入，
+/// 量子上限 16384 帧），记录：
+/// - 建图耗时（创建节点、连接、编译）与首次渲染前后的缺页次数；
+/// - 冷缓存渲染：先遍历一块大于末级缓存的内存把处理图挤出缓存，再渲染一个 512 帧量子；
+/// - 释放耗时（关闭并释放处理图及全部节点）。
+///
+/// macOS 不向用户态开放硬件缓存未命中计数器，冷缓存渲染耗时与缺页次数作为其近似。
+enum ArenaBenchmark: BenchmarkSuite {
+    
+    static let name = "arena"
+    static let summary = "会话内存区与堆分配的建图 / 释放耗时、冷缓存渲染与缺页次数"
+    
+    static let channels = 2
+    static let sampleRate = 48000.0
+    static let framesPerQuantum = 512
+    /// 挤出缓存用的缓冲区（大于常见末级缓存）
+    static let evictionBytes = 64 * 1024 * 1024
+    
+    static func run(_ runner: BenchmarkRunner) {
+        guard #available(macOS 14.4, *) else {
+            Logger.shared.warning("⚠️ 会话内存区基准测试需要 macOS 14.4 或更高版本")
+            return
+        }
+        let iterations = min(max(runner.iterations, 10), 200)
+        let eviction = UnsafeMutablePointer<UInt8>.allocate(capacity: evictionBytes)
+        eviction.initialize(repeating: 1, count: evictionBytes)
+        defer { eviction.deallocate() }
+        
+        for useArena in [false, true] {
+            measure(runner, useArena: useArena, iterations: iterations, eviction: eviction)
+        }
+    }
+    
+    // MARK: - Measurement
+    
+    @available(macOS 14.4, *)
+    private static func measure(_ runner: BenchmarkRunner, useArena: Bool, iterations: Int, eviction: UnsafeMutablePointer<UInt8>) {
+        let label = useArena ? "arena" : "heap"
+        var setupSamples: [UInt64] = []
+        var renderSamples: [UInt64] = []
+        var teardownSamples: [UInt64] = []
+        var faults = 0
+        var hugePages = false
+        
+        for _ in 0..<iterations {
+            let faultsBefore = minorFaults()
+            let setupBegin = mach_absolute_time()
+            var graph: AudioGraph?
+            do {
+                graph = try makeGraph(useArena: useArena)
+            } catch {
+                Logger.shared.error("❌ 会话内存区基准测试建图失败: \(error.localizedDescription)")
+                return
+            }
+            setupSamples.append(BenchmarkRunner.nanoseconds(fromHostTicks: mach_absolute_time() - setupBegin))
+            hugePages = graph?.arena?.isHugePageBacked ?? false
+            
+            // 把处理图挤出缓存后渲染一个量子
+            var checksum: UInt64 = 0
+            for offset in stride(from: 0, to: evictionBytes, by: 64) {
+                checksum &+= UInt64(eviction[offset])
+            }
+            runner.consume(Float(checksum & 1))
+            let renderBegin = mach_absolute_time()
+            graph?.render(frameCount: framesPerQuantum)
+            renderSamples.append(BenchmarkRunner.nanoseconds(fromHostTicks: mach_absolute_time() - renderBegin))
+            faults += minorFaults() - faultsBefore
+            
+            let teardownBegin = mach_absolute_time()
+            graph?.shutdown()
+            graph = nil
+            teardownSamples.append(BenchmarkRunner.nanoseconds(fromHostTicks: mach_absolute_time() - teardownBegin))
+        }
+        
+        runner.record(suite: name, name: "setup \(label)", samples: setupSamples)
+        runner.record(suite: name, name: "cold render \(label)", samples: renderSamples)
+        runner.record(suite: name, name: "teardown \(label)", samples: teardownSamples)
+        Logger.shared.info("📊 \(label): 每会话缺页 \(faults / max(iterations, 1)) 次\(hugePages ? "（超级页）" : "")")
+    }
+    
+    /// 混合录制形状的处理图（写入开关关闭，不创建文件）
+    @available(macOS 14.4, *)
+    private static func makeGraph(useArena: Bool) throws -> AudioGraph {
+        let maxFrames = AudioGraph.defaultMaxFramesPerQuantum
+        let bytesPerFrame = channels * MemoryLayout<Float>.stride
+        let ringFrames = Int(sampleRate) * 2
+        let format = AudioStreamBasicDescription(
+            mSampleRate: sampleRate,
+            mFormatID: kAudioFormatLinearPCM,
+            mFormatFlags: kAudioFormatFlagIsSignedInteger | kAudioFormatFlagIsPacked,
+            mBytesPerPacket: UInt32(channels * 2),
+            mFramesPerPacket: 1,
+            mBytesPerFrame: UInt32(channels * 2),
+            mChannelsPerFrame: UInt32(channels),
+            mBitsPerChannel: 16,
+            mReserved: 0
+        )
+        let fileManager = AudioToolboxFileManager(audioFormat: format)
+        let pipeline = CapturePipelineFactory.make(CapturePipelineConfiguration(mode: .mixed, fileFormat: format))
+        
+        let arena = useArena ? EngineArena(name: "Bench", capacity: EngineArena.estimatedCapacity(
+            nodes: 7, channels: channels, maxFrames: maxFrames, extraBytes: (ringFrames + maxFrames) * bytesPerFrame)) : nil
+        let graph = AudioGraph(name: "Bench", sampleRate: sampleRate, maxFramesPerQuantum: maxFrames, workerCount: 0, arena: arena,
+                               xruns: fileManager.xruns)
+        try graph.withArena {
+            let system = graph.add(PushSourceNode(name: "system", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate, pipeline: pipeline))
+            let mic = graph.add(RingBufferSourceNode(name: "mic", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate,
+                                                     capacityFrames: ringFrames))
+            let agc = graph.add(AGCNode(name: "agc", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate))
+            let mixer = graph.add(MixerNode(name: "mixer", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate))
+            let limiter = graph.add(LimiterNode(name: "limiter", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate))
+            let meter = graph.add(MeterNode(name: "meter", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate,
+                                            scale: .linearRMS(sensitivity: 3.0)))
+            let writer = graph.add(FileWriterNode(name: "writer", fileManager: fileManager, pipeline: pipeline, maxFrames: maxFrames, sampleRate: sampleRate,
+                                                  isWriting: false))
+            try graph.connect(system, to: mixer)
+            try graph.connect(mic, to: agc)
+            try graph.connect(agc, to: mixer)
+            try graph.connect(mixer, to: limiter)
+            try graph.connect(limiter, to: meter)
+            try graph.connect(limiter, to: writer)
+            try graph.compile()
+        }
+        return graph
+    }
+    
+    /// 进程累计的缺页次数（不需要磁盘 IO 的页错误）
+    private static func minorFaults() -> Int {
+        var usage = rusage()
+        guard getrusage(RUSAGE_SELF, &usage) == 0 else { return 0 }
+        return usage.ru_minflt
+    }
+}
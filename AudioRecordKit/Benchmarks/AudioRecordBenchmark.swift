@@ -0,0 +1,162 @@
+import Foundation
+@_spi(Benchmarks) import AudioRecordKit
+
+// MARK: - 基准测试入口
+
+/// 基准测试结果
+struct AudioRecordBenchmarkResult: Sendable, Codable {
+    let suite: String
+    let name: String
+    let iterations: Int
+    let framesPerIteration: Int
+    let nanosecondsPerIteration: Double
+    let nanosecondsPerFrame: Double
+    /// 实时倍数（> 1 表示处理速度快于实时）
+    let realtimeFactor: Double
+    /// 逐次采样的分位数（纳秒，循环计时的测量为 0）
+    let p50Nanoseconds: UInt64
+    let p99Nanoseconds: UInt64
+    /// 每次迭代读写的字节数与内存带宽（GB/s，不按带宽计量时为 0）
+    let bytesPerIteration: Int
+    let gigabytesPerSecond: Double
+    /// 实时运行一路流所需的单核 CPU 比例（未统计 CPU 时间时为 0）
+    let cpuLoad: Double
+    /// 实时节奏下丢弃的块数与内存占用增量（字节，不统计时为 0）
+    let droppedBlocks: Int64
+    let memoryGrowthBytes: Int64
+}
+
+/// 基准测试入口
+///
+/// 套件随命令行目标编译，经 `@_spi(Benchmarks) import` 访问 SDK 的 DSP / 管线代码，不进入发布的库。
+/// 命令行运行：`swift run -c release AudioRecordKitBenchmarks [--suite 名称] [--iterations 次数]`
+enum AudioRecordBenchmark {
+    
+    /// 可用的套件（名称, 说明）
+    static var suites: [(name: String, summary: String)] {
+        return BenchmarkRegistry.suites.map { ($0.name, $0.summary) }
+    }
+    
+    /// 运行基准测试
+    /// - Parameters:
+    ///   - suiteNames: 要运行的套件名称，nil 表示全部
+    ///   - iterations: 每项测量的迭代次数
+    static func run(suiteNames: [String]? = nil, iterations: Int = 200) -> [AudioRecordBenchmarkResult] {
+        let runner = BenchmarkRunner(iterations: iterations)
+        let selected = suiteNames.map { names in names.compactMap { BenchmarkRegistry.suite(named: $0) } } ?? BenchmarkRegistry.suites
+        
+        for suite in selected {
+            suite.run(runner)
+        }
+        
+        return runner.measurements.map { measurement in
+            AudioRecordBenchmarkResult(
+                suite: measurement.suite,
+                name: measurement.name,
+                iterations: measurement.iterations,
+                framesPerIteration: measurement.framesPerIteration,
+                nanosecondsPerIteration: measurement.nanosecondsPerIteration,
+                nanosecondsPerFrame: measurement.nanosecondsPerFrame,
+                realtimeFactor: measurement.realtimeFactor,
+                p50Nanoseconds: measurement.p50Nanoseconds,
+                p99Nanoseconds: measurement.p99Nanoseconds,
+                bytesPerIteration: measurement.bytesPerIteration,
+                gigabytesPerSecond: measurement.gigabytesPerSecond,
+                cpuLoad: measurement.cpuLoad,
+                droppedBlocks: measurement.droppedBlocks,
+                memoryGrowthBytes: measurement.memoryGrowthBytes
+            )
+        }
+    }
+    
+    /// 交叉校验 DSP 内核：当前 CPU 支持的每个变体都与标量参考实现比较
+    /// - Returns: 不一致的描述，全部通过时为空
+    static func verifyKernels() -> [String] {
+        return DSPKernels.verify()
+    }
+    
+    /// 当前选中的 DSP 内核实现（内核名称, 指令集）
+    static var kernelSelection: [(kernel: String, isa: String)] {
+        return DSPKernels.selection.map { ($0.kernel, $0.isa.rawValue) }
+    }
+    
+    /// 格式化为文本报告
+    static func report(_ results: [AudioRecordBenchmarkResult]) -> String {
+        var lines: [String] = []
+        var currentSuite = ""
+        for result in results {
+            if result.suite != currentSuite {
+                currentSuite = result.suite
+                lines.append("")
+                lines.append("== \(currentSuite) ==")
+            }
+            var line = result.name.padding(toLength: 44, withPad: " ", startingAt: 0)
+            line += String(format: " %12.1f ns/iter", result.nanosecondsPerIteration)
+            if result.framesPerIteration > 0 {
+                line += String(format: " %8.2f ns/frame %10.1fx RT", result.nanosecondsPerFrame, result.realtimeFactor)
+            }
+            if result.gigabytesPerSecond > 0 {
+                line += String(format: " %8.2f GB/s", result.gigabytesPerSecond)
+            }
+            if result.cpuLoad > 0 {
+                line += String(format: " %7.3f%% cpu", result.cpuLoad * 100)
+            }
+            if result.p50Nanoseconds > 0 {
+                line += String(format: "  p50 %10.1f us  p99 %10.1f us  (n=%d)",
+                               Double(result.p50Nanoseconds) / 1000, Double(result.p99Nanoseconds) / 1000, result.iterations)
+            }
+            if result.droppedBlocks > 0 || result.memoryGrowthBytes > 0 {
+                line += String(format: "  dropped %lld  mem +%.2f MB",
+                               result.droppedBlocks, Double(result.memoryGrowthBytes) / 1_048_576)
+            }
+            lines.append(line)
+        }
+        return lines.joined(separator: "\n")
+    }
+    
+    /// 格式化为 JSON（含机器与内核选择信息，便于跨提交、跨机器比较）
+    /// - Parameter label: 自定义标签，例如提交号
+    static func json(_ results: [AudioRecordBenchmarkResult], label: String? = nil) -> Data {
+        let document = BenchmarkDocument(
+            label: label,
+            date: ISO8601DateFormatter().string(from: Date()),
+            host: BenchmarkHost(
+                model: sysctlString("hw.model"),
+                cpu: sysctlString("machdep.cpu.brand_string"),
+                cpuFeatures: CPUFeatures.current.description,
+                osVersion: ProcessInfo.processInfo.operatingSystemVersionString,
+                processorCount: ProcessInfo.processInfo.activeProcessorCount
+            ),
+            kernels: Dictionary(DSPKernels.selection.map { ($0.kernel, $0.isa.rawValue) }, uniquingKeysWith: { first, _ in first }),
+            results: results
+        )
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        return (try? encoder.encode(document)) ?? Data()
+    }
+    
+    private static func sysctlString(_ name: String) -> String {
+        var size = 0
+        guard sysctlbyname(name, nil, &size, nil, 0) == 0, size > 0 else { return "" }
+        var buffer = [CChar](repeating: 0, count: size)
+        guard sysctlbyname(name, &buffer, &size, nil, 0) == 0 else { return "" }
+        return String(cString: buffer)
+    }
+}
+
+// MARK: - JSON 文档
+private struct BenchmarkDocument: Encodable {
+    let label: String?
+    let date: String
+    let host: BenchmarkHost
+    let kernels: [String: String]
+    let results: [AudioRecordBenchmarkResult]
+}
+
+private struct BenchmarkHost: Encodable {
+    let model: String
+    let cpu: String
+    let cpuFeatures: String
+    let osVersion: String
+    let processorCount: Int
+}
@@ -0,0 +1,214 @@
+import Foundation
+import Darwin
+@_spi(Benchmarks) import AudioRecordKit
+
+// MARK: - BenchmarkMeasurement
+/// 单项基准测试结果
+struct BenchmarkMeasurement {
+    let suite: String
+    let name: String
+    let iterations: Int
+    /// 每次迭代处理的帧数（不按帧计量时为 0）
+    let framesPerIteration: Int
+    let sampleRate: Double
+    let totalNanoseconds: UInt64
+    /// 逐次采样时的分位数（循环计时的测量为 0）
+    var p50Nanoseconds: UInt64 = 0
+    var p99Nanoseconds: UInt64 = 0
+    /// 每次迭代读写的字节数（不按带宽计量时为 0）
+    var bytesPerIteration: Int = 0
+    /// 线程 CPU 时间（未单独统计时为 0）
+    var cpuNanoseconds: UInt64 = 0
+    /// 实时节奏下丢弃的块数（不统计时为 0）
+    var droppedBlocks: Int64 = 0
+    /// 测量期间的内存占用增量（字节，不统计时为 0）
+    var memoryGrowthBytes: Int64 = 0
+    
+    var nanosecondsPerIteration: Double {
+        return iterations > 0 ? Double(totalNanoseconds) / Double(iterations) : 0
+    }
+    
+    var nanosecondsPerFrame: Double {
+        return framesPerIteration > 0 ? nanosecondsPerIteration / Double(framesPerIteration) : 0
+    }
+    
+    /// 实时倍数：处理一个量子的音频时长 / 实际耗时
+    var realtimeFactor: Double {
+        guard framesPerIteration > 0, sampleRate > 0, nanosecondsPerIteration > 0 else { return 0 }
+        let audioNanoseconds = Double(framesPerIteration) / sampleRate * 1_000_000_000
+        return audioNanoseconds / nanosecondsPerIteration
+    }
+    
+    /// 单核 CPU 占用：CPU 时间 / 处理的音频时长（实时运行一路流所需的核心比例）
+    var cpuLoad: Double {
+        guard cpuNanoseconds > 0, framesPerIteration > 0, sampleRate > 0 else { return 0 }
+        let audioNanoseconds = Double(iterations * framesPerIteration) / sampleRate * 1_000_000_000
+        return Double(cpuNanoseconds) / audioNanoseconds
+    }
+    
+    /// 内存带宽（GB/s，1 GB = 1e9 字节）
+    var gigabytesPerSecond: Double {
+        guard bytesPerIteration > 0, nanosecondsPerIteration > 0 else { return 0 }
+        return Double(bytesPerIteration) / nanosecondsPerIteration
+    }
+}
+
+// MARK: - BenchmarkRunner
+/// 基准测试执行器 - 预热后用 mach_absolute_time 计时
+final class BenchmarkRunner {
+    
+    // MARK: - Properties
+    let iterations: Int
+    let warmupIterations: Int
+    private(set) var measurements: [BenchmarkMeasurement] = []
+    
+    /// 防止被测代码被优化掉的累加值
+    private(set) var sink: Double = 0
+    
+    private static let timebase: mach_timebase_info_data_t = {
+        var info = mach_timebase_info_data_t()
+        mach_timebase_info(&info)
+        return info
+    }()
+    
+    // MARK: - Initialization
+    
+    init(iterations: Int, warmupIterations: Int? = nil) {
+        self.iterations = max(1, iterations)
+        self.warmupIterations = warmupIterations ?? max(1, iterations / 10)
+    }
+    
+    // MARK: - Public Methods
+    
+    /// 计时执行 body，结果追加到 measurements
+    /// - Parameter bytes: 每次迭代读写的字节数（用于计算带宽）
+    @discardableResult
+    func measure(suite: String, name: String, frames: Int = 0, sampleRate: Double = 48000, bytes: Int = 0, _ body: () -> Void) -> BenchmarkMeasurement {
+        for _ in 0..<warmupIterations {
+            body()
+        }
+        
+        let start = mach_absolute_time()
+        for _ in 0..<iterations {
+            body()
+        }
+        let elapsed = mach_absolute_time() - start
+        
+        var measurement = BenchmarkMeasurement(
+            suite: suite,
+            name: name,
+            iterations: iterations,
+            framesPerIteration: frames,
+            sampleRate: sampleRate,
+            totalNanoseconds: BenchmarkRunner.nanoseconds(fromHostTicks: elapsed)
+        )
+        measurement.bytesPerIteration = bytes
+        measurements.append(measurement)
+        return measurement
+    }
+    
+    /// 记录外部测得的结果（例如浸泡测试按墙钟统计）
+    func record(_ measurement: BenchmarkMeasurement) {
+        measurements.append(measurement)
+    }
+    
+    /// 记录逐次测得的耗时（纳秒），报告均值与 p50 / p99
+    ///
+    /// 用于不能循环执行同一段代码计时的场景，例如启动、首帧延迟。
+    @discardableResult
+    func record(suite: String, name: String, samples: [UInt64]) -> BenchmarkMeasurement? {
+        guard let measurement = BenchmarkRunner.sampled(suite: suite, name: name, samples: samples) else { return nil }
+        measurements.append(measurement)
+        return measurement
+    }
+    
+    /// 由逐次测得的耗时（纳秒）构造测量结果（不记录，供调用方补充字段后交给 `record(_:)`）
+    static func sampled(suite: String, name: String, samples: [UInt64]) -> BenchmarkMeasurement? {
+        guard !samples.isEmpty else { return nil }
+        let sorted = samples.sorted()
+        var measurement = BenchmarkMeasurement(
+            suite: suite,
+            name: name,
+            iterations: sorted.count,
+            framesPerIteration: 0,
+            sampleRate: 0,
+            totalNanoseconds: sorted.reduce(0, +)
+        )
+        measurement.p50Nanoseconds = percentile(sorted, 0.50)
+        measurement.p99Nanoseconds = percentile(sorted, 0.99)
+        return measurement
+    }
+    
+    /// 已排序样本的分位数（最近秩）
+    static func percentile(_ sorted: [UInt64], _ quantile: Double) -> UInt64 {
+        guard !sorted.isEmpty else { return 0 }
+        let rank = Int((Double(sorted.count) * quantile).rounded(.up))
+        return sorted[min(max(rank, 1), sorted.count) - 1]
+    }
+    
+    /// 吸收被测代码的输出
+    @inline(never)
+    func consume(_ value: Float) {
+        sink += Double(value)
+    }
+    
+    static func nanoseconds(fromHostTicks ticks: UInt64) -> UInt64 {
+        return ticks * UInt64(timebase.numer) / UInt64(timebase.denom)
+    }
+    
+    static func hostTicks(fromNanoseconds nanoseconds: UInt64) -> UInt64 {
+        return nanoseconds * UInt64(timebase.denom) / UInt64(timebase.numer)
+    }
+    
+    /// 进程内存占用（phys_footprint，与活动监视器的"内存"一致）
+    static func memoryFootprint() -> UInt64 {
+        var info = task_vm_info_data_t()
+        var count = mach_msg_type_number_t(MemoryLayout<task_vm_info_data_t>.size / MemoryLayout<natural_t>.size)
+        let result = withUnsafeMutablePointer(to: &info) { pointer in
+            pointer.withMemoryRebound(to: integer_t.self, capacity: Int(count)) {
+                task_info(mach_task_self_, task_flavor_t(TASK_VM_INFO), $0, &count)
+            }
+        }
+        return result == KERN_SUCCESS ? info.phys_footprint : 0
+    }
+    
+    /// 进程累计 CPU 时间（用户态 + 内核态，纳秒）
+    static func processCPUNanoseconds() -> UInt64 {
+        var usage = rusage()
+        guard getrusage(RUSAGE_SELF, &usage) == 0 else { return 0 }
+        func nanoseconds(_ time: timeval) -> UInt64 {
+            return UInt64(time.tv_sec) * 1_000_000_000 + UInt64(time.tv_usec) * 1000
+        }
+        return nanoseconds(usage.ru_utime) + nanoseconds(usage.ru_stime)
+    }
+}
+
+// MARK: - BenchmarkSuite
+/// 基准测试套件
+protocol BenchmarkSuite {
+    static var name: String { get }
+    static var summary: String { get }
+    static func run(_ runner: BenchmarkRunner)
+}
+
+// MARK: - BenchmarkRegistry
+/// 已注册的基准测试套件
+enum BenchmarkRegistry {
+    
+    static let suites: [BenchmarkSuite.Type] = [
+        CapturePipelineBenchmark.self,
+        DSPKernelBenchmark.self,
+        DenormalBenchmark.self,
+        ProcessLevelBenchmark.self,
+        StartupBenchmark.self,
+        OfflinePipelineBenchmark.self,
+        SessionScalingBenchmark.self,
+        ReplayBenchmark.self,
+        ArenaBenchmark.self,
+        TraceOverheadBenchmark.self
+    ]
+    
+    static func suite(named name: String) -> BenchmarkSuite.Type? {
+        return suites.first { $0.name == name }
+    }
+}
@@ -0,0 +1,56 @@
+import Foundation
+@_spi(Benchmarks) import AudioRecordKit
+
+// MARK: - CapturePipelineBenchmark
+/// 采集管线基准测试 - 特化管线 vs 通用管线
+///
+/// 每个配置测量一次完整的 IO 量子：交错采集数据解交错进入块，再编码为文件格式。
+enum CapturePipelineBenchmark: BenchmarkSuite {
+    
+    static let name = "pipeline"
+    static let summary = "特化采集管线与通用管线的解交错 + 编码耗时对比"
+    
+    /// 单个量子帧数（与常见 Process Tap IO 缓冲区一致）
+    static let framesPerQuantum = 512
+    static let sampleRate = 48000.0
+    
+    static func run(_ runner: BenchmarkRunner) {
+        let frames = framesPerQuantum
+        let maxChannels = 2
+        
+        // 输入为满幅正弦，避免全零输入让量化走捷径
+        let input = UnsafeMutablePointer<Float>.allocate(capacity: frames * maxChannels)
+        defer { input.deallocate() }
+        for i in 0..<(frames * maxChannels) {
+            input[i] = sin(Float(i) * 0.01)
+        }
+        let output = UnsafeMutableRawPointer.allocate(byteCount: frames * maxChannels * 4, alignment: 16)
+        defer { output.deallocate() }
+        let block = AudioBlock(channels: maxChannels, frameCapacity: frames, sampleRate: sampleRate)
+        
+        // 采集模式不影响转换代码，只按声道布局 × 位深测量
+        for channels in 1...maxChannels {
+            for depth in PipelineBitDepth.allCases {
+                let configuration = CapturePipelineConfiguration(mode: .mixed, channelCount: channels, bitDepth: depth)
+                block.setChannelCount(channels)
+                
+                var timings: [String: Double] = [:]
+                let variants: [(String, CapturePipeline)] = [
+                    ("generic", CapturePipelineFactory.makeGeneric(configuration)),
+                    ("specialized", CapturePipelineFactory.make(configuration))
+                ]
+                for (label, pipeline) in variants {
+                    let result = runner.measure(suite: name, name: "\(configuration) \(label)", frames: frames, sampleRate: sampleRate) {
+                        pipeline.ingest(interleaved: input, frames: frames, into: block)
+                        let bytes = pipeline.encode(block, frames: frames, into: output)
+                        runner.consume(Float(bytes) + output.load(as: Float.self))
+                    }
+                    timings[label] = result.nanosecondsPerIteration
+                }
+                if let generic = timings["generic"], let specialized = timings["specialized"], specialized > 0 {
+                    Logger.shared.info("🧬 \(configuration): 特化管线快 \(String(format: "%.2f", generic / specialized))x")
+                }
+            }
+        }
+    }
+}
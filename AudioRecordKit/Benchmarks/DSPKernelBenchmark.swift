@@ -0,0 +1,130 @@
+import Foundation
+import CoreAudio
+@_spi(Benchmarks) import AudioRecordKit
+
+// MARK: - DSPKernelBenchmark
+/// DSP 内核基准测试 - 每个内核 × 当前 CPU 支持的每个指令集变体 × 块大小（64~8192 帧）
+///
+/// 覆盖量化（int16）、混音（mix）、电平（meter）三个内核，以及按声道数测量的
+/// 解交错 / 交错、采集回调的电平计算和按位深测量的编码（float32 / int16 / int24）。每项同时报告
+/// ns/frame 与读写字节数对应的带宽（GB/s），小块看调用开销，大块看带宽上限。
+/// 测量前先用标量参考实现交叉校验，不一致的变体记录错误日志。
+enum DSPKernelBenchmark: BenchmarkSuite {
+    
+    static let name = "kernels"
+    static let summary = "DSP 内核各指令集变体在 64~8192 帧块上的耗时与带宽（含标量交叉校验）"
+    
+    static let blockSizes = [64, 128, 256, 512, 1024, 2048, 4096, 8192]
+    static let channelCounts = [1, 2, 8]
+    static let sampleRate = 48000.0
+    
+    static func run(_ runner: BenchmarkRunner) {
+        for failure in DSPKernels.verify() {
+            Logger.shared.error("❌ DSP 内核校验失败: \(failure)")
+        }
+        
+        let maxFrames = blockSizes.max() ?? 8192
+        let maxChannels = channelCounts.max() ?? 2
+        let maxSamples = maxFrames * maxChannels
+        let source = UnsafeMutablePointer<Float>.allocate(capacity: maxSamples)
+        let destination = UnsafeMutablePointer<Float>.allocate(capacity: maxSamples)
+        let destination16 = UnsafeMutablePointer<Int16>.allocate(capacity: maxFrames)
+        let encoded = UnsafeMutableRawPointer.allocate(byteCount: maxSamples * 4, alignment: 16)
+        defer {
+            source.deallocate()
+            destination.deallocate()
+            destination16.deallocate()
+            encoded.deallocate()
+        }
+        for i in 0..<maxSamples {
+            source[i] = sin(Float(i) * 0.01)
+        }
+        destination.initialize(repeating: 0, count: maxSamples)
+        
+        let floatSize = MemoryLayout<Float>.size
+        for frames in blockSizes {
+            for (isa, function) in DSPKernels.convertInt16.supportedVariants {
+                runner.measure(suite: name, name: label(DSPKernels.convertInt16, isa, frames), frames: frames, sampleRate: sampleRate,
+                               bytes: frames * (floatSize + MemoryLayout<Int16>.size)) {
+                    function(source, destination16, frames)
+                    runner.consume(Float(destination16[frames - 1]))
+                }
+            }
+            for (isa, function) in DSPKernels.multiplyAdd.supportedVariants {
+                // 读源、读写目标
+                runner.measure(suite: name, name: label(DSPKernels.multiplyAdd, isa, frames), frames: frames, sampleRate: sampleRate,
+                               bytes: frames * floatSize * 3) {
+                    // 增益为 0 时目标保持不变，避免多次迭代后溢出
+                    function(source, 0, destination, frames)
+                    runner.consume(destination[frames - 1])
+                }
+            }
+            for (isa, function) in DSPKernels.peakSumSquares.supportedVariants {
+                runner.measure(suite: name, name: label(DSPKernels.peakSumSquares, isa, frames), frames: frames, sampleRate: sampleRate,
+                               bytes: frames * floatSize) {
+                    let result = function(source, frames)
+                    runner.consume(result.peak + result.sumSquares)
+                }
+            }
+        }
+        
+        // 交错 ↔ 非交错（按声道数）
+        for channels in channelCounts {
+            let block = AudioBlock(channels: channels, frameCapacity: maxFrames, sampleRate: sampleRate)
+            for frames in blockSizes {
+                let bytes = frames * channels * floatSize * 2
+                runner.measure(suite: name, name: "deinterleave \(channels)ch n=\(frames)", frames: frames, sampleRate: sampleRate, bytes: bytes) {
+                    block.deinterleave(from: source, channels: channels, frames: frames)
+                    runner.consume(block.channel(channels - 1)[frames - 1])
+                }
+                runner.measure(suite: name, name: "interleave \(channels)ch n=\(frames)", frames: frames, sampleRate: sampleRate, bytes: bytes) {
+                    block.interleave(into: destination, channels: channels, frames: frames)
+                    runner.consume(destination[frames * channels - 1])
+                }
+            }
+        }
+        
+        // 采集回调的电平计算（交错 AudioBufferList 按声道步长读取）
+        let view = AudioBufferListView()
+        for channels in channelCounts {
+            for frames in blockSizes {
+                var bufferList = AudioBufferList(
+                    mNumberBuffers: 1,
+                    mBuffers: AudioBuffer(
+                        mNumberChannels: UInt32(channels),
+                        mDataByteSize: UInt32(frames * channels * floatSize),
+                        mData: UnsafeMutableRawPointer(source)
+                    )
+                )
+                guard view.bind(&bufferList) else { continue }
+                runner.measure(suite: name, name: "level \(channels)ch n=\(frames)", frames: frames, sampleRate: sampleRate,
+                               bytes: frames * channels * floatSize) {
+                    let level = AudioUtils.calculateAudioLevel(from: view, frameCount: UInt32(frames))
+                    runner.consume(level.rmsLevel)
+                }
+            }
+        }
+        
+        // 编码为文件格式（按位深与声道数）
+        for depth in PipelineBitDepth.allCases {
+            for channels in [1, 2] {
+                let configuration = CapturePipelineConfiguration(mode: .mixed, channelCount: channels, bitDepth: depth)
+                let pipeline = CapturePipelineFactory.make(configuration)
+                let block = AudioBlock(channels: channels, frameCapacity: maxFrames, sampleRate: sampleRate)
+                block.deinterleave(from: source, channels: channels, frames: maxFrames)
+                for frames in blockSizes {
+                    let bytes = frames * channels * (floatSize + depth.bytesPerSample)
+                    runner.measure(suite: name, name: "encode \(depth) \(channels)ch n=\(frames)", frames: frames, sampleRate: sampleRate, bytes: bytes) {
+                        let written = pipeline.encode(block, frames: frames, into: encoded)
+                        runner.consume(Float(written) + encoded.load(as: Float.self))
+                    }
+                }
+            }
+        }
+    }
+    
+    private static func label<Function>(_ kernel: DSPKernel<Function>, _ isa: DSPKernelISA, _ frames: Int) -> String {
+        let marker = isa == kernel.selectedISA ? " *" : ""
+        return "\(kernel.name) \(isa.rawValue)\(marker) n=\(frames)"
+    }
+}
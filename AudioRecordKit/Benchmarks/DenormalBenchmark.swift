@@ -0,0 +1,74 @@
+import Foundation
+@_spi(Benchmarks) import AudioRecordKit
+
+// MARK: - DenormalBenchmark
+/// 非规格化数基准测试 - 双二阶滤波器在静音尾部的每块耗时
+///
+/// 每次迭代把滤波器状态设到非规格化边缘再处理一个静音块，模拟录音进入静音后的衰减尾部；
+/// 开启 FTZ/DAZ 时静音尾部与有信号的块耗时应基本持平。
+enum DenormalBenchmark: BenchmarkSuite {
+    
+    static let name = "denormals"
+    static let summary = "双二阶滤波器静音尾部耗时（FTZ/DAZ 开启与关闭对比）"
+    
+    static let framesPerQuantum = 512
+    static let sampleRate = 48000.0
+    /// 低截止频率让极点接近单位圆，状态在整个块内都停留在非规格化区间
+    static let cutoff = 20.0
+    /// 略小于 Float 最小规格化数（约 1.18e-38）
+    static let tailState: Float = 1e-39
+    
+    static func run(_ runner: BenchmarkRunner) {
+        let frames = framesPerQuantum
+        let signal = UnsafeMutablePointer<Float>.allocate(capacity: frames)
+        let silence = UnsafeMutablePointer<Float>.allocate(capacity: frames)
+        let output = UnsafeMutablePointer<Float>.allocate(capacity: frames)
+        defer {
+            signal.deallocate()
+            silence.deallocate()
+            output.deallocate()
+        }
+        for i in 0..<frames {
+            signal[i] = 0.5 * sin(Float(i) * 0.05)
+        }
+        silence.initialize(repeating: 0, count: frames)
+        output.initialize(repeating: 0, count: frames)
+        
+        let coefficients = Biquad.Coefficients.lowPass(frequency: cutoff, sampleRate: sampleRate)
+        var ratios: [(label: String, ratio: Double)] = []
+        
+        for flush in [false, true] {
+            let label = flush ? "ftz=on" : "ftz=off"
+            var filter = Biquad(coefficients)
+            
+            let signalResult = measure(runner, "biquad signal \(label)", flush: flush) {
+                filter.process(signal, output, frames: frames)
+                runner.consume(output[frames - 1])
+            }
+            let tailResult = measure(runner, "biquad silent tail \(label)", flush: flush) {
+                filter.setState(tailState)
+                filter.process(silence, output, frames: frames)
+                runner.consume(output[frames - 1])
+            }
+            if signalResult.nanosecondsPerIteration > 0 {
+                ratios.append((label, tailResult.nanosecondsPerIteration / signalResult.nanosecondsPerIteration))
+            }
+        }
+        
+        for (label, ratio) in ratios {
+            Logger.shared.info("🧊 静音尾部/有信号 耗时比 (\(label)): \(String(format: "%.2f", ratio))x")
+        }
+    }
+    
+    /// 关闭 FTZ 时显式清除标志位，避免继承调用线程的设置
+    private static func measure(_ runner: BenchmarkRunner, _ name: String, flush: Bool, _ body: () -> Void) -> BenchmarkMeasurement {
+        if flush {
+            return DenormalScope.run {
+                runner.measure(suite: self.name, name: name, frames: framesPerQuantum, sampleRate: sampleRate, body)
+            }
+        }
+        return DenormalScope.runWithoutFlush {
+            runner.measure(suite: self.name, name: name, frames: framesPerQuantum, sampleRate: sampleRate, body)
+        }
+    }
+}
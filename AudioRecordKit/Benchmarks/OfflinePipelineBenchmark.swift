@@ -0,0 +1,253 @@
+import Foundation
+import Darwin
+import CoreAudio
+import AVFoundation
+@_spi(Benchmarks) import AudioRecordKit
+
+// MARK: - OfflinePipelineBenchmark
+/// 端到端离线管线基准测试 - 文件回放源尽可能快地驱动处理图
+///
+/// 每种录制模式搭建与录制器相同形状的处理图：回放（44.1kHz）→ 重采样（48kHz）
+/// →（混合模式再叠加麦克风环形缓冲源）→ 混音 → 限幅 → 电平 / 编码写入 WAV。
+/// 每个模式 × 输出位深分别在写入后不 fsync 与每个量子 fsync 两种条件下测量，报告：
+/// - 实时倍数（单线程）
+/// - cpu：实时运行一路该流所需的单核 CPU 比例
+/// - GB/s：写入文件的字节速率
+///
+/// 回放文件在测量前生成并解码到内存，计时范围不含读取文件。
+/// 每项回放 `--iterations` 个量子（至少 100 个）。
+enum OfflinePipelineBenchmark: BenchmarkSuite {
+    
+    static let name = "throughput"
+    static let summary = "端到端离线管线（回放→重采样→混音→限幅→电平→编码→写入）的实时倍数、CPU 与写入速率"
+    
+    static let framesPerQuantum = 512
+    static let graphSampleRate = 48000.0
+    static let fixtureSampleRate = 44100.0
+    static let fixtureSeconds = 10
+    static let minimumQuanta = 100
+    
+    static func run(_ runner: BenchmarkRunner) {
+        guard #available(macOS 14.4, *) else {
+            Logger.shared.warning("⚠️ 离线管线基准测试需要 macOS 14.4 或更高版本")
+            return
+        }
+        runAll(runner)
+    }
+    
+    // MARK: - Fixture
+    
+    /// 解码到内存的回放数据（立体声交错 + 单声道，用作麦克风）
+    private final class Fixture {
+        let frames: Int
+        let stereo: UnsafeMutablePointer<Float>
+        let mono: UnsafeMutablePointer<Float>
+        
+        init(frames: Int) {
+            self.frames = frames
+            stereo = UnsafeMutablePointer<Float>.allocate(capacity: frames * 2)
+            mono = UnsafeMutablePointer<Float>.allocate(capacity: frames)
+        }
+        
+        deinit {
+            stereo.deallocate()
+            mono.deallocate()
+        }
+    }
+    
+    /// 生成回放文件（两个正弦 + 低电平噪声）并解码到内存
+    @available(macOS 14.4, *)
+    private static func makeFixture(in directory: URL) throws -> Fixture {
+        let frames = Int(fixtureSampleRate) * fixtureSeconds
+        let url = directory.appendingPathComponent("replay.wav")
+        let fileManager = AudioToolboxFileManager(audioFormat: fileFormat(.float32, channels: 2, sampleRate: fixtureSampleRate))
+        try fileManager.createAudioFile(at: url)
+        
+        let chunk = 4096
+        var samples = [Float](repeating: 0, count: chunk * 2)
+        var generator = SystemRandomNumberGenerator()
+        var frame = 0
+        while frame < frames {
+            let n = min(chunk, frames - frame)
+            for i in 0..<n {
+                let t = Float(frame + i) / Float(fixtureSampleRate)
+                let noise = Float.random(in: -0.01...0.01, using: &generator)
+                samples[i * 2] = 0.5 * sin(2 * .pi * 440 * t) + noise
+                samples[i * 2 + 1] = 0.4 * sin(2 * .pi * 660 * t) + noise
+            }
+            try samples.withUnsafeBytes { bytes in
+                try fileManager.writeEncodedPackets(bytes.baseAddress!, byteCount: n * 2 * MemoryLayout<Float>.size, frameCount: UInt32(n))
+            }
+            frame += n
+        }
+        fileManager.closeFile()
+        
+        // 回放：按交错 Float32 解码
+        let file = try AVAudioFile(forReading: url, commonFormat: .pcmFormatFloat32, interleaved: true)
+        guard let buffer = AVAudioPCMBuffer(pcmFormat: file.processingFormat, frameCapacity: AVAudioFrameCount(file.length)) else {
+            throw NSError(domain: "OfflinePipelineBenchmark", code: -1,
+                          userInfo: [NSLocalizedDescriptionKey: "无法分配回放缓冲区"])
+        }
+        try file.read(into: buffer)
+        guard let data = buffer.floatChannelData?[0], buffer.frameLength > 0 else {
+            throw NSError(domain: "OfflinePipelineBenchmark", code: -2,
+                          userInfo: [NSLocalizedDescriptionKey: "回放文件为空"])
+        }
+        
+        let fixture = Fixture(frames: Int(buffer.frameLength))
+        fixture.stereo.update(from: data, count: fixture.frames * 2)
+        for i in 0..<fixture.frames {
+            fixture.mono[i] = data[i * 2]
+        }
+        return fixture
+    }
+    
+    // MARK: - Measurement
+    
+    @available(macOS 14.4, *)
+    private static func runAll(_ runner: BenchmarkRunner) {
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("audiorecord-throughput-\(ProcessInfo.processInfo.processIdentifier)")
+        defer { try? FileManager.default.removeItem(at: directory) }
+        
+        let fixture: Fixture
+        do {
+            try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+            fixture = try makeFixture(in: directory)
+        } catch {
+            Logger.shared.error("❌ 无法生成回放文件: \(error.localizedDescription)")
+            return
+        }
+        
+        for mode in CaptureMode.allCases {
+            for depth in PipelineBitDepth.allCases {
+                for sync in [false, true] {
+                    do {
+                        runner.record(try measure(runner, mode: mode, depth: depth, sync: sync, fixture: fixture, directory: directory))
+                    } catch {
+                        Logger.shared.error("❌ 离线管线 \(mode.name)/\(depth) 测量失败: \(error.localizedDescription)")
+                    }
+                }
+            }
+        }
+    }
+    
+    @available(macOS 14.4, *)
+    private static func measure(_ runner: BenchmarkRunner, mode: CaptureMode, depth: PipelineBitDepth, sync: Bool,
+                                fixture: Fixture, directory: URL) throws -> BenchmarkMeasurement {
+        // 麦克风模式为单声道，其余为立体声
+        let channels = mode == .microphone ? 1 : 2
+        let format = fileFormat(depth, channels: channels, sampleRate: graphSampleRate)
+        let fileManager = AudioToolboxFileManager(audioFormat: format)
+        let pipeline = CapturePipelineFactory.make(CapturePipelineConfiguration(mode: mode, fileFormat: format))
+        
+        // 每个量子读入的回放帧数，重采样后约为一个图量子
+        let inputFrames = Int((Double(framesPerQuantum) * fixtureSampleRate / graphSampleRate).rounded(.up))
+        
+        let graph = AudioGraph(name: "Offline", sampleRate: graphSampleRate, maxFramesPerQuantum: framesPerQuantum, workerCount: 0,
+                               xruns: fileManager.xruns)
+        let source = graph.add(PushSourceNode(name: "replay", channels: channels, maxFrames: framesPerQuantum, sampleRate: fixtureSampleRate, pipeline: pipeline))
+        let resampler = graph.add(ResamplerNode(name: "resampler", channels: channels, maxInputFrames: framesPerQuantum,
+                                                inputSampleRate: fixtureSampleRate, outputSampleRate: graphSampleRate))
+        let limiter = graph.add(LimiterNode(name: "limiter", channels: channels, maxFrames: framesPerQuantum, sampleRate: graphSampleRate))
+        let meter = graph.add(MeterNode(name: "meter", channels: channels, maxFrames: framesPerQuantum, sampleRate: graphSampleRate,
+                                        scale: .decibel(floorDB: 96)))
+        let writer = graph.add(FileWriterNode(name: "writer", fileManager: fileManager, pipeline: pipeline, maxFrames: framesPerQuantum, sampleRate: graphSampleRate))
+        
+        try graph.connect(source, to: resampler)
+        var mic: RingBufferSourceNode?
+        if mode == .mixed {
+            let micSource = graph.add(RingBufferSourceNode(name: "mic", channels: channels, maxFrames: framesPerQuantum, sampleRate: graphSampleRate,
+                                                           capacityFrames: framesPerQuantum * 8))
+            let agc = graph.add(AGCNode(name: "agc", channels: channels, maxFrames: framesPerQuantum, sampleRate: graphSampleRate))
+            let mixer = graph.add(MixerNode(name: "mixer", channels: channels, maxFrames: framesPerQuantum, sampleRate: graphSampleRate))
+            try graph.connect(resampler, to: mixer)
+            try graph.connect(micSource, to: agc)
+            try graph.connect(agc, to: mixer)
+            try graph.connect(mixer, to: limiter)
+            mixer.setGain(0.6, forInput: 0)
+            mixer.setGain(0.4, forInput: 1)
+            mic = micSource
+        } else {
+            try graph.connect(resampler, to: limiter)
+        }
+        try graph.connect(limiter, to: meter)
+        try graph.connect(limiter, to: writer)
+        try graph.compile()
+        
+        let label = "\(mode.name) \(channels)ch \(depth) fsync=\(sync ? "on" : "off")"
+        let url = directory.appendingPathComponent("throughput_\(mode.rawValue)_\(depth)_\(sync ? 1 : 0).wav")
+        try fileManager.createAudioFile(at: url)
+        // 写入不经过缓存，在另一个描述符上 fsync 即可把该文件的数据刷到设备
+        let descriptor = sync ? open(url.path, O_RDONLY) : -1
+        defer {
+            if descriptor >= 0 {
+                close(descriptor)
+            }
+            graph.shutdown()
+            fileManager.closeFile()
+            try? FileManager.default.removeItem(at: url)
+        }
+        
+        let quanta = max(runner.iterations, minimumQuanta)
+        let span = max(inputFrames, framesPerQuantum)
+        var micPointer = fixture.mono
+        var position = 0
+        
+        let cpuBegin = clock_gettime_nsec_np(CLOCK_THREAD_CPUTIME_ID)
+        let wallBegin = mach_absolute_time()
+        for _ in 0..<quanta {
+            if position + span > fixture.frames {
+                position = 0
+            }
+            if channels == 1 {
+                source.load(interleaved: fixture.mono + position, channels: 1, frames: inputFrames)
+            } else {
+                source.load(interleaved: fixture.stereo + position * 2, channels: 2, frames: inputFrames)
+            }
+            if let mic = mic {
+                micPointer = fixture.mono + position
+                mic.write(channels: &micPointer, channelCount: 1, frames: framesPerQuantum)
+            }
+            graph.render(frameCount: framesPerQuantum)
+            if descriptor >= 0 {
+                fsync(descriptor)
+            }
+            position += inputFrames
+        }
+        let wallTicks = mach_absolute_time() - wallBegin
+        let cpuNanoseconds = clock_gettime_nsec_np(CLOCK_THREAD_CPUTIME_ID) - cpuBegin
+        let bytesWritten = Int(fileManager.getFileInfo().totalFrames) * Int(format.mBytesPerFrame)
+        
+        var measurement = BenchmarkMeasurement(
+            suite: name,
+            name: label,
+            iterations: quanta,
+            framesPerIteration: framesPerQuantum,
+            sampleRate: graphSampleRate,
+            totalNanoseconds: BenchmarkRunner.nanoseconds(fromHostTicks: wallTicks)
+        )
+        measurement.cpuNanoseconds = cpuNanoseconds
+        measurement.bytesPerIteration = bytesWritten / quanta
+        return measurement
+    }
+    
+    /// 交错 PCM 文件格式
+    private static func fileFormat(_ depth: PipelineBitDepth, channels: Int, sampleRate: Double) -> AudioStreamBasicDescription {
+        let bytesPerFrame = UInt32(depth.bytesPerSample * channels)
+        let flags: AudioFormatFlags = depth == .float32
+            ? kAudioFormatFlagIsFloat | kAudioFormatFlagIsPacked
+            : kAudioFormatFlagIsSignedInteger | kAudioFormatFlagIsPacked
+        return AudioStreamBasicDescription(
+            mSampleRate: sampleRate,
+            mFormatID: kAudioFormatLinearPCM,
+            mFormatFlags: flags,
+            mBytesPerPacket: bytesPerFrame,
+            mFramesPerPacket: 1,
+            mBytesPerFrame: bytesPerFrame,
+            mChannelsPerFrame: UInt32(channels),
+            mBitsPerChannel: depth.bitsPerChannel,
+            mReserved: 0
+        )
+    }
+}
@@ -0,0 +1,50 @@
+import Foundation
+import CoreAudio
+@_spi(Benchmarks) import AudioRecordKit
+
+// MARK: - ProcessLevelBenchmark
+/// 多进程电平监控基准测试 - IO 回调耗时随进程数的增长
+///
+/// 每项测量一个 IO 量子：N 个 Tap 各一个交错立体声缓冲区，全部交给 `ProcessLevelMeter`。
+/// 实时倍数即单个监控回调相对量子时长的余量，ns/frame 除以进程数得到每个进程的开销。
+enum ProcessLevelBenchmark: BenchmarkSuite {
+    
+    static let name = "process-levels"
+    static let summary = "多进程电平监控：单个 IO 量子的耗时随进程数（1~128）的变化"
+    
+    static let framesPerQuantum = 512
+    static let channels = 2
+    static let sampleRate = 48000.0
+    static let processCounts = [1, 4, 16, 32, 64, 128]
+    
+    static func run(_ runner: BenchmarkRunner) {
+        let frames = framesPerQuantum
+        let samplesPerTap = frames * channels
+        let maxProcesses = processCounts.max() ?? 1
+        
+        // 每个 Tap 一个独立缓冲区，模拟聚合设备交给回调的多条输入流
+        let storage = UnsafeMutablePointer<Float>.allocate(capacity: samplesPerTap * maxProcesses)
+        defer { storage.deallocate() }
+        for i in 0..<(samplesPerTap * maxProcesses) {
+            storage[i] = sin(Float(i) * 0.01) * 0.5
+        }
+        
+        for count in processCounts {
+            let bufferList = AudioBufferList.allocate(maximumBuffers: count)
+            defer { free(bufferList.unsafeMutablePointer) }
+            for index in 0..<count {
+                bufferList[index] = AudioBuffer(
+                    mNumberChannels: UInt32(channels),
+                    mDataByteSize: UInt32(samplesPerTap * MemoryLayout<Float>.size),
+                    mData: UnsafeMutableRawPointer(storage + index * samplesPerTap)
+                )
+            }
+            
+            let meter = ProcessLevelMeter(pids: (0..<count).map { pid_t($0 + 1) })
+            runner.measure(suite: name, name: "\(count) processes", frames: frames, sampleRate: sampleRate) {
+                meter.accumulate(bufferList.unsafePointer)
+                runner.consume(Float(meter.publishCount))
+            }
+        }
+    }
+}
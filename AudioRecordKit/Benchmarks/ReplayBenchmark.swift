@@ -0,0 +1,64 @@
+import Foundation
+@_spi(Benchmarks) import AudioRecordKit
+
+// MARK: - ReplayBenchmark
+/// 回调回放基准测试 - 用现场采集的回调序列比较不同提交的性能与输出
+///
+/// 环境变量 `AUDIORECORD_BENCH_TRACE` 指定采集文件（`AUDIORECORD_CAPTURE` 录制所得），未设置时跳过。
+/// 先回放一次作为预热并记下输出哈希，再全速回放 `--iterations` 次（至少 3 次），
+/// 报告每次渲染的耗时与 p50/p99；任一次输出哈希与预热不同即说明回放不确定，记录错误日志。
+enum ReplayBenchmark: BenchmarkSuite {
+    
+    static let name = "replay"
+    static let summary = "全速回放现场采集的回调序列（AUDIORECORD_BENCH_TRACE），报告渲染耗时并校验输出逐位一致"
+    
+    static let environmentVariable = "AUDIORECORD_BENCH_TRACE"
+    static let minimumRuns = 3
+    
+    static func run(_ runner: BenchmarkRunner) {
+        guard let path = ProcessInfo.processInfo.environment[environmentVariable], !path.isEmpty else {
+            Logger.shared.info("ℹ️ 未设置 \(environmentVariable)，跳过回放基准测试")
+            return
+        }
+        guard #available(macOS 14.4, *) else {
+            Logger.shared.warning("⚠️ 回放基准测试需要 macOS 14.4 或更高版本")
+            return
+        }
+        
+        do {
+            let replay = try CallbackReplay(url: URL(fileURLWithPath: path))
+            let reference = try replay.run(timing: .asFastAsPossible)
+            let runs = min(max(runner.iterations, minimumRuns), 20)
+            var renders: [UInt64] = []
+            var mismatches = 0
+            var last = reference
+            for _ in 0..<runs {
+                last = try replay.run(timing: .asFastAsPossible)
+                renders.append(last.renderNanoseconds)
+                if last.outputHash != reference.outputHash {
+                    mismatches += 1
+                }
+            }
+            if mismatches > 0 {
+                Logger.shared.error("❌ 回放输出不确定: \(mismatches)/\(runs) 次哈希与预热不同")
+            }
+            
+            let quanta = max(Int(last.renderLatency.count), 1)
+            let fileName = URL(fileURLWithPath: path).lastPathComponent
+            var measurement = BenchmarkMeasurement(
+                suite: name,
+                name: "\(fileName) render",
+                iterations: quanta,
+                framesPerIteration: Int(last.frames) / quanta,
+                sampleRate: last.sampleRate,
+                totalNanoseconds: BenchmarkRunner.percentile(renders.sorted(), 0.5)
+            )
+            measurement.p50Nanoseconds = UInt64(max(last.renderLatency.p50, 0))
+            measurement.p99Nanoseconds = UInt64(max(last.renderLatency.p99, 0))
+            runner.record(measurement)
+            Logger.shared.info("🔁 回放 \(fileName): \(last.callbacks) 块, 输出哈希 \(String(format: "%016llx", reference.outputHash))")
+        } catch {
+            Logger.shared.error("❌ 回放基准测试失败: \(error.localizedDescription)")
+        }
+    }
+}
@@ -0,0 +1,187 @@
+import Foundation
+import Darwin
+import CoreAudio
+@_spi(Benchmarks) import AudioRecordKit
+
+// MARK: - SessionScalingBenchmark
+/// 多会话扩展性基准测试 - 1…N 个并发录制会话共用进程内的单例与全局状态
+///
+/// 每个会话是一条独立的录制链路（推送源 → 限幅 → 电平 / 写入 16 位 WAV），
+/// 由各自的合成设备线程驱动。每个会话数分两轮：
+/// - 实时节奏：各会话按 512 帧周期回调，统计每个会话的回调延迟 p99、丢块数与内存增量；
+/// - 全速：各会话不等待周期连续渲染，统计聚合实时倍数与每路流的 CPU 占用。
+///
+/// 聚合实时倍数相对单会话的加速比低于 min(N, 核心数) 时，说明共享状态开始限制扩展。
+enum SessionScalingBenchmark: BenchmarkSuite {
+    
+    static let name = "scaling"
+    static let summary = "1…64 个并发会话的聚合吞吐、每会话 p99 回调延迟、丢块数与内存"
+    
+    static let sessionCounts = [1, 2, 4, 8, 16, 32, 64]
+    static let framesPerQuantum = 512
+    static let channels = 2
+    static let sampleRate = 48000.0
+    /// 全速轮每个会话渲染的量子数是实时轮的倍数
+    static let freeRunMultiplier = 5
+    static let minimumQuanta = 100
+    
+    static func run(_ runner: BenchmarkRunner) {
+        guard #available(macOS 14.4, *) else {
+            Logger.shared.warning("⚠️ 多会话基准测试需要 macOS 14.4 或更高版本")
+            return
+        }
+        runAll(runner)
+    }
+    
+    // MARK: - Session
+    
+    /// 一个录制会话：处理图 + 文件 + 合成设备
+    @available(macOS 14.4, *)
+    private final class Session {
+        let device: SyntheticDevice
+        let histogram: LatencyHistogram
+        private let graph: AudioGraph
+        private let fileManager: AudioToolboxFileManager
+        private let url: URL
+        
+        init(url: URL, input: UnsafePointer<Float>, paced: Bool, quanta: Int) throws {
+            let format = AudioStreamBasicDescription(
+                mSampleRate: SessionScalingBenchmark.sampleRate,
+                mFormatID: kAudioFormatLinearPCM,
+                mFormatFlags: kAudioFormatFlagIsSignedInteger | kAudioFormatFlagIsPacked,
+                mBytesPerPacket: UInt32(SessionScalingBenchmark.channels * 2),
+                mFramesPerPacket: 1,
+                mBytesPerFrame: UInt32(SessionScalingBenchmark.channels * 2),
+                mChannelsPerFrame: UInt32(SessionScalingBenchmark.channels),
+                mBitsPerChannel: 16,
+                mReserved: 0
+            )
+            let frames = SessionScalingBenchmark.framesPerQuantum
+            let channels = SessionScalingBenchmark.channels
+            let sampleRate = SessionScalingBenchmark.sampleRate
+            
+            self.url = url
+            fileManager = AudioToolboxFileManager(audioFormat: format)
+            let pipeline = CapturePipelineFactory.make(CapturePipelineConfiguration(mode: .specificProcess, fileFormat: format))
+            graph = AudioGraph(name: "Session", sampleRate: sampleRate, maxFramesPerQuantum: frames, workerCount: 0, xruns: fileManager.xruns)
+            let source = graph.add(PushSourceNode(name: "source", channels: channels, maxFrames: frames, sampleRate: sampleRate, pipeline: pipeline))
+            let limiter = graph.add(LimiterNode(name: "limiter", channels: channels, maxFrames: frames, sampleRate: sampleRate))
+            let meter = graph.add(MeterNode(name: "meter", channels: channels, maxFrames: frames, sampleRate: sampleRate, scale: .decibel(floorDB: 96)))
+            let writer = graph.add(FileWriterNode(name: "writer", fileManager: fileManager, pipeline: pipeline, maxFrames: frames, sampleRate: sampleRate))
+            try graph.connect(source, to: limiter)
+            try graph.connect(limiter, to: meter)
+            try graph.connect(limiter, to: writer)
+            try graph.compile()
+            try fileManager.createAudioFile(at: url)
+            
+            histogram = LatencyHistogram()
+            device = SyntheticDevice(graph: graph, source: source, input: input, channels: channels, frames: frames, sampleRate: sampleRate,
+                                     paced: paced, maxCallbacks: quanta, callbackLatency: paced ? histogram : nil)
+        }
+        
+        func close() {
+            device.stop()
+            graph.shutdown()
+            fileManager.closeFile()
+            try? FileManager.default.removeItem(at: url)
+        }
+    }
+    
+    // MARK: - Measurement
+    
+    @available(macOS 14.4, *)
+    private static func runAll(_ runner: BenchmarkRunner) {
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("audiorecord-scaling-\(ProcessInfo.processInfo.processIdentifier)")
+        do {
+            try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        } catch {
+            Logger.shared.error("❌ 无法创建多会话基准测试目录: \(error.localizedDescription)")
+            return
+        }
+        defer { try? FileManager.default.removeItem(at: directory) }
+        
+        let input = UnsafeMutablePointer<Float>.allocate(capacity: framesPerQuantum * channels)
+        defer { input.deallocate() }
+        for i in 0..<(framesPerQuantum * channels) {
+            input[i] = sin(Float(i) * 0.01) * 0.5
+        }
+        
+        let quanta = max(runner.iterations, minimumQuanta)
+        var singleSessionFactor = 0.0
+        for count in sessionCounts {
+            do {
+                try measurePaced(runner, sessions: count, quanta: quanta, input: input, directory: directory)
+                let aggregate = try measureFreeRunning(runner, sessions: count, quanta: quanta * freeRunMultiplier, input: input, directory: directory)
+                if count == 1 {
+                    singleSessionFactor = aggregate
+                }
+                if singleSessionFactor > 0 {
+                    let cores = ProcessInfo.processInfo.activeProcessorCount
+                    Logger.shared.info("📈 \(count) 个会话: 聚合 \(String(format: "%.1f", aggregate))x 实时, 相对单会话加速 \(String(format: "%.2f", aggregate / singleSessionFactor))x（理想 \(min(count, cores))x）")
+                }
+            } catch {
+                Logger.shared.error("❌ \(count) 个会话测量失败: \(error.localizedDescription)")
+            }
+        }
+    }
+    
+    /// 实时节奏：每会话 p99 回调延迟、丢块数与内存增量
+    @available(macOS 14.4, *)
+    private static func measurePaced(_ runner: BenchmarkRunner, sessions count: Int, quanta: Int,
+                                     input: UnsafePointer<Float>, directory: URL) throws {
+        let footprintBefore = BenchmarkRunner.memoryFootprint()
+        var sessions: [Session] = []
+        defer { sessions.forEach { $0.close() } }
+        for index in 0..<count {
+            sessions.append(try Session(url: directory.appendingPathComponent("paced_\(index).wav"), input: input, paced: true, quanta: quanta))
+        }
+        
+        sessions.forEach { $0.device.start() }
+        sessions.forEach { $0.device.waitUntilFinished() }
+        let footprintAfter = BenchmarkRunner.memoryFootprint()
+        
+        let p99s = sessions.map { UInt64(max($0.histogram.summary().p99, 0)) }
+        let dropped = sessions.reduce(Int64(0)) { $0 + $1.device.droppedBlocks.value }
+        let growth = footprintAfter > footprintBefore ? footprintAfter - footprintBefore : 0
+        if var measurement = BenchmarkRunner.sampled(suite: name, name: "\(count) sessions callback p99", samples: p99s) {
+            measurement.droppedBlocks = dropped
+            measurement.memoryGrowthBytes = Int64(growth)
+            runner.record(measurement)
+        }
+        
+        Logger.shared.info("📊 \(count) 个会话: 丢块 \(dropped), 内存 +\(String(format: "%.2f", Double(growth) / 1_048_576))MB（每会话 \(String(format: "%.2f", Double(growth) / 1_048_576 / Double(count)))MB）")
+    }
+    
+    /// 全速：聚合吞吐与每路流 CPU
+    /// - Returns: 聚合实时倍数
+    @available(macOS 14.4, *)
+    private static func measureFreeRunning(_ runner: BenchmarkRunner, sessions count: Int, quanta: Int,
+                                           input: UnsafePointer<Float>, directory: URL) throws -> Double {
+        var sessions: [Session] = []
+        defer { sessions.forEach { $0.close() } }
+        for index in 0..<count {
+            sessions.append(try Session(url: directory.appendingPathComponent("free_\(index).wav"), input: input, paced: false, quanta: quanta))
+        }
+        
+        let cpuBegin = BenchmarkRunner.processCPUNanoseconds()
+        let wallBegin = mach_absolute_time()
+        sessions.forEach { $0.device.start() }
+        sessions.forEach { $0.device.waitUntilFinished() }
+        let wallTicks = mach_absolute_time() - wallBegin
+        let cpuNanoseconds = BenchmarkRunner.processCPUNanoseconds() - cpuBegin
+        
+        var measurement = BenchmarkMeasurement(
+            suite: name,
+            name: "\(count) sessions aggregate",
+            iterations: count * quanta,
+            framesPerIteration: framesPerQuantum,
+            sampleRate: sampleRate,
+            totalNanoseconds: BenchmarkRunner.nanoseconds(fromHostTicks: wallTicks)
+        )
+        measurement.cpuNanoseconds = cpuNanoseconds
+        measurement.bytesPerIteration = framesPerQuantum * channels * MemoryLayout<Int16>.size
+        runner.record(measurement)
+        return measurement.realtimeFactor
+    }
+}
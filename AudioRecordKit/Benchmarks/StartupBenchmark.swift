@@ -0,0 +1,229 @@
+import Foundation
+import Darwin
+import CoreAudio
+import AVFoundation
+@_spi(Benchmarks) import AudioRecordKit
+
+// MARK: - StartupBenchmark
+/// 启动延迟基准测试 - 创建 → 预热 → 开始 → 第一帧 → 第一个字节落盘
+///
+/// 合成后端搭建与混音录制相同的写入链路（推送源 → 文件写入节点 → WAV 文件），
+/// 由一个按量子周期唤醒的线程模拟设备 IO 回调。每次迭代的各阶段：
+/// - create：创建文件管理器、采集管线与处理图
+/// - prepare：创建文件、编译处理图并启动设备（写入开关关闭）
+/// - start：打开写入开关
+/// - first-frame / first-byte：从开始到第一帧写入、到文件第一次变大
+///
+/// 第一次迭代单独报告为 cold（进程内第一个会话，包含类型加载、文件系统缓存等一次性开销），
+/// 其余迭代报告为 warm。cold 只在进程内第一次运行时有意义，应单独运行 `--suite startup`。
+/// 设置 `AUDIORECORD_BENCH_DEVICES=1` 且已授予麦克风权限时，另外测量真实麦克风录制器。
+enum StartupBenchmark: BenchmarkSuite {
+    
+    static let name = "startup"
+    static let summary = "启动延迟：创建/预热/开始/首帧/首字节落盘各阶段 p50/p99（冷启动单独统计）"
+    
+    static let framesPerQuantum = 512
+    static let channels = 2
+    static let sampleRate = 48000.0
+    /// 等待第一帧/第一个字节的超时
+    static let timeoutNanoseconds: UInt64 = 1_000_000_000
+    /// 真实设备每次启动较重，迭代次数上限
+    static let deviceIterations = 20
+    
+    static func run(_ runner: BenchmarkRunner) {
+        guard #available(macOS 14.4, *) else {
+            Logger.shared.warning("⚠️ 启动延迟基准测试需要 macOS 14.4 或更高版本")
+            return
+        }
+        runSynthetic(runner)
+        if ProcessInfo.processInfo.environment["AUDIORECORD_BENCH_DEVICES"] == "1" {
+            runMicrophone(runner)
+        }
+    }
+    
+    // MARK: - Synthetic Backend
+    
+    /// 单次启动各阶段耗时（纳秒）
+    private struct StartupSample {
+        var create: UInt64 = 0
+        var prepare: UInt64 = 0
+        var start: UInt64 = 0
+        var firstFrame: UInt64 = 0
+        var firstByte: UInt64 = 0
+        var total: UInt64 = 0
+    }
+    
+    @available(macOS 14.4, *)
+    private static func runSynthetic(_ runner: BenchmarkRunner) {
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("audiorecord-startup-\(ProcessInfo.processInfo.processIdentifier)")
+        do {
+            try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        } catch {
+            Logger.shared.error("❌ 无法创建启动基准测试目录: \(error.localizedDescription)")
+            return
+        }
+        defer { try? FileManager.default.removeItem(at: directory) }
+        
+        // 满幅正弦输入，设备线程每个量子重复载入
+        let input = UnsafeMutablePointer<Float>.allocate(capacity: framesPerQuantum * channels)
+        defer { input.deallocate() }
+        for i in 0..<(framesPerQuantum * channels) {
+            input[i] = sin(Float(i) * 0.01) * 0.5
+        }
+        
+        var samples: [StartupSample] = []
+        let count = max(runner.iterations, 2)
+        samples.reserveCapacity(count)
+        for index in 0..<count {
+            let url = directory.appendingPathComponent("startup_\(index).wav")
+            do {
+                samples.append(try measureStartup(url: url, input: input))
+            } catch {
+                Logger.shared.error("❌ 合成启动第 \(index) 次失败: \(error.localizedDescription)")
+            }
+            try? FileManager.default.removeItem(at: url)
+        }
+        guard let cold = samples.first else { return }
+        let warm = samples.dropFirst()
+        
+        let phases: [(String, KeyPath<StartupSample, UInt64>)] = [
+            ("create", \.create),
+            ("prepare", \.prepare),
+            ("start", \.start),
+            ("first-frame", \.firstFrame),
+            ("first-byte", \.firstByte),
+            ("total", \.total)
+        ]
+        for (phase, keyPath) in phases {
+            runner.record(suite: name, name: "synthetic cold \(phase)", samples: [cold[keyPath: keyPath]])
+            runner.record(suite: name, name: "synthetic warm \(phase)", samples: warm.map { $0[keyPath: keyPath] })
+        }
+    }
+    
+    /// 一次完整的合成启动（结束后关闭并保留文件，由调用方删除）
+    @available(macOS 14.4, *)
+    private static func measureStartup(url: URL, input: UnsafePointer<Float>) throws -> StartupSample {
+        var sample = StartupSample()
+        let format = AudioStreamBasicDescription(
+            mSampleRate: sampleRate,
+            mFormatID: kAudioFormatLinearPCM,
+            mFormatFlags: kAudioFormatFlagIsFloat | kAudioFormatFlagIsPacked,
+            mBytesPerPacket: UInt32(channels * 4),
+            mFramesPerPacket: 1,
+            mBytesPerFrame: UInt32(channels * 4),
+            mChannelsPerFrame: UInt32(channels),
+            mBitsPerChannel: 32,
+            mReserved: 0
+        )
+        
+        // create
+        let createBegin = mach_absolute_time()
+        let fileManager = AudioToolboxFileManager(audioFormat: format)
+        let pipeline = CapturePipelineFactory.make(CapturePipelineConfiguration(mode: .mixed, fileFormat: format))
+        let graph = AudioGraph(name: "Startup", sampleRate: sampleRate, maxFramesPerQuantum: framesPerQuantum, workerCount: 0,
+                               xruns: fileManager.xruns)
+        let source = graph.add(PushSourceNode(name: "source", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate, pipeline: pipeline))
+        let firstWrite = AtomicInt64()
+        let writer = graph.add(FileWriterNode(name: "writer", fileManager: fileManager, pipeline: pipeline, maxFrames: framesPerQuantum, sampleRate: sampleRate,
+                                              isWriting: false, firstWriteHostTime: firstWrite))
+        try graph.connect(source, to: writer)
+        let prepareBegin = mach_absolute_time()
+        
+        // prepare
+        try fileManager.createAudioFile(at: url)
+        try graph.compile()
+        let device = SyntheticDevice(graph: graph, source: source, input: input, channels: channels,
+                                     frames: framesPerQuantum, sampleRate: sampleRate)
+        device.start()
+        defer {
+            device.stop()
+            graph.shutdown()
+            fileManager.closeFile()
+        }
+        let baselineSize = fileSize(url)
+        let startBegin = mach_absolute_time()
+        
+        // start
+        writer.isWriting = true
+        let startEnd = mach_absolute_time()
+        
+        let deadline = startBegin + BenchmarkRunner.hostTicks(fromNanoseconds: timeoutNanoseconds)
+        while firstWrite.value == 0 && mach_absolute_time() < deadline {
+            usleep(50)
+        }
+        let firstFrameTime = UInt64(max(firstWrite.value, 0))
+        while fileSize(url) <= baselineSize && mach_absolute_time() < deadline {
+            usleep(50)
+        }
+        let firstByteTime = mach_absolute_time()
+        guard firstFrameTime > 0, firstByteTime < deadline else {
+            throw NSError(domain: "StartupBenchmark", code: -1,
+                          userInfo: [NSLocalizedDescriptionKey: "等待第一帧写入超时"])
+        }
+        
+        sample.create = BenchmarkRunner.nanoseconds(fromHostTicks: prepareBegin - createBegin)
+        sample.prepare = BenchmarkRunner.nanoseconds(fromHostTicks: startBegin - prepareBegin)
+        sample.start = BenchmarkRunner.nanoseconds(fromHostTicks: startEnd - startBegin)
+        sample.firstFrame = BenchmarkRunner.nanoseconds(fromHostTicks: firstFrameTime > startBegin ? firstFrameTime - startBegin : 0)
+        sample.firstByte = BenchmarkRunner.nanoseconds(fromHostTicks: firstByteTime - startBegin)
+        sample.total = BenchmarkRunner.nanoseconds(fromHostTicks: firstByteTime - createBegin)
+        return sample
+    }
+    
+    private static func fileSize(_ url: URL) -> Int64 {
+        var info = stat()
+        guard stat(url.path, &info) == 0 else { return 0 }
+        return Int64(info.st_size)
+    }
+    
+    // MARK: - Microphone Backend
+    
+    /// 真实麦克风录制器：未预热的 startRecording（预热在开始内完成）到第一帧
+    ///
+    /// 录制器要求主线程；基准测试命令行在主线程同步运行。
+    private static func runMicrophone(_ runner: BenchmarkRunner) {
+        guard Thread.isMainThread else {
+            Logger.shared.warning("⚠️ 真实设备启动测试需要在主线程运行，已跳过")
+            return
+        }
+        guard AVCaptureDevice.authorizationStatus(for: .audio) == .authorized else {
+            Logger.shared.warning("⚠️ 未授予麦克风权限，跳过真实设备启动测试")
+            return
+        }
+        
+        var creates: [UInt64] = []
+        var prepares: [UInt64] = []
+        var firstFrames: [UInt64] = []
+        for _ in 0..<deviceIterations {
+            let timings: AudioRecordStartupTimings? = MainActor.assumeIsolated {
+                let createBegin = mach_absolute_time()
+                let recorder = MicrophoneRecorder(mode: .microphone)
+                creates.append(BenchmarkRunner.nanoseconds(fromHostTicks: mach_absolute_time() - createBegin))
+                
+                recorder.startRecording()
+                guard recorder.isRunning else { return nil }
+                let deadline = mach_absolute_time() + BenchmarkRunner.hostTicks(fromNanoseconds: timeoutNanoseconds)
+                while recorder.startupTimings.firstFrameNanoseconds == 0 && mach_absolute_time() < deadline {
+                    usleep(100)
+                }
+                let timings = recorder.startupTimings
+                recorder.stopRecording()
+                if let url = recorder.outputURL {
+                    try? FileManager.default.removeItem(at: url)
+                }
+                return timings
+            }
+            guard let timings = timings, timings.firstFrameNanoseconds > 0 else {
+                Logger.shared.warning("⚠️ 麦克风启动失败或第一帧超时，停止真实设备测试")
+                break
+            }
+            prepares.append(timings.prepareNanoseconds)
+            firstFrames.append(timings.firstFrameNanoseconds)
+        }
+        
+        runner.record(suite: name, name: "microphone create", samples: creates)
+        runner.record(suite: name, name: "microphone prepare", samples: prepares)
+        runner.record(suite: name, name: "microphone first-frame", samples: firstFrames)
+    }
+}
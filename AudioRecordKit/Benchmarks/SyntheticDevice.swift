@@ -0,0 +1,98 @@
+import Foundation
+import Darwin
+@_spi(Benchmarks) import AudioRecordKit
+
+// MARK: - SyntheticDevice
+/// 合成设备 - 专用线程按量子周期渲染处理图，模拟 HAL IO 回调
+///
+/// 与真实设备一样，第一个回调在启动后一个周期到达。回调完成时下一个周期已经过去，
+/// 说明该周期的数据已被设备丢弃：计入丢块数并跳到下一个未来的周期。
+/// `paced` 为 false 时不等待周期，尽可能快地连续渲染（测量吞吐上限）。
+final class SyntheticDevice {
+    
+    // MARK: - Properties
+    private let graph: AudioGraph
+    private let source: PushSourceNode
+    private let input: UnsafePointer<Float>
+    private let channels: Int
+    private let frames: Int
+    private let periodTicks: UInt64
+    private let paced: Bool
+    /// 渲染指定量子数后自动停止（0 表示直到 stop）
+    private let maxCallbacks: Int64
+    private let running = AtomicInt64()
+    private var started = false
+    private let finished = DispatchSemaphore(value: 0)
+    
+    /// 回调延迟：周期边界到渲染完成（纳秒）
+    let callbackLatency: LatencyHistogram?
+    /// 已完成的回调数
+    let callbacks = AtomicInt64()
+    /// 因回调超时被跳过的周期数
+    let droppedBlocks = AtomicInt64()
+    
+    // MARK: - Initialization
+    
+    init(graph: AudioGraph, source: PushSourceNode, input: UnsafePointer<Float>, channels: Int, frames: Int, sampleRate: Double,
+         paced: Bool = true, maxCallbacks: Int = 0, callbackLatency: LatencyHistogram? = nil) {
+        self.graph = graph
+        self.source = source
+        self.input = input
+        self.channels = channels
+        self.frames = frames
+        self.periodTicks = BenchmarkRunner.hostTicks(fromNanoseconds: UInt64(Double(frames) / sampleRate * 1_000_000_000))
+        self.paced = paced
+        self.maxCallbacks = Int64(maxCallbacks)
+        self.callbackLatency = callbackLatency
+    }
+    
+    // MARK: - Control
+    
+    func start() {
+        guard !started else { return }
+        started = true
+        running.store(1)
+        let thread = Thread { [self] in
+            var next = mach_absolute_time() + (paced ? periodTicks : 0)
+            while running.value != 0 {
+                if paced {
+                    mach_wait_until(next)
+                }
+                source.load(interleaved: input, channels: channels, frames: frames)
+                graph.render(frameCount: frames, hostTime: next)
+                let now = mach_absolute_time()
+                if paced {
+                    callbackLatency?.record(Int64(BenchmarkRunner.nanoseconds(fromHostTicks: now > next ? now - next : 0)))
+                    next += periodTicks
+                    if now > next {
+                        let missed = (now - next) / periodTicks + 1
+                        droppedBlocks.add(Int64(missed))
+                        next += missed * periodTicks
+                    }
+                } else {
+                    next = now
+                }
+                if callbacks.increment() == maxCallbacks {
+                    break
+                }
+            }
+            running.store(0)
+            finished.signal()
+        }
+        thread.name = "SyntheticDevice"
+        thread.qualityOfService = .userInteractive
+        thread.start()
+    }
+    
+    /// 等待渲染到 maxCallbacks 后自动停止
+    func waitUntilFinished() {
+        guard started else { return }
+        finished.wait()
+        finished.signal()
+    }
+    
+    func stop() {
+        running.store(0)
+        waitUntilFinished()
+    }
+}
@@ -0,0 +1,139 @@
+import Foundation
+import CoreAudio
+@_spi(Benchmarks) import AudioRecordKit
+
+// MARK: - TraceOverheadBenchmark
+/// 引擎追踪开销基准测试 - 混合录制形状的处理图在追踪关闭与开启时的每量子渲染耗时
+///
+/// 图与录制器相同（推送源 + 环形缓冲源 → 自动增益 → 混音 → 限幅 → 电平 / 写入，写入开关关闭），
+/// 每次迭代向麦克风环形缓冲区写入一个量子并渲染。开启时每个节点、调度器与断流报告都记录事件，
+/// 报告两者的差值相对关闭时的百分比（目标 < 1%）与每线程事件缓冲区的大小。
+enum TraceOverheadBenchmark: BenchmarkSuite {
+    
+    static let name = "trace"
+    static let summary = "引擎追踪关闭 / 开启时录制器处理图的渲染耗时差"
+    
+    static let channels = 2
+    static let sampleRate = 48000.0
+    static let framesPerQuantum = 512
+    /// 开销目标（相对追踪关闭）
+    static let targetOverhead = 0.01
+    
+    static func run(_ runner: BenchmarkRunner) {
+        guard #available(macOS 14.4, *) else {
+            Logger.shared.warning("⚠️ 追踪开销基准测试需要 macOS 14.4 或更高版本")
+            return
+        }
+        guard AudioRecordDiagnostics.isTracingAvailable else {
+            Logger.shared.warning("⚠️ 以 AUDIORECORD_NO_TRACE 编译，追踪代码已移除，跳过追踪开销基准测试")
+            return
+        }
+        let wasEnabled = AudioRecordDiagnostics.isTracing
+        defer {
+            if wasEnabled {
+                AudioRecordDiagnostics.startTracing()
+            } else {
+                AudioRecordDiagnostics.stopTracing()
+            }
+        }
+        
+        let input = UnsafeMutablePointer<Float>.allocate(capacity: framesPerQuantum * channels)
+        let pointers = UnsafeMutablePointer<UnsafeMutablePointer<Float>>.allocate(capacity: channels)
+        defer {
+            input.deallocate()
+            pointers.deallocate()
+        }
+        for i in 0..<framesPerQuantum * channels {
+            input[i] = 0.25 * sin(Float(i) * 0.01)
+        }
+        for c in 0..<channels {
+            pointers[c] = input + c * framesPerQuantum
+        }
+        
+        // 追踪关闭与开启交替测两轮，取各自较快的一轮，减少频率调节与缓存状态带来的偏差
+        var best: [Bool: Double] = [:]
+        for _ in 0..<2 {
+            for traced in [false, true] {
+                let result: BenchmarkMeasurement
+                do {
+                    result = try measure(runner, traced: traced, input: input, pointers: pointers)
+                } catch {
+                    Logger.shared.error("❌ 追踪开销基准测试建图失败: \(error.localizedDescription)")
+                    return
+                }
+                best[traced] = min(best[traced] ?? .infinity, result.nanosecondsPerIteration)
+            }
+        }
+        
+        guard let off = best[false], let on = best[true], off > 0 else { return }
+        let overhead = (on - off) / off
+        let eventBytes = MemoryLayout<Int32>.stride + MemoryLayout<TracePhase>.stride + 3 * MemoryLayout<UInt64>.stride
+        let bufferBytes = EngineTrace.eventsPerThread * eventBytes
+        Logger.shared.info("🧵 追踪开销: 关闭 \(String(format: "%.0f", off))ns / 开启 \(String(format: "%.0f", on))ns 每量子，差 \(String(format: "%+.2f", overhead * 100))%（目标 < \(Int(targetOverhead * 100))%），每线程缓冲区 \(bufferBytes / 1024)KB")
+        if overhead > targetOverhead {
+            Logger.shared.warning("⚠️ 追踪开销超过目标 \(Int(targetOverhead * 100))%")
+        }
+    }
+    
+    // MARK: - Measurement
+    
+    @available(macOS 14.4, *)
+    private static func measure(_ runner: BenchmarkRunner, traced: Bool, input: UnsafePointer<Float>,
+                                pointers: UnsafeMutablePointer<UnsafeMutablePointer<Float>>) throws -> BenchmarkMeasurement {
+        if traced {
+            AudioRecordDiagnostics.startTracing()
+        } else {
+            AudioRecordDiagnostics.stopTracing()
+        }
+        let (graph, system, mic) = try makeGraph()
+        defer { graph.shutdown() }
+        
+        return runner.measure(suite: name, name: "render \(traced ? "trace=on" : "trace=off")", frames: framesPerQuantum, sampleRate: sampleRate) {
+            _ = mic.write(channels: pointers, channelCount: channels, frames: framesPerQuantum)
+            system.load(interleaved: input, channels: channels, frames: framesPerQuantum)
+            graph.render(frameCount: framesPerQuantum)
+        }
+    }
+    
+    /// 混合录制形状的处理图（写入开关关闭，不创建文件）
+    @available(macOS 14.4, *)
+    private static func makeGraph() throws -> (AudioGraph, PushSourceNode, RingBufferSourceNode) {
+        let maxFrames = framesPerQuantum
+        let format = AudioStreamBasicDescription(
+            mSampleRate: sampleRate,
+            mFormatID: kAudioFormatLinearPCM,
+            mFormatFlags: kAudioFormatFlagIsSignedInteger | kAudioFormatFlagIsPacked,
+            mBytesPerPacket: UInt32(channels * 2),
+            mFramesPerPacket: 1,
+            mBytesPerFrame: UInt32(channels * 2),
+            mChannelsPerFrame: UInt32(channels),
+            mBitsPerChannel: 16,
+            mReserved: 0
+        )
+        let fileManager = AudioToolboxFileManager(audioFormat: format)
+        let pipeline = CapturePipelineFactory.make(CapturePipelineConfiguration(mode: .mixed, fileFormat: format))
+        
+        let graph = AudioGraph(name: "Trace", sampleRate: sampleRate, maxFramesPerQuantum: maxFrames, workerCount: 0,
+                               xruns: fileManager.xruns)
+        let system = graph.add(PushSourceNode(name: "system", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate, pipeline: pipeline))
+        let mic = graph.add(RingBufferSourceNode(name: "mic", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate,
+                                                 capacityFrames: maxFrames * 8))
+        let agc = graph.add(AGCNode(name: "agc", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate))
+        let mixer = graph.add(MixerNode(name: "mixer", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate))
+        let limiter = graph.add(LimiterNode(name: "limiter", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate))
+        let meter = graph.add(MeterNode(name: "meter", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate,
+                                        scale: .linearRMS(sensitivity: 3.0)))
+        let writer = graph.add(FileWriterNode(name: "writer", fileManager: fileManager, pipeline: pipeline, maxFrames: maxFrames, sampleRate: sampleRate,
+                                              isWriting: false))
+        try graph.connect(system, to: mixer)
+        try graph.connect(mic, to: agc)
+        try graph.connect(agc, to: mixer)
+        try graph.connect(mixer, to: limiter)
+        try graph.connect(limiter, to: meter)
+        try graph.connect(limiter, to: writer)
+        try graph.compile()
+        mixer.setGain(0.6, forInput: 0)
+        mixer.setGain(0.4, forInput: 1)
+        return (graph, system, mic)
+    }
+}
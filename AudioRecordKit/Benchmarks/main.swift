@@ -0,0 +1,71 @@
+import Foundation
+@_spi(Benchmarks) import AudioRecordKit
+
+// AudioRecordKit 基准测试命令行
+// 用法: swift run -c release AudioRecordKitBenchmarks [--list] [--verify] [--suite 名称]... [--iterations 次数]
+//                                                   [--json 文件|-] [--label 标签]
+// 环境变量 AUDIORECORD_DSP_KERNELS 可强制 DSP 内核变体，例如 scalar 或 meter=simd4
+// 环境变量 AUDIORECORD_BENCH_DEVICES=1 时 startup 套件额外测量真实设备
+// 环境变量 AUDIORECORD_BENCH_TRACE=<采集文件> 时 replay 套件回放现场采集的回调序列
+
+var suiteNames: [String] = []
+var iterations = 200
+var jsonPath: String?
+var label: String?
+var arguments = CommandLine.arguments.dropFirst().makeIterator()
+
+while let argument = arguments.next() {
+    switch argument {
+    case "--list":
+        for suite in AudioRecordBenchmark.suites {
+            print("\(suite.name)\t\(suite.summary)")
+        }
+        exit(0)
+    case "--verify":
+        for (kernel, isa) in AudioRecordBenchmark.kernelSelection {
+            print("\(kernel)\t\(isa)")
+        }
+        let failures = AudioRecordBenchmark.verifyKernels()
+        for failure in failures {
+            print("FAIL \(failure)")
+        }
+        print(failures.isEmpty ? "DSP 内核校验通过" : "DSP 内核校验失败: \(failures.count) 项")
+        exit(failures.isEmpty ? 0 : 1)
+    case "--suite":
+        if let name = arguments.next() {
+            suiteNames.append(name)
+        }
+    case "--iterations":
+        if let value = arguments.next(), let count = Int(value) {
+            iterations = count
+        }
+    case "--json":
+        jsonPath = arguments.next()
+    case "--label":
+        label = arguments.next()
+    default:
+        print("未知参数: \(argument)")
+        exit(1)
+    }
+}
+
+let results = AudioRecordBenchmark.run(suiteNames: suiteNames.isEmpty ? nil : suiteNames, iterations: iterations)
+// 输出 JSON 到标准输出时不再打印文本报告
+if jsonPath != "-" {
+    print(AudioRecordBenchmark.report(results))
+}
+
+if let path = jsonPath {
+    let data = AudioRecordBenchmark.json(results, label: label)
+    if path == "-" {
+        FileHandle.standardOutput.write(data)
+    } else {
+        do {
+            try data.write(to: URL(fileURLWithPath: path))
+            print("JSON 结果已写入: \(path)")
+        } catch {
+            print("写入 JSON 失败: \(error.localizedDescription)")
+            exit(1)
+        }
+    }
+}
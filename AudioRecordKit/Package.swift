@@ -13,8 +13,13 @@ let package = Package(
         )
     ],
     targets: [
+        .target(
+            name: "AudioRecordKitAtomics",
+            path: "Atomics"
+        ),
         .target(
             name: "AudioRecordKit",
+            dependencies: ["AudioRecordKitAtomics"],
             path: "Sources",
             sources: ["Core", "API", "Utils", "CAPI"],
             publicHeadersPath: "CAPI",
@@ -25,6 +30,16 @@ let package = Package(
                 .linkedFramework("ScreenCaptureKit")
             ]
         ),
+        .executableTarget(
+            name: "AudioRecordKitBenchmarks",
+            dependencies: ["AudioRecordKit"],
+            path: "Benchmarks"
+        ),
+        .executableTarget(
+            name: "AudioRecordKitSoak",
+            dependencies: ["AudioRecordKit"],
+            path: "Soak"
+        ),
         .testTarget(
             name: "AudioRecordKitTests",
             dependencies: ["AudioRecordKit"],
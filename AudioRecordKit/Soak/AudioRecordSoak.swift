@@ -0,0 +1,141 @@
+import Foundation
+@_spi(Benchmarks) import AudioRecordKit
+
+// MARK: - 浸泡测试入口
+
+/// 浸泡测试配置
+struct AudioRecordSoakConfiguration: Sendable {
+    /// 模拟的音频时长（小时），以加速时间运行
+    var simulatedHours: Double = 24
+    /// 麦克风时钟相对系统音频时钟的偏差（ppm）
+    var skewPPM: Double = 100
+    /// 检查点间隔（模拟分钟）
+    var checkpointMinutes: Double = 60
+    /// 输出位深：16、24 或 32（浮点）
+    var bitDepth: Int = 16
+    /// 第一个检查点之后允许的内存增长（字节）
+    var maxMemoryGrowthBytes: UInt64 = 16 * 1024 * 1024
+    /// 录音文件目录
+    var directory: URL = FileManager.default.temporaryDirectory.appendingPathComponent("audiorecord-soak")
+    /// 结束后保留录音文件
+    var keepFiles = false
+    
+    init() {}
+}
+
+/// 检查点
+struct AudioRecordSoakCheckpoint: Sendable, Codable {
+    let simulatedSeconds: Double
+    let wallSeconds: Double
+    let framesWritten: Int64
+    /// 麦克风环形缓冲区的填充量（帧）
+    let ringFill: Int
+    let memoryFootprint: UInt64
+    let discontinuities: Int64
+    let xruns: Int64
+    let fileValid: Bool
+    let fileDetail: String
+}
+
+/// 单项检查结果
+struct AudioRecordSoakCheck: Sendable, Codable {
+    let name: String
+    let passed: Bool
+    let detail: String
+}
+
+/// 浸泡测试报告
+struct AudioRecordSoakReport: Sendable, Codable {
+    let simulatedHours: Double
+    let skewPPM: Double
+    let wallSeconds: Double
+    let checkpoints: [AudioRecordSoakCheckpoint]
+    let checks: [AudioRecordSoakCheck]
+    
+    var passed: Bool {
+        return !checks.isEmpty && checks.allSatisfy { $0.passed }
+    }
+}
+
+/// 浸泡测试入口
+///
+/// 随命令行目标编译，经 `@_spi(Benchmarks) import` 访问 SDK 的处理图，不进入发布的库。
+/// 命令行运行：`swift run -c release AudioRecordKitSoak [--hours 小时] [--skew-ppm 偏差]`
+enum AudioRecordSoak {
+    
+    /// 运行浸泡测试（阻塞直到完成）
+    /// - Parameters:
+    ///   - configuration: 测试配置
+    ///   - progress: 每个检查点的回调（在调用线程上）
+    @available(macOS 14.4, *)
+    static func run(_ configuration: AudioRecordSoakConfiguration = AudioRecordSoakConfiguration(),
+                           progress: ((AudioRecordSoakCheckpoint) -> Void)? = nil) throws -> AudioRecordSoakReport {
+        var internalConfiguration = SoakHarness.Configuration()
+        internalConfiguration.simulatedHours = configuration.simulatedHours
+        internalConfiguration.skewPPM = configuration.skewPPM
+        internalConfiguration.checkpointMinutes = configuration.checkpointMinutes
+        internalConfiguration.maxMemoryGrowthBytes = configuration.maxMemoryGrowthBytes
+        internalConfiguration.directory = configuration.directory
+        internalConfiguration.keepFiles = configuration.keepFiles
+        switch configuration.bitDepth {
+        case 16:
+            internalConfiguration.bitDepth = .int16
+        case 24:
+            internalConfiguration.bitDepth = .int24
+        case 32:
+            internalConfiguration.bitDepth = .float32
+        default:
+            throw NSError(domain: "AudioRecordSoak", code: -1,
+                          userInfo: [NSLocalizedDescriptionKey: "不支持的位深: \(configuration.bitDepth)"])
+        }
+        
+        let harness = SoakHarness(configuration: internalConfiguration)
+        let report = try harness.run { checkpoint in
+            progress?(publicCheckpoint(checkpoint))
+        }
+        return AudioRecordSoakReport(
+            simulatedHours: configuration.simulatedHours,
+            skewPPM: configuration.skewPPM,
+            wallSeconds: report.wallSeconds,
+            checkpoints: report.checkpoints.map(publicCheckpoint),
+            checks: report.checks.map { AudioRecordSoakCheck(name: $0.name, passed: $0.passed, detail: $0.detail) }
+        )
+    }
+    
+    /// 格式化为文本报告
+    static func report(_ report: AudioRecordSoakReport) -> String {
+        var lines: [String] = []
+        lines.append(String(format: "浸泡测试: 模拟 %.1f 小时, 时钟偏差 %.1fppm, 耗时 %.1fs",
+                            report.simulatedHours, report.skewPPM, report.wallSeconds))
+        lines.append("")
+        lines.append("== checkpoints ==")
+        for checkpoint in report.checkpoints {
+            lines.append(String(format: "%8.2fh  frames %12lld  ring %7d  mem %8.1fMB  gaps %lld  xruns %lld  file %@",
+                                checkpoint.simulatedSeconds / 3600, checkpoint.framesWritten, checkpoint.ringFill,
+                                Double(checkpoint.memoryFootprint) / 1_048_576, checkpoint.discontinuities, checkpoint.xruns,
+                                checkpoint.fileValid ? "ok" : "FAIL"))
+        }
+        lines.append("")
+        lines.append("== checks ==")
+        for check in report.checks {
+            lines.append("\(check.passed ? "PASS" : "FAIL")  \(check.name.padding(toLength: 20, withPad: " ", startingAt: 0))  \(check.detail)")
+        }
+        lines.append("")
+        lines.append(report.passed ? "结果: 通过" : "结果: 失败")
+        return lines.joined(separator: "\n")
+    }
+    
+    private static func publicCheckpoint(_ checkpoint: SoakHarness.Checkpoint) -> AudioRecordSoakCheckpoint {
+        return AudioRecordSoakCheckpoint(
+            simulatedSeconds: checkpoint.simulatedSeconds,
+            wallSeconds: checkpoint.wallSeconds,
+            framesWritten: checkpoint.framesWritten,
+            ringFill: checkpoint.ringFill,
+            memoryFootprint: checkpoint.memoryFootprint,
+            discontinuities: checkpoint.discontinuities,
+            xruns: checkpoint.xruns,
+            fileValid: checkpoint.fileValid,
+            fileDetail: checkpoint.fileDetail
+        )
+    }
+}
@@ -0,0 +1,409 @@
+import Foundation
+import Darwin
+import CoreAudio
+import AVFoundation
+@_spi(Benchmarks) import AudioRecordKit
+
+// MARK: - SequenceTone
+/// 序号音 - 把样本序号编码为锯齿波，写入、混音、量化之后仍能逐样本解码
+///
+/// 幅度保持在 ±0.25（限幅器不介入），相邻序号相差约 4 个 16 位 LSB。
+/// 解码后相邻样本的序号必须连续（模周期），否则说明丢帧、重复或插入了静音。
+enum SequenceTone {
+    
+    static let period = 4096
+    static let amplitude: Float = 0.25
+    
+    @inline(__always)
+    static func value(_ index: Int64) -> Float {
+        let phase = Float(Int(index % Int64(period))) / Float(period)
+        return phase * 2 * amplitude - amplitude
+    }
+    
+    @inline(__always)
+    static func decode(_ sample: Float) -> Int {
+        let position = Int((((sample + amplitude) / (2 * amplitude)) * Float(period)).rounded())
+        return (position % period + period) % period
+    }
+}
+
+// MARK: - SequenceChecker
+/// 逐样本检查序号连续性（渲染线程调用）
+final class SequenceChecker {
+    
+    private var expected: Int?
+    private(set) var discontinuities: Int64 = 0
+    /// 第一次不连续时的帧位置（-1 表示没有）
+    private(set) var firstDiscontinuityFrame: Int64 = -1
+    
+    func check(_ samples: UnsafePointer<Float>, frames: Int, startFrame: Int64) {
+        for i in 0..<frames {
+            let value = SequenceTone.decode(samples[i])
+            if let expected = expected, value != expected {
+                discontinuities += 1
+                if firstDiscontinuityFrame < 0 {
+                    firstDiscontinuityFrame = startFrame + Int64(i)
+                }
+            }
+            expected = (value + 1) % SequenceTone.period
+        }
+    }
+}
+
+// MARK: - SoakHarness
+/// 长时间浸泡测试 - 以加速时间运行混音处理图，模拟 24 小时以上的录制
+///
+/// 两个合成源的时钟有偏差：系统音频源按图的量子推送，麦克风源按 (1 + skew) 倍速率
+/// 写入环形缓冲源，与 MixedAudioRecorder 的结构一致。左声道承载系统音频的序号音，
+/// 右声道承载麦克风的序号音，经混音 → 限幅后由旁路节点逐样本检查连续性，并写入 WAV。
+///
+/// 每个检查点记录内存占用、环形缓冲填充量、断流计数，并从磁盘读取刚写入的尾部数据
+/// 校验文件大小与内容；结束时关闭文件并用 AVAudioFile 重新打开，核对总帧数。
+final class SoakHarness {
+    
+    // MARK: - Configuration
+    struct Configuration {
+        /// 模拟的音频时长（小时）
+        var simulatedHours: Double = 24
+        /// 麦克风时钟相对系统音频时钟的偏差（ppm，正值表示麦克风更快）
+        var skewPPM: Double = 100
+        /// 检查点间隔（模拟分钟）
+        var checkpointMinutes: Double = 60
+        var bitDepth: PipelineBitDepth = .int16
+        var sampleRate: Double = 48000
+        /// 允许的内存增长（第一个检查点之后）
+        var maxMemoryGrowthBytes: UInt64 = 16 * 1024 * 1024
+        var directory: URL = FileManager.default.temporaryDirectory.appendingPathComponent("audiorecord-soak")
+        /// 结束后保留录音文件
+        var keepFiles = false
+    }
+    
+    // MARK: - Results
+    struct Checkpoint {
+        let simulatedSeconds: Double
+        let wallSeconds: Double
+        let framesWritten: Int64
+        let ringFill: Int
+        let memoryFootprint: UInt64
+        let discontinuities: Int64
+        let xruns: Int64
+        let fileValid: Bool
+        let fileDetail: String
+    }
+    
+    struct Check {
+        let name: String
+        let passed: Bool
+        let detail: String
+    }
+    
+    struct Report {
+        let configuration: Configuration
+        let checkpoints: [Checkpoint]
+        let checks: [Check]
+        let wallSeconds: Double
+        
+        var passed: Bool {
+            return !checks.isEmpty && checks.allSatisfy { $0.passed }
+        }
+    }
+    
+    static let framesPerQuantum = 512
+    static let channels = 2
+    /// 麦克风环形缓冲区：容量 2 秒（与 MixedAudioRecorder 一致），启动时预填 4 个量子
+    static let ringSeconds = 2
+    static let prefillQuanta = 4
+    
+    private let configuration: Configuration
+    private let logger = Logger.shared
+    
+    init(configuration: Configuration) {
+        self.configuration = configuration
+    }
+    
+    // MARK: - Run
+    
+    @available(macOS 14.4, *)
+    func run(progress: ((Checkpoint) -> Void)? = nil) throws -> Report {
+        let frames = SoakHarness.framesPerQuantum
+        let channels = SoakHarness.channels
+        let sampleRate = configuration.sampleRate
+        let format = fileFormat()
+        let bytesPerFrame = Int(format.mBytesPerFrame)
+        
+        try FileManager.default.createDirectory(at: configuration.directory, withIntermediateDirectories: true)
+        let url = configuration.directory.appendingPathComponent("soak_\(Int(Date().timeIntervalSince1970)).wav")
+        
+        // 处理图：系统(推送源) + 麦克风(环形缓冲源) → 混音 → 限幅 → 连续性检查 / 文件写入
+        let fileManager = AudioToolboxFileManager(audioFormat: format)
+        let pipeline = CapturePipelineFactory.make(CapturePipelineConfiguration(mode: .mixed, fileFormat: format))
+        let graph = AudioGraph(name: "Soak", sampleRate: sampleRate, maxFramesPerQuantum: frames, workerCount: 0, xruns: fileManager.xruns)
+        let system = graph.add(PushSourceNode(name: "system", channels: channels, maxFrames: frames, sampleRate: sampleRate, pipeline: pipeline))
+        let mic = graph.add(RingBufferSourceNode(name: "mic", channels: channels, maxFrames: frames, sampleRate: sampleRate,
+                                                 capacityFrames: Int(sampleRate) * SoakHarness.ringSeconds))
+        let mixer = graph.add(MixerNode(name: "mixer", channels: channels, maxFrames: frames, sampleRate: sampleRate))
+        let limiter = graph.add(LimiterNode(name: "limiter", channels: channels, maxFrames: frames, sampleRate: sampleRate))
+        let systemChecker = SequenceChecker()
+        let micChecker = SequenceChecker()
+        let verify = graph.add(TapNode(name: "verify", sampleRate: sampleRate) { block, context in
+            let n = min(block.frameCount, context.frameCount)
+            systemChecker.check(block.channel(0), frames: n, startFrame: context.sampleTime)
+            micChecker.check(block.channel(1), frames: n, startFrame: context.sampleTime)
+        })
+        let writer = graph.add(FileWriterNode(name: "writer", fileManager: fileManager, pipeline: pipeline, maxFrames: frames, sampleRate: sampleRate))
+        try graph.connect(system, to: mixer)
+        try graph.connect(mic, to: mixer)
+        try graph.connect(mixer, to: limiter)
+        try graph.connect(limiter, to: verify)
+        try graph.connect(limiter, to: writer)
+        try graph.compile()
+        try fileManager.createAudioFile(at: url)
+        defer {
+            graph.shutdown()
+            fileManager.closeFile()
+            if !configuration.keepFiles {
+                try? FileManager.default.removeItem(at: url)
+                try? FileManager.default.removeItem(at: url.appendingPathExtension("xruns.log"))
+            }
+        }
+        
+        // 源数据：系统音频只有左声道，麦克风只有右声道
+        let systemBuffer = UnsafeMutablePointer<Float>.allocate(capacity: frames * channels)
+        systemBuffer.initialize(repeating: 0, count: frames * channels)
+        let micCapacity = frames * 2
+        let micSilence = UnsafeMutablePointer<Float>.allocate(capacity: micCapacity)
+        micSilence.initialize(repeating: 0, count: micCapacity)
+        let micTone = UnsafeMutablePointer<Float>.allocate(capacity: micCapacity)
+        micTone.initialize(repeating: 0, count: micCapacity)
+        var micChannels = [micSilence, micTone]
+        defer {
+            systemBuffer.deallocate()
+            micSilence.deallocate()
+            micTone.deallocate()
+        }
+        
+        var micIndex: Int64 = 0
+        func produceMic(_ count: Int) {
+            for i in 0..<count {
+                micTone[i] = SequenceTone.value(micIndex + Int64(i))
+            }
+            micIndex += Int64(count)
+            micChannels.withUnsafeBufferPointer { pointers in
+                _ = mic.write(channels: pointers.baseAddress!, channelCount: channels, frames: count)
+            }
+        }
+        for _ in 0..<SoakHarness.prefillQuanta {
+            produceMic(frames)
+        }
+        
+        let totalQuanta = Int64(configuration.simulatedHours * 3600 * sampleRate) / Int64(frames)
+        let checkpointQuanta = max(Int64(configuration.checkpointMinutes * 60 * sampleRate) / Int64(frames), 1)
+        let micFramesPerQuantum = Double(frames) * (1 + configuration.skewPPM / 1_000_000)
+        var micAccumulator = 0.0
+        var systemIndex: Int64 = 0
+        var checkpoints: [Checkpoint] = []
+        let wallBegin = mach_absolute_time()
+        
+        logger.info("🧪 浸泡测试开始: 模拟 \(configuration.simulatedHours) 小时, 时钟偏差 \(configuration.skewPPM)ppm, 文件 \(url.lastPathComponent)")
+        
+        for quantum in 1...max(totalQuanta, 1) {
+            for i in 0..<frames {
+                systemBuffer[i * channels] = SequenceTone.value(systemIndex + Int64(i))
+            }
+            systemIndex += Int64(frames)
+            system.load(interleaved: systemBuffer, channels: channels, frames: frames)
+            
+            micAccumulator += micFramesPerQuantum
+            let micFrames = min(Int(micAccumulator), micCapacity)
+            micAccumulator -= Double(micFrames)
+            produceMic(micFrames)
+            
+            graph.render(frameCount: frames)
+            
+            if quantum % checkpointQuanta == 0 || quantum == totalQuanta {
+                let framesWritten = Int64(fileManager.getFileInfo().totalFrames)
+                let file = verifyTail(url: url, framesWritten: framesWritten, bytesPerFrame: bytesPerFrame)
+                let checkpoint = Checkpoint(
+                    simulatedSeconds: Double(systemIndex) / sampleRate,
+                    wallSeconds: Double(BenchmarkRunner.nanoseconds(fromHostTicks: mach_absolute_time() - wallBegin)) / 1e9,
+                    framesWritten: framesWritten,
+                    ringFill: mic.bufferedFrames,
+                    memoryFootprint: BenchmarkRunner.memoryFootprint(),
+                    discontinuities: systemChecker.discontinuities + micChecker.discontinuities,
+                    xruns: XrunKind.allCases.reduce(Int64(0)) { $0 + fileManager.xruns.count(of: $1) },
+                    fileValid: file.valid,
+                    fileDetail: file.detail
+                )
+                checkpoints.append(checkpoint)
+                progress?(checkpoint)
+            }
+        }
+        
+        // 关闭后重新打开，核对总帧数（超过 4 GiB 的 WAV 头无法表示真实长度）
+        let framesWritten = Int64(fileManager.getFileInfo().totalFrames)
+        let xrunSummary = XrunKind.allCases.map { "\($0.name)=\(fileManager.xruns.count(of: $0))" }.joined(separator: " ")
+        let ringXruns = fileManager.xruns.count(of: .ringOverrun) + fileManager.xruns.count(of: .ringUnderrun)
+        let totalXruns = XrunKind.allCases.reduce(Int64(0)) { $0 + fileManager.xruns.count(of: $1) }
+        fileManager.closeFile()
+        let reopened = verifyClosedFile(url: url, expectedFrames: framesWritten, bytesPerFrame: bytesPerFrame)
+        let wallSeconds = Double(BenchmarkRunner.nanoseconds(fromHostTicks: mach_absolute_time() - wallBegin)) / 1e9
+        
+        var checks: [Check] = []
+        checks.append(Check(
+            name: "sample continuity",
+            passed: systemChecker.discontinuities == 0 && micChecker.discontinuities == 0,
+            detail: "系统 \(systemChecker.discontinuities) 处不连续（首次 \(describe(frame: systemChecker.firstDiscontinuityFrame))），"
+                + "麦克风 \(micChecker.discontinuities) 处（首次 \(describe(frame: micChecker.firstDiscontinuityFrame))）"
+        ))
+        checks.append(driftCheck(checkpoints, ringXruns: ringXruns))
+        checks.append(memoryCheck(checkpoints))
+        let badCheckpoint = checkpoints.first { !$0.fileValid }
+        checks.append(Check(
+            name: "file checkpoints",
+            passed: badCheckpoint == nil,
+            detail: badCheckpoint.map { "模拟 \(String(format: "%.2f", $0.simulatedSeconds / 3600))h: \($0.fileDetail)" }
+                ?? "\(checkpoints.count) 个检查点均通过"
+        ))
+        checks.append(Check(name: "final file", passed: reopened.valid, detail: reopened.detail))
+        checks.append(Check(name: "xruns", passed: totalXruns == 0, detail: xrunSummary))
+        
+        let report = Report(configuration: configuration, checkpoints: checkpoints, checks: checks, wallSeconds: wallSeconds)
+        logger.info("🧪 浸泡测试结束: \(report.passed ? "通过" : "失败"), 耗时 \(String(format: "%.1f", wallSeconds))s")
+        return report
+    }
+    
+    // MARK: - Checks
+    
+    /// 环形缓冲区填充量的变化即两个时钟的实际偏差
+    private func driftCheck(_ checkpoints: [Checkpoint], ringXruns: Int64) -> Check {
+        guard let first = checkpoints.first, let last = checkpoints.last, last.framesWritten > first.framesWritten else {
+            return Check(name: "inter-source drift", passed: ringXruns == 0, detail: "检查点不足")
+        }
+        let measured = Double(last.ringFill - first.ringFill) / Double(last.framesWritten - first.framesWritten) * 1_000_000
+        let fills = checkpoints.map { $0.ringFill }
+        let detail = String(format: "实测 %.1fppm（配置 %.1fppm），缓冲填充 %d…%d 帧，环形缓冲溢出/欠载 %lld 次",
+                            measured, configuration.skewPPM, fills.min() ?? 0, fills.max() ?? 0, ringXruns)
+        return Check(name: "inter-source drift", passed: ringXruns == 0, detail: detail)
+    }
+    
+    private func memoryCheck(_ checkpoints: [Checkpoint]) -> Check {
+        guard let first = checkpoints.first, let last = checkpoints.last else {
+            return Check(name: "memory growth", passed: true, detail: "检查点不足")
+        }
+        let peak = checkpoints.map { $0.memoryFootprint }.max() ?? last.memoryFootprint
+        let growth = peak > first.memoryFootprint ? peak - first.memoryFootprint : 0
+        let detail = String(format: "首个检查点 %.1fMB，峰值 %.1fMB，增长 %.1fMB（上限 %.1fMB）",
+                            Double(first.memoryFootprint) / 1_048_576, Double(peak) / 1_048_576,
+                            Double(growth) / 1_048_576, Double(configuration.maxMemoryGrowthBytes) / 1_048_576)
+        return Check(name: "memory growth", passed: growth <= configuration.maxMemoryGrowthBytes, detail: detail)
+    }
+    
+    /// 校验写入中的文件：RIFF 头、data 块位置、文件大小，并解码尾部左声道的序号
+    ///
+    /// 系统音频不经过环形缓冲，文件第 f 帧的左声道序号必然是 f（模周期）。
+    private func verifyTail(url: URL, framesWritten: Int64, bytesPerFrame: Int) -> (valid: Bool, detail: String) {
+        guard let handle = try? FileHandle(forReadingFrom: url) else {
+            return (false, "无法打开文件")
+        }
+        defer { try? handle.close() }
+        guard let header = try? handle.read(upToCount: 4096), let dataOffset = SoakHarness.dataChunkOffset(header) else {
+            return (false, "RIFF/WAVE 头或 data 块无效")
+        }
+        let expectedSize = UInt64(dataOffset) + UInt64(framesWritten) * UInt64(bytesPerFrame)
+        let actualSize = (try? handle.seekToEnd()) ?? 0
+        guard actualSize >= expectedSize else {
+            return (false, "文件大小 \(actualSize) 小于应写入的 \(expectedSize) 字节")
+        }
+        let tailFrames = Int(min(framesWritten, Int64(SoakHarness.framesPerQuantum)))
+        guard tailFrames > 0 else { return (true, "尚无数据") }
+        let tailStart = framesWritten - Int64(tailFrames)
+        do {
+            try handle.seek(toOffset: UInt64(dataOffset) + UInt64(tailStart) * UInt64(bytesPerFrame))
+            guard let tail = try handle.read(upToCount: tailFrames * bytesPerFrame), tail.count == tailFrames * bytesPerFrame else {
+                return (false, "尾部数据不完整")
+            }
+            for i in 0..<tailFrames {
+                let sample = leftSample(tail, frame: i, bytesPerFrame: bytesPerFrame)
+                let expected = Int((tailStart + Int64(i)) % Int64(SequenceTone.period))
+                if SequenceTone.decode(sample) != expected {
+                    return (false, "第 \(tailStart + Int64(i)) 帧内容与序号不符")
+                }
+            }
+        } catch {
+            return (false, "读取尾部失败: \(error.localizedDescription)")
+        }
+        let limit = UInt64(UInt32.max)
+        if expectedSize > limit {
+            return (true, "数据已超过 4 GiB（\(expectedSize) 字节），需在关闭后核对文件头")
+        }
+        return (true, "大小与尾部内容一致")
+    }
+    
+    /// 关闭后用 AVAudioFile 打开，核对帧数
+    private func verifyClosedFile(url: URL, expectedFrames: Int64, bytesPerFrame: Int) -> (valid: Bool, detail: String) {
+        do {
+            let file = try AVAudioFile(forReading: url)
+            guard file.length == expectedFrames else {
+                return (false, "文件头记录 \(file.length) 帧，实际写入 \(expectedFrames) 帧（数据 \(expectedFrames * Int64(bytesPerFrame)) 字节）")
+            }
+            return (true, "\(expectedFrames) 帧，\(String(format: "%.2f", Double(expectedFrames) / configuration.sampleRate / 3600))h")
+        } catch {
+            return (false, "无法打开: \(error.localizedDescription)")
+        }
+    }
+    
+    private func leftSample(_ data: Data, frame: Int, bytesPerFrame: Int) -> Float {
+        let offset = frame * bytesPerFrame
+        return data.withUnsafeBytes { raw -> Float in
+            switch configuration.bitDepth {
+            case .float32:
+                return raw.loadUnaligned(fromByteOffset: offset, as: Float.self)
+            case .int16:
+                return Float(Int16(littleEndian: raw.loadUnaligned(fromByteOffset: offset, as: Int16.self))) / 32767
+            case .int24:
+                let value = Int32(raw[offset]) | Int32(raw[offset + 1]) << 8 | Int32(Int8(bitPattern: raw[offset + 2])) << 16
+                return Float(value) / 8_388_607
+            }
+        }
+    }
+    
+    /// 在 RIFF/WAVE 头中查找 data 块的数据起始偏移
+    static func dataChunkOffset(_ header: Data) -> Int? {
+        let bytes = [UInt8](header)
+        guard bytes.count >= 12,
+              bytes[0..<4].elementsEqual("RIFF".utf8) || bytes[0..<4].elementsEqual("RF64".utf8),
+              bytes[8..<12].elementsEqual("WAVE".utf8) else { return nil }
+        var offset = 12
+        while offset + 8 <= bytes.count {
+            let size = Int(bytes[offset + 4]) | Int(bytes[offset + 5]) << 8 | Int(bytes[offset + 6]) << 16 | Int(bytes[offset + 7]) << 24
+            if bytes[offset..<(offset + 4)].elementsEqual("data".utf8) {
+                return offset + 8
+            }
+            offset += 8 + size + (size & 1)
+        }
+        return nil
+    }
+    
+    private func describe(frame: Int64) -> String {
+        guard frame >= 0 else { return "无" }
+        return String(format: "%.2fh", Double(frame) / configuration.sampleRate / 3600)
+    }
+    
+    private func fileFormat() -> AudioStreamBasicDescription {
+        let depth = configuration.bitDepth
+        let bytesPerFrame = UInt32(depth.bytesPerSample * SoakHarness.channels)
+        return AudioStreamBasicDescription(
+            mSampleRate: configuration.sampleRate,
+            mFormatID: kAudioFormatLinearPCM,
+            mFormatFlags: depth == .float32
+                ? kAudioFormatFlagIsFloat | kAudioFormatFlagIsPacked
+                : kAudioFormatFlagIsSignedInteger | kAudioFormatFlagIsPacked,
+            mBytesPerPacket: bytesPerFrame,
+            mFramesPerPacket: 1,
+            mBytesPerFrame: bytesPerFrame,
+            mChannelsPerFrame: UInt32(SoakHarness.channels),
+            mBitsPerChannel: depth.bitsPerChannel,
+            mReserved: 0
+        )
+    }
+}
@@ -0,0 +1,68 @@
+import Foundation
+@_spi(Benchmarks) import AudioRecordKit
+
+// AudioRecordKit 浸泡测试命令行
+// 用法: swift run -c release AudioRecordKitSoak [--hours 小时] [--skew-ppm 偏差] [--checkpoint-minutes 分钟]
+//                                            [--bit-depth 16|24|32] [--directory 目录] [--keep] [--json 文件]
+// 全部检查通过时退出码为 0，否则为 1
+
+var configuration = AudioRecordSoakConfiguration()
+var jsonPath: String?
+var arguments = CommandLine.arguments.dropFirst().makeIterator()
+
+while let argument = arguments.next() {
+    switch argument {
+    case "--hours":
+        if let value = arguments.next(), let hours = Double(value) {
+            configuration.simulatedHours = hours
+        }
+    case "--skew-ppm":
+        if let value = arguments.next(), let ppm = Double(value) {
+            configuration.skewPPM = ppm
+        }
+    case "--checkpoint-minutes":
+        if let value = arguments.next(), let minutes = Double(value) {
+            configuration.checkpointMinutes = minutes
+        }
+    case "--bit-depth":
+        if let value = arguments.next(), let depth = Int(value) {
+            configuration.bitDepth = depth
+        }
+    case "--directory":
+        if let path = arguments.next() {
+            configuration.directory = URL(fileURLWithPath: path)
+        }
+    case "--keep":
+        configuration.keepFiles = true
+    case "--json":
+        jsonPath = arguments.next()
+    default:
+        print("未知参数: \(argument)")
+        exit(1)
+    }
+}
+
+if #available(macOS 14.4, *) {
+    do {
+        let report = try AudioRecordSoak.run(configuration) { checkpoint in
+            print(String(format: "[%.2fh] %lld 帧, 缓冲 %d 帧, 内存 %.1fMB, 不连续 %lld, 断流 %lld, 文件 %@",
+                         checkpoint.simulatedSeconds / 3600, checkpoint.framesWritten, checkpoint.ringFill,
+                         Double(checkpoint.memoryFootprint) / 1_048_576, checkpoint.discontinuities, checkpoint.xruns,
+                         checkpoint.fileValid ? "ok" : checkpoint.fileDetail))
+        }
+        print(AudioRecordSoak.report(report))
+        if let path = jsonPath {
+            let encoder = JSONEncoder()
+            encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+            try encoder.encode(report).write(to: URL(fileURLWithPath: path))
+            print("JSON 报告已写入: \(path)")
+        }
+        exit(report.passed ? 0 : 1)
+    } catch {
+        print("浸泡测试失败: \(error.localizedDescription)")
+        exit(1)
+    }
+} else {
+    print("浸泡测试需要 macOS 14.4 或更高版本")
+    exit(1)
+}
@@ -19,6 +19,21 @@ public class AudioRecordAPI {
         return currentRecorder?.isRunning ?? false
     }
     
+    /// 已预热、等待开始录制
+    public var isArmed: Bool {
+        return currentRecorder?.isArmed ?? false
+    }
+    
+    /// 最近一次启动的各阶段耗时
+    public var startupTimings: AudioRecordStartupTimings {
+        return currentRecorder?.startupTimings ?? AudioRecordStartupTimings()
+    }
+    
+    /// 当前会话处理图占用的引擎内存（字节，未建图时为 0）
+    public var sessionMemoryBytes: Int64 {
+        return currentRecorder?.memoryAccount?.totalBytes ?? 0
+    }
+    
     // MARK: - 权限通过 PermissionManager 统一管理
     
     // MARK: - 回调
@@ -45,22 +60,72 @@ public class AudioRecordAPI {
         return stream
     }
     
+    /// 预热录制：建图、打开设备、分配缓冲并创建输出文件，但不写入
+    ///
+    /// 之后对同一个流调用 `startRecording(stream:)` 只需打开写入开关（不超过一个缓冲周期）。
+    /// - Parameter stream: 媒体流
+    public func prepareRecording(stream: MediaStream) async throws {
+        guard !isRecording else {
+            throw AudioRecordError.alreadyRecording
+        }
+        if let current = currentRecorder, current !== stream.recorder {
+            current.stopRecording()
+        }
+        
+        currentRecorder = stream.recorder
+        setupRecorderCallbacks()
+        try await stream.recorder.prepareRecording()
+    }
+    
     /// 开始录制
     /// - Parameter stream: 媒体流
     public func startRecording(stream: MediaStream) throws {
         guard !isRecording else {
             throw AudioRecordError.alreadyRecording
         }
+        // 另一个流已预热时先释放它的设备
+        if let current = currentRecorder, current !== stream.recorder {
+            current.stopRecording()
+        }
         
         currentRecorder = stream.recorder
         setupRecorderCallbacks()
         currentRecorder?.startRecording()
     }
     
+    /// 取消预热：释放该流预热的会话（已开始录制或已切换到其他流时不做处理）
+    /// - Parameter stream: 预热时使用的媒体流
+    public func cancelPreparedRecording(stream: MediaStream) {
+        guard let current = currentRecorder, current === stream.recorder, !current.isRunning else {
+            return
+        }
+        stopRecording()
+    }
+    
     /// 停止录制
     public func stopRecording() {
         currentRecorder?.stopRecording()
         currentRecorder = nil
+        // 录制线程上的日志在后台批量落盘，停止时立即写出
+        Logger.shared.flush()
+    }
+    
+    // MARK: - 进程电平监控
+    
+    /// 开始监控各进程的实时电平（用于进程选择界面，不录制、不写文件）
+    /// - Parameter pids: 要监控的进程，nil 表示全部可录制进程（进程列表变化时自动更新）
+    public func startProcessLevelMonitoring(pids: [pid_t]? = nil) throws {
+        try ProcessLevelMonitor.shared.start(pids: pids)
+    }
+    
+    /// 停止进程电平监控
+    public func stopProcessLevelMonitoring() {
+        ProcessLevelMonitor.shared.stop()
+    }
+    
+    /// 各进程最近的电平（可按界面刷新频率轮询）
+    public func processLevels() -> [AudioProcessLevel] {
+        return ProcessLevelMonitor.shared.snapshot()
     }
     
     // MARK: - 私有方法
@@ -0,0 +1,433 @@
+import Foundation
+
+// MARK: - 诊断公开接口
+
+/// 运行时诊断入口
+///
+/// 实时安全检查只在 Debug 构建中启用：IO 回调与图调度工作线程上的内存分配、
+/// 阻塞等待、文件 IO 与日志调用会被记录。宿主测试可在录制结束后断言违规数为 0。
+public enum AudioRecordDiagnostics {
+    
+    /// 实时安全检查是否启用（Debug 构建）
+    public static var isRealtimeSafetyCheckingEnabled: Bool {
+        return RealtimeSafety.isEnabled
+    }
+    
+    /// 实时线程违规总数
+    public static var realtimeViolationCount: Int {
+        return RealtimeSafety.violationCount
+    }
+    
+    /// 违规报告（每条包含类别、位置与符号化的调用栈），无违规时为空
+    public static func realtimeViolationReport() -> String {
+        return RealtimeSafety.violations().map { $0.description }.joined(separator: "\n")
+    }
+    
+    /// 清空违规记录（应在没有录制进行时调用）
+    public static func resetRealtimeViolations() {
+        RealtimeSafety.reset()
+    }
+}
+
+// MARK: - 管线统计
+
+/// 单个阶段的耗时分布（纳秒）
+public struct AudioRecordLatencySummary: Sendable {
+    public let count: Int64
+    public let meanNanoseconds: Double
+    public let p50Nanoseconds: Int64
+    public let p99Nanoseconds: Int64
+    public let p999Nanoseconds: Int64
+    public let maxNanoseconds: Int64
+    
+    init(_ summary: HistogramSummary) {
+        count = summary.count
+        meanNanoseconds = summary.mean
+        p50Nanoseconds = summary.p50
+        p99Nanoseconds = summary.p99
+        p999Nanoseconds = summary.p999
+        maxNanoseconds = summary.max
+    }
+}
+
+/// 单个阶段的统计
+public struct AudioRecordStageStatistics: Sendable {
+    /// 阶段名称（capture / ingest / process / analysis / encode / write / end-to-end / callback）
+    public let stage: String
+    /// 每块墙钟耗时
+    public let latency: AudioRecordLatencySummary
+    /// 每块线程 CPU 时间
+    public let cpu: AudioRecordLatencySummary
+}
+
+/// 采集管线统计（自上次重置以来）
+public struct AudioRecordStatistics: Sendable {
+    public let blocks: Int64
+    public let frames: Int64
+    public let elapsedNanoseconds: Int64
+    public let stages: [AudioRecordStageStatistics]
+}
+
+extension AudioRecordDiagnostics {
+    
+    /// 读取各阶段的延迟与 CPU 时间分布（进程全局，所有录制会话计入同一份统计）
+    public static func statistics() -> AudioRecordStatistics {
+        let snapshot = PipelineStats.shared.snapshot()
+        return AudioRecordStatistics(
+            blocks: snapshot.blocks,
+            frames: snapshot.frames,
+            elapsedNanoseconds: snapshot.elapsedNanoseconds,
+            stages: snapshot.stages.map {
+                AudioRecordStageStatistics(stage: $0.stage.name, latency: AudioRecordLatencySummary($0.latency), cpu: AudioRecordLatencySummary($0.cpu))
+            }
+        )
+    }
+    
+    /// 重新开始统计（录制中调用不会暂停采集）
+    public static func resetStatistics() {
+        PipelineStats.shared.reset()
+    }
+}
+
+// MARK: - 断流 / 溢出
+
+/// 断流 / 溢出事件类别
+public enum AudioRecordXrunKind: Int, Sendable, CaseIterable {
+    /// 采集时间线不连续（frames 为缺失帧数，负数为重叠）
+    case discontinuity = 0
+    /// 环形缓冲区已满，新数据被丢弃
+    case ringOverrun = 1
+    /// 环形缓冲区数据不足，以静音补齐
+    case ringUnderrun = 2
+    /// 写入失败
+    case writeFailure = 3
+    /// IO 回调超过块时长
+    case callbackOverrun = 4
+    
+    var internalKind: XrunKind {
+        return XrunKind(rawValue: rawValue)!
+    }
+}
+
+/// 断流 / 溢出事件
+public struct AudioRecordXrunEvent: Sendable {
+    public let kind: AudioRecordXrunKind
+    /// 发生位置（io / ring / writer）
+    public let origin: String
+    /// 事件大小（帧）
+    public let frames: Int64
+    /// 发生时刻（mach_absolute_time 换算的纳秒）
+    public let hostTimeNanoseconds: UInt64
+}
+
+extension AudioRecordDiagnostics {
+    
+    /// 进程内所有录制累计的某类事件次数（单个录制的计数见 C 接口 `AudioRecord_GetXrunCount`）
+    public static func xrunCount(_ kind: AudioRecordXrunKind) -> Int64 {
+        return XrunMonitor.shared.count(of: kind.internalKind)
+    }
+    
+    /// 进程内所有录制累计的某类事件帧数
+    public static func xrunFrames(_ kind: AudioRecordXrunKind) -> Int64 {
+        return XrunMonitor.shared.frames(of: kind.internalKind)
+    }
+    
+    /// 添加事件观察者（在主线程批量回调）
+    /// - Returns: 用于 `removeXrunObserver(_:)` 的标识
+    @discardableResult
+    public static func addXrunObserver(_ handler: @escaping (AudioRecordXrunEvent) -> Void) -> Int {
+        return XrunMonitor.shared.addObserver { event in
+            handler(AudioRecordXrunEvent(
+                kind: AudioRecordXrunKind(rawValue: event.kind.rawValue)!,
+                origin: event.origin,
+                frames: event.frames,
+                hostTimeNanoseconds: event.hostTimeNanoseconds
+            ))
+        }
+    }
+    
+    public static func removeXrunObserver(_ id: Int) {
+        XrunMonitor.shared.removeObserver(id)
+    }
+}
+
+// MARK: - 引擎追踪
+
+extension AudioRecordDiagnostics {
+    
+    /// 是否编译了追踪支持（以 `-DAUDIORECORD_NO_TRACE` 编译时为 false）
+    public static var isTracingAvailable: Bool {
+        return EngineTrace.isCompiledIn
+    }
+    
+    /// 追踪是否正在记录
+    public static var isTracing: Bool {
+        return EngineTrace.isEnabled
+    }
+    
+    /// 清空已有事件并开始记录回调、节点处理、写入与等待的时间线
+    public static func startTracing() {
+        EngineTrace.start()
+    }
+    
+    /// 停止记录（事件保留到下次开始或导出）
+    public static func stopTracing() {
+        EngineTrace.stop()
+    }
+    
+    /// 导出追踪：`.json` 为 Chrome trace JSON，其他扩展名（如 `.perfetto-trace`）为 Perfetto protobuf
+    /// - Returns: 导出的事件数
+    @discardableResult
+    public static func dumpTrace(to url: URL) throws -> Int {
+        return try EngineTrace.dump(to: url)
+    }
+}
+
+// MARK: - 回调采集与回放
+
+/// 回放时序
+public enum AudioRecordReplayTiming: Sendable {
+    /// 按采集时的回调间隔回放（复现现场的时序与断流）
+    case original
+    /// 尽可能快地回放（回归测试与性能比较）
+    case asFastAsPossible
+}
+
+/// 回放结果
+public struct AudioRecordReplayResult: Sendable {
+    /// 回放的回调块数（含麦克风环形缓冲的写入）
+    public let callbacks: Int
+    /// 渲染的帧数
+    public let frames: Int64
+    /// 渲染总耗时（不含等待）
+    public let renderNanoseconds: UInt64
+    /// 回放墙钟耗时
+    public let wallNanoseconds: UInt64
+    /// 实时倍数
+    public let realtimeFactor: Double
+    /// 每次渲染的耗时分布
+    public let renderLatency: AudioRecordLatencySummary
+    /// 处理图输出的逐样本哈希，相同采集文件与相同代码下必须一致
+    public let outputHash: UInt64
+    /// 回放期间各类断流 / 溢出的次数
+    public let xrunCounts: [AudioRecordXrunKind: Int64]
+}
+
+extension AudioRecordDiagnostics {
+    
+    /// 回调采集是否正在记录
+    public static var isCapturingCallbacks: Bool {
+        return CallbackCapture.shared.isEnabled
+    }
+    
+    /// 开始采集：之后每个源回调的原始输入块与时间戳写入采集文件
+    ///
+    /// 也可以用环境变量 `AUDIORECORD_CAPTURE=<路径>` 在第一次录制时开启。
+    /// - Parameters:
+    ///   - url: 采集文件路径
+    ///   - compressed: 是否按块 LZFSE 压缩
+    public static func startCallbackCapture(to url: URL, compressed: Bool = true) throws {
+        try CallbackCapture.shared.start(url: url, compressed: compressed)
+    }
+    
+    /// 停止采集并关闭文件
+    public static func stopCallbackCapture() {
+        CallbackCapture.shared.stop()
+    }
+    
+    /// 把采集文件按相同的顺序回放到重建的处理图
+    /// - Parameters:
+    ///   - url: 采集文件路径
+    ///   - timing: 回放时序
+    ///   - outputURL: 同时写出 Float32 WAV（nil 表示不写文件）
+    @available(macOS 14.4, *)
+    public static func replayCallbackCapture(from url: URL, timing: AudioRecordReplayTiming = .asFastAsPossible,
+                                             outputURL: URL? = nil) throws -> AudioRecordReplayResult {
+        let replay = try CallbackReplay(url: url)
+        let result = try replay.run(timing: timing == .original ? .original : .asFastAsPossible, outputURL: outputURL)
+        var xruns: [AudioRecordXrunKind: Int64] = [:]
+        for (kind, count) in result.xruns {
+            xruns[AudioRecordXrunKind(rawValue: kind.rawValue)!] = count
+        }
+        return AudioRecordReplayResult(
+            callbacks: result.callbacks,
+            frames: result.frames,
+            renderNanoseconds: result.renderNanoseconds,
+            wallNanoseconds: result.wallNanoseconds,
+            realtimeFactor: result.realtimeFactor,
+            renderLatency: AudioRecordLatencySummary(result.renderLatency),
+            outputHash: result.outputHash,
+            xrunCounts: xruns
+        )
+    }
+}
+
+// MARK: - 内存记账与预算
+
+/// 引擎内存类别
+public enum AudioRecordMemoryTag: Int, Sendable, CaseIterable {
+    /// 节点输出块
+    case blocks = 0
+    /// 环形缓冲区（麦克风等异步源）
+    case rings = 1
+    /// 节点暂存区（写入器编码缓冲等）
+    case scratch = 2
+    /// 回调采集缓冲区
+    case capture = 3
+    /// 引擎追踪缓冲区
+    case trace = 4
+    /// 诊断缓冲区（日志、xrun 事件、延迟直方图）
+    case diagnostics = 5
+    
+    var internalTag: MemoryTag {
+        return MemoryTag(rawValue: rawValue)!
+    }
+}
+
+/// 单个会话（处理图）的内存
+public struct AudioRecordSessionMemory: Sendable {
+    public let name: String
+    public let bytes: Int64
+}
+
+/// 引擎内存统计
+public struct AudioRecordMemoryStatistics: Sendable {
+    /// 当前引擎分配的字节数
+    public let totalBytes: Int64
+    /// 进程启动以来的峰值
+    public let peakBytes: Int64
+    /// 内存预算（0 表示不限制）
+    public let budgetBytes: Int64
+    /// 因预算不足而缩小分配的次数
+    public let degradations: Int64
+    /// 各类别的字节数
+    public let tagBytes: [AudioRecordMemoryTag: Int64]
+    /// 存活的会话
+    public let sessions: [AudioRecordSessionMemory]
+}
+
+extension AudioRecordDiagnostics {
+    
+    /// 读取引擎内存统计
+    public static func memoryStatistics() -> AudioRecordMemoryStatistics {
+        let snapshot = EngineMemory.snapshot()
+        var tagBytes: [AudioRecordMemoryTag: Int64] = [:]
+        for tag in AudioRecordMemoryTag.allCases {
+            tagBytes[tag] = snapshot.tagBytes[tag.internalTag] ?? 0
+        }
+        return AudioRecordMemoryStatistics(
+            totalBytes: snapshot.totalBytes,
+            peakBytes: snapshot.peakBytes,
+            budgetBytes: snapshot.budgetBytes,
+            degradations: snapshot.degradations,
+            tagBytes: tagBytes,
+            sessions: snapshot.sessions.map { AudioRecordSessionMemory(name: $0.name, bytes: $0.bytes) }
+        )
+    }
+    
+    /// 引擎内存预算（字节，0 表示不限制）
+    ///
+    /// 在预热之前设置：超出预算时麦克风环形缓冲区与回调采集缓冲区按可用空间缩小
+    /// （不低于各自的下限），已分配的缓冲区不受影响。
+    public static var memoryBudgetBytes: Int64 {
+        get { return EngineMemory.budgetBytes }
+        set { EngineMemory.budgetBytes = newValue }
+    }
+    
+    /// 每个录制会话的内存预算（字节，0 表示不限制）
+    ///
+    /// 对之后建立的处理图生效：单个会话的麦克风环形缓冲区与写入队列合计不超过该值
+    /// （不低于各自的下限），与全局预算同时约束。
+    public static var sessionMemoryBudgetBytes: Int64 {
+        get { return EngineMemory.sessionBudgetBytes }
+        set { EngineMemory.sessionBudgetBytes = newValue }
+    }
+}
+
+// MARK: - 磁盘空间
+
+/// 磁盘空间压力等级
+public enum AudioRecordDiskPressureLevel: Int, Sendable {
+    /// 剩余空间充足
+    case normal = 0
+    /// 预计剩余录制时间低于警告阈值（已切换到溢出文件）
+    case low = 1
+    /// 预计剩余录制时间低于临界阈值，应尽快停止录制或释放空间
+    case critical = 2
+}
+
+/// 磁盘空间压力事件（等级变化时发出）
+public struct AudioRecordDiskPressureEvent: Sendable {
+    public let level: AudioRecordDiskPressureLevel
+    /// 卷上的可用字节数
+    public let freeBytes: Int64
+    /// 按当前写入速率预计还能录制的秒数
+    public let secondsRemaining: Double
+    /// 录音文件
+    public let fileURL: URL
+    /// 溢出文件（CAF：整数样本为 ALAC 压缩，浮点样本为不压缩的 Float32 LPCM；未切换时为 nil）
+    public let spillURL: URL?
+}
+
+/// 磁盘空间策略
+public struct AudioRecordDiskPolicy: Sendable {
+    /// 预计剩余时间低于该值时切换到溢出文件并发出 low 事件（秒）
+    public var warningSeconds: Double
+    /// 预计剩余时间低于该值时发出 critical 事件（秒）
+    public var criticalSeconds: Double
+    /// 每次为录音文件预留的空间（字节），0 表示不预留
+    public var preallocationBytes: Int64
+    /// 空间不足时切换到溢出文件
+    public var spillEnabled: Bool
+    
+    public init(warningSeconds: Double = 600, criticalSeconds: Double = 60,
+                preallocationBytes: Int64 = 64 * 1024 * 1024, spillEnabled: Bool = true) {
+        self.warningSeconds = warningSeconds
+        self.criticalSeconds = criticalSeconds
+        self.preallocationBytes = preallocationBytes
+        self.spillEnabled = spillEnabled
+    }
+}
+
+extension AudioRecordDiagnostics {
+    
+    /// 磁盘空间策略（预留大小对之后开始的录制生效，阈值在下一次检查时生效）
+    public static var diskPolicy: AudioRecordDiskPolicy {
+        get {
+            let policy = DiskPressureMonitor.policy
+            return AudioRecordDiskPolicy(
+                warningSeconds: policy.warningSeconds,
+                criticalSeconds: policy.criticalSeconds,
+                preallocationBytes: policy.preallocationBytes,
+                spillEnabled: policy.spillEnabled
+            )
+        }
+        set {
+            DiskPressureMonitor.policy = DiskPressurePolicy(
+                warningSeconds: newValue.warningSeconds,
+                criticalSeconds: min(newValue.criticalSeconds, newValue.warningSeconds),
+                preallocationBytes: max(0, newValue.preallocationBytes),
+                spillEnabled: newValue.spillEnabled
+            )
+        }
+    }
+    
+    /// 添加磁盘空间观察者（在主线程回调）
+    /// - Returns: 用于 `removeDiskPressureObserver(_:)` 的标识
+    @discardableResult
+    public static func addDiskPressureObserver(_ handler: @escaping (AudioRecordDiskPressureEvent) -> Void) -> Int {
+        return DiskPressureMonitor.addObserver { event in
+            handler(AudioRecordDiskPressureEvent(
+                level: AudioRecordDiskPressureLevel(rawValue: event.level.rawValue)!,
+                freeBytes: event.freeBytes,
+                secondsRemaining: event.secondsRemaining,
+                fileURL: event.fileURL,
+                spillURL: event.spillURL
+            ))
+        }
+    }
+    
+    public static func removeDiskPressureObserver(_ id: Int) {
+        DiskPressureMonitor.removeObserver(id)
+    }
+}
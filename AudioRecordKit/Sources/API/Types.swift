@@ -81,6 +81,37 @@ public struct AudioProcessInfo: Hashable, Sendable {
     }
 }
 
+/// 单个进程的实时电平（线性值，0~1）
+public struct AudioProcessLevel: Sendable {
+    public let pid: pid_t
+    /// 最近一个统计窗口的峰值
+    public let peak: Float
+    /// 最近一个统计窗口的 RMS
+    public let rms: Float
+    
+    public init(pid: pid_t, peak: Float, rms: Float) {
+        self.pid = pid
+        self.peak = peak
+        self.rms = rms
+    }
+}
+
+/// 录制启动各阶段耗时（纳秒，未发生的阶段为 0）
+public struct AudioRecordStartupTimings: Sendable {
+    /// 预热：建图、打开设备、分配缓冲、创建输出文件
+    public let prepareNanoseconds: UInt64
+    /// 开始录制调用到写入开关打开（已预热时只是切换开关）
+    public let startNanoseconds: UInt64
+    /// 开始录制调用到第一帧写入文件
+    public let firstFrameNanoseconds: UInt64
+    
+    public init(prepareNanoseconds: UInt64 = 0, startNanoseconds: UInt64 = 0, firstFrameNanoseconds: UInt64 = 0) {
+        self.prepareNanoseconds = prepareNanoseconds
+        self.startNanoseconds = startNanoseconds
+        self.firstFrameNanoseconds = firstFrameNanoseconds
+    }
+}
+
 /// 录制文件信息
 public struct RecordedFileInfo: Identifiable, Sendable {
     public let id: UUID
@@ -62,7 +62,8 @@ typedef enum {
     AudioRecordState_Preparing = 1,  ///< 准备中
     AudioRecordState_Recording = 2,  ///< 录制中
     AudioRecordState_Stopping = 3,   ///< 停止中
-    AudioRecordState_Paused = 4      ///< 已暂停
+    AudioRecordState_Paused = 4,     ///< 已暂停
+    AudioRecordState_Armed = 5       ///< 已预热，等待 AudioRecord_Start
 } AudioRecordState;
 
 /**
@@ -78,6 +79,7 @@ typedef enum {
     AudioRecordError_FileError = -6,          ///< 文件错误
     AudioRecordError_UnsupportedMode = -7,    ///< 不支持的模式
     AudioRecordError_SystemVersionTooLow = -8,///< 系统版本过低
+    AudioRecordError_InvalidArgument = -9,    ///< 参数无效
     AudioRecordError_Unknown = -99            ///< 未知错误
 } AudioRecordError;
 
@@ -91,6 +93,26 @@ typedef enum {
     AudioPermission_Restricted = 3      ///< 受限制
 } AudioPermissionStatus;
 
+/**
+ * @brief 断流 / 溢出事件类别
+ */
+typedef enum {
+    AudioRecordXrun_Discontinuity = 0,   ///< 采集时间线不连续，frames 为缺失帧数（负数为重叠）
+    AudioRecordXrun_RingOverrun = 1,     ///< 环形缓冲区已满，frames 为丢弃帧数
+    AudioRecordXrun_RingUnderrun = 2,    ///< 环形缓冲区数据不足，frames 为补零帧数
+    AudioRecordXrun_WriteFailure = 3,    ///< 写入失败，frames 为丢失帧数
+    AudioRecordXrun_CallbackOverrun = 4  ///< IO 回调超过块时长，frames 为超出帧数
+} AudioRecordXrunKind;
+
+/**
+ * @brief 磁盘空间压力等级
+ */
+typedef enum {
+    AudioRecordDiskPressure_Normal = 0,   ///< 剩余空间充足
+    AudioRecordDiskPressure_Low = 1,      ///< 预计剩余录制时间低于警告阈值，已切换到溢出文件
+    AudioRecordDiskPressure_Critical = 2  ///< 预计剩余录制时间低于临界阈值，应尽快停止录制或释放空间
+} AudioRecordDiskPressure;
+
 /**
  * @brief 进程信息
  */
@@ -103,10 +125,18 @@ typedef struct {
 
 /**
  * @brief 进程列表
+ *
+ * 由 AudioRecord_CopyAudioProcessList / AudioRecord_CopyAudioProcessChanges 返回。
+ * 结构体、进程数组、移除 PID 数组与全部字符串位于同一块内存，
+ * 使用后调用一次 AudioRecord_FreeAudioProcessList 释放。
  */
 typedef struct {
-    AudioProcessInfo* processes;  ///< 进程数组
+    AudioProcessInfo* processes;  ///< 进程数组（变化列表中为新增的进程）
     int32_t count;               ///< 进程数量
+    int32_t removedCount;        ///< 已移除的进程数量（仅变化列表）
+    const int32_t* removedPIDs;  ///< 已移除进程的 PID（仅变化列表）
+    uint64_t generation;         ///< 列表版本号
+    bool isFullList;             ///< true 表示 processes 为完整列表，调用方应整体替换
 } AudioProcessList;
 
 // ============================================================================
@@ -143,6 +173,26 @@ typedef void (*AudioCompleteCallback)(const char* filePath, int64_t durationMs,
  */
 typedef void (*AudioErrorCallback)(AudioRecordError error, const char* message, void* userData);
 
+/**
+ * @brief 断流 / 溢出事件回调
+ * @param kind 事件类别
+ * @param frames 事件大小（帧）
+ * @param hostTimeNs 发生时刻（mach_absolute_time 换算的纳秒）
+ * @param userData 用户数据
+ */
+typedef void (*AudioXrunCallback)(AudioRecordXrunKind kind, int64_t frames, uint64_t hostTimeNs, void* userData);
+
+/**
+ * @brief 磁盘空间压力回调（等级变化时触发）
+ * @param level 压力等级
+ * @param freeBytes 卷上的可用字节数
+ * @param secondsRemaining 按当前写入速率预计还能录制的秒数
+ * @param spillPath 溢出文件路径（未切换时为 NULL）
+ * @param userData 用户数据
+ */
+typedef void (*AudioDiskPressureCallback)(AudioRecordDiskPressure level, uint64_t freeBytes, double secondsRemaining,
+                                          const char* spillPath, void* userData);
+
 // ============================================================================
 // MARK: - 生命周期管理
 // ============================================================================
@@ -170,11 +220,34 @@ const char* AudioRecord_GetVersion(void);
 // ============================================================================
 
 /**
- * @brief 开始录制
+ * @brief 录制启动耗时（纳秒，未发生的阶段为 0）
+ */
+typedef struct {
+    uint64_t prepareNs;      ///< 预热耗时：建图、打开设备、分配缓冲、创建输出文件
+    uint64_t startNs;        ///< 开始录制到打开写入开关
+    uint64_t firstFrameNs;   ///< 开始录制到第一帧写入文件
+} AudioRecordStartupLatency;
+
+/**
+ * @brief 预热录制
+ *
+ * 异步完成建图、打开设备、分配缓冲与创建输出文件，设备开始运行但不写入；
+ * 进行中状态为 AudioRecordState_Preparing，完成后状态回调报告 AudioRecordState_Armed。
+ * 之后以相同模式调用 AudioRecord_Start 只打开写入开关，不超过一个缓冲周期即开始落盘；
+ * 预热未完成时调用 AudioRecord_Start 则在预热完成后立即开始。
+ * 预热中或预热后调用 AudioRecord_Stop 取消预热，预热好的会话随即释放并删除空文件。
  * @param handle SDK 句柄
  * @param mode 录制模式
  * @return 错误码
  */
+AudioRecordError AudioRecord_Prepare(AudioRecordHandle handle, AudioRecordMode mode);
+
+/**
+ * @brief 开始录制
+ * @param handle SDK 句柄
+ * @param mode 录制模式（与预热模式相同时直接使用预热的会话）
+ * @return 错误码（其他模式的预热进行中时返回 AudioRecordError_AlreadyRecording）
+ */
 AudioRecordError AudioRecord_Start(AudioRecordHandle handle, AudioRecordMode mode);
 
 /**
@@ -220,6 +293,14 @@ bool AudioRecord_IsRecording(AudioRecordHandle handle);
  */
 AudioRecordState AudioRecord_GetState(AudioRecordHandle handle);
 
+/**
+ * @brief 获取最近一次启动的各阶段耗时
+ * @param handle SDK 句柄
+ * @param latency 输出
+ * @return 错误码
+ */
+AudioRecordError AudioRecord_GetStartupLatency(AudioRecordHandle handle, AudioRecordStartupLatency* latency);
+
 /**
  * @brief 获取当前录制时长
  * @param handle SDK 句柄
@@ -291,6 +372,25 @@ void AudioRecord_SetCompleteCallback(AudioRecordHandle handle, AudioCompleteCall
  */
 void AudioRecord_SetErrorCallback(AudioRecordHandle handle, AudioErrorCallback callback, void* userData);
 
+/**
+ * @brief 设置断流 / 溢出事件回调（在主线程批量触发，事件同时写入录音文件旁的 .xruns.log）
+ * @param handle SDK 句柄
+ * @param callback 回调函数，传 NULL 取消
+ * @param userData 用户数据
+ */
+void AudioRecord_SetXrunCallback(AudioRecordHandle handle, AudioXrunCallback callback, void* userData);
+
+/**
+ * @brief 设置磁盘空间压力回调（在主线程触发）
+ *
+ * 录制期间后台每秒按可用空间与写入速率预测剩余录制时间，在数据丢失之前发出
+ * Low / Critical 事件；空间恢复后发出 Normal。
+ * @param handle SDK 句柄
+ * @param callback 回调函数，传 NULL 取消
+ * @param userData 用户数据
+ */
+void AudioRecord_SetDiskPressureCallback(AudioRecordHandle handle, AudioDiskPressureCallback callback, void* userData);
+
 // ============================================================================
 // MARK: - 权限管理
 // ============================================================================
@@ -324,14 +424,74 @@ AudioPermissionStatus AudioRecord_GetScreenCapturePermission(void);
 typedef void* AudioProcessListHandle;
 
 /**
- * @brief 获取可录制的音频进程数量（快速检查）
+ * @brief 进程列表变化类型
+ */
+typedef enum {
+    AudioProcessChange_Added = 0,    ///< 新出现的可录制进程
+    AudioProcessChange_Removed = 1   ///< 已退出的可录制进程
+} AudioProcessChange;
+
+/**
+ * @brief 进程列表变化回调
+ * @param change 变化类型
+ * @param pid 进程 PID
+ * @param generation 变化后的列表版本号（同一批变化相同）
+ * @param userData 用户数据
+ */
+typedef void (*AudioProcessListCallback)(AudioProcessChange change, int32_t pid, uint64_t generation, void* userData);
+
+/**
+ * @brief 获取可录制的音频进程数量（读取缓存，不重新枚举）
  * @return 进程数量
  */
 int32_t AudioRecord_GetAudioProcessCount(void);
 
+/**
+ * @brief 检查进程是否可录制（按 PID 查缓存）
+ * @param pid 进程 PID
+ * @return true 表示在可录制列表中
+ */
+bool AudioRecord_IsAudioProcessAvailable(int32_t pid);
+
+/**
+ * @brief 订阅进程列表变化
+ *
+ * 进程列表由 CoreAudio 属性通知增量更新；每个新增 / 移除的进程在主线程回调一次。
+ * 再次调用会替换之前的订阅，传 NULL 取消订阅。
+ * @param callback 回调函数
+ * @param userData 用户数据
+ */
+void AudioRecord_SetProcessListCallback(AudioProcessListCallback callback, void* userData);
+
+/**
+ * @brief 一次性复制完整的可录制进程列表
+ *
+ * 整个列表（含字符串）一次分配、一次填充，字段可直接读取，无需逐个索引调用。
+ * @return 进程列表（isFullList 为 true），失败返回 NULL；使用后调用 AudioRecord_FreeAudioProcessList 释放
+ */
+AudioProcessList* AudioRecord_CopyAudioProcessList(void);
+
+/**
+ * @brief 复制自某个版本号之后的进程列表变化（供轮询的宿主使用）
+ *
+ * 调用方先移除 removedPIDs 中的进程，再加入 processes 中的进程，然后保存 generation 供下次调用。
+ * sinceGeneration 为 0 或早于内部保留的变化记录时返回完整列表（isFullList 为 true）；
+ * 没有变化时 count 与 removedCount 均为 0。
+ * @param sinceGeneration 上次取得的列表版本号
+ * @return 变化列表，失败返回 NULL；使用后调用 AudioRecord_FreeAudioProcessList 释放
+ */
+AudioProcessList* AudioRecord_CopyAudioProcessChanges(uint64_t sinceGeneration);
+
+/**
+ * @brief 释放 AudioRecord_CopyAudioProcessList / AudioRecord_CopyAudioProcessChanges 返回的列表
+ * @param list 进程列表（可为 NULL）
+ */
+void AudioRecord_FreeAudioProcessList(AudioProcessList* list);
+
 /**
  * @brief 获取可录制的音频进程列表
  * @return 进程列表句柄，使用后需调用 AudioRecord_FreeProcessList 释放
+ * @note 新代码建议使用 AudioRecord_CopyAudioProcessList
  */
 AudioProcessListHandle AudioRecord_GetAudioProcesses(void);
 
@@ -372,6 +532,285 @@ const char* AudioRecord_GetProcessBundleID(AudioProcessListHandle handle, int32_
  */
 void AudioRecord_FreeProcessList(AudioProcessListHandle handle);
 
+// ============================================================================
+// MARK: - 进程电平监控
+// ============================================================================
+
+/**
+ * @brief 单个进程的实时电平（线性值，0~1）
+ */
+typedef struct {
+    int32_t pid;    ///< 进程 PID
+    float peak;     ///< 最近一个统计窗口的峰值
+    float rms;      ///< 最近一个统计窗口的 RMS
+} AudioProcessLevel;
+
+/**
+ * @brief 开始监控多个进程的电平
+ *
+ * 每个进程一个轻量 Tap，共用一个 IO 回调，只计算峰值与 RMS，不录制、不写文件。
+ * 再次调用会替换之前的监控集合。可在任意线程调用。
+ * @param pids 进程 PID 数组，传 NULL 表示全部可录制进程（进程列表变化时自动更新）
+ * @param count PID 数量
+ * @return 错误码
+ */
+AudioRecordError AudioRecord_StartProcessLevelMonitor(const int32_t* pids, int32_t count);
+
+/**
+ * @brief 停止进程电平监控
+ */
+void AudioRecord_StopProcessLevelMonitor(void);
+
+/**
+ * @brief 读取各进程最近的电平快照
+ * @param levels 输出数组（可为 NULL，仅查询数量）
+ * @param capacity 数组容量
+ * @return 被监控的进程数（可能大于 capacity，只写入前 capacity 个）
+ */
+int32_t AudioRecord_GetProcessLevels(AudioProcessLevel* levels, int32_t capacity);
+
+// ============================================================================
+// MARK: - 诊断
+// ============================================================================
+
+/**
+ * @brief 统计结构体版本
+ */
+#define AUDIO_RECORD_STATS_VERSION 1
+
+/**
+ * @brief 统计阶段（每块计时）
+ */
+typedef enum {
+    AudioRecordStage_Capture = 0,   ///< 设备采集时刻 → IO 回调开始（仅墙钟）
+    AudioRecordStage_Ingest = 1,    ///< 采集数据载入处理图
+    AudioRecordStage_Process = 2,   ///< 处理器节点（混音、限幅等）
+    AudioRecordStage_Analysis = 3,  ///< 电平表等旁路输出
+    AudioRecordStage_Encode = 4,    ///< 编码为文件格式并提交给写入器
+    AudioRecordStage_Write = 5,     ///< 写入器调用到写入完成
+    AudioRecordStage_EndToEnd = 6,  ///< 设备采集时刻 → 写入完成（仅墙钟）
+    AudioRecordStage_Callback = 7,  ///< 整个 IO 回调
+    AudioRecordStage_Count = 8
+} AudioRecordStage;
+
+/**
+ * @brief 耗时分布（纳秒）
+ */
+typedef struct {
+    uint64_t count;    ///< 样本数（块数）
+    uint64_t meanNs;   ///< 平均值
+    uint64_t p50Ns;    ///< 50 分位
+    uint64_t p99Ns;    ///< 99 分位
+    uint64_t p999Ns;   ///< 99.9 分位
+    uint64_t maxNs;    ///< 最大值
+} AudioRecordHistogram;
+
+/**
+ * @brief 单个阶段的统计
+ */
+typedef struct {
+    AudioRecordHistogram latency;  ///< 每块墙钟耗时
+    AudioRecordHistogram cpu;      ///< 每块线程 CPU 时间（Capture / EndToEnd 为空）
+} AudioRecordStageStats;
+
+/**
+ * @brief 采集管线统计
+ *
+ * 调用前填入 version 与 size；SDK 只写入 size 范围内的字段，返回时
+ * version 为 SDK 的结构体版本，size 为实际写入的字节数。新版本只在末尾追加字段。
+ */
+typedef struct {
+    uint32_t version;   ///< 结构体版本（AUDIO_RECORD_STATS_VERSION）
+    uint32_t size;      ///< 结构体大小（sizeof(AudioRecordStats)）
+    uint64_t blocks;    ///< 自上次重置以来处理的块数
+    uint64_t frames;    ///< 自上次重置以来处理的帧数
+    uint64_t elapsedNs; ///< 自上次重置以来的时间
+    AudioRecordStageStats stages[AudioRecordStage_Count]; ///< 按 AudioRecordStage 索引
+} AudioRecordStats;
+
+/**
+ * @brief 获取采集管线统计（每阶段延迟与 CPU 时间的 p50/p99/p999/max）
+ *
+ * 统计是进程全局的：同时录制的多个句柄计入同一份统计。
+ * @param stats 输出，调用前填入 version 与 size
+ * @return 错误码；stats 为空或 size 小于头部时返回 InvalidArgument
+ */
+AudioRecordError AudioRecord_GetStats(AudioRecordStats* stats);
+
+/**
+ * @brief 重置采集管线统计（进程全局；录制中调用不会暂停采集）
+ * @return 错误码
+ */
+AudioRecordError AudioRecord_ResetStats(void);
+
+/**
+ * @brief 获取该句柄本次录制某类断流 / 溢出事件的次数
+ *
+ * 计数属于句柄最近一次开始的录制，其他句柄或并发会话的事件不计入；停止后保留到下次开始。
+ * @param handle SDK 句柄
+ * @param kind 事件类别
+ * @return 次数；失败时返回负的错误码
+ */
+int64_t AudioRecord_GetXrunCount(AudioRecordHandle handle, AudioRecordXrunKind kind);
+
+/**
+ * @brief 获取该句柄本次录制某类断流 / 溢出事件累计的帧数
+ * @param handle SDK 句柄
+ * @param kind 事件类别
+ * @return 帧数；失败时返回负的错误码
+ */
+int64_t AudioRecord_GetXrunFrames(AudioRecordHandle handle, AudioRecordXrunKind kind);
+
+/**
+ * @brief 获取实时线程违规次数
+ * @return IO 线程上的内存分配、阻塞等待、文件 IO 与日志调用次数；
+ *         Release 构建中检查关闭，始终返回 0
+ */
+int64_t AudioRecord_GetRealtimeViolationCount(void);
+
+/**
+ * @brief 清空实时线程违规记录（应在没有录制进行时调用）
+ */
+void AudioRecord_ResetRealtimeViolations(void);
+
+/**
+ * @brief 开始 / 停止引擎追踪
+ *
+ * 开始时清空已有事件；记录 IO 回调、处理图节点、写入与等待的时间线。
+ * 也可以用环境变量 AUDIORECORD_TRACE=1 在启动时开启。
+ * @param enabled true 开始记录，false 停止记录（已记录的事件保留）
+ * @return 错误码；编译时关闭了追踪返回 UnsupportedMode
+ */
+AudioRecordError AudioRecord_SetTraceEnabled(bool enabled);
+
+/**
+ * @brief 导出引擎追踪
+ * @param path 输出路径：扩展名为 .json 时写 Chrome trace JSON（chrome://tracing、ui.perfetto.dev 可打开），
+ *             其他扩展名写 Perfetto protobuf（如 trace.perfetto-trace）
+ * @return 错误码；path 为空返回 InvalidArgument，写入失败返回 FileError，
+ *         编译时关闭了追踪返回 UnsupportedMode
+ */
+AudioRecordError AudioRecord_DumpTrace(const char* path);
+
+/**
+ * @brief 开始回调采集
+ *
+ * 之后每个源回调（Process Tap IO 回调、麦克风 Tap）的原始输入块与时间戳写入采集文件，
+ * 可用 AudioRecord_ReplayCallbackCapture 确定性地回放。也可以用环境变量
+ * AUDIORECORD_CAPTURE=<路径> 在第一次录制时开启。
+ * @param path 采集文件路径
+ * @param compressed true 按块 LZFSE 压缩
+ * @return 错误码；path 为空返回 InvalidArgument，无法创建文件返回 FileError
+ */
+AudioRecordError AudioRecord_StartCallbackCapture(const char* path, bool compressed);
+
+/**
+ * @brief 停止回调采集并关闭文件
+ * @return 错误码
+ */
+AudioRecordError AudioRecord_StopCallbackCapture(void);
+
+/**
+ * @brief 回放结果
+ */
+typedef struct {
+    uint64_t callbacks;     ///< 回放的回调块数
+    uint64_t frames;        ///< 渲染的帧数
+    uint64_t renderNs;      ///< 渲染总耗时（不含等待）
+    uint64_t wallNs;        ///< 回放墙钟耗时
+    uint64_t renderP50Ns;   ///< 单次渲染耗时 p50
+    uint64_t renderP99Ns;   ///< 单次渲染耗时 p99
+    uint64_t outputHash;    ///< 处理图输出的逐样本哈希，相同采集文件与相同代码下必须一致
+    uint64_t xrunCount;     ///< 回放期间断流 / 溢出合计次数
+} AudioRecordReplayResult;
+
+/**
+ * @brief 把采集文件回放到按录制器形状重建的处理图
+ * @param path 采集文件路径
+ * @param realtime true 按采集时的回调间隔回放，false 尽可能快
+ * @param outputPath 同时写出 Float32 WAV 的路径，NULL 表示不写文件
+ * @param result 输出，可为 NULL
+ * @return 错误码；path 为空返回 InvalidArgument，文件无效返回 FileError
+ */
+AudioRecordError AudioRecord_ReplayCallbackCapture(const char* path, bool realtime, const char* outputPath, AudioRecordReplayResult* result);
+
+/**
+ * @brief 引擎内存类别
+ */
+typedef enum {
+    AudioRecordMemoryTag_Blocks = 0,   ///< 节点输出块
+    AudioRecordMemoryTag_Rings = 1,    ///< 环形缓冲区（麦克风等异步源）
+    AudioRecordMemoryTag_Scratch = 2,  ///< 节点暂存区（写入器编码缓冲等）
+    AudioRecordMemoryTag_Capture = 3,  ///< 回调采集缓冲区
+    AudioRecordMemoryTag_Trace = 4,    ///< 引擎追踪缓冲区
+    AudioRecordMemoryTag_Diagnostics = 5, ///< 诊断缓冲区（日志、xrun 事件、延迟直方图）
+    AudioRecordMemoryTag_Count = 6
+} AudioRecordMemoryTag;
+
+#define AUDIO_RECORD_MEMORY_STATS_VERSION 1
+
+/**
+ * @brief 引擎内存统计
+ *
+ * 与 AudioRecordStats 相同，调用前填入 version 与 size，SDK 只写入 size 范围内的字段。
+ */
+typedef struct {
+    uint32_t version;        ///< 结构体版本（AUDIO_RECORD_MEMORY_STATS_VERSION）
+    uint32_t size;           ///< 结构体大小（sizeof(AudioRecordMemoryStats)）
+    uint64_t totalBytes;     ///< 当前引擎分配的字节数（全部会话 + 诊断缓冲区）
+    uint64_t peakBytes;      ///< 进程启动以来的峰值
+    uint64_t budgetBytes;    ///< 内存预算，0 表示不限制
+    uint64_t degradations;   ///< 因预算不足而缩小分配的次数
+    uint64_t sessionBytes;   ///< 当前句柄会话的处理图占用（未建图时为 0）
+    uint64_t sessionCount;   ///< 存活的会话数
+    uint64_t tagBytes[AudioRecordMemoryTag_Count]; ///< 按 AudioRecordMemoryTag 索引
+} AudioRecordMemoryStats;
+
+/**
+ * @brief 获取引擎内存统计
+ * @param handle SDK 句柄
+ * @param stats 输出，调用前填入 version 与 size
+ * @return 错误码；stats 为空或 size 小于头部时返回 InvalidArgument
+ */
+AudioRecordError AudioRecord_GetMemoryStats(AudioRecordHandle handle, AudioRecordMemoryStats* stats);
+
+/**
+ * @brief 设置引擎内存预算
+ *
+ * 在预热之前设置。超出预算时引擎降级而不是继续增长：麦克风环形缓冲区
+ * 与回调采集缓冲区按剩余预算缩小（不低于各自的下限），每次降级计入 degradations。
+ * @param bytes 预算字节数，0 表示不限制
+ * @return 错误码
+ */
+AudioRecordError AudioRecord_SetMemoryBudget(uint64_t bytes);
+
+/**
+ * @brief 设置每个录制会话的内存预算
+ *
+ * 在预热之前设置，对之后建立的会话生效。与全局预算同时约束：单个会话的麦克风环形缓冲区
+ * 与写入队列合计超出该值时按剩余空间缩小（不低于各自的下限），同样计入 degradations。
+ * @param bytes 预算字节数，0 表示不限制
+ * @return 错误码
+ */
+AudioRecordError AudioRecord_SetSessionMemoryBudget(uint64_t bytes);
+
+/**
+ * @brief 设置磁盘空间阈值
+ *
+ * 录音文件按 preallocateBytes 整块预留空间（F_PREALLOCATE），写到一半时预留下一块，
+ * 停止时归还未用部分。预计剩余录制时间低于 warningSeconds 时，之后的数据改写到
+ * 录音文件旁的溢出文件（<文件名>.spill.caf）并发出 Low 事件：整数样本用 ALAC 无损压缩（约为 PCM 的一半大小），
+ * 浮点样本量化为 24 位整数后用 ALAC 压缩（约为 Float32 的 45%，量化噪声约 -144 dBFS，超过满幅的值被截断）；
+ * 低于 criticalSeconds 时发出 Critical 事件。
+ * @param warningSeconds 警告阈值（秒），默认 600
+ * @param criticalSeconds 临界阈值（秒），默认 60
+ * @param preallocateBytes 每次预留的字节数，0 表示不预留，默认 64MB
+ * @param spill 空间不足时是否切换到溢出文件
+ * @return 错误码；criticalSeconds 大于 warningSeconds 时返回 InvalidArgument
+ */
+AudioRecordError AudioRecord_SetDiskPressureThresholds(uint32_t warningSeconds, uint32_t criticalSeconds,
+                                                       uint64_t preallocateBytes, bool spill);
+
 // ============================================================================
 // MARK: - 工具函数
 // ============================================================================
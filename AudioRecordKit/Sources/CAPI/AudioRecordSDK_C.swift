@@ -29,6 +29,8 @@ final class AudioRecordInstance {
     var completeUserData: UnsafeMutableRawPointer?
     var errorCallback: (Int32, String, UnsafeMutableRawPointer?) -> Void = { _, _, _ in }
     var errorUserData: UnsafeMutableRawPointer?
+    var xrunObserverID: Int?
+    var diskObserverID: Int?
     
     // 配置
     var outputDirectory: String?
@@ -39,6 +41,20 @@ final class AudioRecordInstance {
     var isRecording = false
     var recordingStartTime: Date?
     
+    /// 预热状态（armLock 保护：Prepare 的任务在主线程完成，Start / Stop / GetState 可在任意线程调用）
+    private let armLock = NSLock()
+    /// 预热完成的媒体流与模式（AudioRecord_Prepare）
+    private var armedStream: MediaStream?
+    private var armedMode: Int32 = -1
+    /// 进行中的预热令牌（0 表示没有）；Stop 将其清零使该次预热作废
+    private var pendingPrepare: UInt64 = 0
+    private var pendingMode: Int32 = -1
+    private var prepareSequence: UInt64 = 0
+    /// 预热完成前调用了 Start：完成后直接开始录制
+    private var startWhenArmed = false
+    /// 最近一次开始录制的会话断流监测（armLock 保护，停止后保留到下次开始）
+    private var recordingXruns: XrunMonitor?
+    
     init() {
         // 在主线程设置回调
         Task { @MainActor in
@@ -46,6 +62,138 @@ final class AudioRecordInstance {
         }
     }
     
+    // MARK: - 录制会话
+    
+    /// 录制已开始（主线程调用）：记录开始时间与该会话的断流监测
+    func markStarted(_ stream: MediaStream) {
+        recordingStartTime = Date()
+        armLock.lock()
+        recordingXruns = stream.recorder.xruns
+        armLock.unlock()
+    }
+    
+    /// 本句柄最近一次录制的断流监测（尚未开始过时为 nil）
+    var xruns: XrunMonitor? {
+        armLock.lock()
+        defer { armLock.unlock() }
+        return recordingXruns
+    }
+    
+    // MARK: - 预热状态
+    
+    /// Start 对预热状态的处理
+    enum ArmedStart {
+        /// 已按该模式预热完成，直接打开写入开关
+        case armed(MediaStream)
+        /// 该模式的预热进行中，完成后开始录制
+        case deferred
+        /// 其他模式的预热进行中
+        case busy
+        /// 没有可用的预热，走完整启动流程
+        case cold
+    }
+    
+    /// 预热完成后的去向
+    enum PrepareOutcome {
+        case armed
+        case start
+        case cancelled
+    }
+    
+    /// 预热进行中
+    var isPreparing: Bool {
+        armLock.lock()
+        defer { armLock.unlock() }
+        return pendingPrepare != 0
+    }
+    
+    /// 已预热、等待开始
+    var isArmed: Bool {
+        armLock.lock()
+        defer { armLock.unlock() }
+        return armedStream != nil
+    }
+    
+    /// 登记一次预热（取代之前未完成的预热）
+    /// - Returns: 预热令牌，完成时交给 `completePrepare`
+    func beginPrepare(mode: Int32) -> UInt64 {
+        armLock.lock()
+        defer { armLock.unlock() }
+        prepareSequence += 1
+        pendingPrepare = prepareSequence
+        pendingMode = mode
+        startWhenArmed = false
+        armedStream = nil
+        return prepareSequence
+    }
+    
+    /// 预热完成（主线程）
+    /// - Returns: `.cancelled` 表示该次预热已被 Stop 或新的预热取代，调用方负责释放会话
+    func completePrepare(token: UInt64, stream: MediaStream) -> PrepareOutcome {
+        armLock.lock()
+        defer { armLock.unlock() }
+        guard pendingPrepare == token else {
+            return .cancelled
+        }
+        pendingPrepare = 0
+        if startWhenArmed {
+            startWhenArmed = false
+            return .start
+        }
+        armedStream = stream
+        armedMode = pendingMode
+        return .armed
+    }
+    
+    /// 预热失败（主线程）
+    func failPrepare(token: UInt64) {
+        armLock.lock()
+        defer { armLock.unlock() }
+        if pendingPrepare == token {
+            pendingPrepare = 0
+            startWhenArmed = false
+        }
+    }
+    
+    /// Start 取用预热状态
+    func takeArmed(mode: Int32) -> ArmedStart {
+        armLock.lock()
+        defer { armLock.unlock() }
+        if let stream = armedStream, armedMode == mode {
+            armedStream = nil
+            return .armed(stream)
+        }
+        if pendingPrepare != 0 {
+            guard pendingMode == mode else {
+                return .busy
+            }
+            startWhenArmed = true
+            return .deferred
+        }
+        armedStream = nil
+        return .cold
+    }
+    
+    /// 被取消的预热
+    enum CancelledArming {
+        case none
+        /// 预热尚未完成，由预热任务完成时释放会话
+        case pending
+        /// 已预热完成，由调用方释放会话
+        case armed
+    }
+    
+    /// 取消预热（Stop / 进程录制）
+    func cancelArming() -> CancelledArming {
+        armLock.lock()
+        defer { armLock.unlock() }
+        let cancelled: CancelledArming = pendingPrepare != 0 ? .pending : (armedStream != nil ? .armed : .none)
+        pendingPrepare = 0
+        startWhenArmed = false
+        armedStream = nil
+        return cancelled
+    }
+    
     @MainActor
     private func setupCallbacks() {
         let api = AudioRecordAPI.shared
@@ -83,6 +231,15 @@ final class AudioRecordInstance {
         }
     }
     
+    deinit {
+        if let id = xrunObserverID {
+            AudioRecordDiagnostics.removeXrunObserver(id)
+        }
+        if let id = diskObserverID {
+            AudioRecordDiagnostics.removeDiskPressureObserver(id)
+        }
+    }
+    
     /// 获取当前录制时长（毫秒）
     var currentDurationMs: Int64 {
         guard let startTime = recordingStartTime, isRecording else { return 0 }
@@ -146,8 +303,104 @@ private func getInstance(_ handle: UnsafeMutableRawPointer?) -> AudioRecordInsta
     return instance
 }
 
+/// 在主线程同步执行（C API 约定在主线程调用，此时不经过任务调度）
+@available(macOS 14.4, *)
+private func runOnMain<T: Sendable>(_ body: @MainActor () -> T) -> T {
+    if Thread.isMainThread {
+        return MainActor.assumeIsolated(body)
+    }
+    return DispatchQueue.main.sync {
+        MainActor.assumeIsolated(body)
+    }
+}
+
+/// 录制错误 → C API 错误码
+private func errorCode(for error: Error) -> Int32 {
+    if let recordError = error as? AudioRecordError {
+        switch recordError {
+        case .microphonePermissionDenied, .systemAudioPermissionDenied:
+            return -2 // PermissionDenied
+        case .deviceNotFound:
+            return -5 // DeviceError
+        case .alreadyRecording:
+            return -3 // AlreadyRecording
+        case .notSupported:
+            return -7 // UnsupportedMode
+        case .unknown(let underlying):
+            return errorCode(for: underlying)
+        }
+    }
+    let nsError = error as NSError
+    switch nsError.domain {
+    case "AudioRecorder":
+        return -2 // PermissionDenied - 输出目录访问被拒绝
+    case "AudioToolboxFileManager", NSCocoaErrorDomain:
+        return -6 // FileError
+    case NSOSStatusErrorDomain, "MixedAudioRecorder", "CoreAudioProcessTapRecorder":
+        return -5 // DeviceError
+    default:
+        return -99 // Unknown
+    }
+}
+
+/// 录制模式 → 约束（不支持的模式返回 nil）
+private func makeConstraints(mode: Int32) -> AudioConstraints? {
+    let includeSystemAudio: Bool
+    switch mode {
+    case 0: includeSystemAudio = false  // 纯麦克风
+    case 1, 2, 3: includeSystemAudio = true  // 系统音频/进程/混音
+    default: return nil
+    }
+    return AudioConstraints(
+        echoCancellation: false,
+        noiseSuppression: false,
+        includeSystemAudio: includeSystemAudio
+    )
+}
+
 // MARK: - 录制控制
 
+@_cdecl("AudioRecord_Prepare")
+public func AudioRecord_Prepare(_ handle: UnsafeMutableRawPointer?, _ mode: Int32) -> Int32 {
+    guard #available(macOS 14.4, *) else {
+        return -8 // SystemVersionTooLow
+    }
+    guard let instance = getInstance(handle) else {
+        return -1 // InvalidHandle
+    }
+    if instance.isRecording {
+        return -3 // AlreadyRecording
+    }
+    guard let constraints = makeConstraints(mode: mode) else {
+        return -7 // UnsupportedMode
+    }
+    
+    let token = instance.beginPrepare(mode: mode)
+    Task { @MainActor in
+        let api = AudioRecordAPI.shared
+        do {
+            let stream = try await api.getUserMedia(constraints: constraints)
+            try await api.prepareRecording(stream: stream)
+            switch instance.completePrepare(token: token, stream: stream) {
+            case .armed:
+                instance.stateCallback(5, instance.stateUserData) // Armed
+            case .start:
+                // 预热期间已调用 Start
+                try api.startRecording(stream: stream)
+                instance.markStarted(stream)
+            case .cancelled:
+                // 预热期间已调用 Stop：释放刚预热好的会话
+                api.cancelPreparedRecording(stream: stream)
+            }
+        } catch {
+            instance.failPrepare(token: token)
+            instance.errorCallback(errorCode(for: error), error.localizedDescription, instance.errorUserData)
+        }
+    }
+    
+    return 0 // None
+}
+
 @_cdecl("AudioRecord_Start")
 public func AudioRecord_Start(_ handle: UnsafeMutableRawPointer?, _ mode: Int32) -> Int32 {
     guard #available(macOS 14.4, *) else {
@@ -162,20 +415,31 @@ public func AudioRecord_Start(_ handle: UnsafeMutableRawPointer?, _ mode: Int32)
         return -3 // AlreadyRecording
     }
     
-    // 根据模式设置是否包含系统音频
-    let includeSystemAudio: Bool
-    switch mode {
-    case 0: includeSystemAudio = false  // 纯麦克风
-    case 1, 2, 3: includeSystemAudio = true  // 系统音频/进程/混音
-    default: return -7 // UnsupportedMode
+    guard let constraints = makeConstraints(mode: mode) else {
+        return -7 // UnsupportedMode
     }
     
-    // 创建约束
-    let constraints = AudioConstraints(
-        echoCancellation: false,
-        noiseSuppression: false,
-        includeSystemAudio: includeSystemAudio
-    )
+    switch instance.takeArmed(mode: mode) {
+    case .armed(let stream):
+        // 已按该模式预热：同步打开写入开关，不经过权限检查与建图
+        let result: Int32 = runOnMain {
+            do {
+                try AudioRecordAPI.shared.startRecording(stream: stream)
+                instance.markStarted(stream)
+                return 0
+            } catch {
+                return errorCode(for: error)
+            }
+        }
+        return result
+    case .deferred:
+        // 该模式的预热进行中：预热完成后立即开始
+        return 0 // None
+    case .busy:
+        return -3 // AlreadyRecording - 其他模式的预热进行中
+    case .cold:
+        break
+    }
     
     // 异步启动录制
     Task { @MainActor in
@@ -183,9 +447,9 @@ public func AudioRecord_Start(_ handle: UnsafeMutableRawPointer?, _ mode: Int32)
             let api = AudioRecordAPI.shared
             let stream = try await api.getUserMedia(constraints: constraints)
             try api.startRecording(stream: stream)
-            instance.recordingStartTime = Date()
+            instance.markStarted(stream)
         } catch {
-            instance.errorCallback(-99, error.localizedDescription, instance.errorUserData)
+            instance.errorCallback(errorCode(for: error), error.localizedDescription, instance.errorUserData)
         }
     }
     
@@ -214,15 +478,19 @@ public func AudioRecord_StartWithProcess(_ handle: UnsafeMutableRawPointer?, _ p
         includeSystemAudio: true
     )
     _ = pid  // 暂未使用，预留扩展
+    if instance.isPreparing {
+        return -3 // AlreadyRecording - 预热进行中
+    }
+    _ = instance.cancelArming()
     
     Task { @MainActor in
         do {
             let api = AudioRecordAPI.shared
             let stream = try await api.getUserMedia(constraints: constraints)
             try api.startRecording(stream: stream)
-            instance.recordingStartTime = Date()
+            instance.markStarted(stream)
         } catch {
-            instance.errorCallback(-99, error.localizedDescription, instance.errorUserData)
+            instance.errorCallback(errorCode(for: error), error.localizedDescription, instance.errorUserData)
         }
     }
     
@@ -234,8 +502,17 @@ public func AudioRecord_Stop(_ handle: UnsafeMutableRawPointer?) -> Int32 {
     guard #available(macOS 14.4, *) else { return -8 }
     guard let instance = getInstance(handle) else { return -1 }
     
+    // 预热后未开始（或预热尚未完成）时，Stop 取消预热
+    let cancelled = instance.cancelArming()
     if !instance.isRecording {
-        return -4 // NotRecording
+        switch cancelled {
+        case .none:
+            return -4 // NotRecording
+        case .pending:
+            return 0 // 预热任务完成时释放会话
+        case .armed:
+            break
+        }
     }
     
     Task { @MainActor in
@@ -271,8 +548,31 @@ public func AudioRecord_GetState(_ handle: UnsafeMutableRawPointer?) -> Int32 {
     guard #available(macOS 14.4, *) else { return 0 }
     guard let instance = getInstance(handle) else { return 0 }
     
-    // 简化状态：录制中返回 2，否则返回 0
-    return instance.isRecording ? 2 : 0
+    // 简化状态：录制中返回 2，预热中返回 1，已预热返回 5，否则返回 0
+    if instance.isRecording {
+        return 2
+    }
+    if instance.isPreparing {
+        return 1
+    }
+    return instance.isArmed ? 5 : 0
+}
+
+@_cdecl("AudioRecord_GetStartupLatency")
+public func AudioRecord_GetStartupLatency(_ handle: UnsafeMutableRawPointer?, _ latency: UnsafeMutableRawPointer?) -> Int32 {
+    guard #available(macOS 14.4, *) else { return -8 }
+    guard getInstance(handle) != nil else { return -1 }
+    guard let latency = latency else {
+        return -9 // InvalidArgument
+    }
+    
+    let timings = runOnMain { AudioRecordAPI.shared.startupTimings }
+    // 布局：prepareNs / startNs / firstFrameNs（均为 u64）
+    let fields = [timings.prepareNanoseconds, timings.startNanoseconds, timings.firstFrameNanoseconds]
+    for (index, value) in fields.enumerated() {
+        latency.storeBytes(of: value, toByteOffset: index * MemoryLayout<UInt64>.size, as: UInt64.self)
+    }
+    return 0
 }
 
 @_cdecl("AudioRecord_GetDuration")
@@ -323,6 +623,8 @@ public typealias CLevelCallback = @convention(c) (Float, UnsafeMutableRawPointer
 public typealias CStateCallback = @convention(c) (Int32, UnsafeMutableRawPointer?) -> Void
 public typealias CCompleteCallback = @convention(c) (UnsafePointer<CChar>?, Int64, UnsafeMutableRawPointer?) -> Void
 public typealias CErrorCallback = @convention(c) (Int32, UnsafePointer<CChar>?, UnsafeMutableRawPointer?) -> Void
+public typealias CXrunCallback = @convention(c) (Int32, Int64, UInt64, UnsafeMutableRawPointer?) -> Void
+public typealias CDiskPressureCallback = @convention(c) (Int32, UInt64, Double, UnsafePointer<CChar>?, UnsafeMutableRawPointer?) -> Void
 
 @_cdecl("AudioRecord_SetLevelCallback")
 public func AudioRecord_SetLevelCallback(
@@ -400,6 +702,53 @@ public func AudioRecord_SetErrorCallback(
     }
 }
 
+@_cdecl("AudioRecord_SetXrunCallback")
+public func AudioRecord_SetXrunCallback(
+    _ handle: UnsafeMutableRawPointer?,
+    _ callback: CXrunCallback?,
+    _ userData: UnsafeMutableRawPointer?
+) {
+    guard #available(macOS 14.4, *) else { return }
+    guard let instance = getInstance(handle) else { return }
+    
+    if let id = instance.xrunObserverID {
+        AudioRecordDiagnostics.removeXrunObserver(id)
+        instance.xrunObserverID = nil
+    }
+    if let callback = callback {
+        instance.xrunObserverID = AudioRecordDiagnostics.addXrunObserver { event in
+            callback(Int32(event.kind.rawValue), event.frames, event.hostTimeNanoseconds, userData)
+        }
+    }
+}
+
+@_cdecl("AudioRecord_SetDiskPressureCallback")
+public func AudioRecord_SetDiskPressureCallback(
+    _ handle: UnsafeMutableRawPointer?,
+    _ callback: CDiskPressureCallback?,
+    _ userData: UnsafeMutableRawPointer?
+) {
+    guard #available(macOS 14.4, *) else { return }
+    guard let instance = getInstance(handle) else { return }
+    
+    if let id = instance.diskObserverID {
+        AudioRecordDiagnostics.removeDiskPressureObserver(id)
+        instance.diskObserverID = nil
+    }
+    if let callback = callback {
+        instance.diskObserverID = AudioRecordDiagnostics.addDiskPressureObserver { event in
+            let freeBytes = UInt64(max(0, event.freeBytes))
+            if let spillPath = event.spillURL?.path {
+                spillPath.withCString { cPath in
+                    callback(Int32(event.level.rawValue), freeBytes, event.secondsRemaining, cPath, userData)
+                }
+            } else {
+                callback(Int32(event.level.rawValue), freeBytes, event.secondsRemaining, nil, userData)
+            }
+        }
+    }
+}
+
 // MARK: - 权限管理
 
 @_cdecl("AudioRecord_GetMicrophonePermission")
@@ -439,19 +788,144 @@ public func AudioRecord_GetScreenCapturePermission() -> Int32 {
 /// 进程列表句柄（内部存储）
 private var processListStorage = [OpaquePointer: [AudioProcessInfo]]()
 private let processListLock = NSLock()
-private let processEnumerator = AudioProcessEnumerator()
+/// 进程列表变化订阅（全局只有一个）
+private var processListObserverID: Int?
 
-/// 获取可录制音频的进程数量
+/// 获取可录制音频的进程数量（读取注册表缓存）
 @_cdecl("AudioRecord_GetAudioProcessCount")
 public func AudioRecord_GetAudioProcessCount() -> Int32 {
-    let processes = processEnumerator.getAvailableAudioProcesses()
-    return Int32(processes.count)
+    return Int32(AudioProcessRegistry.shared.count)
+}
+
+/// 检查进程是否可录制（按 PID 查缓存）
+@_cdecl("AudioRecord_IsAudioProcessAvailable")
+public func AudioRecord_IsAudioProcessAvailable(_ pid: Int32) -> Bool {
+    return AudioProcessRegistry.shared.process(pid: pid) != nil
+}
+
+public typealias CProcessListCallback = @convention(c) (Int32, Int32, UInt64, UnsafeMutableRawPointer?) -> Void
+
+/// 订阅进程列表变化（主线程回调，每个新增 / 移除的进程回调一次）
+@_cdecl("AudioRecord_SetProcessListCallback")
+public func AudioRecord_SetProcessListCallback(
+    _ callback: CProcessListCallback?,
+    _ userData: UnsafeMutableRawPointer?
+) {
+    processListLock.lock()
+    defer { processListLock.unlock() }
+    
+    if let id = processListObserverID {
+        AudioProcessRegistry.shared.removeObserver(id)
+        processListObserverID = nil
+    }
+    if let callback = callback {
+        processListObserverID = AudioProcessRegistry.shared.addObserver { change in
+            for process in change.added {
+                callback(0, process.pid, change.generation, userData) // Added
+            }
+            for process in change.removed {
+                callback(1, process.pid, change.generation, userData) // Removed
+            }
+        }
+    }
+}
+
+/// 与 AudioRecordSDK.h 中 AudioProcessInfo 的布局一致
+struct CAudioProcessInfo {
+    var pid: Int32
+    var name: UnsafePointer<CChar>?
+    var bundleID: UnsafePointer<CChar>?
+    var path: UnsafePointer<CChar>?
+}
+
+/// 与 AudioRecordSDK.h 中 AudioProcessList 的布局一致
+struct CAudioProcessList {
+    var processes: UnsafeMutablePointer<CAudioProcessInfo>?
+    var count: Int32
+    var removedCount: Int32
+    var removedPIDs: UnsafePointer<Int32>?
+    var generation: UInt64
+    var isFullList: Bool
+}
+
+/// 把进程列表打包到一块内存：[AudioProcessList][AudioProcessInfo × N][PID × M][字符串池]
+///
+/// 先计算总大小，一次 malloc，再顺序填充；调用方用一次 free 释放。
+func makePackedProcessList(
+    _ processes: [AudioProcessInfo],
+    removedPIDs: [pid_t],
+    generation: UInt64,
+    isFullList: Bool
+) -> UnsafeMutableRawPointer? {
+    let infoOffset = MemoryLayout<CAudioProcessList>.stride
+    let pidOffset = infoOffset + MemoryLayout<CAudioProcessInfo>.stride * processes.count
+    let stringOffset = pidOffset + MemoryLayout<Int32>.stride * removedPIDs.count
+    let stringBytes = processes.reduce(0) { $0 + $1.name.utf8.count + $1.bundleID.utf8.count + $1.path.utf8.count + 3 }
+    
+    guard let base = malloc(stringOffset + stringBytes) else { return nil }
+    let infos = (base + infoOffset).bindMemory(to: CAudioProcessInfo.self, capacity: processes.count)
+    let pids = (base + pidOffset).bindMemory(to: Int32.self, capacity: removedPIDs.count)
+    var cursor = (base + stringOffset).bindMemory(to: CChar.self, capacity: stringBytes)
+    
+    func pack(_ string: String) -> UnsafePointer<CChar> {
+        let start = cursor
+        var string = string
+        string.withUTF8 { bytes in
+            if let source = bytes.baseAddress {
+                UnsafeMutableRawPointer(start).copyMemory(from: source, byteCount: bytes.count)
+            }
+            start[bytes.count] = 0
+            cursor += bytes.count + 1
+        }
+        return UnsafePointer(start)
+    }
+    
+    for (index, process) in processes.enumerated() {
+        (infos + index).initialize(to: CAudioProcessInfo(
+            pid: process.pid,
+            name: pack(process.name),
+            bundleID: pack(process.bundleID),
+            path: pack(process.path)
+        ))
+    }
+    for (index, pid) in removedPIDs.enumerated() {
+        (pids + index).initialize(to: pid)
+    }
+    base.bindMemory(to: CAudioProcessList.self, capacity: 1).initialize(to: CAudioProcessList(
+        processes: processes.isEmpty ? nil : infos,
+        count: Int32(processes.count),
+        removedCount: Int32(removedPIDs.count),
+        removedPIDs: removedPIDs.isEmpty ? nil : UnsafePointer(pids),
+        generation: generation,
+        isFullList: isFullList
+    ))
+    return base
+}
+
+/// 一次性复制完整的进程列表（单次分配）
+@_cdecl("AudioRecord_CopyAudioProcessList")
+public func AudioRecord_CopyAudioProcessList() -> UnsafeMutableRawPointer? {
+    let delta = AudioProcessRegistry.shared.changes(since: 0)
+    return makePackedProcessList(delta.added, removedPIDs: [], generation: delta.generation, isFullList: true)
+}
+
+/// 复制自 sinceGeneration 之后的变化（单次分配）
+@_cdecl("AudioRecord_CopyAudioProcessChanges")
+public func AudioRecord_CopyAudioProcessChanges(_ sinceGeneration: UInt64) -> UnsafeMutableRawPointer? {
+    let delta = AudioProcessRegistry.shared.changes(since: sinceGeneration)
+    return makePackedProcessList(delta.added, removedPIDs: delta.removedPIDs, generation: delta.generation, isFullList: delta.isFullList)
+}
+
+/// 释放打包的进程列表
+@_cdecl("AudioRecord_FreeAudioProcessList")
+public func AudioRecord_FreeAudioProcessList(_ list: UnsafeMutableRawPointer?) {
+    free(list)
 }
 
 /// 获取进程列表句柄
 @_cdecl("AudioRecord_GetAudioProcesses")
 public func AudioRecord_GetAudioProcesses() -> OpaquePointer? {
-    let processes = processEnumerator.getAvailableAudioProcesses()
+    let processes = AudioProcessRegistry.shared.processes()
     
     // 创建一个唯一的句柄
     let handle = OpaquePointer(bitPattern: Int.random(in: 1..<Int.max))!
@@ -524,6 +998,284 @@ public func AudioRecord_FreeProcessList(_ handle: OpaquePointer?) {
     processListLock.unlock()
 }
 
+// MARK: - 进程电平监控
+
+@_cdecl("AudioRecord_StartProcessLevelMonitor")
+public func AudioRecord_StartProcessLevelMonitor(_ pids: UnsafePointer<Int32>?, _ count: Int32) -> Int32 {
+    guard #available(macOS 14.4, *) else {
+        return -8 // SystemVersionTooLow
+    }
+    guard pids == nil || count > 0 else {
+        return -9 // InvalidArgument
+    }
+    let requested = pids.map { Array(UnsafeBufferPointer(start: $0, count: Int(count))) }
+    do {
+        try ProcessLevelMonitor.shared.start(pids: requested)
+        return 0
+    } catch {
+        return -5 // DeviceError
+    }
+}
+
+@_cdecl("AudioRecord_StopProcessLevelMonitor")
+public func AudioRecord_StopProcessLevelMonitor() {
+    guard #available(macOS 14.4, *) else { return }
+    ProcessLevelMonitor.shared.stop()
+}
+
+/// 与 AudioRecordSDK.h 中 AudioProcessLevel 的布局一致
+private struct CAudioProcessLevel {
+    var pid: Int32
+    var peak: Float
+    var rms: Float
+}
+
+@_cdecl("AudioRecord_GetProcessLevels")
+public func AudioRecord_GetProcessLevels(_ levels: UnsafeMutableRawPointer?, _ capacity: Int32) -> Int32 {
+    guard #available(macOS 14.4, *) else { return 0 }
+    let snapshot = ProcessLevelMonitor.shared.snapshot()
+    if let levels = levels {
+        let output = levels.bindMemory(to: CAudioProcessLevel.self, capacity: Int(max(capacity, 0)))
+        for (index, level) in snapshot.prefix(Int(max(capacity, 0))).enumerated() {
+            output[index] = CAudioProcessLevel(pid: level.pid, peak: level.peak, rms: level.rms)
+        }
+    }
+    return Int32(snapshot.count)
+}
+
+// MARK: - 诊断
+
+@_cdecl("AudioRecord_GetRealtimeViolationCount")
+public func AudioRecord_GetRealtimeViolationCount() -> Int64 {
+    return Int64(AudioRecordDiagnostics.realtimeViolationCount)
+}
+
+@_cdecl("AudioRecord_ResetRealtimeViolations")
+public func AudioRecord_ResetRealtimeViolations() {
+    AudioRecordDiagnostics.resetRealtimeViolations()
+}
+
+@_cdecl("AudioRecord_GetStats")
+public func AudioRecord_GetStats(_ stats: UnsafeMutableRawPointer?) -> Int32 {
+    guard #available(macOS 14.4, *) else {
+        return -8 // SystemVersionTooLow
+    }
+    // 头部：version(u32) + size(u32) + blocks/frames/elapsedNs(u64)
+    let headerSize = 2 * MemoryLayout<UInt32>.size
+    guard let stats = stats else {
+        return -9 // InvalidArgument
+    }
+    let requestedSize = Int(stats.load(fromByteOffset: MemoryLayout<UInt32>.size, as: UInt32.self))
+    guard requestedSize >= headerSize + 3 * MemoryLayout<UInt64>.size else {
+        return -9 // InvalidArgument
+    }
+    
+    // 按 AudioRecordStats 的字段顺序展开为 u64 序列
+    let snapshot = PipelineStats.shared.snapshot()
+    var fields: [UInt64] = [UInt64(snapshot.blocks), UInt64(snapshot.frames), UInt64(snapshot.elapsedNanoseconds)]
+    for stage in snapshot.stages {
+        for summary in [stage.latency, stage.cpu] {
+            fields.append(contentsOf: [
+                UInt64(summary.count), UInt64(summary.mean.rounded()),
+                UInt64(summary.p50), UInt64(summary.p99), UInt64(summary.p999), UInt64(summary.max)
+            ])
+        }
+    }
+    
+    // 只写入调用方声明的大小，兼容旧版本结构体
+    let fieldBytes = fields.count * MemoryLayout<UInt64>.size
+    let written = min(requestedSize - headerSize, fieldBytes) / MemoryLayout<UInt64>.size * MemoryLayout<UInt64>.size
+    fields.withUnsafeBytes { bytes in
+        (stats + headerSize).copyMemory(from: bytes.baseAddress!, byteCount: written)
+    }
+    stats.storeBytes(of: PipelineStats.version, toByteOffset: 0, as: UInt32.self)
+    stats.storeBytes(of: UInt32(headerSize + written), toByteOffset: MemoryLayout<UInt32>.size, as: UInt32.self)
+    return 0
+}
+
+@_cdecl("AudioRecord_GetXrunCount")
+public func AudioRecord_GetXrunCount(_ handle: UnsafeMutableRawPointer?, _ kind: Int32) -> Int64 {
+    guard #available(macOS 14.4, *) else {
+        return -8 // SystemVersionTooLow
+    }
+    guard let instance = getInstance(handle) else {
+        return -1 // InvalidHandle
+    }
+    guard let kind = AudioRecordXrunKind(rawValue: Int(kind)) else {
+        return -9 // InvalidArgument
+    }
+    return instance.xruns?.count(of: kind.internalKind) ?? 0
+}
+
+@_cdecl("AudioRecord_GetXrunFrames")
+public func AudioRecord_GetXrunFrames(_ handle: UnsafeMutableRawPointer?, _ kind: Int32) -> Int64 {
+    guard #available(macOS 14.4, *) else {
+        return -8 // SystemVersionTooLow
+    }
+    guard let instance = getInstance(handle) else {
+        return -1 // InvalidHandle
+    }
+    guard let kind = AudioRecordXrunKind(rawValue: Int(kind)) else {
+        return -9 // InvalidArgument
+    }
+    return instance.xruns?.frames(of: kind.internalKind) ?? 0
+}
+
+@_cdecl("AudioRecord_ResetStats")
+public func AudioRecord_ResetStats() -> Int32 {
+    guard #available(macOS 14.4, *) else {
+        return -8 // SystemVersionTooLow
+    }
+    AudioRecordDiagnostics.resetStatistics()
+    return 0
+}
+
+@_cdecl("AudioRecord_SetTraceEnabled")
+public func AudioRecord_SetTraceEnabled(_ enabled: Bool) -> Int32 {
+    guard AudioRecordDiagnostics.isTracingAvailable else {
+        return -7 // UnsupportedMode
+    }
+    if enabled {
+        AudioRecordDiagnostics.startTracing()
+    } else {
+        AudioRecordDiagnostics.stopTracing()
+    }
+    return 0
+}
+
+@_cdecl("AudioRecord_DumpTrace")
+public func AudioRecord_DumpTrace(_ path: UnsafePointer<CChar>?) -> Int32 {
+    guard AudioRecordDiagnostics.isTracingAvailable else {
+        return -7 // UnsupportedMode
+    }
+    guard let path = path else {
+        return -9 // InvalidArgument
+    }
+    do {
+        try AudioRecordDiagnostics.dumpTrace(to: URL(fileURLWithPath: String(cString: path)))
+        return 0
+    } catch {
+        return -6 // FileError
+    }
+}
+
+@_cdecl("AudioRecord_StartCallbackCapture")
+public func AudioRecord_StartCallbackCapture(_ path: UnsafePointer<CChar>?, _ compressed: Bool) -> Int32 {
+    guard let path = path else {
+        return -9 // InvalidArgument
+    }
+    do {
+        try AudioRecordDiagnostics.startCallbackCapture(to: URL(fileURLWithPath: String(cString: path)), compressed: compressed)
+        return 0
+    } catch {
+        return -6 // FileError
+    }
+}
+
+@_cdecl("AudioRecord_StopCallbackCapture")
+public func AudioRecord_StopCallbackCapture() -> Int32 {
+    AudioRecordDiagnostics.stopCallbackCapture()
+    return 0
+}
+
+@_cdecl("AudioRecord_ReplayCallbackCapture")
+public func AudioRecord_ReplayCallbackCapture(_ path: UnsafePointer<CChar>?, _ realtime: Bool,
+                                              _ outputPath: UnsafePointer<CChar>?, _ result: UnsafeMutableRawPointer?) -> Int32 {
+    guard #available(macOS 14.4, *) else {
+        return -8 // SystemVersionTooLow
+    }
+    guard let path = path else {
+        return -9 // InvalidArgument
+    }
+    let replay: AudioRecordReplayResult
+    do {
+        replay = try AudioRecordDiagnostics.replayCallbackCapture(
+            from: URL(fileURLWithPath: String(cString: path)),
+            timing: realtime ? .original : .asFastAsPossible,
+            outputURL: outputPath.map { URL(fileURLWithPath: String(cString: $0)) }
+        )
+    } catch {
+        return -6 // FileError
+    }
+    if let result = result {
+        // 按 AudioRecordReplayResult 的字段顺序写入 u64
+        let fields: [UInt64] = [
+            UInt64(replay.callbacks), UInt64(replay.frames), replay.renderNanoseconds, replay.wallNanoseconds,
+            UInt64(replay.renderLatency.p50Nanoseconds), UInt64(replay.renderLatency.p99Nanoseconds),
+            replay.outputHash, UInt64(replay.xrunCounts.values.reduce(0, +))
+        ]
+        for (index, value) in fields.enumerated() {
+            result.storeBytes(of: value, toByteOffset: index * MemoryLayout<UInt64>.size, as: UInt64.self)
+        }
+    }
+    return 0
+}
+
+@_cdecl("AudioRecord_GetMemoryStats")
+public func AudioRecord_GetMemoryStats(_ handle: UnsafeMutableRawPointer?, _ stats: UnsafeMutableRawPointer?) -> Int32 {
+    guard #available(macOS 14.4, *) else {
+        return -8 // SystemVersionTooLow
+    }
+    guard getInstance(handle) != nil else {
+        return -1 // InvalidHandle
+    }
+    let headerSize = 2 * MemoryLayout<UInt32>.size
+    guard let stats = stats else {
+        return -9 // InvalidArgument
+    }
+    let requestedSize = Int(stats.load(fromByteOffset: MemoryLayout<UInt32>.size, as: UInt32.self))
+    guard requestedSize >= headerSize + MemoryLayout<UInt64>.size else {
+        return -9 // InvalidArgument
+    }
+    
+    // 按 AudioRecordMemoryStats 的字段顺序展开为 u64 序列
+    let memory = AudioRecordDiagnostics.memoryStatistics()
+    let sessionBytes = runOnMain { AudioRecordAPI.shared.sessionMemoryBytes }
+    var fields: [UInt64] = [
+        UInt64(max(memory.totalBytes, 0)), UInt64(max(memory.peakBytes, 0)), UInt64(memory.budgetBytes),
+        UInt64(memory.degradations), UInt64(max(sessionBytes, 0)), UInt64(memory.sessions.count)
+    ]
+    for tag in AudioRecordMemoryTag.allCases {
+        fields.append(UInt64(max(memory.tagBytes[tag] ?? 0, 0)))
+    }
+    
+    let fieldBytes = fields.count * MemoryLayout<UInt64>.size
+    let written = min(requestedSize - headerSize, fieldBytes) / MemoryLayout<UInt64>.size * MemoryLayout<UInt64>.size
+    fields.withUnsafeBytes { bytes in
+        (stats + headerSize).copyMemory(from: bytes.baseAddress!, byteCount: written)
+    }
+    stats.storeBytes(of: EngineMemory.version, toByteOffset: 0, as: UInt32.self)
+    stats.storeBytes(of: UInt32(headerSize + written), toByteOffset: MemoryLayout<UInt32>.size, as: UInt32.self)
+    return 0
+}
+
+@_cdecl("AudioRecord_SetMemoryBudget")
+public func AudioRecord_SetMemoryBudget(_ bytes: UInt64) -> Int32 {
+    AudioRecordDiagnostics.memoryBudgetBytes = Int64(clamping: bytes)
+    return 0
+}
+
+@_cdecl("AudioRecord_SetSessionMemoryBudget")
+public func AudioRecord_SetSessionMemoryBudget(_ bytes: UInt64) -> Int32 {
+    AudioRecordDiagnostics.sessionMemoryBudgetBytes = Int64(clamping: bytes)
+    return 0
+}
+
+@_cdecl("AudioRecord_SetDiskPressureThresholds")
+public func AudioRecord_SetDiskPressureThresholds(_ warningSeconds: UInt32, _ criticalSeconds: UInt32,
+                                                  _ preallocateBytes: UInt64, _ spill: Bool) -> Int32 {
+    guard criticalSeconds <= warningSeconds else {
+        return -9 // InvalidArgument
+    }
+    AudioRecordDiagnostics.diskPolicy = AudioRecordDiskPolicy(
+        warningSeconds: Double(warningSeconds),
+        criticalSeconds: Double(criticalSeconds),
+        preallocationBytes: Int64(clamping: preallocateBytes),
+        spillEnabled: spill
+    )
+    return 0
+}
+
 // MARK: - 工具函数
 
 @_cdecl("AudioRecord_GetErrorDescription")
@@ -539,6 +1291,7 @@ public func AudioRecord_GetErrorDescription(_ error: Int32) -> UnsafePointer<CCh
     case -6: description = "File error"
     case -7: description = "Unsupported mode"
     case -8: description = "System version too low"
+    case -9: description = "Invalid argument"
     default: description = "Unknown error"
     }
     return (description as NSString).utf8String
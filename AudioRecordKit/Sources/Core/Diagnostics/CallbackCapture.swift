@@ -0,0 +1,691 @@
+import Foundation
+import Darwin
+import CoreAudio
+import Compression
+
+// MARK: - CallbackCaptureRole
+/// 采集源在处理图中的角色（回放时据此重建相同的驱动方式）
+enum CallbackCaptureRole: UInt8 {
+    /// 回调直接载入推送源并驱动图渲染（Process Tap IO 回调）
+    case driver = 0
+    /// 异步生产者写入环形缓冲源（麦克风 Tap）
+    case ring = 1
+}
+
+// MARK: - CallbackCaptureDeclaration
+/// 采集源声明：回放时按声明重建与录制器相同形状的处理图
+struct CallbackCaptureDeclaration {
+    let id: UInt16
+    let role: CallbackCaptureRole
+    let name: String
+    /// 所属处理图的名称（Mixed / ProcessTap）
+    let graphName: String
+    let sampleRate: Double
+    /// 处理图输出声道数
+    let channels: Int
+    /// 采集端声道数（与 channels 不同时回放按标准布局上/下混，0 表示未知）
+    let inputChannels: Int
+    /// 混音增益
+    let gain: Float
+    /// 环形缓冲源的容量（帧），回放时按此重建；驱动源与旧版本文件为 0
+    let ringCapacityFrames: Int
+}
+
+// MARK: - CaptureByteRing
+/// 单生产者单消费者字节环形缓冲区
+///
+/// 生产者（IO 线程）先写入数据再推进写位置，消费者（drainQueue）读完后推进读位置。
+/// 位置单调递增，取模得到偏移，跨越末尾时分两段拷贝。
+final class CaptureByteRing {
+    
+    // MARK: - Properties
+    let capacity: Int
+    private let tag: MemoryTag
+    private let storage: UnsafeMutableRawPointer
+    private let writePosition = AtomicInt64()
+    private let readPosition = AtomicInt64()
+    
+    // MARK: - Initialization
+    
+    /// - Parameter tag: 记账类别（写入器队列等其他用途按各自类别记账）
+    init(capacity: Int, tag: MemoryTag = .capture) {
+        self.capacity = capacity
+        self.tag = tag
+        storage = EngineMemory.allocateRaw(byteCount: capacity, alignment: 16, tag: tag)
+    }
+    
+    deinit {
+        EngineMemory.deallocateRaw(storage, byteCount: capacity, tag: tag)
+    }
+    
+    // MARK: - Producer
+    
+    /// 可写入的字节数
+    var freeBytes: Int {
+        return capacity - Int(writePosition.value - readPosition.value)
+    }
+    
+    /// 写入位置 offset 字节之后（尚未发布）
+    func write(_ source: UnsafeRawPointer, count: Int, offset: Int) {
+        copy(into: true, source, count: count, position: writePosition.value + Int64(offset))
+    }
+    
+    /// 发布已写入的字节
+    func publish(_ count: Int) {
+        writePosition.store(writePosition.value + Int64(count))
+    }
+    
+    // MARK: - Consumer
+    
+    /// 已发布、可读取的字节数
+    var readableBytes: Int {
+        return Int(writePosition.value - readPosition.value)
+    }
+    
+    /// 读取位置 offset 字节之后的数据（不推进读位置）
+    func read(into destination: UnsafeMutableRawPointer, count: Int, offset: Int) {
+        copy(into: false, destination, count: count, position: readPosition.value + Int64(offset))
+    }
+    
+    func consume(_ count: Int) {
+        readPosition.store(readPosition.value + Int64(count))
+    }
+    
+    /// 丢弃全部内容并把位置归零（生产者与消费者都已停止时调用）
+    func reset() {
+        readPosition.store(0)
+        writePosition.store(0)
+    }
+    
+    // MARK: - Private
+    
+    private func copy(into ring: Bool, _ pointer: UnsafeRawPointer, count: Int, position: Int64) {
+        let start = Int(position % Int64(capacity))
+        let first = min(count, capacity - start)
+        let outside = UnsafeMutableRawPointer(mutating: pointer)
+        if ring {
+            (storage + start).copyMemory(from: pointer, byteCount: first)
+            if count > first {
+                storage.copyMemory(from: pointer + first, byteCount: count - first)
+            }
+        } else {
+            outside.copyMemory(from: storage + start, byteCount: first)
+            if count > first {
+                (outside + first).copyMemory(from: storage, byteCount: count - first)
+            }
+        }
+    }
+}
+
+// MARK: - CallbackBlockHeader
+/// 每个回调块的记录头（32 字节，后接 frames × channels 个非交错 Float32）
+struct CallbackBlockHeader {
+    var sequence: Int64
+    var hostTime: UInt64
+    var sampleTime: Double
+    var frames: UInt32
+    var channels: UInt16
+    var sourceID: UInt16
+    
+    static let size = 32
+    
+    var payloadBytes: Int {
+        return Int(frames) * Int(channels) * MemoryLayout<Float>.size
+    }
+}
+
+// MARK: - CallbackCaptureSource
+/// 单个采集源（一个回调线程独占写入）
+///
+/// 捕获关闭时 `capture` 只读一次原子标志；开启时把输入按声道拷贝为非交错 Float32，
+/// 连同时间戳写入本源的字节环形缓冲区（不加锁、不分配）。缓冲区写满或块超过
+/// 预分配的暂存区时丢弃该块并计数，回放时据此判断采集是否完整。
+///
+/// 开启时的捕获用 `inFlight` 计数包住，关闭开关后 `quiesce()` 等到计数归零，
+/// 此后环形缓冲区不再有写入，可以安全地取出剩余数据或归零。
+final class CallbackCaptureSource {
+    
+    // MARK: - Properties
+    let declaration: CallbackCaptureDeclaration
+    /// 因缓冲区已满或块过大而丢弃的块数
+    let droppedBlocks = AtomicInt64()
+    fileprivate let active = AtomicInt64()
+    /// 正在写入环形缓冲区的捕获数（0 或 1）
+    private let inFlight = AtomicInt64()
+    fileprivate private(set) var ring: CaptureByteRing?
+    private var scratch: UnsafeMutablePointer<Float>?
+    private let view = AudioBufferListView()
+    
+    /// 单块最多捕获的样本数（帧 × 声道）
+    static let maxSamplesPerBlock = 16384 * 8
+    
+    // MARK: - Initialization
+    
+    fileprivate init(declaration: CallbackCaptureDeclaration) {
+        self.declaration = declaration
+    }
+    
+    deinit {
+        if let scratch = scratch {
+            EngineMemory.deallocate(scratch, capacity: CallbackCaptureSource.maxSamplesPerBlock, tag: .capture)
+        }
+    }
+    
+    /// 首次开启时分配缓冲区（drainQueue 上调用，之后一直保留到源被释放）
+    ///
+    /// 再次开启时丢弃上一次采集残留的内容，新文件从空缓冲区开始。
+    fileprivate func activate(ringBytes: Int) {
+        quiesce()
+        if let ring = ring {
+            ring.reset()
+        } else {
+            ring = CaptureByteRing(capacity: ringBytes)
+            scratch = EngineMemory.allocate(Float.self, capacity: CallbackCaptureSource.maxSamplesPerBlock, tag: .capture)
+        }
+        active.store(1)
+    }
+    
+    /// 关闭捕获并等待进行中的写入完成（drainQueue 上调用）
+    fileprivate func quiesce() {
+        active.store(0)
+        while inFlight.value != 0 {
+            usleep(50)
+        }
+    }
+    
+    /// 进入写入区：先登记再复查开关，与 `quiesce()` 的先关开关再等计数配对
+    @inline(__always)
+    private func enter() -> Bool {
+        inFlight.increment()
+        if active.value != 0 {
+            return true
+        }
+        inFlight.decrement()
+        return false
+    }
+    
+    // MARK: - Capture (callback thread)
+    
+    /// 捕获 IO 回调的 AudioBufferList（交错或非交错 Float32）
+    @inline(__always)
+    func capture(bufferList: UnsafePointer<AudioBufferList>, frames: Int, hostTime: UInt64, sampleTime: Double) {
+        guard active.value != 0, enter() else { return }
+        defer { inFlight.decrement() }
+        guard let scratch = scratch, view.bind(bufferList) else { return }
+        let n = min(frames, view.frameCount)
+        let channels = view.channelCount
+        guard n > 0, channels > 0, n * channels <= CallbackCaptureSource.maxSamplesPerBlock else {
+            droppedBlocks.increment()
+            return
+        }
+        for c in 0..<channels {
+            var source = view.channel(c)
+            let stride = view.stride(c)
+            let destination = scratch + c * n
+            for i in 0..<n {
+                destination[i] = source.pointee
+                source = source.advanced(by: stride)
+            }
+        }
+        commit(frames: n, channels: channels, hostTime: hostTime, sampleTime: sampleTime)
+    }
+    
+    /// 捕获非交错声道指针（AVAudioPCMBuffer.floatChannelData）
+    @inline(__always)
+    func capture(channels pointers: UnsafePointer<UnsafeMutablePointer<Float>>, channelCount: Int, frames: Int,
+                 hostTime: UInt64, sampleTime: Double) {
+        guard active.value != 0, enter() else { return }
+        defer { inFlight.decrement() }
+        guard let scratch = scratch else { return }
+        guard frames > 0, channelCount > 0, frames * channelCount <= CallbackCaptureSource.maxSamplesPerBlock else {
+            droppedBlocks.increment()
+            return
+        }
+        for c in 0..<channelCount {
+            (scratch + c * frames).update(from: pointers[c], count: frames)
+        }
+        commit(frames: frames, channels: channelCount, hostTime: hostTime, sampleTime: sampleTime)
+    }
+    
+    private func commit(frames: Int, channels: Int, hostTime: UInt64, sampleTime: Double) {
+        guard let ring = ring, let scratch = scratch else { return }
+        var header = CallbackBlockHeader(
+            sequence: CallbackCapture.shared.nextSequence(),
+            hostTime: hostTime,
+            sampleTime: sampleTime,
+            frames: UInt32(frames),
+            channels: UInt16(channels),
+            sourceID: declaration.id
+        )
+        let total = CallbackBlockHeader.size + header.payloadBytes
+        guard ring.freeBytes >= total else {
+            droppedBlocks.increment()
+            return
+        }
+        withUnsafeBytes(of: &header) { ring.write($0.baseAddress!, count: CallbackBlockHeader.size, offset: 0) }
+        ring.write(scratch, count: header.payloadBytes, offset: CallbackBlockHeader.size)
+        ring.publish(total)
+    }
+}
+
+// MARK: - CallbackCapture
+/// 回调采集 - 把每个源回调的原始输入块与时间戳写入紧凑的采集文件，供确定性回放
+///
+/// 默认关闭；`start(url:compressed:)` 或环境变量 `AUDIORECORD_CAPTURE=<路径>` 开启
+/// （环境变量在第一个源登记时生效）。回调线程只写各源的预分配环形缓冲区，
+/// 后台队列定期取出、按全局序号排序后分块写入文件，可选 LZFSE 压缩。
+///
+/// 文件格式（小端）：
+/// - 头部 24 字节：魔数 `ARCB`、版本 UInt16、标志 UInt16（bit0 = LZFSE）、
+///   mach 时基 numer / denom（UInt32 × 2）、创建时间（Double，Unix 秒）
+/// - 之后是若干块：原始字节数 UInt32、存储字节数 UInt32、数据（两者相等时未压缩）
+/// - 块内为记录序列：类型 1 为源声明，类型 2 为回调块（`CallbackBlockHeader` + 非交错样本）
+/// - 版本 2 起源声明在增益之后带环形缓冲区容量（UInt32 帧），读取时兼容版本 1
+final class CallbackCapture {
+    
+    static let shared = CallbackCapture()
+    
+    static let environmentVariable = "AUDIORECORD_CAPTURE"
+    static let magic: [UInt8] = Array("ARCB".utf8)
+    static let version: UInt16 = 2
+    static let headerSize = 24
+    /// 每个源的环形缓冲区（立体声 48kHz 约 10 秒）
+    static let ringBytes = 4 * 1024 * 1024
+    /// 内存预算不足时环形缓冲区的下限（约 0.6 秒，后台每 100ms 取出一次）
+    static let minimumRingBytes = 256 * 1024
+    /// 累积到该大小后压缩并写出一块
+    static let chunkBytes = 1024 * 1024
+    private static let drainInterval: DispatchTimeInterval = .milliseconds(100)
+    
+    static let declarationRecord: UInt8 = 1
+    static let blockRecord: UInt8 = 2
+    
+    // MARK: - Properties
+    private let sequence = AtomicInt64()
+    private let enabled = AtomicInt64()
+    
+    // drainQueue 独占
+    private let drainQueue = DispatchQueue(label: "com.audiorecordkit.capture", qos: .utility)
+    private var timer: DispatchSourceTimer?
+    private var sources: [CallbackCaptureSource] = []
+    private var nextSourceID: UInt16 = 0
+    private var file: FileHandle?
+    private var fileURL: URL?
+    private var compressed = true
+    private var chunk = Data()
+    private var blocksWritten: Int64 = 0
+    private var rawBytes: Int64 = 0
+    private var storedBytes: Int64 = 0
+    private var environmentChecked = false
+    private let logger = Logger.shared
+    
+    // MARK: - Initialization
+    
+    private init() {}
+    
+    /// 是否正在采集
+    var isEnabled: Bool {
+        return enabled.value != 0
+    }
+    
+    fileprivate func nextSequence() -> Int64 {
+        return sequence.increment()
+    }
+    
+    // MARK: - Sources
+    
+    /// 登记一个采集源（在启动回调之前调用，不要在 IO 线程上调用）
+    /// - Parameter ringCapacityFrames: 环形缓冲源的容量（帧），驱动源传 0
+    func register(name: String, role: CallbackCaptureRole, graphName: String, sampleRate: Double,
+                  channels: Int, inputChannels: Int = 0, gain: Float = 1.0, ringCapacityFrames: Int = 0) -> CallbackCaptureSource {
+        let source: CallbackCaptureSource = drainQueue.sync {
+            let declaration = CallbackCaptureDeclaration(
+                id: nextSourceID, role: role, name: name, graphName: graphName,
+                sampleRate: sampleRate, channels: channels, inputChannels: inputChannels, gain: gain,
+                ringCapacityFrames: ringCapacityFrames
+            )
+            nextSourceID &+= 1
+            let source = CallbackCaptureSource(declaration: declaration)
+            sources.append(source)
+            if file != nil {
+                source.activate(ringBytes: grantedRingBytes(for: source))
+                appendDeclaration(declaration)
+            }
+            return source
+        }
+        startFromEnvironmentIfNeeded()
+        return source
+    }
+    
+    /// 按内存预算确定源的环形缓冲区大小（drainQueue 上调用）
+    private func grantedRingBytes(for source: CallbackCaptureSource) -> Int {
+        guard source.ring == nil else { return CallbackCapture.ringBytes }
+        return EngineMemory.grant(requested: CallbackCapture.ringBytes, minimum: CallbackCapture.minimumRingBytes,
+                                  tag: .capture, what: "回调采集[\(source.declaration.name)]")
+    }
+    
+    /// 注销采集源（在停止回调之后调用），先取出其剩余数据
+    func unregister(_ source: CallbackCaptureSource) {
+        drainQueue.sync {
+            source.quiesce()
+            drain()
+            sources.removeAll { $0 === source }
+        }
+    }
+    
+    private func startFromEnvironmentIfNeeded() {
+        let path: String? = drainQueue.sync {
+            guard !environmentChecked else { return nil }
+            environmentChecked = true
+            return ProcessInfo.processInfo.environment[CallbackCapture.environmentVariable]
+        }
+        guard let path = path, !path.isEmpty, !isEnabled else { return }
+        do {
+            try start(url: URL(fileURLWithPath: path), compressed: true)
+        } catch {
+            logger.error("❌ CallbackCapture: 无法开始采集 \(path): \(error.localizedDescription)")
+        }
+    }
+    
+    // MARK: - Control
+    
+    /// 创建采集文件并开始记录所有已登记与之后登记的源
+    func start(url: URL, compressed: Bool = true) throws {
+        try drainQueue.sync {
+            // 重新开始时先停止之前的采集，各源在 activate 中归零
+            enabled.store(0)
+            sources.forEach { $0.quiesce() }
+            closeFile()
+            guard FileManager.default.createFile(atPath: url.path, contents: nil) else {
+                throw NSError(domain: "CallbackCapture", code: -1,
+                              userInfo: [NSLocalizedDescriptionKey: "无法创建采集文件: \(url.path)"])
+            }
+            let handle = try FileHandle(forWritingTo: url)
+            var timebase = mach_timebase_info_data_t()
+            mach_timebase_info(&timebase)
+            var header = Data(CallbackCapture.magic)
+            header.appendLittleEndian(CallbackCapture.version)
+            header.appendLittleEndian(UInt16(compressed ? 1 : 0))
+            header.appendLittleEndian(timebase.numer)
+            header.appendLittleEndian(timebase.denom)
+            header.appendLittleEndian(Date().timeIntervalSince1970.bitPattern)
+            try handle.write(contentsOf: header)
+            
+            file = handle
+            fileURL = url
+            self.compressed = compressed
+            chunk.removeAll(keepingCapacity: true)
+            blocksWritten = 0
+            rawBytes = 0
+            storedBytes = 0
+            for source in sources {
+                source.droppedBlocks.store(0)
+                source.activate(ringBytes: grantedRingBytes(for: source))
+                appendDeclaration(source.declaration)
+            }
+            startTimerIfNeeded()
+            enabled.store(1)
+            logger.info("🎙️ CallbackCapture: 开始采集回调到 \(url.lastPathComponent)\(compressed ? "（LZFSE）" : "")")
+        }
+    }
+    
+    /// 停止采集：取出剩余数据、写出最后一块并关闭文件
+    func stop() {
+        drainQueue.sync {
+            guard file != nil else { return }
+            // 先等回调线程上进行中的写入完成，再取出剩余数据
+            enabled.store(0)
+            sources.forEach { $0.quiesce() }
+            drain()
+            flushChunk()
+            let dropped = sources.reduce(Int64(0)) { $0 + $1.droppedBlocks.value }
+            let ratio = rawBytes > 0 ? Double(storedBytes) / Double(rawBytes) : 1
+            logger.info("🎙️ CallbackCapture: 采集结束，\(blocksWritten) 块，\(storedBytes) 字节（压缩比 \(String(format: "%.2f", ratio))）")
+            if dropped > 0 {
+                logger.warning("⚠️ CallbackCapture: 采集期间丢弃 \(dropped) 块，回放不完整")
+            }
+            closeFile()
+        }
+    }
+    
+    // MARK: - Draining
+    
+    private func startTimerIfNeeded() {
+        guard timer == nil else { return }
+        let source = DispatchSource.makeTimerSource(queue: drainQueue)
+        source.schedule(deadline: .now() + CallbackCapture.drainInterval, repeating: CallbackCapture.drainInterval)
+        source.setEventHandler { [weak self] in
+            self?.drain()
+        }
+        source.resume()
+        timer = source
+    }
+    
+    /// 取出各源已发布的块，按全局序号合并后追加到当前块（drainQueue 上调用）
+    ///
+    /// 不同线程上几乎同时开始的回调可能跨两次取出而顺序互换，其余按回调开始的先后排列。
+    private func drain() {
+        guard file != nil else { return }
+        var records: [(sequence: Int64, data: Data)] = []
+        var header = CallbackBlockHeader(sequence: 0, hostTime: 0, sampleTime: 0, frames: 0, channels: 0, sourceID: 0)
+        for source in sources {
+            guard let ring = source.ring else { continue }
+            while ring.readableBytes >= CallbackBlockHeader.size {
+                withUnsafeMutableBytes(of: &header) { ring.read(into: $0.baseAddress!, count: CallbackBlockHeader.size, offset: 0) }
+                let total = CallbackBlockHeader.size + header.payloadBytes
+                var record = Data(count: total + 1)
+                record[0] = CallbackCapture.blockRecord
+                record.withUnsafeMutableBytes { ring.read(into: $0.baseAddress! + 1, count: total, offset: 0) }
+                ring.consume(total)
+                records.append((header.sequence, record))
+            }
+        }
+        for record in records.sorted(by: { $0.sequence < $1.sequence }) {
+            chunk.append(record.data)
+            blocksWritten += 1
+            if chunk.count >= CallbackCapture.chunkBytes {
+                flushChunk()
+            }
+        }
+    }
+    
+    private func appendDeclaration(_ declaration: CallbackCaptureDeclaration) {
+        chunk.append(CallbackCapture.declarationRecord)
+        chunk.appendLittleEndian(declaration.id)
+        chunk.append(declaration.role.rawValue)
+        chunk.appendLittleEndian(declaration.sampleRate.bitPattern)
+        chunk.appendLittleEndian(UInt16(declaration.channels))
+        chunk.appendLittleEndian(UInt16(declaration.inputChannels))
+        chunk.appendLittleEndian(declaration.gain.bitPattern)
+        chunk.appendLittleEndian(UInt32(declaration.ringCapacityFrames))
+        for text in [declaration.name, declaration.graphName] {
+            let bytes = Array(text.utf8)
+            chunk.appendLittleEndian(UInt16(bytes.count))
+            chunk.append(contentsOf: bytes)
+        }
+    }
+    
+    /// 写出当前块（按需压缩，压缩无收益时原样存储）
+    private func flushChunk() {
+        guard let file = file, !chunk.isEmpty else { return }
+        var stored = chunk
+        if compressed {
+            let capacity = chunk.count + 4096
+            var encoded = Data(count: capacity)
+            let size = chunk.withUnsafeBytes { source in
+                encoded.withUnsafeMutableBytes { destination in
+                    compression_encode_buffer(destination.bindMemory(to: UInt8.self).baseAddress!, capacity,
+                                              source.bindMemory(to: UInt8.self).baseAddress!, chunk.count,
+                                              nil, COMPRESSION_LZFSE)
+                }
+            }
+            if size > 0 && size < chunk.count {
+                stored = encoded.prefix(size)
+            }
+        }
+        var frame = Data()
+        frame.appendLittleEndian(UInt32(chunk.count))
+        frame.appendLittleEndian(UInt32(stored.count))
+        frame.append(stored)
+        do {
+            try file.write(contentsOf: frame)
+        } catch {
+            logger.error("❌ CallbackCapture: 写入采集文件失败: \(error.localizedDescription)")
+        }
+        rawBytes += Int64(chunk.count)
+        storedBytes += Int64(stored.count)
+        chunk.removeAll(keepingCapacity: true)
+    }
+    
+    private func closeFile() {
+        try? file?.close()
+        file = nil
+        fileURL = nil
+    }
+}
+
+// MARK: - CallbackTrace
+/// 读取采集文件（回放时一次性载入内存）
+struct CallbackTrace {
+    
+    /// 回调块（样本为非交错 Float32）
+    struct Block {
+        let sourceID: UInt16
+        let sequence: Int64
+        /// 采集时刻（采集机器的纳秒）
+        let hostTimeNanoseconds: UInt64
+        let sampleTime: Double
+        let frames: Int
+        let channels: Int
+        let samples: [Float]
+    }
+    
+    let declarations: [CallbackCaptureDeclaration]
+    let blocks: [Block]
+    let created: Date
+    let compressed: Bool
+    
+    init(url: URL) throws {
+        let data = try Data(contentsOf: url, options: .mappedIfSafe)
+        var reader = LittleEndianReader(data: data)
+        guard data.count >= CallbackCapture.headerSize,
+              Array(data.prefix(4)) == CallbackCapture.magic else {
+            throw CallbackTrace.error(-1, "不是回调采集文件")
+        }
+        reader.offset = 4
+        let version: UInt16 = try reader.read()
+        guard version >= 1 && version <= CallbackCapture.version else {
+            throw CallbackTrace.error(-2, "不支持的采集文件版本 \(version)")
+        }
+        let flags: UInt16 = try reader.read()
+        let numer: UInt32 = try reader.read()
+        let denom: UInt32 = try reader.read()
+        let created: UInt64 = try reader.read()
+        self.compressed = flags & 1 != 0
+        self.created = Date(timeIntervalSince1970: Double(bitPattern: created))
+        
+        var declarations: [CallbackCaptureDeclaration] = []
+        var blocks: [Block] = []
+        while reader.remaining > 0 {
+            let rawSize = Int(try reader.read() as UInt32)
+            let storedSize = Int(try reader.read() as UInt32)
+            let stored = try reader.bytes(storedSize)
+            let chunk = rawSize == storedSize ? stored : try CallbackTrace.decompress(stored, rawSize: rawSize)
+            var records = LittleEndianReader(data: chunk)
+            while records.remaining > 0 {
+                let type: UInt8 = try records.read()
+                switch type {
+                case CallbackCapture.declarationRecord:
+                    let id: UInt16 = try records.read()
+                    let roleValue: UInt8 = try records.read()
+                    let sampleRate = Double(bitPattern: try records.read())
+                    let channels = Int(try records.read() as UInt16)
+                    let inputChannels = Int(try records.read() as UInt16)
+                    let gain = Float(bitPattern: try records.read())
+                    let ringCapacityFrames = version >= 2 ? Int(try records.read() as UInt32) : 0
+                    let name = try records.string()
+                    let graphName = try records.string()
+                    declarations.append(CallbackCaptureDeclaration(
+                        id: id, role: CallbackCaptureRole(rawValue: roleValue) ?? .driver, name: name, graphName: graphName,
+                        sampleRate: sampleRate, channels: channels, inputChannels: inputChannels, gain: gain,
+                        ringCapacityFrames: ringCapacityFrames
+                    ))
+                case CallbackCapture.blockRecord:
+                    let sequence: Int64 = try records.read()
+                    let hostTime: UInt64 = try records.read()
+                    let sampleTime = Double(bitPattern: try records.read())
+                    let frames = Int(try records.read() as UInt32)
+                    let channels = Int(try records.read() as UInt16)
+                    let sourceID: UInt16 = try records.read()
+                    let payload = try records.bytes(frames * channels * MemoryLayout<Float>.size)
+                    let samples = payload.withUnsafeBytes { Array($0.bindMemory(to: Float.self)) }
+                    blocks.append(Block(
+                        sourceID: sourceID, sequence: sequence,
+                        hostTimeNanoseconds: hostTime &* UInt64(numer) / UInt64(max(denom, 1)),
+                        sampleTime: sampleTime, frames: frames, channels: channels, samples: samples
+                    ))
+                default:
+                    throw CallbackTrace.error(-3, "未知记录类型 \(type)")
+                }
+            }
+        }
+        self.declarations = declarations
+        self.blocks = blocks
+    }
+    
+    private static func decompress(_ data: Data, rawSize: Int) throws -> Data {
+        var decoded = Data(count: rawSize)
+        let size = data.withUnsafeBytes { source in
+            decoded.withUnsafeMutableBytes { destination in
+                compression_decode_buffer(destination.bindMemory(to: UInt8.self).baseAddress!, rawSize,
+                                          source.bindMemory(to: UInt8.self).baseAddress!, data.count,
+                                          nil, COMPRESSION_LZFSE)
+            }
+        }
+        guard size == rawSize else {
+            throw CallbackTrace.error(-4, "数据块解压失败")
+        }
+        return decoded
+    }
+    
+    static func error(_ code: Int, _ message: String) -> NSError {
+        return NSError(domain: "CallbackTrace", code: code, userInfo: [NSLocalizedDescriptionKey: message])
+    }
+}
+
+// MARK: - LittleEndianReader
+private struct LittleEndianReader {
+    let data: Data
+    var offset = 0
+    
+    var remaining: Int {
+        return data.count - offset
+    }
+    
+    mutating func read<T: FixedWidthInteger>() throws -> T {
+        let size = MemoryLayout<T>.size
+        guard remaining >= size else { throw CallbackTrace.error(-5, "采集文件被截断") }
+        let value = data.withUnsafeBytes { $0.loadUnaligned(fromByteOffset: offset, as: T.self) }
+        offset += size
+        return T(littleEndian: value)
+    }
+    
+    mutating func bytes(_ count: Int) throws -> Data {
+        guard count >= 0, remaining >= count else { throw CallbackTrace.error(-5, "采集文件被截断") }
+        let start = data.startIndex + offset
+        offset += count
+        return data.subdata(in: start..<(start + count))
+    }
+    
+    mutating func string() throws -> String {
+        let length = Int(try read() as UInt16)
+        return String(decoding: try bytes(length), as: UTF8.self)
+    }
+}
+
+private extension Data {
+    mutating func appendLittleEndian<T: FixedWidthInteger>(_ value: T) {
+        var little = value.littleEndian
+        Swift.withUnsafeBytes(of: &little) { append(contentsOf: $0) }
+    }
+}
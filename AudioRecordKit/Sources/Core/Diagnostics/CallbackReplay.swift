@@ -0,0 +1,245 @@
+import Foundation
+import Darwin
+import CoreAudio
+
+// MARK: - CallbackReplayTiming
+@_spi(Benchmarks) public enum CallbackReplayTiming {
+    /// 按采集时的回调间隔等待（复现现场的时序与断流）
+    case original
+    /// 不等待，尽可能快地回放（回归测试与性能比较）
+    case asFastAsPossible
+}
+
+// MARK: - CallbackReplayResult
+@_spi(Benchmarks) public struct CallbackReplayResult {
+    /// 回放的回调块数（含环形缓冲源的写入）
+    public let callbacks: Int
+    /// 驱动源渲染的帧数
+    public let frames: Int64
+    public let sampleRate: Double
+    /// 渲染总耗时（不含等待）
+    public let renderNanoseconds: UInt64
+    /// 回放墙钟耗时（含等待）
+    public let wallNanoseconds: UInt64
+    /// 每次渲染的耗时分布
+    public let renderLatency: HistogramSummary
+    /// 处理图最终输出的 FNV-1a 哈希（逐样本位模式），相同输入、相同代码下必须一致
+    public let outputHash: UInt64
+    /// 回放期间的断流 / 溢出次数
+    public let xruns: [XrunKind: Int64]
+    
+    /// 实时倍数（渲染耗时相对音频时长）
+    public var realtimeFactor: Double {
+        guard renderNanoseconds > 0 else { return 0 }
+        return Double(frames) / sampleRate * 1e9 / Double(renderNanoseconds)
+    }
+}
+
+// MARK: - CallbackReplay
+/// 回调回放后端 - 把采集文件中的回调块按原顺序送回引擎
+///
+/// 按源声明重建与录制器相同形状的处理图：
+/// - 只有驱动源：推送源 → 电平 / 写入（ProcessTap）
+/// - 另有环形缓冲源：推送源 + 环形缓冲源 → 自动增益 → 混音（声明中的增益）→ 限幅 → 电平 / 写入（Mixed）
+///
+/// 驱动源的块像 IO 回调一样载入并渲染一个量子，环形缓冲源的块写入环形缓冲区，
+/// 所有块在同一线程上按采集序号执行，因此输出与断流计数是确定的。
+/// 旁路节点对最终输出做逐样本哈希，用于逐位比较回归。
+@_spi(Benchmarks) public final class CallbackReplay {
+    
+    // MARK: - Properties
+    let trace: CallbackTrace
+    private let logger = Logger.shared
+    
+    // MARK: - Initialization
+    
+    public init(url: URL) throws {
+        trace = try CallbackTrace(url: url)
+        guard trace.declarations.contains(where: { $0.role == .driver }) else {
+            throw CallbackTrace.error(-10, "采集文件中没有驱动源")
+        }
+    }
+    
+    // MARK: - Replay
+    
+    /// 回放一次
+    /// - Parameters:
+    ///   - timing: 按原时序或尽可能快
+    ///   - outputURL: 同时写出 Float32 WAV（nil 表示不写文件）
+    @available(macOS 14.4, *)
+    public func run(timing: CallbackReplayTiming, outputURL: URL? = nil) throws -> CallbackReplayResult {
+        let driverDeclarations = trace.declarations.filter { $0.role == .driver }
+        let driver = driverDeclarations[0]
+        if driverDeclarations.count > 1 {
+            logger.warning("⚠️ CallbackReplay: 采集文件含 \(driverDeclarations.count) 个驱动源，只回放 \(driver.name)")
+        }
+        let rings = trace.declarations.filter { $0.role == .ring && $0.graphName == driver.graphName }
+        let channels = max(driver.channels, 1)
+        let sampleRate = driver.sampleRate
+        let maxFrames = max(trace.blocks.filter { $0.sourceID == driver.id }.map { $0.frames }.max() ?? 0, 1)
+        
+        // 每次回放独立计数断流，不转报进程级监测，也不影响正在进行的录制
+        let monitor = XrunMonitor(name: "replay", parent: nil)
+        
+        // 处理图
+        let graph = AudioGraph(name: "Replay-\(driver.graphName)", sampleRate: sampleRate, maxFramesPerQuantum: maxFrames, workerCount: 0,
+                               xruns: monitor)
+        let source = graph.add(PushSourceNode(name: driver.name, channels: channels, maxFrames: maxFrames, sampleRate: sampleRate))
+        if driver.inputChannels > 0 && driver.inputChannels != channels {
+            source.configureInput(layout: ChannelLayout(channelCount: driver.inputChannels))
+        }
+        var ringNodes: [UInt16: RingBufferSourceNode] = [:]
+        var last: AudioNode = source
+        if !rings.isEmpty {
+            let mixer = graph.add(MixerNode(name: "mixer", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate))
+            try graph.connect(source, to: mixer)
+            mixer.setGain(driver.gain, forInput: 0)
+            for (index, declaration) in rings.enumerated() {
+                // 按采集时的容量重建，环形缓冲区溢出 / 欠载与现场一致（旧版本文件没有记录容量，按录制器默认的 2 秒）
+                let capacity = declaration.ringCapacityFrames > 0 ? declaration.ringCapacityFrames : Int(sampleRate) * 2
+                let node = graph.add(RingBufferSourceNode(name: declaration.name, channels: channels, maxFrames: maxFrames, sampleRate: sampleRate,
+                                                          capacityFrames: capacity))
+                let agc = graph.add(AGCNode(name: "agc-\(declaration.name)", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate))
+                try graph.connect(node, to: agc)
+                try graph.connect(agc, to: mixer)
+                mixer.setGain(declaration.gain, forInput: index + 1)
+                ringNodes[declaration.id] = node
+            }
+            let limiter = graph.add(LimiterNode(name: "limiter", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate))
+            try graph.connect(mixer, to: limiter)
+            last = limiter
+        }
+        let meter = graph.add(MeterNode(name: "meter", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate, scale: .decibel(floorDB: 96)))
+        try graph.connect(last, to: meter)
+        
+        var hash: UInt64 = 0xcbf2_9ce4_8422_2325
+        let hasher = graph.add(TapNode(name: "hash", sampleRate: sampleRate) { block, context in
+            let n = min(block.frameCount, context.frameCount)
+            for c in 0..<block.channelCount {
+                let samples = block.channel(c)
+                for i in 0..<n {
+                    hash = (hash ^ UInt64(samples[i].bitPattern)) &* 0x0000_0100_0000_01b3
+                }
+            }
+        })
+        try graph.connect(last, to: hasher)
+        
+        var fileManager: AudioToolboxFileManager?
+        if let outputURL = outputURL {
+            let format = CallbackReplay.fileFormat(channels: channels, sampleRate: sampleRate)
+            let manager = AudioToolboxFileManager(audioFormat: format, xruns: monitor)
+            let pipeline = CapturePipelineFactory.make(CapturePipelineConfiguration(mode: rings.isEmpty ? .systemAudio : .mixed, fileFormat: format))
+            let writer = graph.add(FileWriterNode(name: "writer", fileManager: manager, pipeline: pipeline, maxFrames: maxFrames, sampleRate: sampleRate))
+            try graph.connect(last, to: writer)
+            fileManager = manager
+        }
+        try graph.compile()
+        if let outputURL = outputURL {
+            try fileManager?.createAudioFile(at: outputURL)
+        }
+        defer {
+            graph.shutdown()
+            fileManager?.closeFile()
+        }
+        
+        // 驱动源的块以非交错 AudioBufferList 载入，与 IO 回调相同的路径
+        let maxChannels = max(trace.blocks.map { $0.channels }.max() ?? 1, 1)
+        let bufferList = AudioBufferList.allocate(maximumBuffers: maxChannels)
+        let ringPointers = UnsafeMutablePointer<UnsafeMutablePointer<Float>>.allocate(capacity: maxChannels)
+        defer {
+            free(bufferList.unsafeMutablePointer)
+            ringPointers.deallocate()
+        }
+        
+        var timeline = CaptureTimeline()
+        let histogram = LatencyHistogram()
+        var frames: Int64 = 0
+        var renderNanoseconds: UInt64 = 0
+        let firstHost = trace.blocks.first?.hostTimeNanoseconds ?? 0
+        let base = mach_absolute_time()
+        
+        logger.info("▶️ CallbackReplay: 回放 \(trace.blocks.count) 块（\(timing == .original ? "原时序" : "全速")），源: \(trace.declarations.map { $0.name }.joined(separator: ", "))")
+        
+        for block in trace.blocks {
+            let offset = block.hostTimeNanoseconds > firstHost ? block.hostTimeNanoseconds - firstHost : 0
+            let hostTime = base + PipelineStats.hostTicks(fromNanoseconds: offset)
+            if timing == .original {
+                mach_wait_until(hostTime)
+            }
+            
+            try block.samples.withUnsafeBufferPointer { samples in
+                let pointer = UnsafeMutablePointer(mutating: samples.baseAddress!)
+                if let ring = ringNodes[block.sourceID] {
+                    for c in 0..<block.channels {
+                        ringPointers[c] = pointer + c * block.frames
+                    }
+                    ring.write(channels: ringPointers, channelCount: block.channels, frames: block.frames)
+                    return
+                }
+                guard block.sourceID == driver.id else { return }
+                guard block.frames <= maxFrames else {
+                    throw CallbackTrace.error(-11, "回调块超过处理图量子")
+                }
+                
+                if let gap = timeline.advance(sampleTime: block.sampleTime, hostTime: hostTime, frames: block.frames, sampleRate: sampleRate) {
+                    monitor.report(.discontinuity, origin: "replay", frames: gap)
+                }
+                let buffers = UnsafeMutableAudioBufferListPointer(bufferList.unsafeMutablePointer)
+                buffers.count = block.channels
+                for c in 0..<block.channels {
+                    buffers[c] = AudioBuffer(mNumberChannels: 1, mDataByteSize: UInt32(block.frames * MemoryLayout<Float>.size),
+                                             mData: UnsafeMutableRawPointer(pointer + c * block.frames))
+                }
+                
+                let begin = mach_absolute_time()
+                source.load(bufferList: bufferList.unsafePointer, frames: block.frames)
+                graph.render(frameCount: block.frames, hostTime: hostTime)
+                let elapsed = PipelineStats.nanoseconds(fromHostTicks: mach_absolute_time() - begin)
+                histogram.record(Int64(elapsed))
+                renderNanoseconds += elapsed
+                frames += Int64(block.frames)
+                
+                // 原时序下渲染超过块时长与 IO 回调一样计为溢出
+                let budget = UInt64(Double(block.frames) / sampleRate * 1e9)
+                if timing == .original && elapsed > budget {
+                    monitor.report(.callbackOverrun, origin: "replay",
+                                              frames: Int64((Double(elapsed - budget) / 1e9 * sampleRate).rounded(.up)))
+                }
+            }
+        }
+        
+        let wallNanoseconds = PipelineStats.nanoseconds(fromHostTicks: mach_absolute_time() - base)
+        var xruns: [XrunKind: Int64] = [:]
+        for kind in XrunKind.allCases {
+            xruns[kind] = monitor.count(of: kind)
+        }
+        let result = CallbackReplayResult(
+            callbacks: trace.blocks.count,
+            frames: frames,
+            sampleRate: sampleRate,
+            renderNanoseconds: renderNanoseconds,
+            wallNanoseconds: wallNanoseconds,
+            renderLatency: histogram.summary(),
+            outputHash: hash,
+            xruns: xruns
+        )
+        logger.info("✅ CallbackReplay: \(frames) 帧，\(String(format: "%.1f", result.realtimeFactor))x 实时，输出哈希 \(String(format: "%016llx", hash))")
+        return result
+    }
+    
+    /// 回放输出文件格式：交错 Float32，不引入量化
+    private static func fileFormat(channels: Int, sampleRate: Double) -> AudioStreamBasicDescription {
+        let bytesPerFrame = UInt32(channels * MemoryLayout<Float>.size)
+        return AudioStreamBasicDescription(
+            mSampleRate: sampleRate,
+            mFormatID: kAudioFormatLinearPCM,
+            mFormatFlags: kAudioFormatFlagIsFloat | kAudioFormatFlagIsPacked,
+            mBytesPerPacket: bytesPerFrame,
+            mFramesPerPacket: 1,
+            mBytesPerFrame: bytesPerFrame,
+            mChannelsPerFrame: UInt32(channels),
+            mBitsPerChannel: 32,
+            mReserved: 0
+        )
+    }
+}
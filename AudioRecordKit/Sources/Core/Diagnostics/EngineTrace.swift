@@ -0,0 +1,409 @@
+import Foundation
+import Darwin
+
+// MARK: - TraceName
+/// 追踪事件名称（驻留为整数 ID，事件记录中只保存 ID）
+///
+/// 创建时加锁登记，应在初始化阶段创建（例如 `static let` 或图编译时），
+/// 不要在 IO 线程上新建。
+struct TraceName {
+    let id: Int32
+    
+    init(_ name: String, category: String = "engine") {
+        #if AUDIORECORD_NO_TRACE
+        id = 0
+        #else
+        id = EngineTrace.intern(name, category: category)
+        #endif
+    }
+}
+
+// MARK: - TraceSpan
+/// 进行中的区间事件（追踪关闭时为空操作）
+struct TraceSpan {
+    fileprivate let name: Int32
+    fileprivate let start: UInt64
+    
+    /// 结束区间并记录为一个完整事件
+    @inline(__always)
+    func end() {
+        #if !AUDIORECORD_NO_TRACE
+        guard start != 0 else { return }
+        EngineTrace.append(name: name, phase: .complete, start: start, duration: mach_absolute_time() &- start, value: 0)
+        #endif
+    }
+}
+
+// MARK: - TracePhase
+@_spi(Benchmarks) public enum TracePhase: UInt8 {
+    /// 区间（起点 + 时长）
+    case complete = 0
+    /// 瞬时事件
+    case instant = 1
+    /// 计数器
+    case counter = 2
+}
+
+// MARK: - TraceThreadBuffer
+/// 单个线程的事件环形缓冲区
+///
+/// 只有所属线程写入（单生产者），写满后覆盖最早的事件；导出时按写位置读取最近的事件。
+/// 线程退出后缓冲区回到空闲列表，事件保留到被另一个线程领取为止。
+final class TraceThreadBuffer {
+    
+    // MARK: - Properties
+    let capacity: Int
+    /// 当前持有缓冲区的线程号（0 表示空闲）
+    let owner = AtomicInt64()
+    /// 最近一个持有线程的线程号与名称（导出时使用）
+    private let lastThreadID = AtomicInt64()
+    private let threadNameBytes: UnsafeMutablePointer<CChar>
+    private static let threadNameCapacity = 64
+    
+    let names: UnsafeMutablePointer<Int32>
+    let phases: UnsafeMutablePointer<TracePhase>
+    let starts: UnsafeMutablePointer<UInt64>
+    let durations: UnsafeMutablePointer<UInt64>
+    let values: UnsafeMutablePointer<Int64>
+    /// 已写入的事件总数（单调递增）
+    let written = AtomicInt64()
+    
+    // MARK: - Initialization
+    
+    init(capacity: Int) {
+        self.capacity = capacity
+        threadNameBytes = EngineMemory.allocate(CChar.self, capacity: TraceThreadBuffer.threadNameCapacity, tag: .trace)
+        threadNameBytes.initialize(repeating: 0, count: TraceThreadBuffer.threadNameCapacity)
+        names = EngineMemory.allocate(Int32.self, capacity: capacity, tag: .trace)
+        phases = EngineMemory.allocate(TracePhase.self, capacity: capacity, tag: .trace)
+        starts = EngineMemory.allocate(UInt64.self, capacity: capacity, tag: .trace)
+        durations = EngineMemory.allocate(UInt64.self, capacity: capacity, tag: .trace)
+        values = EngineMemory.allocate(Int64.self, capacity: capacity, tag: .trace)
+    }
+    
+    deinit {
+        EngineMemory.deallocate(threadNameBytes, capacity: TraceThreadBuffer.threadNameCapacity, tag: .trace)
+        EngineMemory.deallocate(names, capacity: capacity, tag: .trace)
+        EngineMemory.deallocate(phases, capacity: capacity, tag: .trace)
+        EngineMemory.deallocate(starts, capacity: capacity, tag: .trace)
+        EngineMemory.deallocate(durations, capacity: capacity, tag: .trace)
+        EngineMemory.deallocate(values, capacity: capacity, tag: .trace)
+    }
+    
+    // MARK: - Ownership
+    
+    /// 由当前线程领取（不加锁、不分配）
+    /// - Returns: 缓冲区已被其他线程持有时为 false
+    func claim(threadID: UInt64) -> Bool {
+        guard owner.compareExchange(expected: 0, desired: Int64(bitPattern: threadID)) else { return false }
+        // 丢弃上一个线程的事件，避免导出时混在新线程名下
+        written.store(0)
+        lastThreadID.store(Int64(bitPattern: threadID))
+        pthread_getname_np(pthread_self(), threadNameBytes, TraceThreadBuffer.threadNameCapacity)
+        return true
+    }
+    
+    /// 归还到空闲列表（线程退出时由 TLS 析构函数调用）
+    func release() {
+        owner.store(0)
+    }
+    
+    var threadID: UInt64 {
+        return UInt64(bitPattern: lastThreadID.value)
+    }
+    
+    var threadName: String {
+        let name = String(cString: threadNameBytes)
+        return name.isEmpty ? "thread-\(threadID)" : name
+    }
+    
+    // MARK: - Recording
+    
+    @inline(__always)
+    func append(name: Int32, phase: TracePhase, start: UInt64, duration: UInt64, value: Int64) {
+        let index = Int(written.value % Int64(capacity))
+        names[index] = name
+        phases[index] = phase
+        starts[index] = start
+        durations[index] = duration
+        values[index] = value
+        written.increment()
+    }
+}
+
+// MARK: - EngineTrace
+/// 引擎活动追踪（回调、DSP 阶段、写入、等待）
+///
+/// 默认关闭；`start()` 或环境变量 `AUDIORECORD_TRACE=1` 开启后，每个线程把事件写入自己的
+/// 无锁环形缓冲区（每条事件一次 TLS 读取、一次 mach_absolute_time 与几次存储），
+/// `dump(to:)` 时再导出为 Chrome trace JSON 或 Perfetto protobuf。
+///
+/// 处理图编译时为 IO 线程与工作线程预留缓冲区（`reserveThreads(_:)`），这些线程第一次记录事件时
+/// 从空闲列表中领取，不加锁、不分配；线程退出时缓冲区经 TLS 析构函数归还，供之后的线程复用。
+/// 其他线程（主线程、写入线程）在没有空闲缓冲区时新建。
+/// 以 `-Xswiftc -DAUDIORECORD_NO_TRACE` 编译时所有入口为空操作。
+@_spi(Benchmarks) public enum EngineTrace {
+    
+    static let environmentVariable = "AUDIORECORD_TRACE"
+    /// 每个线程保留的事件数
+    public static let eventsPerThread = 1 << 16
+    /// 缓冲区总数上限（超出后新线程的事件被丢弃）
+    static let maxThreads = 256
+    
+    // MARK: - State
+    private static let enabled = AtomicInt64(ProcessInfo.processInfo.environment[environmentVariable] == "1" ? 1 : 0)
+    private static let lock = NSLock()
+    /// 全部缓冲区（加锁追加，持有引用）
+    private static var buffers: [TraceThreadBuffer] = []
+    /// 与 buffers 相同顺序的无锁视图：先写槽位再发布 slotCount
+    private static let slots: UnsafeMutablePointer<Unmanaged<TraceThreadBuffer>?> = {
+        let pointer = UnsafeMutablePointer<Unmanaged<TraceThreadBuffer>?>.allocate(capacity: maxThreads)
+        pointer.initialize(repeating: nil, count: maxThreads)
+        return pointer
+    }()
+    private static let slotCount = AtomicInt64()
+    /// 存活的处理图预留的线程数
+    private static let reservedThreads = AtomicInt64()
+    private static var nameTable: [(name: String, category: String)] = [("", "")]
+    private static var nameIDs: [String: Int32] = [:]
+    private static let bufferKey: pthread_key_t = {
+        var key = pthread_key_t()
+        pthread_key_create(&key) { pointer in
+            Unmanaged<TraceThreadBuffer>.fromOpaque(pointer).takeUnretainedValue().release()
+        }
+        return key
+    }()
+    /// 追踪开始时刻（导出时的时间原点）
+    private static var originHostTime = mach_absolute_time()
+    
+    // MARK: - Control
+    
+    static var isEnabled: Bool {
+        #if AUDIORECORD_NO_TRACE
+        return false
+        #else
+        return enabled.value != 0
+        #endif
+    }
+    
+    /// 是否编译了追踪支持
+    static var isCompiledIn: Bool {
+        #if AUDIORECORD_NO_TRACE
+        return false
+        #else
+        return true
+        #endif
+    }
+    
+    /// 清空已有事件并开始记录
+    static func start() {
+        #if !AUDIORECORD_NO_TRACE
+        RealtimeSafety.check(.lock, "EngineTrace.start")
+        lock.lock()
+        for buffer in buffers {
+            buffer.written.store(0)
+        }
+        originHostTime = mach_absolute_time()
+        lock.unlock()
+        // 录制中开启时，为正在运行的处理图线程补足缓冲区
+        fillPool()
+        enabled.store(1)
+        Logger.shared.info("🧵 EngineTrace: 开始记录")
+        #endif
+    }
+    
+    /// 停止记录（已记录的事件保留到下次 `start()`）
+    static func stop() {
+        enabled.store(0)
+    }
+    
+    // MARK: - Recording
+    
+    /// 开始一个区间
+    @inline(__always)
+    static func span(_ name: TraceName) -> TraceSpan {
+        #if AUDIORECORD_NO_TRACE
+        return TraceSpan(name: 0, start: 0)
+        #else
+        guard enabled.value != 0 else { return TraceSpan(name: 0, start: 0) }
+        return TraceSpan(name: name.id, start: mach_absolute_time())
+        #endif
+    }
+    
+    /// 记录瞬时事件
+    @inline(__always)
+    static func instant(_ name: TraceName, value: Int64 = 0) {
+        #if !AUDIORECORD_NO_TRACE
+        guard enabled.value != 0 else { return }
+        append(name: name.id, phase: .instant, start: mach_absolute_time(), duration: 0, value: value)
+        #endif
+    }
+    
+    /// 记录计数器取值
+    @inline(__always)
+    static func counter(_ name: TraceName, _ value: Int64) {
+        #if !AUDIORECORD_NO_TRACE
+        guard enabled.value != 0 else { return }
+        append(name: name.id, phase: .counter, start: mach_absolute_time(), duration: 0, value: value)
+        #endif
+    }
+    
+    @inline(__always)
+    fileprivate static func append(name: Int32, phase: TracePhase, start: UInt64, duration: UInt64, value: Int64) {
+        currentBuffer()?.append(name: name, phase: phase, start: start, duration: duration, value: value)
+    }
+    
+    // MARK: - Registration
+    
+    static func intern(_ name: String, category: String) -> Int32 {
+        RealtimeSafety.check(.lock, "EngineTrace.intern")
+        lock.lock()
+        defer { lock.unlock() }
+        let key = category + "\u{1F}" + name
+        if let id = nameIDs[key] {
+            return id
+        }
+        let id = Int32(nameTable.count)
+        nameTable.append((name, category))
+        nameIDs[key] = id
+        return id
+    }
+    
+    /// 为处理图的渲染线程预留缓冲区（图编译时在非实时线程上调用）
+    ///
+    /// 追踪开启时立即补足空闲缓冲区，否则在 `start()` 时补足。
+    /// - Parameter count: IO 线程与工作线程的总数
+    static func reserveThreads(_ count: Int) {
+        #if !AUDIORECORD_NO_TRACE
+        reservedThreads.add(Int64(count))
+        if enabled.value != 0 {
+            fillPool()
+        }
+        #endif
+    }
+    
+    /// 撤销预留（处理图停止时调用；缓冲区保留在空闲列表中供复用）
+    static func releaseThreads(_ count: Int) {
+        #if !AUDIORECORD_NO_TRACE
+        reservedThreads.add(-Int64(count))
+        #endif
+    }
+    
+    @inline(__always)
+    private static func currentBuffer() -> TraceThreadBuffer? {
+        if let pointer = pthread_getspecific(bufferKey) {
+            return Unmanaged<TraceThreadBuffer>.fromOpaque(pointer).takeUnretainedValue()
+        }
+        return claimBuffer()
+    }
+    
+    /// 为当前线程领取空闲缓冲区；没有空闲缓冲区时新建（加锁、分配，只应发生在非实时线程上）
+    private static func claimBuffer() -> TraceThreadBuffer? {
+        var tid: UInt64 = 0
+        pthread_threadid_np(nil, &tid)
+        // 优先领取从未写入过的缓冲区，尽量保留已退出线程的事件
+        let count = Int(slotCount.value)
+        for pass in 0..<2 {
+            for index in 0..<count {
+                guard let buffer = slots[index]?.takeUnretainedValue() else { continue }
+                if pass == 0 && buffer.written.value != 0 {
+                    continue
+                }
+                if buffer.claim(threadID: tid) {
+                    pthread_setspecific(bufferKey, Unmanaged.passUnretained(buffer).toOpaque())
+                    return buffer
+                }
+            }
+        }
+        
+        RealtimeSafety.check(.lock, "EngineTrace.claimBuffer")
+        lock.lock()
+        let buffer = appendBuffer()
+        lock.unlock()
+        guard let buffer = buffer, buffer.claim(threadID: tid) else { return nil }
+        pthread_setspecific(bufferKey, Unmanaged.passUnretained(buffer).toOpaque())
+        return buffer
+    }
+    
+    /// 补足空闲缓冲区，使其不少于预留的线程数
+    private static func fillPool() {
+        RealtimeSafety.check(.lock, "EngineTrace.fillPool")
+        lock.lock()
+        defer { lock.unlock() }
+        var missing = Int(reservedThreads.value) - buffers.filter { $0.owner.value == 0 }.count
+        while missing > 0, appendBuffer() != nil {
+            missing -= 1
+        }
+    }
+    
+    /// 新建一个空闲缓冲区（调用方持有锁）
+    private static func appendBuffer() -> TraceThreadBuffer? {
+        guard buffers.count < maxThreads else { return nil }
+        let buffer = TraceThreadBuffer(capacity: eventsPerThread)
+        slots[buffers.count] = Unmanaged.passUnretained(buffer)
+        buffers.append(buffer)
+        slotCount.store(Int64(buffers.count))
+        return buffer
+    }
+    
+    // MARK: - Export
+    
+    /// 导出时的快照
+    struct Snapshot {
+        let originHostTime: UInt64
+        let names: [(name: String, category: String)]
+        let threads: [(id: UInt64, name: String, events: [Event])]
+    }
+    
+    struct Event {
+        let name: Int32
+        let phase: TracePhase
+        let start: UInt64
+        let duration: UInt64
+        let value: Int64
+    }
+    
+    /// 复制各线程缓冲区中的事件（按开始时间排序）
+    static func snapshot() -> Snapshot {
+        RealtimeSafety.check(.lock, "EngineTrace.snapshot")
+        lock.lock()
+        defer { lock.unlock() }
+        let threads = buffers.map { buffer -> (id: UInt64, name: String, events: [Event]) in
+            let total = Int(buffer.written.value)
+            // 正在覆盖的最早一条可能不完整，缓冲区写满时跳过
+            let first = total > buffer.capacity ? total - buffer.capacity + 1 : 0
+            var events: [Event] = []
+            events.reserveCapacity(total - first)
+            for sequence in first..<total {
+                let index = sequence % buffer.capacity
+                events.append(Event(
+                    name: buffer.names[index],
+                    phase: buffer.phases[index],
+                    start: buffer.starts[index],
+                    duration: buffer.durations[index],
+                    value: buffer.values[index]
+                ))
+            }
+            events.sort { $0.start < $1.start }
+            return (buffer.threadID, buffer.threadName, events)
+        }
+        return Snapshot(originHostTime: originHostTime, names: nameTable, threads: threads.filter { !$0.events.isEmpty })
+    }
+    
+    /// 导出到文件：扩展名为 `.json` 时写 Chrome trace JSON，否则写 Perfetto protobuf
+    /// - Returns: 导出的事件数
+    @discardableResult
+    static func dump(to url: URL) throws -> Int {
+        let snapshot = self.snapshot()
+        let data: Data
+        if url.pathExtension.lowercased() == "json" {
+            data = TraceExport.chromeJSON(snapshot)
+        } else {
+            data = TraceExport.perfetto(snapshot)
+        }
+        try data.write(to: url, options: .atomic)
+        let count = snapshot.threads.reduce(0) { $0 + $1.events.count }
+        Logger.shared.info("🧵 EngineTrace: 已导出 \(count) 个事件到 \(url.path)")
+        return count
+    }
+}
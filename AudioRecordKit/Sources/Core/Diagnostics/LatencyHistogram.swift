@@ -0,0 +1,130 @@
+import Foundation
+
+// MARK: - HistogramSummary
+/// 直方图摘要（单位：纳秒）
+@_spi(Benchmarks) public struct HistogramSummary {
+    public let count: Int64
+    public let mean: Double
+    public let p50: Int64
+    public let p99: Int64
+    public let p999: Int64
+    public let max: Int64
+    
+    static let empty = HistogramSummary(count: 0, mean: 0, p50: 0, p99: 0, p999: 0, max: 0)
+}
+
+// MARK: - LatencyHistogram
+/// 无锁对数-线性直方图（HDR 风格）
+///
+/// 小于 16ns 的值逐一计数，之后每个 2 的幂区间再均分为 16 个桶，相对误差不超过 1/16；
+/// 上限约 2^40ns（18 分钟），超出的值计入最后一个桶。
+///
+/// `record(_:)` 只做原子加法，可在 IO 线程与多个工作线程上并发调用。
+/// `reset()` 不清零计数，而是记录当前值作为基线，读取时扣除，因此录制中途重置不会与写入竞争。
+/// `summary()` 与 `reset()` 由调用方串行化（非实时线程）。
+@_spi(Benchmarks) public final class LatencyHistogram {
+    
+    // MARK: - Layout
+    
+    /// 每个 2 的幂区间的桶数（log2）
+    private static let subBucketBits = 4
+    private static let subBucketCount = 1 << subBucketBits
+    /// 可表示的最大值（纳秒）
+    static let maxTrackableValue: UInt64 = (1 << 40) - 1
+    /// 桶总数
+    static let bucketCount = index(of: maxTrackableValue) + 1
+    
+    // MARK: - Properties
+    private let buckets = AtomicInt64Array(count: LatencyHistogram.bucketCount, tag: .diagnostics)
+    private let total = AtomicInt64()
+    private let sum = AtomicInt64()
+    private let maximum = AtomicInt64()
+    
+    /// 重置时的计数基线（仅读取方访问）
+    private let baseline: UnsafeMutablePointer<Int64>
+    private var baselineTotal: Int64 = 0
+    private var baselineSum: Int64 = 0
+    
+    // MARK: - Initialization
+    
+    public init() {
+        baseline = EngineMemory.allocate(Int64.self, capacity: LatencyHistogram.bucketCount, tag: .diagnostics)
+        baseline.initialize(repeating: 0, count: LatencyHistogram.bucketCount)
+    }
+    
+    deinit {
+        EngineMemory.deallocate(baseline, capacity: LatencyHistogram.bucketCount, tag: .diagnostics)
+    }
+    
+    // MARK: - Recording
+    
+    /// 记录一个值（纳秒，负值按 0 计）
+    @inline(__always)
+    public func record(_ nanoseconds: Int64) {
+        let value = nanoseconds > 0 ? nanoseconds : 0
+        buckets.add(1, at: LatencyHistogram.index(of: UInt64(value)))
+        total.increment()
+        sum.add(value)
+        maximum.storeMax(value)
+    }
+    
+    // MARK: - Reading
+    
+    /// 自上次重置以来的样本数
+    var count: Int64 {
+        return total.value - baselineTotal
+    }
+    
+    /// 自上次重置以来的摘要
+    public func summary() -> HistogramSummary {
+        let n = total.value - baselineTotal
+        guard n > 0 else { return .empty }
+        let mean = Double(sum.value - baselineSum) / Double(n)
+        let maxValue = maximum.value
+        
+        // 一次遍历求三个分位数
+        let ranks = [0.50, 0.99, 0.999].map { Int64((Double(n) * $0).rounded(.up)) }
+        var results = [Int64](repeating: maxValue, count: ranks.count)
+        var next = 0
+        var cumulative: Int64 = 0
+        for index in 0..<LatencyHistogram.bucketCount where next < ranks.count {
+            cumulative += buckets.load(index) - baseline[index]
+            while next < ranks.count && cumulative >= ranks[next] {
+                results[next] = min(LatencyHistogram.highestEquivalentValue(at: index), maxValue)
+                next += 1
+            }
+        }
+        return HistogramSummary(count: n, mean: mean, p50: results[0], p99: results[1], p999: results[2], max: maxValue)
+    }
+    
+    /// 以当前计数为基线重新开始统计（不阻塞并发的 `record(_:)`）
+    func reset() {
+        for index in 0..<LatencyHistogram.bucketCount {
+            baseline[index] = buckets.load(index)
+        }
+        baselineTotal = total.value
+        baselineSum = sum.value
+        maximum.store(0)
+    }
+    
+    // MARK: - Bucket Math
+    
+    @inline(__always)
+    static func index(of value: UInt64) -> Int {
+        let v = min(value, maxTrackableValue)
+        guard v >= UInt64(subBucketCount) else { return Int(v) }
+        let exponent = 63 - v.leadingZeroBitCount
+        let shift = exponent - subBucketBits
+        let mantissa = Int((v >> UInt64(shift)) & UInt64(subBucketCount - 1))
+        return (shift + 1) * subBucketCount + mantissa
+    }
+    
+    /// 桶内可表示的最大值
+    static func highestEquivalentValue(at index: Int) -> Int64 {
+        guard index >= subBucketCount else { return Int64(index) }
+        let shift = index / subBucketCount - 1
+        let mantissa = Int64(index % subBucketCount)
+        let lower = (Int64(subBucketCount) + mantissa) << Int64(shift)
+        return lower + (Int64(1) << Int64(shift)) - 1
+    }
+}
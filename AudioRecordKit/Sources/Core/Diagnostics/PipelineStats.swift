@@ -0,0 +1,244 @@
+import Foundation
+import Darwin
+
+// MARK: - PipelineStage
+/// 采集到落盘之间的统计阶段
+///
+/// 顺序与取值同 C API 的 `AudioRecordStage` 一致，不可调整。
+enum PipelineStage: Int, CaseIterable {
+    /// 设备采集时刻 → IO 回调开始（仅墙钟延迟）
+    case capture = 0
+    /// 采集数据载入源节点
+    case ingest = 1
+    /// 处理器节点（混音、限幅等）
+    case process = 2
+    /// 旁路输出端（电平表、Tap）
+    case analysis = 3
+    /// 编码为文件格式并提交给写入器
+    case encode = 4
+    /// 写入器调用到写入完成
+    case write = 5
+    /// 设备采集时刻 → 写入完成（仅墙钟延迟）
+    case endToEnd = 6
+    /// 整个 IO 回调
+    case callback = 7
+    
+    var name: String {
+        switch self {
+        case .capture: return "capture"
+        case .ingest: return "ingest"
+        case .process: return "process"
+        case .analysis: return "analysis"
+        case .encode: return "encode"
+        case .write: return "write"
+        case .endToEnd: return "end-to-end"
+        case .callback: return "callback"
+        }
+    }
+}
+
+// MARK: - StageMark
+/// 阶段起点：墙钟（mach_absolute_time）与当前线程 CPU 时间
+struct StageMark {
+    let hostTime: UInt64
+    let cpuNanoseconds: UInt64
+    
+    @inline(__always)
+    static func now() -> StageMark {
+        return StageMark(hostTime: mach_absolute_time(), cpuNanoseconds: clock_gettime_nsec_np(CLOCK_THREAD_CPUTIME_ID))
+    }
+}
+
+// MARK: - PipelineStageTimer
+/// 单个 IO 回调的逐块阶段计时器
+///
+/// 一个块内同一阶段可能被多次计入（多个处理器节点、并行分支），先在这里按块累加，
+/// 块结束时每个阶段向直方图提交一个样本。累加器是原子的，图调度的工作线程可以并发计入；
+/// `beginBlock` / `endBlock` 只在 IO 线程调用。每个回调（每个图）持有自己的计时器，
+/// 多个会话并发时互不干扰。
+final class PipelineStageTimer {
+    
+    // MARK: - Properties
+    let stats: PipelineStats
+    private let wall = AtomicInt64Array(count: PipelineStage.allCases.count)
+    private let cpu = AtomicInt64Array(count: PipelineStage.allCases.count)
+    private let hits = AtomicInt64Array(count: PipelineStage.allCases.count)
+    private var blockStart = StageMark(hostTime: 0, cpuNanoseconds: 0)
+    
+    // MARK: - Initialization
+    
+    init(stats: PipelineStats = .shared) {
+        self.stats = stats
+    }
+    
+    // MARK: - Block
+    
+    /// 块开始（IO 回调入口）
+    /// - Parameter captureHostTime: 设备采集时刻，0 表示未知
+    @inline(__always)
+    func beginBlock(captureHostTime: UInt64) {
+        blockStart = StageMark.now()
+        if captureHostTime > 0 && captureHostTime <= blockStart.hostTime {
+            stats.record(.capture, wallTicks: blockStart.hostTime - captureHostTime)
+        }
+    }
+    
+    /// 块结束（IO 回调返回前）：提交本块各阶段的累计耗时
+    /// - Returns: 本块回调耗时（纳秒）
+    @discardableResult
+    func endBlock(frames: Int) -> UInt64 {
+        for stage in PipelineStage.allCases where hits.load(stage.rawValue) > 0 {
+            stats.record(stage, wallTicks: UInt64(wall.load(stage.rawValue)), cpuNanoseconds: UInt64(cpu.load(stage.rawValue)))
+        }
+        // 本块的并发计入都已在调度器返回前完成
+        wall.fillUnsynchronized(0)
+        cpu.fillUnsynchronized(0)
+        hits.fillUnsynchronized(0)
+        
+        let end = StageMark.now()
+        let elapsed = end.hostTime - blockStart.hostTime
+        stats.record(.callback, wallTicks: elapsed, cpuNanoseconds: end.cpuNanoseconds &- blockStart.cpuNanoseconds)
+        stats.countBlock(frames: frames)
+        return PipelineStats.nanoseconds(fromHostTicks: elapsed)
+    }
+    
+    // MARK: - Stages
+    
+    /// 把从 mark 到现在的耗时计入 stage（可在工作线程调用）
+    @inline(__always)
+    func add(_ stage: PipelineStage, since mark: StageMark) {
+        let end = StageMark.now()
+        wall.add(Int64(end.hostTime &- mark.hostTime), at: stage.rawValue)
+        cpu.add(Int64(bitPattern: end.cpuNanoseconds &- mark.cpuNanoseconds), at: stage.rawValue)
+        hits.add(1, at: stage.rawValue)
+    }
+    
+    /// 记录端到端延迟：从采集时刻到现在（写入完成时调用）
+    @inline(__always)
+    func completeWrite(captureHostTime: UInt64) {
+        let now = mach_absolute_time()
+        guard captureHostTime > 0 && captureHostTime <= now else { return }
+        stats.record(.endToEnd, wallTicks: now - captureHostTime)
+    }
+}
+
+// MARK: - PipelineStats
+/// 采集管线统计 - 每个阶段一组墙钟延迟与 CPU 时间直方图
+///
+/// 录制线程只做原子加法；读取与重置在调用方线程进行，由内部锁串行化，
+/// 重置不需要暂停采集。
+final class PipelineStats {
+    
+    static let shared = PipelineStats()
+    
+    /// 对外结构体版本（与 C API 的 AUDIO_RECORD_STATS_VERSION 一致）
+    static let version: UInt32 = 1
+    
+    // MARK: - Properties
+    private let latency = PipelineStage.allCases.map { _ in LatencyHistogram() }
+    private let cpuTime = PipelineStage.allCases.map { _ in LatencyHistogram() }
+    private let blocks = AtomicInt64()
+    private let frames = AtomicInt64()
+    private var baselineBlocks: Int64 = 0
+    private var baselineFrames: Int64 = 0
+    private var resetHostTime = mach_absolute_time()
+    private let readLock = NSLock()
+    
+    private static let timebase: mach_timebase_info_data_t = {
+        var info = mach_timebase_info_data_t()
+        mach_timebase_info(&info)
+        return info
+    }()
+    
+    // MARK: - Recording
+    
+    @inline(__always)
+    func record(_ stage: PipelineStage, wallTicks: UInt64, cpuNanoseconds: UInt64? = nil) {
+        latency[stage.rawValue].record(Int64(PipelineStats.nanoseconds(fromHostTicks: wallTicks)))
+        if let cpuNanoseconds = cpuNanoseconds {
+            cpuTime[stage.rawValue].record(Int64(clamping: cpuNanoseconds))
+        }
+    }
+    
+    @inline(__always)
+    func countBlock(frames count: Int) {
+        blocks.increment()
+        frames.add(Int64(count))
+    }
+    
+    // MARK: - Reading
+    
+    /// 自上次重置以来的统计快照
+    func snapshot() -> PipelineStatsSnapshot {
+        readLock.lock()
+        defer { readLock.unlock() }
+        let stages = PipelineStage.allCases.map { stage in
+            PipelineStageSnapshot(
+                stage: stage,
+                latency: latency[stage.rawValue].summary(),
+                cpu: cpuTime[stage.rawValue].summary()
+            )
+        }
+        return PipelineStatsSnapshot(
+            blocks: blocks.value - baselineBlocks,
+            frames: frames.value - baselineFrames,
+            elapsedNanoseconds: Int64(PipelineStats.nanoseconds(fromHostTicks: mach_absolute_time() - resetHostTime)),
+            stages: stages
+        )
+    }
+    
+    /// 重新开始统计（录制中调用安全）
+    func reset() {
+        readLock.lock()
+        defer { readLock.unlock() }
+        for histogram in latency + cpuTime {
+            histogram.reset()
+        }
+        baselineBlocks = blocks.value
+        baselineFrames = frames.value
+        resetHostTime = mach_absolute_time()
+    }
+    
+    /// 输出各阶段摘要到日志
+    func logSummary() {
+        let snapshot = self.snapshot()
+        guard snapshot.blocks > 0 else { return }
+        Logger.shared.info("📈 管线统计: \(snapshot.blocks) 块, \(snapshot.frames) 帧")
+        for stage in snapshot.stages where stage.latency.count > 0 {
+            let l = stage.latency
+            Logger.shared.info(String(format: "📈   %@: p50 %.1fµs p99 %.1fµs p999 %.1fµs max %.1fµs, CPU p99 %.1fµs",
+                                      stage.stage.name,
+                                      Double(l.p50) / 1000, Double(l.p99) / 1000, Double(l.p999) / 1000, Double(l.max) / 1000,
+                                      Double(stage.cpu.p99) / 1000))
+        }
+    }
+    
+    // MARK: - Helpers
+    
+    @inline(__always)
+    static func nanoseconds(fromHostTicks ticks: UInt64) -> UInt64 {
+        return ticks &* UInt64(timebase.numer) / UInt64(timebase.denom)
+    }
+    
+    @inline(__always)
+    static func hostTicks(fromNanoseconds nanoseconds: UInt64) -> UInt64 {
+        return nanoseconds &* UInt64(timebase.denom) / UInt64(timebase.numer)
+    }
+}
+
+// MARK: - Snapshot
+struct PipelineStageSnapshot {
+    let stage: PipelineStage
+    /// 每块墙钟耗时
+    let latency: HistogramSummary
+    /// 每块线程 CPU 时间（capture 与 end-to-end 阶段为空）
+    let cpu: HistogramSummary
+}
+
+struct PipelineStatsSnapshot {
+    let blocks: Int64
+    let frames: Int64
+    /// 自上次重置以来的墙钟时间
+    let elapsedNanoseconds: Int64
+    let stages: [PipelineStageSnapshot]
+}
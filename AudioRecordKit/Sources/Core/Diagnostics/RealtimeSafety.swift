@@ -0,0 +1,279 @@
+import Foundation
+import Darwin
+
+// MARK: - RealtimeViolationKind
+/// 实时线程上的违规操作类别
+enum RealtimeViolationKind: Int64, CaseIterable {
+    case allocation = 0
+    case deallocation = 1
+    /// 引擎内的 NSLock 加锁处（只覆盖显式检查点，不拦截系统框架内部的锁）
+    case lock = 2
+    case blocking = 3
+    case fileIO = 4
+    case logging = 5
+    
+    var name: String {
+        switch self {
+        case .allocation: return "malloc"
+        case .deallocation: return "free"
+        case .lock: return "lock"
+        case .blocking: return "blocking-wait"
+        case .fileIO: return "file-io"
+        case .logging: return "logging"
+        }
+    }
+}
+
+// MARK: - RealtimeViolation
+/// 一次违规记录（读取时才做符号化）
+struct RealtimeViolation: CustomStringConvertible {
+    let kind: RealtimeViolationKind
+    let detail: String
+    /// Mach 线程号
+    let thread: UInt32
+    let hostTime: UInt64
+    let backtrace: [String]
+    
+    var description: String {
+        var lines = ["[\(kind.name)] \(detail) (thread \(thread))"]
+        lines.append(contentsOf: backtrace.map { "    \($0)" })
+        return lines.joined(separator: "\n")
+    }
+}
+
+// MARK: - RealtimeSafety
+/// 实时安全检查器（仅 Debug 构建启用）
+///
+/// 引擎在 IO 回调入口与图调度工作线程上标记实时线程；这些线程上的
+/// malloc/free（通过 libmalloc 的 `malloc_logger` 钩子拦截）、引擎内加锁处
+/// （EngineTrace、BinaryLog、EngineArena、AudioProcessRegistry）与阻塞等待、
+/// 文件 IO 和日志调用都会被记录为违规，附带调用栈。
+///
+/// 录制器的文件写入在写入线程上进行、电平经 `LevelPublisher` 回到主线程，
+/// 正常运行时违规数应为 0。
+///
+/// 记录过程不加锁、不分配：槽位按原子序号领取，调用栈写入预分配的缓冲区，
+/// 符号化推迟到 `violations()` 读取时。Release 构建中所有入口都是空操作。
+enum RealtimeSafety {
+    
+    #if DEBUG
+    static let isEnabled = true
+    #else
+    static let isEnabled = false
+    #endif
+    
+    /// 保留调用栈的记录条数（超出后只计数）
+    static let capacity = 256
+    /// 每条记录保留的栈帧数
+    static let maxFrames = 32
+    
+    // MARK: - Storage
+    
+    private static let realtimeKey: pthread_key_t = makeKey()
+    private static let reentrancyKey: pthread_key_t = makeKey()
+    
+    private static let sequence = AtomicInt64()
+    private static let kindCounts = AtomicInt64Array(count: RealtimeViolationKind.allCases.count)
+    private static let published = AtomicInt64Array(count: capacity)
+    private static let kinds = UnsafeMutablePointer<RealtimeViolationKind>.allocate(capacity: capacity)
+    private static let details = UnsafeMutablePointer<StaticString>.allocate(capacity: capacity)
+    private static let threads = UnsafeMutablePointer<UInt32>.allocate(capacity: capacity)
+    private static let hostTimes = UnsafeMutablePointer<UInt64>.allocate(capacity: capacity)
+    private static let frameCounts = UnsafeMutablePointer<Int32>.allocate(capacity: capacity)
+    private static let frames: UnsafeMutablePointer<UnsafeMutableRawPointer?> = {
+        let pointer = UnsafeMutablePointer<UnsafeMutableRawPointer?>.allocate(capacity: capacity * maxFrames)
+        pointer.initialize(repeating: nil, count: capacity * maxFrames)
+        return pointer
+    }()
+    
+    /// 首次标记实时线程时安装分配钩子
+    private static let allocationHookInstalled: Bool = installAllocationHook()
+    
+    // MARK: - Thread Marking
+    
+    /// 在非实时线程上提前安装分配钩子（否则在第一次 `enterRealtime()` 时安装）
+    static func prepare() {
+        #if DEBUG
+        _ = allocationHookInstalled
+        #endif
+    }
+    
+    /// 把当前线程标记为实时线程（可嵌套，与 `exitRealtime()` 成对调用）
+    @inline(__always)
+    static func enterRealtime() {
+        #if DEBUG
+        _ = allocationHookInstalled
+        let depth = Int(bitPattern: pthread_getspecific(realtimeKey))
+        pthread_setspecific(realtimeKey, UnsafeRawPointer(bitPattern: depth + 1))
+        #endif
+    }
+    
+    @inline(__always)
+    static func exitRealtime() {
+        #if DEBUG
+        let depth = Int(bitPattern: pthread_getspecific(realtimeKey))
+        pthread_setspecific(realtimeKey, UnsafeRawPointer(bitPattern: max(depth - 1, 0)))
+        #endif
+    }
+    
+    /// 当前线程是否为实时线程
+    static var isRealtimeThread: Bool {
+        #if DEBUG
+        return pthread_getspecific(realtimeKey) != nil
+        #else
+        return false
+        #endif
+    }
+    
+    // MARK: - Checks
+    
+    /// 检查点：在实时线程上调用时记录违规
+    @inline(__always)
+    static func check(_ kind: RealtimeViolationKind, _ detail: StaticString) {
+        #if DEBUG
+        guard pthread_getspecific(realtimeKey) != nil else { return }
+        record(kind, detail)
+        #endif
+    }
+    
+    // MARK: - Results
+    
+    /// 违规总数（包括超出容量未保留调用栈的记录）
+    static var violationCount: Int {
+        return Int(sequence.value)
+    }
+    
+    /// 某一类违规的次数
+    static func count(of kind: RealtimeViolationKind) -> Int {
+        return Int(kindCounts.load(Int(kind.rawValue)))
+    }
+    
+    /// 已保留的违规记录（在非实时线程调用，会做符号化）
+    static func violations() -> [RealtimeViolation] {
+        let total = min(violationCount, capacity)
+        var result: [RealtimeViolation] = []
+        for slot in 0..<total where published.load(slot) != 0 {
+            let base = frames + slot * maxFrames
+            let symbols = (0..<Int(frameCounts[slot])).compactMap { base[$0] }.map(symbolicate)
+            result.append(RealtimeViolation(
+                kind: kinds[slot],
+                detail: details[slot].description,
+                thread: threads[slot],
+                hostTime: hostTimes[slot],
+                backtrace: symbols
+            ))
+        }
+        return result
+    }
+    
+    /// 清空记录（调用时不应有实时线程正在记录）
+    static func reset() {
+        published.fillUnsynchronized(0)
+        kindCounts.fillUnsynchronized(0)
+        sequence.store(0)
+    }
+    
+    /// 断言没有违规（测试中使用），失败时打印全部记录
+    static func assertNoViolations(file: StaticString = #file, line: UInt = #line) {
+        let count = violationCount
+        guard count > 0 else { return }
+        let report = violations().map { $0.description }.joined(separator: "\n")
+        assertionFailure("实时线程违规 \(count) 次:\n\(report)", file: file, line: line)
+    }
+    
+    /// 输出违规摘要到日志（在非实时线程调用）
+    static func logSummary() {
+        guard isEnabled, violationCount > 0 else { return }
+        let byKind = RealtimeViolationKind.allCases
+            .filter { count(of: $0) > 0 }
+            .map { "\($0.name)=\(count(of: $0))" }
+            .joined(separator: ", ")
+        Logger.shared.warning("⏱️ 实时线程违规 \(violationCount) 次: \(byKind)")
+        if let first = violations().first {
+            Logger.shared.warning("⏱️ 首次违规:\n\(first)")
+        }
+    }
+    
+    // MARK: - Recording
+    
+    private static func record(_ kind: RealtimeViolationKind, _ detail: StaticString) {
+        // 钩子内部的分配（例如记录过程本身）不再记录
+        guard pthread_getspecific(reentrancyKey) == nil else { return }
+        pthread_setspecific(reentrancyKey, UnsafeRawPointer(bitPattern: 1))
+        defer { pthread_setspecific(reentrancyKey, nil) }
+        
+        kindCounts.add(1, at: Int(kind.rawValue))
+        let slot = Int(sequence.increment() - 1)
+        guard slot < capacity else { return }
+        
+        kinds[slot] = kind
+        details[slot] = detail
+        threads[slot] = pthread_mach_thread_np(pthread_self())
+        hostTimes[slot] = mach_absolute_time()
+        frameCounts[slot] = backtrace(frames + slot * maxFrames, Int32(maxFrames))
+        _ = published.compareExchange(expected: 0, desired: 1, at: slot)
+    }
+    
+    // MARK: - Allocation Hook
+    
+    /// libmalloc 在每次分配/释放时调用的日志钩子签名
+    fileprivate typealias MallocLogger = @convention(c) (UInt32, UInt, UInt, UInt, UInt, UInt32) -> Void
+    
+    fileprivate static var previousMallocLogger: MallocLogger?
+    
+    private static func installAllocationHook() -> Bool {
+        #if DEBUG
+        // RTLD_DEFAULT
+        guard let symbol = dlsym(UnsafeMutableRawPointer(bitPattern: -2), "malloc_logger") else {
+            Logger.shared.warning("⏱️ RealtimeSafety: 找不到 malloc_logger，分配检查不可用")
+            return false
+        }
+        // 钩子会在任意线程上调用，先完成所有静态存储的惰性初始化
+        _ = (realtimeKey, reentrancyKey, sequence, kindCounts, published, frames)
+        _ = (kinds, details, threads, hostTimes, frameCounts)
+        let slot = symbol.assumingMemoryBound(to: MallocLogger?.self)
+        previousMallocLogger = slot.pointee
+        slot.pointee = realtimeMallocLogger
+        Logger.shared.info("⏱️ RealtimeSafety: 已启用实时线程检查（malloc/free、锁、文件 IO、日志）")
+        return true
+        #else
+        return false
+        #endif
+    }
+    
+    fileprivate static func allocationObserved(type: UInt32) {
+        guard pthread_getspecific(realtimeKey) != nil else { return }
+        // MALLOC_LOG_TYPE_ALLOCATE = 2, MALLOC_LOG_TYPE_DEALLOCATE = 4
+        if type & 2 != 0 {
+            record(.allocation, "malloc")
+        } else if type & 4 != 0 {
+            record(.deallocation, "free")
+        }
+    }
+    
+    // MARK: - Helpers
+    
+    private static func makeKey() -> pthread_key_t {
+        var key = pthread_key_t()
+        pthread_key_create(&key, nil)
+        return key
+    }
+    
+    private static func symbolicate(_ address: UnsafeMutableRawPointer) -> String {
+        var info = Dl_info()
+        guard dladdr(address, &info) != 0 else {
+            return "\(address)"
+        }
+        let image = info.dli_fname.map { URL(fileURLWithPath: String(cString: $0)).lastPathComponent } ?? "?"
+        guard let symbol = info.dli_sname, let start = info.dli_saddr else {
+            return "\(image) \(address)"
+        }
+        return "\(image) \(String(cString: symbol)) + \(address - UnsafeMutableRawPointer(mutating: start))"
+    }
+}
+
+/// 分配钩子（C 函数指针，不捕获上下文）
+private let realtimeMallocLogger: RealtimeSafety.MallocLogger = { type, arg1, arg2, arg3, result, skip in
+    RealtimeSafety.previousMallocLogger?(type, arg1, arg2, arg3, result, skip)
+    RealtimeSafety.allocationObserved(type: type)
+}
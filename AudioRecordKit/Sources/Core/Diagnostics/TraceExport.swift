@@ -0,0 +1,243 @@
+import Foundation
+
+// MARK: - TraceExport
+/// 追踪快照的导出格式
+///
+/// - Chrome trace JSON：chrome://tracing 与 ui.perfetto.dev 都能直接打开
+/// - Perfetto protobuf：`Trace { repeated TracePacket packet = 1 }`，每个线程一条 track，
+///   区间拆成 SLICE_BEGIN / SLICE_END，计数器各自一条 counter track
+enum TraceExport {
+    
+    // MARK: - Chrome Trace JSON
+    
+    static func chromeJSON(_ snapshot: EngineTrace.Snapshot) -> Data {
+        let pid = ProcessInfo.processInfo.processIdentifier
+        var json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+        var first = true
+        func emit(_ line: String) {
+            if !first { json += ",\n" }
+            json += line
+            first = false
+        }
+        
+        emit("{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":\(pid),\"tid\":0,\"args\":{\"name\":\"AudioRecordKit\"}}")
+        for thread in snapshot.threads {
+            emit("{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":\(pid),\"tid\":\(thread.id),\"args\":{\"name\":\(quoted(thread.name))}}")
+            for event in thread.events {
+                let entry = snapshot.names[Int(event.name)]
+                let ts = microseconds(event.start, origin: snapshot.originHostTime)
+                let common = "\"name\":\(quoted(entry.name)),\"cat\":\(quoted(entry.category)),\"pid\":\(pid),\"tid\":\(thread.id),\"ts\":\(ts)"
+                switch event.phase {
+                case .complete:
+                    let dur = Double(PipelineStats.nanoseconds(fromHostTicks: event.duration)) / 1000
+                    emit("{\"ph\":\"X\",\(common),\"dur\":\(dur)}")
+                case .instant:
+                    emit("{\"ph\":\"i\",\"s\":\"t\",\(common),\"args\":{\"value\":\(event.value)}}")
+                case .counter:
+                    emit("{\"ph\":\"C\",\(common),\"args\":{\"value\":\(event.value)}}")
+                }
+            }
+        }
+        json += "\n]}\n"
+        return Data(json.utf8)
+    }
+    
+    private static func microseconds(_ hostTime: UInt64, origin: UInt64) -> Double {
+        let ticks = hostTime >= origin ? hostTime - origin : 0
+        return Double(PipelineStats.nanoseconds(fromHostTicks: ticks)) / 1000
+    }
+    
+    private static func quoted(_ string: String) -> String {
+        var result = "\""
+        for scalar in string.unicodeScalars {
+            switch scalar {
+            case "\"": result += "\\\""
+            case "\\": result += "\\\\"
+            case "\n": result += "\\n"
+            case "\t": result += "\\t"
+            default:
+                if scalar.value < 0x20 {
+                    result += String(format: "\\u%04x", scalar.value)
+                } else {
+                    result.unicodeScalars.append(scalar)
+                }
+            }
+        }
+        return result + "\""
+    }
+    
+    // MARK: - Perfetto Protobuf
+    
+    /// 字段号取自 perfetto/protos/perfetto/trace/*.proto
+    private enum Field {
+        // Trace
+        static let packet = 1
+        // TracePacket
+        static let timestamp = 8
+        static let trustedPacketSequenceID = 10
+        static let trackEvent = 11
+        static let sequenceFlags = 13
+        static let trackDescriptor = 60
+        // TrackDescriptor
+        static let uuid = 1
+        static let trackName = 2
+        static let process = 3
+        static let thread = 4
+        static let parentUUID = 5
+        static let counter = 8
+        // ProcessDescriptor / ThreadDescriptor
+        static let pid = 1
+        static let tid = 2
+        static let threadName = 5
+        static let processName = 6
+        // TrackEvent
+        static let type = 9
+        static let trackUUID = 11
+        static let categories = 22
+        static let name = 23
+        static let counterValue = 30
+    }
+    
+    /// TrackEvent.Type
+    private enum TrackEventType: UInt64 {
+        case sliceBegin = 1
+        case sliceEnd = 2
+        case instant = 3
+        case counter = 4
+    }
+    
+    private static let sequenceID: UInt64 = 1
+    /// SEQ_INCREMENTAL_STATE_CLEARED
+    private static let incrementalStateCleared: UInt64 = 1
+    
+    static func perfetto(_ snapshot: EngineTrace.Snapshot) -> Data {
+        let pid = UInt64(ProcessInfo.processInfo.processIdentifier)
+        let processUUID = pid << 32
+        var trace = ProtoWriter()
+        
+        var process = ProtoWriter()
+        process.varint(Field.pid, pid)
+        process.string(Field.processName, "AudioRecordKit")
+        var processTrack = ProtoWriter()
+        processTrack.varint(Field.uuid, processUUID)
+        processTrack.message(Field.process, process)
+        trace.message(Field.packet, packet(trackDescriptor: processTrack, flags: incrementalStateCleared))
+        
+        // 计数器轨道按名称分配，挂在进程轨道下
+        var counterTracks: [Int32: UInt64] = [:]
+        
+        for (threadIndex, thread) in snapshot.threads.enumerated() {
+            let threadUUID = processUUID | UInt64(threadIndex + 1) << 16
+            var descriptor = ProtoWriter()
+            descriptor.varint(Field.pid, pid)
+            descriptor.varint(Field.tid, thread.id)
+            descriptor.string(Field.threadName, thread.name)
+            var track = ProtoWriter()
+            track.varint(Field.uuid, threadUUID)
+            track.varint(Field.parentUUID, processUUID)
+            track.message(Field.thread, descriptor)
+            trace.message(Field.packet, packet(trackDescriptor: track))
+            
+            // 区间拆成开始/结束后按时间排序，结束排在同一时刻的开始之前
+            var records: [(time: UInt64, order: Int, event: EngineTrace.Event, type: TrackEventType)] = []
+            records.reserveCapacity(thread.events.count * 2)
+            for event in thread.events {
+                switch event.phase {
+                case .complete:
+                    records.append((event.start, 1, event, .sliceBegin))
+                    records.append((event.start &+ event.duration, 0, event, .sliceEnd))
+                case .instant:
+                    records.append((event.start, 1, event, .instant))
+                case .counter:
+                    records.append((event.start, 1, event, .counter))
+                }
+            }
+            records.sort { ($0.time, $0.order) < ($1.time, $1.order) }
+            
+            for record in records {
+                let entry = snapshot.names[Int(record.event.name)]
+                var trackEvent = ProtoWriter()
+                trackEvent.varint(Field.type, record.type.rawValue)
+                switch record.type {
+                case .counter:
+                    let uuid: UInt64
+                    if let existing = counterTracks[record.event.name] {
+                        uuid = existing
+                    } else {
+                        uuid = processUUID | 0x8000 | UInt64(counterTracks.count + 1)
+                        counterTracks[record.event.name] = uuid
+                        var counterTrack = ProtoWriter()
+                        counterTrack.varint(Field.uuid, uuid)
+                        counterTrack.varint(Field.parentUUID, processUUID)
+                        counterTrack.string(Field.trackName, entry.name)
+                        counterTrack.message(Field.counter, ProtoWriter())
+                        trace.message(Field.packet, packet(trackDescriptor: counterTrack))
+                    }
+                    trackEvent.varint(Field.trackUUID, uuid)
+                    trackEvent.varint(Field.counterValue, UInt64(bitPattern: record.event.value))
+                case .sliceEnd:
+                    trackEvent.varint(Field.trackUUID, threadUUID)
+                default:
+                    trackEvent.varint(Field.trackUUID, threadUUID)
+                    trackEvent.string(Field.categories, entry.category)
+                    trackEvent.string(Field.name, entry.name)
+                }
+                
+                var event = ProtoWriter()
+                event.varint(Field.timestamp, nanoseconds(record.time, origin: snapshot.originHostTime))
+                event.varint(Field.trustedPacketSequenceID, sequenceID)
+                event.message(Field.trackEvent, trackEvent)
+                trace.message(Field.packet, event)
+            }
+        }
+        return trace.data
+    }
+    
+    private static func packet(trackDescriptor: ProtoWriter, flags: UInt64 = 0) -> ProtoWriter {
+        var packet = ProtoWriter()
+        packet.varint(Field.trustedPacketSequenceID, sequenceID)
+        if flags != 0 {
+            packet.varint(Field.sequenceFlags, flags)
+        }
+        packet.message(Field.trackDescriptor, trackDescriptor)
+        return packet
+    }
+    
+    private static func nanoseconds(_ hostTime: UInt64, origin: UInt64) -> UInt64 {
+        return PipelineStats.nanoseconds(fromHostTicks: hostTime >= origin ? hostTime - origin : 0)
+    }
+}
+
+// MARK: - ProtoWriter
+/// 最小 protobuf 编码器（varint 与长度前缀字段）
+private struct ProtoWriter {
+    private(set) var data = Data()
+    
+    mutating func varint(_ field: Int, _ value: UInt64) {
+        appendVarint(UInt64(field << 3))
+        appendVarint(value)
+    }
+    
+    mutating func string(_ field: Int, _ value: String) {
+        bytes(field, Data(value.utf8))
+    }
+    
+    mutating func message(_ field: Int, _ value: ProtoWriter) {
+        bytes(field, value.data)
+    }
+    
+    private mutating func bytes(_ field: Int, _ value: Data) {
+        appendVarint(UInt64(field << 3 | 2))
+        appendVarint(UInt64(value.count))
+        data.append(value)
+    }
+    
+    private mutating func appendVarint(_ value: UInt64) {
+        var v = value
+        while v >= 0x80 {
+            data.append(UInt8(truncatingIfNeeded: v) | 0x80)
+            v >>= 7
+        }
+        data.append(UInt8(v))
+    }
+}
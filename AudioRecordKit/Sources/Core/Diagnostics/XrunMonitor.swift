@@ -0,0 +1,346 @@
+import Foundation
+import Darwin
+
+// MARK: - XrunKind
+/// 断流 / 溢出事件类别
+///
+/// 取值与 C API 的 `AudioRecordXrunKind` 一致，不可调整。
+@_spi(Benchmarks) public enum XrunKind: Int, CaseIterable {
+    /// 采集时间线不连续（设备样本时间或回调间隔出现跳变），frames 为缺失帧数（负数为重叠）
+    case discontinuity = 0
+    /// 环形缓冲区已满，新数据被丢弃，frames 为丢弃帧数
+    case ringOverrun = 1
+    /// 环形缓冲区数据不足，以静音补齐，frames 为补零帧数
+    case ringUnderrun = 2
+    /// 写入器写入失败，frames 为丢失帧数
+    case writeFailure = 3
+    /// IO 回调耗时超过块时长（写入器跟不上采集），frames 为超出的帧数
+    case callbackOverrun = 4
+    
+    public var name: String {
+        switch self {
+        case .discontinuity: return "discontinuity"
+        case .ringOverrun: return "ring-overrun"
+        case .ringUnderrun: return "ring-underrun"
+        case .writeFailure: return "write-failure"
+        case .callbackOverrun: return "callback-overrun"
+        }
+    }
+}
+
+// MARK: - XrunEvent
+/// 一次断流 / 溢出事件
+struct XrunEvent: CustomStringConvertible {
+    let kind: XrunKind
+    /// 发生位置（例如 "io"、"mic-ring"、"writer"）
+    let origin: String
+    /// 事件大小（帧）
+    let frames: Int64
+    /// 发生时刻（mach_absolute_time）
+    let hostTime: UInt64
+    /// 发生时刻（纳秒，与 hostTime 同一时钟）
+    let hostTimeNanoseconds: UInt64
+    
+    var description: String {
+        return "\(hostTimeNanoseconds) \(kind.name) \(origin) frames=\(frames)"
+    }
+}
+
+// MARK: - CaptureTimeline
+/// 采集时间线连续性检测（每个 IO 回调一个实例，仅在 IO 线程使用）
+///
+/// 优先比较设备样本时间：本块起点应等于上一块起点加上一块帧数；
+/// 设备未提供样本时间时，按主机时间间隔与上一块时长比较，超过 1.5 倍视为断流。
+struct CaptureTimeline {
+    
+    private var expectedSampleTime: Double = -1
+    private var lastHostTime: UInt64 = 0
+    private var lastFrames = 0
+    
+    /// 检查本块与上一块是否连续
+    /// - Returns: 缺失的帧数（负数为重叠），连续时为 nil
+    mutating func advance(sampleTime: Double?, hostTime: UInt64, frames: Int, sampleRate: Double) -> Int64? {
+        defer {
+            lastHostTime = hostTime
+            lastFrames = frames
+        }
+        
+        if let sampleTime = sampleTime {
+            defer { expectedSampleTime = sampleTime + Double(frames) }
+            guard expectedSampleTime >= 0 else { return nil }
+            let gap = (sampleTime - expectedSampleTime).rounded()
+            return abs(gap) >= 1 ? Int64(gap) : nil
+        }
+        
+        guard lastHostTime > 0, hostTime > lastHostTime, lastFrames > 0, sampleRate > 0 else { return nil }
+        let elapsed = Double(PipelineStats.nanoseconds(fromHostTicks: hostTime - lastHostTime)) / 1e9
+        let expected = Double(lastFrames) / sampleRate
+        guard elapsed > expected * 1.5 else { return nil }
+        return Int64(((elapsed - expected) * sampleRate).rounded())
+    }
+    
+    mutating func reset() {
+        expectedSampleTime = -1
+        lastHostTime = 0
+        lastFrames = 0
+    }
+}
+
+// MARK: - XrunMonitor
+/// 断流 / 溢出监测
+///
+/// 每个录制会话持有自己的实例（由文件管理器创建，处理图与 IO 回调向它报告），
+/// 计数与旁路日志（录音文件名 + `.xruns.log`）只属于该会话，并发的会话互不影响。
+/// 会话实例同时把事件转报给 `shared`：进程级实例只汇总所有会话的计数并分发给观察者，不写旁路日志。
+///
+/// `report(_:origin:frames:)` 可在 IO 线程与工作线程上调用：只做原子计数并把事件写入
+/// 预分配的多生产者环形队列（队列满时只计数、丢弃事件）。后台队列定期取出事件，
+/// 分发给观察者（主线程）并追加到旁路日志。
+@_spi(Benchmarks) public final class XrunMonitor {
+    
+    /// 进程级实例：汇总所有会话，未挂载观察者时不排队事件
+    public static let shared = XrunMonitor(name: "process", capacity: 1024, parent: nil)
+    
+    /// 后台取出事件的间隔
+    private static let drainInterval: DispatchTimeInterval = .milliseconds(200)
+    
+    let name: String
+    /// 事件队列容量
+    let capacity: Int
+    /// 转报的上级实例（shared 自身为 nil）
+    private let parent: XrunMonitor?
+    
+    // MARK: - Counters
+    private let counts = AtomicInt64Array(count: XrunKind.allCases.count)
+    private let frameTotals = AtomicInt64Array(count: XrunKind.allCases.count)
+    private let droppedEvents = AtomicInt64()
+    
+    // MARK: - Event Queue
+    private let writeSequence = AtomicInt64()
+    private let readSequence = AtomicInt64()
+    /// 槽位发布标记：写入完成后为序号 + 1
+    private let published: AtomicInt64Array
+    private let kinds: UnsafeMutablePointer<XrunKind>
+    private let origins: UnsafeMutablePointer<StaticString>
+    private let eventFrames: UnsafeMutablePointer<Int64>
+    private let hostTimes: UnsafeMutablePointer<UInt64>
+    /// 后台已开始取出事件（有旁路日志或观察者）时才排队，否则只计数
+    private let draining = AtomicInt64()
+    
+    // MARK: - Consumer (drainQueue)
+    private let drainQueue: DispatchQueue
+    private var timer: DispatchSourceTimer?
+    private var sidecar: FileHandle?
+    private var sidecarURL: URL?
+    private var observers: [Int: (XrunEvent) -> Void] = [:]
+    private var nextObserverID = 1
+    private let logger = Logger.shared
+    private static let traceNames = XrunKind.allCases.map { TraceName("xrun.\($0.name)", category: "xrun") }
+    
+    // MARK: - Initialization
+    
+    /// - Parameters:
+    ///   - name: 会话名（用于日志）
+    ///   - capacity: 事件队列容量
+    ///   - parent: 转报的上级实例，回放等独立运行时传 nil
+    init(name: String, capacity: Int = 256, parent: XrunMonitor? = .shared) {
+        self.name = name
+        self.capacity = capacity
+        self.parent = parent
+        published = AtomicInt64Array(count: capacity, tag: .diagnostics)
+        kinds = EngineMemory.allocate(XrunKind.self, capacity: capacity, tag: .diagnostics)
+        origins = EngineMemory.allocate(StaticString.self, capacity: capacity, tag: .diagnostics)
+        eventFrames = EngineMemory.allocate(Int64.self, capacity: capacity, tag: .diagnostics)
+        hostTimes = EngineMemory.allocate(UInt64.self, capacity: capacity, tag: .diagnostics)
+        drainQueue = DispatchQueue(label: "com.audiorecordkit.xrun.\(name)", qos: .utility)
+    }
+    
+    deinit {
+        timer?.cancel()
+        sidecar?.closeFile()
+        EngineMemory.deallocate(kinds, capacity: capacity, tag: .diagnostics)
+        EngineMemory.deallocate(origins, capacity: capacity, tag: .diagnostics)
+        EngineMemory.deallocate(eventFrames, capacity: capacity, tag: .diagnostics)
+        EngineMemory.deallocate(hostTimes, capacity: capacity, tag: .diagnostics)
+    }
+    
+    // MARK: - Reporting
+    
+    /// 报告一次事件（实时安全：不加锁、不分配），开启追踪时同时记录瞬时事件
+    @inline(__always)
+    func report(_ kind: XrunKind, origin: StaticString, frames: Int64, hostTime: UInt64 = mach_absolute_time()) {
+        record(kind, origin: origin, frames: frames, hostTime: hostTime)
+        parent?.record(kind, origin: origin, frames: frames, hostTime: hostTime)
+        EngineTrace.instant(XrunMonitor.traceNames[kind.rawValue], value: frames)
+    }
+    
+    @inline(__always)
+    private func record(_ kind: XrunKind, origin: StaticString, frames: Int64, hostTime: UInt64) {
+        counts.add(1, at: kind.rawValue)
+        frameTotals.add(frames, at: kind.rawValue)
+        if draining.value != 0 {
+            enqueue(kind, origin: origin, frames: frames, hostTime: hostTime)
+        }
+    }
+    
+    private func enqueue(_ kind: XrunKind, origin: StaticString, frames: Int64, hostTime: UInt64) {
+        // 先确认有空位再领取序号，保证已领取的序号一定会被发布
+        var sequence: Int64
+        repeat {
+            sequence = writeSequence.value
+            if sequence - readSequence.value >= Int64(capacity) {
+                droppedEvents.increment()
+                return
+            }
+        } while !writeSequence.compareExchange(expected: sequence, desired: sequence + 1)
+        
+        let slot = Int(sequence % Int64(capacity))
+        kinds[slot] = kind
+        origins[slot] = origin
+        eventFrames[slot] = frames
+        hostTimes[slot] = hostTime
+        published.store(sequence + 1, at: slot)
+    }
+    
+    // MARK: - Counters
+    
+    /// 某类事件的次数
+    public func count(of kind: XrunKind) -> Int64 {
+        return counts.load(kind.rawValue)
+    }
+    
+    /// 某类事件累计的帧数
+    func frames(of kind: XrunKind) -> Int64 {
+        return frameTotals.load(kind.rawValue)
+    }
+    
+    /// 事件队列满而未能记录详情的事件数（计数仍然准确）
+    var droppedEventCount: Int64 {
+        return droppedEvents.value
+    }
+    
+    /// 清零计数（录制中调用时并发的事件可能计入新旧任意一侧）
+    func resetCounters() {
+        for kind in XrunKind.allCases {
+            counts.store(0, at: kind.rawValue)
+            frameTotals.store(0, at: kind.rawValue)
+        }
+        droppedEvents.store(0)
+    }
+    
+    // MARK: - Observers
+    
+    /// 添加事件观察者（在主线程回调）
+    /// - Returns: 用于移除的标识
+    @discardableResult
+    func addObserver(_ handler: @escaping (XrunEvent) -> Void) -> Int {
+        return drainQueue.sync {
+            let id = nextObserverID
+            nextObserverID += 1
+            observers[id] = handler
+            startTimerIfNeeded()
+            return id
+        }
+    }
+    
+    func removeObserver(_ id: Int) {
+        drainQueue.sync {
+            _ = observers.removeValue(forKey: id)
+        }
+    }
+    
+    // MARK: - Recording Sidecar
+    
+    /// 开始一次录制：清零本会话的计数并在录音文件旁创建旁路日志
+    func beginRecording(fileURL: URL) {
+        resetCounters()
+        drainQueue.sync {
+            closeSidecar()
+            let url = fileURL.appendingPathExtension("xruns.log")
+            guard FileManager.default.createFile(atPath: url.path, contents: nil),
+                  let handle = try? FileHandle(forWritingTo: url) else {
+                logger.warning("⚠️ XrunMonitor[\(name)]: 无法创建旁路日志 \(url.lastPathComponent)")
+                return
+            }
+            sidecar = handle
+            sidecarURL = url
+            append("# xruns for \(fileURL.lastPathComponent), started \(ISO8601DateFormatter().string(from: Date()))\n")
+            append("# host_time_ns kind origin frames=N\n")
+            startTimerIfNeeded()
+        }
+    }
+    
+    /// 结束录制：取出剩余事件，写入汇总并关闭旁路日志
+    func endRecording() {
+        drainQueue.sync {
+            drain()
+            guard sidecar != nil else { return }
+            let summary = XrunKind.allCases.map { "\($0.name)=\(count(of: $0))/\(frames(of: $0))f" }.joined(separator: " ")
+            append("# summary \(summary) dropped=\(droppedEventCount)\n")
+            let total = XrunKind.allCases.reduce(Int64(0)) { $0 + count(of: $1) }
+            if total > 0 {
+                logger.warning("⚠️ XrunMonitor[\(name)]: 本次录制断流/溢出 \(total) 次 - \(summary)")
+            }
+            closeSidecar()
+        }
+    }
+    
+    // MARK: - Draining
+    
+    private func startTimerIfNeeded() {
+        guard timer == nil else { return }
+        let source = DispatchSource.makeTimerSource(queue: drainQueue)
+        source.schedule(deadline: .now() + XrunMonitor.drainInterval, repeating: XrunMonitor.drainInterval)
+        source.setEventHandler { [weak self] in
+            self?.drain()
+        }
+        source.resume()
+        timer = source
+        draining.store(1)
+    }
+    
+    /// 取出已发布的事件（drainQueue 上调用）
+    private func drain() {
+        var events: [XrunEvent] = []
+        var sequence = readSequence.value
+        while sequence < writeSequence.value {
+            let slot = Int(sequence % Int64(capacity))
+            // 序号已领取但尚未发布，下次再取
+            guard published.load(slot) == sequence + 1 else { break }
+            events.append(XrunEvent(
+                kind: kinds[slot],
+                origin: origins[slot].description,
+                frames: eventFrames[slot],
+                hostTime: hostTimes[slot],
+                hostTimeNanoseconds: PipelineStats.nanoseconds(fromHostTicks: hostTimes[slot])
+            ))
+            sequence += 1
+            readSequence.store(sequence)
+        }
+        guard !events.isEmpty else { return }
+        
+        if sidecar != nil {
+            append(events.map { "\($0)\n" }.joined())
+        }
+        let handlers = Array(observers.values)
+        if !handlers.isEmpty {
+            DispatchQueue.main.async {
+                for event in events {
+                    handlers.forEach { $0(event) }
+                }
+            }
+        }
+    }
+    
+    private func append(_ text: String) {
+        guard let sidecar = sidecar, let data = text.data(using: .utf8) else { return }
+        sidecar.seekToEndOfFile()
+        sidecar.write(data)
+    }
+    
+    private func closeSidecar() {
+        sidecar?.closeFile()
+        sidecar = nil
+        sidecarURL = nil
+    }
+}
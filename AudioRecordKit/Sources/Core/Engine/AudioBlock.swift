@@ -0,0 +1,171 @@
+import Foundation
+import Accelerate
+
+// MARK: - AudioBlock
+/// 处理图内部流转的音频块
+///
+/// 采用非交错（planar）Float32 存储，每个声道连续排列。
+/// 容量在创建时固定，渲染期间只读写已有内存，不做任何分配。
+/// 源节点可以借用外部的非交错缓冲区（零拷贝），借用期间块只读。
+@_spi(Benchmarks) public final class AudioBlock {
+    
+    // MARK: - Properties
+    let channelCapacity: Int
+    let frameCapacity: Int
+    public private(set) var channelCount: Int
+    public var frameCount: Int = 0
+    var sampleRate: Double
+    /// 块起始样本序号（从录制开始累计）
+    var sampleTime: Int64 = 0
+    /// 块捕获时刻（mach_absolute_time）
+    var hostTime: UInt64 = 0
+    
+    /// 是否正在借用外部缓冲区
+    private(set) var isBorrowed = false
+    
+    private let storage: UnsafeMutablePointer<Float>
+    /// 各声道起始指针（默认指向自有存储，借用时指向外部内存）
+    private let channelPointers: UnsafeMutablePointer<UnsafeMutablePointer<Float>>
+    
+    // MARK: - Initialization
+    
+    public init(channels: Int, frameCapacity: Int, sampleRate: Double) {
+        precondition(channels > 0 && frameCapacity > 0, "AudioBlock 容量必须大于0")
+        self.channelCapacity = channels
+        self.frameCapacity = frameCapacity
+        self.channelCount = channels
+        self.sampleRate = sampleRate
+        storage = EngineMemory.allocate(Float.self, capacity: channels * frameCapacity, tag: .blocks)
+        storage.initialize(repeating: 0, count: channels * frameCapacity)
+        channelPointers = EngineMemory.allocate(UnsafeMutablePointer<Float>.self, capacity: channels, tag: .blocks)
+        for c in 0..<channels {
+            (channelPointers + c).initialize(to: storage + c * frameCapacity)
+        }
+    }
+    
+    deinit {
+        EngineMemory.deallocate(channelPointers, capacity: channelCapacity, tag: .blocks)
+        EngineMemory.deallocate(storage, capacity: channelCapacity * frameCapacity, tag: .blocks)
+    }
+    
+    /// 块持有的字节数（存储 + 声道指针表）
+    var allocatedBytes: Int {
+        return channelCapacity * frameCapacity * MemoryLayout<Float>.stride
+            + channelCapacity * MemoryLayout<UnsafeMutablePointer<Float>>.stride
+    }
+    
+    // MARK: - Channel Access
+    
+    /// 第 index 个声道的样本指针
+    @inline(__always)
+    public func channel(_ index: Int) -> UnsafeMutablePointer<Float> {
+        return channelPointers[index]
+    }
+    
+    /// 调整当前声道数（不超过容量）
+    public func setChannelCount(_ count: Int) {
+        channelCount = min(max(1, count), channelCapacity)
+    }
+    
+    // MARK: - Borrowing
+    
+    /// 借用外部非交错缓冲区（零拷贝）
+    ///
+    /// 下游节点直接读取外部内存，调用方保证在本次渲染结束前外部内存有效。
+    /// 借用期间不得写入块，需要写入时先调用 `detach()` 或 `restoreStorage()`。
+    /// - Returns: 声道数或帧数超出容量时返回 false（块保持原状）
+    @discardableResult
+    func borrow(channels: UnsafePointer<UnsafePointer<Float>>, count: Int, frames: Int) -> Bool {
+        guard count > 0, count <= channelCapacity, frames <= frameCapacity else { return false }
+        for c in 0..<count {
+            channelPointers[c] = UnsafeMutablePointer(mutating: channels[c])
+        }
+        channelCount = count
+        frameCount = frames
+        isBorrowed = true
+        return true
+    }
+    
+    /// 结束借用，声道指针恢复为自有存储（内容不保留）
+    func restoreStorage() {
+        guard isBorrowed else { return }
+        for c in 0..<channelCapacity {
+            channelPointers[c] = storage + c * frameCapacity
+        }
+        isBorrowed = false
+    }
+    
+    /// 把借用的数据拷入自有存储后结束借用，之后可以写入
+    func detach() {
+        guard isBorrowed else { return }
+        for c in 0..<channelCount {
+            (storage + c * frameCapacity).update(from: channelPointers[c], count: frameCount)
+        }
+        restoreStorage()
+    }
+    
+    // MARK: - Bulk Operations
+    
+    /// 将当前声道的前 frames 帧清零
+    func clear(frames: Int? = nil) {
+        let n = vDSP_Length(min(frames ?? frameCapacity, frameCapacity))
+        for c in 0..<channelCount {
+            vDSP_vclr(channel(c), 1, n)
+        }
+    }
+    
+    /// 复制另一个块的内容与时间信息
+    func copy(from other: AudioBlock) {
+        let frames = min(other.frameCount, frameCapacity)
+        setChannelCount(other.channelCount)
+        for c in 0..<channelCount {
+            channel(c).update(from: other.channel(min(c, other.channelCount - 1)), count: frames)
+        }
+        frameCount = frames
+        sampleTime = other.sampleTime
+        hostTime = other.hostTime
+    }
+    
+    /// 从交错数据解交错写入
+    ///
+    /// 源声道数少于块声道数时，缺失声道复制源的最后一个声道（单声道→立体声即左右相同）。
+    public func deinterleave(from source: UnsafePointer<Float>, channels sourceChannels: Int, frames: Int) {
+        let n = min(frames, frameCapacity)
+        guard sourceChannels > 0, n > 0 else {
+            frameCount = 0
+            return
+        }
+        for c in 0..<channelCount {
+            let sc = min(c, sourceChannels - 1)
+            // 把交错源看作 n 行 × sourceChannels 列的矩阵，拷贝第 sc 列
+            vDSP_mmov(source + sc, channel(c), 1, vDSP_Length(n), vDSP_Length(sourceChannels), 1)
+        }
+        frameCount = n
+    }
+    
+    /// 从 AudioBufferList 视图拷贝（交错或非交错，按声道步长读取）
+    ///
+    /// 源声道数少于块声道数时，缺失声道复制源的最后一个声道。
+    func copy(from view: AudioBufferListView, frames: Int) {
+        let n = min(frames, view.frameCount, frameCapacity)
+        guard view.channelCount > 0, n > 0 else {
+            frameCount = 0
+            return
+        }
+        for c in 0..<channelCount {
+            let sc = min(c, view.channelCount - 1)
+            vDSP_mmov(view.channel(sc), channel(c), 1, vDSP_Length(n), vDSP_Length(view.stride(sc)), 1)
+        }
+        frameCount = n
+    }
+    
+    /// 交错写出到目标缓冲区（目标需至少 frames × channels 个样本）
+    public func interleave(into destination: UnsafeMutablePointer<Float>, channels destinationChannels: Int, frames: Int? = nil) {
+        let n = min(frames ?? frameCount, frameCount)
+        guard destinationChannels > 0, n > 0 else { return }
+        for c in 0..<destinationChannels {
+            let sc = min(c, channelCount - 1)
+            vDSP_mmov(channel(sc), destination + c, 1, vDSP_Length(n), 1, vDSP_Length(destinationChannels))
+        }
+    }
+}
@@ -0,0 +1,94 @@
+import Foundation
+import CoreAudio
+
+// MARK: - AudioBufferListView
+/// AudioBufferList 的逐声道视图 - 统一交错与非交错（planar）两种布局
+///
+/// - 交错：一个缓冲区包含全部声道，第 c 声道从 `mData + c` 开始，步长为该缓冲区的声道数；
+/// - 非交错：每个缓冲区一个声道，步长为 1；
+/// - 多个缓冲区各自交错时按缓冲区顺序展开声道。
+///
+/// 指针表按最大声道数预分配，IO 线程上重复 `bind` 不分配内存。
+/// 视图只引用缓冲区内存，绑定的 AudioBufferList 失效后视图也随之失效。
+@_spi(Benchmarks) public final class AudioBufferListView {
+    
+    // MARK: - Properties
+    let maxChannels: Int
+    /// 当前声道数
+    private(set) var channelCount = 0
+    /// 每个声道可读的帧数（各缓冲区取最小值）
+    private(set) var frameCount = 0
+    /// 缓冲区个数
+    private(set) var bufferCount = 0
+    /// 所有声道的步长都为 1（可直接作为非交错声道指针使用）
+    private(set) var isPlanar = false
+    
+    private let pointers: UnsafeMutablePointer<UnsafePointer<Float>>
+    private let strides: UnsafeMutablePointer<Int>
+    
+    // MARK: - Initialization
+    
+    public init(maxChannels: Int = 64) {
+        self.maxChannels = max(maxChannels, 1)
+        pointers = UnsafeMutablePointer<UnsafePointer<Float>>.allocate(capacity: self.maxChannels)
+        strides = UnsafeMutablePointer<Int>.allocate(capacity: self.maxChannels)
+        strides.initialize(repeating: 1, count: self.maxChannels)
+    }
+    
+    deinit {
+        pointers.deallocate()
+        strides.deallocate()
+    }
+    
+    // MARK: - Binding
+    
+    /// 绑定 Float32 AudioBufferList
+    /// - Returns: 是否得到至少一个有效声道（超出 maxChannels 的声道被忽略）
+    @discardableResult
+    public func bind(_ bufferList: UnsafePointer<AudioBufferList>) -> Bool {
+        let buffers = UnsafeMutableAudioBufferListPointer(UnsafeMutablePointer(mutating: bufferList))
+        var channels = 0
+        var frames = Int.max
+        var planar = true
+        
+        for buffer in buffers {
+            guard let data = buffer.mData, buffer.mDataByteSize > 0 else { continue }
+            let bufferChannels = max(Int(buffer.mNumberChannels), 1)
+            let samples = data.assumingMemoryBound(to: Float.self)
+            frames = min(frames, Int(buffer.mDataByteSize) / (MemoryLayout<Float>.size * bufferChannels))
+            if bufferChannels > 1 {
+                planar = false
+            }
+            for c in 0..<bufferChannels where channels < maxChannels {
+                pointers[channels] = UnsafePointer(samples + c)
+                strides[channels] = bufferChannels
+                channels += 1
+            }
+        }
+        
+        bufferCount = buffers.count
+        channelCount = channels
+        frameCount = channels > 0 ? frames : 0
+        isPlanar = planar
+        return channels > 0
+    }
+    
+    // MARK: - Channel Access
+    
+    /// 第 index 个声道的起始指针
+    @inline(__always)
+    func channel(_ index: Int) -> UnsafePointer<Float> {
+        return pointers[index]
+    }
+    
+    /// 第 index 个声道的样本步长
+    @inline(__always)
+    func stride(_ index: Int) -> Int {
+        return strides[index]
+    }
+    
+    /// 逐声道指针表（仅在 `isPlanar` 时可当作非交错数据使用）
+    var channelPointers: UnsafePointer<UnsafePointer<Float>> {
+        return UnsafePointer(pointers)
+    }
+}
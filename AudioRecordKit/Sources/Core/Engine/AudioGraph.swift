@@ -0,0 +1,249 @@
+import Foundation
+import Darwin
+
+// MARK: - AudioGraphError
+/// 处理图错误
+enum AudioGraphError: Error, LocalizedError {
+    case cycleDetected([String])
+    case invalidConnection(String)
+    case alreadyCompiled
+    
+    var errorDescription: String? {
+        switch self {
+        case .cycleDetected(let names):
+            return "处理图存在环路: \(names.joined(separator: " -> "))"
+        case .invalidConnection(let reason):
+            return "无效的节点连接: \(reason)"
+        case .alreadyCompiled:
+            return "处理图已编译，不能再修改拓扑"
+        }
+    }
+}
+
+// MARK: - AudioGraph
+/// 声明式音频处理图
+///
+/// 使用方式：
+/// 1. `add(_:)` 添加节点（源 / 处理器 / 输出端）；
+/// 2. `connect(_:to:)` 声明数据流向；
+/// 3. `compile()` 做拓扑排序并创建调度器；
+/// 4. 每个量子调用 `render(frameCount:hostTime:)`，由调度器按依赖执行，独立分支可并行。
+@_spi(Benchmarks) public final class AudioGraph {
+    
+    // MARK: - Properties
+    let name: String
+    let sampleRate: Double
+    let maxFramesPerQuantum: Int
+    /// 会话内存账户（节点加入时记入其缓冲区）
+    let memory: MemoryAccount
+    /// 会话内存区（nil 表示节点缓冲区直接分配在堆上）
+    public let arena: EngineArena?
+    /// 节点报告断流 / 溢出的会话监测
+    let xruns: XrunMonitor
+    
+    private(set) var nodes: [AudioNode] = []
+    private var edges: [(from: Int, to: Int)] = []
+    private(set) var executionOrder: [AudioNode] = []
+    private(set) var isCompiled = false
+    
+    private let requestedWorkerCount: Int
+    private var scheduler: AudioGraphScheduler?
+    private var sampleTime: Int64 = 0
+    /// 向 EngineTrace 预留的渲染线程数
+    private var tracedThreads = 0
+    
+    /// 阶段计时器（由 IO 回调设置；设置后调度器对每个节点计时）
+    var stageTimer: PipelineStageTimer?
+    private let logger = Logger.shared
+    
+    /// 调度器实际使用的工作线程数（编译前为 0）
+    public var workerCount: Int {
+        return scheduler?.workerCount ?? 0
+    }
+    
+    /// 默认单量子最大帧数（覆盖常见 IO 缓冲区大小）
+    public static let defaultMaxFramesPerQuantum = 16384
+    
+    /// 默认工作线程数：保留一个核心给调用线程，最多 3 个
+    public static var defaultWorkerCount: Int {
+        return max(0, min(ProcessInfo.processInfo.activeProcessorCount - 1, 3))
+    }
+    
+    // MARK: - Initialization
+    
+    /// - Parameters:
+    ///   - workerCount: 工作线程数；0 表示在调用线程上串行执行
+    ///   - arena: 会话内存区，`withArena(_:)` 内创建的节点从中分配缓冲区，处理图释放时一并关闭
+    ///   - xruns: 会话的断流监测（通常是文件管理器的实例），未指定时报告到进程级实例
+    ///   - memory: 会话内存账户（建图前已用它批准缓冲区大小时传入），未指定时新建
+    public init(name: String, sampleRate: Double, maxFramesPerQuantum: Int, workerCount: Int = AudioGraph.defaultWorkerCount,
+         arena: EngineArena? = nil, xruns: XrunMonitor = .shared, memory: MemoryAccount? = nil) {
+        self.name = name
+        self.sampleRate = sampleRate
+        self.maxFramesPerQuantum = maxFramesPerQuantum
+        self.requestedWorkerCount = max(0, workerCount)
+        self.memory = memory ?? EngineMemory.makeSessionAccount(name: name)
+        self.arena = arena
+        self.xruns = xruns
+    }
+    
+    deinit {
+        scheduler?.shutdown()
+        releaseTraceThreads()
+        guard let arena = arena else { return }
+        // 节点在丢弃作用域内析构，内存区中的块不再逐个归还
+        arena.drop {
+            scheduler = nil
+            executionOrder = []
+            nodes = []
+        }
+    }
+    
+    /// 在会话内存区作用域内构建节点（没有内存区时直接执行）
+    public func withArena<T>(_ body: () throws -> T) rethrows -> T {
+        guard let arena = arena else { return try body() }
+        return try arena.withCurrent(body)
+    }
+    
+    // MARK: - Topology
+    
+    /// 添加节点
+    @discardableResult
+    public func add<Node: AudioNode>(_ node: Node) -> Node {
+        precondition(!isCompiled, "处理图已编译，不能再添加节点")
+        node.graphIndex = nodes.count
+        node.xruns = xruns
+        nodes.append(node)
+        memory.adopt(node.memoryLedger)
+        return node
+    }
+    
+    /// 连接两个节点（from 的输出作为 to 的下一个输入）
+    public func connect(_ from: AudioNode, to: AudioNode) throws {
+        guard !isCompiled else { throw AudioGraphError.alreadyCompiled }
+        guard from.graphIndex >= 0, from.graphIndex < nodes.count, nodes[from.graphIndex] === from,
+              to.graphIndex >= 0, to.graphIndex < nodes.count, nodes[to.graphIndex] === to else {
+            throw AudioGraphError.invalidConnection("节点 \(from.name) 或 \(to.name) 未加入图 \(name)")
+        }
+        guard from.role != .sink else {
+            throw AudioGraphError.invalidConnection("输出端节点 \(from.name) 不能作为上游")
+        }
+        guard to.role != .source else {
+            throw AudioGraphError.invalidConnection("源节点 \(to.name) 不能有上游")
+        }
+        edges.append((from.graphIndex, to.graphIndex))
+    }
+    
+    /// 拓扑排序并创建调度器
+    public func compile() throws {
+        guard !isCompiled else { throw AudioGraphError.alreadyCompiled }
+        
+        let count = nodes.count
+        var successors = [[Int]](repeating: [], count: count)
+        var indegrees = [Int](repeating: 0, count: count)
+        var inputs = [[AudioNode]](repeating: [], count: count)
+        for edge in edges {
+            successors[edge.from].append(edge.to)
+            indegrees[edge.to] += 1
+            inputs[edge.to].append(nodes[edge.from])
+        }
+        
+        // Kahn 算法，同时计算每个节点的层级（最长路径深度）用于估计并行宽度
+        var remainingIndegrees = indegrees
+        var queue = indegrees.indices.filter { indegrees[$0] == 0 }
+        var levels = [Int](repeating: 0, count: count)
+        var order: [Int] = []
+        order.reserveCapacity(count)
+        var cursor = 0
+        while cursor < queue.count {
+            let index = queue[cursor]
+            cursor += 1
+            order.append(index)
+            for successor in successors[index] {
+                levels[successor] = max(levels[successor], levels[index] + 1)
+                remainingIndegrees[successor] -= 1
+                if remainingIndegrees[successor] == 0 {
+                    queue.append(successor)
+                }
+            }
+        }
+        
+        guard order.count == count else {
+            let cyclic = nodes.indices.filter { remainingIndegrees[$0] > 0 }.map { nodes[$0].name }
+            throw AudioGraphError.cycleDetected(cyclic)
+        }
+        
+        var nodesPerLevel: [Int: Int] = [:]
+        for level in levels {
+            nodesPerLevel[level, default: 0] += 1
+        }
+        let parallelWidth = nodesPerLevel.values.max() ?? 1
+        
+        for (index, node) in nodes.enumerated() {
+            node.inputs = inputs[index]
+        }
+        executionOrder = order.map { nodes[$0] }
+        
+        scheduler = AudioGraphScheduler(
+            nodes: nodes,
+            successors: successors,
+            indegrees: indegrees,
+            topologicalOrder: order,
+            parallelWidth: parallelWidth,
+            workerCount: requestedWorkerCount,
+            xruns: xruns
+        )
+        isCompiled = true
+        // 节点已收录各自的分配，建图前的预留不再计入预算
+        memory.settleReservations()
+        // IO 线程与工作线程第一次记录日志 / 追踪事件时从预留的队列与缓冲区中领取
+        tracedThreads = (scheduler?.workerCount ?? 0) + 1
+        BinaryLog.reserveRings(tracedThreads)
+        EngineTrace.reserveThreads(tracedThreads)
+        
+        let arenaInfo = arena.map { "（内存区 \($0.usedBytes / 1024)/\($0.capacity / 1024)KB\($0.isHugePageBacked ? "，超级页" : "")）" } ?? ""
+        logger.info("🧩 AudioGraph[\(name)]: 编译完成 - 节点 \(count) 个, 连接 \(edges.count) 条, 并行宽度 \(parallelWidth), 工作线程 \(workerCount), 内存 \(memory.totalBytes / 1024)KB\(arenaInfo)")
+        logger.info("🧩 AudioGraph[\(name)]: 执行顺序 \(executionOrder.map { $0.name }.joined(separator: " → "))")
+    }
+    
+    // MARK: - Rendering
+    
+    /// 渲染一个量子（在采集回调线程调用）
+    public func render(frameCount: Int, hostTime: UInt64 = mach_absolute_time()) {
+        guard let scheduler = scheduler, frameCount > 0 else { return }
+        let frames = min(frameCount, maxFramesPerQuantum)
+        let context = AudioRenderContext(
+            frameCount: frames,
+            sampleTime: sampleTime,
+            hostTime: hostTime,
+            sampleRate: sampleRate,
+            timer: stageTimer
+        )
+        // 块处理期间开启 FTZ/DAZ，返回 IO 回调前恢复宿主的浮点环境
+        DenormalScope.run {
+            scheduler.run(context)
+        }
+        sampleTime += Int64(frames)
+    }
+    
+    /// 重置所有节点状态与样本计数
+    func reset() {
+        sampleTime = 0
+        for node in nodes {
+            node.reset()
+        }
+    }
+    
+    /// 停止调度器工作线程（图之后不可再渲染）
+    public func shutdown() {
+        scheduler?.shutdown()
+        scheduler = nil
+        releaseTraceThreads()
+    }
+    
+    private func releaseTraceThreads() {
+        guard tracedThreads > 0 else { return }
+        EngineTrace.releaseThreads(tracedThreads)
+        tracedThreads = 0
+    }
+}
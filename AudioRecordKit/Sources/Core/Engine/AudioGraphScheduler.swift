@@ -0,0 +1,251 @@
+import Foundation
+import Darwin
+
+// MARK: - AudioGraphScheduler
+/// 处理图调度器 - 按拓扑依赖在多个线程上执行一个量子
+///
+/// 调度方式：
+/// - 每个节点持有一个依赖计数器（入度），量子开始时重置；
+/// - 节点完成后原子递减后继的计数器，归零即就绪；
+/// - 就绪节点进入无锁就绪队列（每个量子每个节点恰好入队一次，无需环绕）；
+/// - 完成节点的线程若只有一个后继就绪，直接在本线程继续执行，减少线程切换；
+/// - 调用线程（通常是 IO 回调线程）自身也参与执行，队列为空后自旋等待剩余节点完成，
+///   但不超过一个量子的时长，也从不在信号量上阻塞；超时记一次回调超时，
+///   本量子由工作线程完成，它们退出前下一个量子不再渲染（同样计为超时）。
+final class AudioGraphScheduler {
+    
+    // MARK: - Properties
+    private let nodes: [AudioNode]
+    private let successors: [[Int]]
+    private let indegrees: UnsafeMutableBufferPointer<Int64>
+    private let roots: [Int]
+    private let serialOrder: [Int]
+    private let parallelWidth: Int
+    
+    private let pending: AtomicInt64Array
+    /// 就绪队列槽位：0 表示尚未发布，否则为节点索引 + 1
+    private let readySlots: AtomicInt64Array
+    private let queueHead = AtomicInt64()
+    private let queueTail = AtomicInt64()
+    private let remaining = AtomicInt64()
+    /// 已唤醒但尚未退出本量子的工作线程数
+    private let outstandingWorkers = AtomicInt64()
+    private let isShuttingDown = AtomicInt64()
+    
+    private var workers: [Thread] = []
+    private var startSemaphores: [DispatchSemaphore] = []
+    /// 超过截止时间时报告到的会话监测
+    private let xruns: XrunMonitor
+    
+    /// 当前量子上下文（在唤醒工作线程之前写入，信号量保证可见性）
+    private var context = AudioRenderContext(frameCount: 0, sampleTime: 0, hostTime: 0, sampleRate: 0)
+    
+    /// 工作线程在队列为空时最多自旋的次数
+    private let workerSpinLimit = 4096
+    
+    private static let waitTraceName = TraceName("scheduler.wait", category: "wait")
+    private static let workerTraceName = TraceName("scheduler.worker", category: "scheduler")
+    
+    // MARK: - Initialization
+    
+    init(nodes: [AudioNode], successors: [[Int]], indegrees: [Int], topologicalOrder: [Int], parallelWidth: Int, workerCount: Int,
+         xruns: XrunMonitor = .shared) {
+        self.nodes = nodes
+        self.xruns = xruns
+        self.successors = successors
+        self.serialOrder = topologicalOrder
+        self.parallelWidth = parallelWidth
+        self.roots = indegrees.indices.filter { indegrees[$0] == 0 }
+        
+        self.indegrees = UnsafeMutableBufferPointer<Int64>.allocate(capacity: max(nodes.count, 1))
+        _ = self.indegrees.initialize(from: indegrees.map { Int64($0) })
+        self.pending = AtomicInt64Array(count: nodes.count)
+        self.readySlots = AtomicInt64Array(count: nodes.count)
+        
+        // 并行宽度为1（纯链路）时不需要工作线程
+        let effectiveWorkers = parallelWidth > 1 ? min(workerCount, parallelWidth - 1) : 0
+        for index in 0..<effectiveWorkers {
+            let semaphore = DispatchSemaphore(value: 0)
+            startSemaphores.append(semaphore)
+            // 线程强引用调度器，shutdown() 后线程退出并释放引用
+            let thread = Thread {
+                self.workerLoop(semaphore: semaphore)
+            }
+            thread.name = "com.audiorecordkit.graph.worker.\(index)"
+            thread.qualityOfService = .userInteractive
+            thread.stackSize = 512 * 1024
+            workers.append(thread)
+            thread.start()
+        }
+    }
+    
+    deinit {
+        indegrees.deallocate()
+    }
+    
+    // MARK: - Public Methods
+    
+    /// 实际参与调度的工作线程数（不含调用线程）
+    var workerCount: Int {
+        return workers.count
+    }
+    
+    /// 执行一个量子：调用线程参与执行并自旋等待，最长一个量子的时长
+    func run(_ context: AudioRenderContext) {
+        guard !workers.isEmpty else {
+            for index in serialOrder {
+                execute(nodes[index], context)
+            }
+            return
+        }
+        
+        let deadline = mach_absolute_time() + PipelineStats.hostTicks(
+            fromNanoseconds: UInt64(Double(context.frameCount) / max(context.sampleRate, 1) * 1e9))
+        
+        // 上一个量子的工作线程通常已退出或即将退出；超时仍未退出时跳过本量子，避免其观察到重置过程中的状态
+        var spins = 0
+        while outstandingWorkers.value > 0 {
+            spins += 1
+            if spins & 63 == 0 && mach_absolute_time() >= deadline {
+                xruns.report(.callbackOverrun, origin: "scheduler", frames: Int64(context.frameCount), hostTime: context.hostTime)
+                return
+            }
+        }
+        
+        self.context = context
+        pending.resetUnsynchronized(UnsafeBufferPointer(indegrees))
+        readySlots.fillUnsynchronized(0)
+        queueHead.store(0)
+        queueTail.store(0)
+        remaining.store(Int64(nodes.count))
+        
+        for root in roots {
+            push(root)
+        }
+        
+        outstandingWorkers.add(Int64(workers.count))
+        for semaphore in startSemaphores {
+            semaphore.signal()
+        }
+        
+        if !drain(spinLimit: Int.max, deadline: deadline) {
+            let span = EngineTrace.span(AudioGraphScheduler.waitTraceName)
+            while remaining.value > 0 {
+                if mach_absolute_time() >= deadline {
+                    // 不阻塞 IO 线程：剩余节点由工作线程完成，本量子计为一次超时
+                    xruns.report(.callbackOverrun, origin: "scheduler", frames: Int64(context.frameCount), hostTime: context.hostTime)
+                    break
+                }
+            }
+            span.end()
+        }
+    }
+    
+    /// 停止并回收工作线程
+    func shutdown() {
+        guard isShuttingDown.exchange(1) == 0 else { return }
+        for semaphore in startSemaphores {
+            semaphore.signal()
+        }
+        startSemaphores.removeAll()
+        workers.removeAll()
+    }
+    
+    // MARK: - Private Methods
+    
+    private func workerLoop(semaphore: DispatchSemaphore) {
+        // 工作线程只运行 DSP，常驻开启 FTZ/DAZ
+        DenormalScope.enableForCurrentThread()
+        while true {
+            semaphore.wait()
+            if isShuttingDown.value != 0 {
+                return
+            }
+            RealtimeSafety.enterRealtime()
+            let span = EngineTrace.span(AudioGraphScheduler.workerTraceName)
+            _ = drain(spinLimit: workerSpinLimit)
+            span.end()
+            RealtimeSafety.exitRealtime()
+            outstandingWorkers.decrement()
+        }
+    }
+    
+    /// 执行就绪节点直到图完成、队列长时间为空或超过截止时间
+    /// - Returns: 当前线程是否完成了本量子的最后一个节点
+    private func drain(spinLimit: Int, deadline: UInt64 = .max) -> Bool {
+        var spins = 0
+        while true {
+            if var current = pop() {
+                spins = 0
+                while current >= 0 {
+                    execute(nodes[current], context)
+                    
+                    var next = -1
+                    for successor in successors[current] {
+                        guard pending.add(-1, at: successor) == 0 else { continue }
+                        if next < 0 {
+                            next = successor
+                        } else {
+                            push(successor)
+                        }
+                    }
+                    
+                    if remaining.decrement() == 0 {
+                        return true
+                    }
+                    current = next
+                }
+            } else {
+                if remaining.value == 0 {
+                    return false
+                }
+                spins += 1
+                if spins >= spinLimit {
+                    return false
+                }
+                if spins & 63 == 0 {
+                    if mach_absolute_time() >= deadline {
+                        return false
+                    }
+                    sched_yield()
+                }
+            }
+        }
+    }
+    
+    /// 执行单个节点；挂载了计时器时把耗时计入节点所属阶段，开启追踪时记录一个区间
+    @inline(__always)
+    private func execute(_ node: AudioNode, _ context: AudioRenderContext) {
+        let span = EngineTrace.span(node.traceName)
+        defer { span.end() }
+        guard let timer = context.timer, let stage = node.statsStage else {
+            node.process(context)
+            return
+        }
+        let mark = StageMark.now()
+        node.process(context)
+        timer.add(stage, since: mark)
+    }
+    
+    private func push(_ index: Int) {
+        let slot = Int(queueTail.add(1) - 1)
+        _ = readySlots.compareExchange(expected: 0, desired: Int64(index + 1), at: slot)
+    }
+    
+    private func pop() -> Int? {
+        while true {
+            let head = queueHead.value
+            if head >= queueTail.value {
+                return nil
+            }
+            if queueHead.compareExchange(expected: head, desired: head + 1) {
+                // 生产者先递增 tail 再发布槽位，这里短暂等待发布完成
+                var published = readySlots.load(Int(head))
+                while published == 0 {
+                    published = readySlots.load(Int(head))
+                }
+                return Int(published - 1)
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+import Foundation
+
+// MARK: - AudioNodeRole
+/// 节点在处理图中的角色
+enum AudioNodeRole: String {
+    case source     // 采集源（Process Tap、麦克风、文件回放等）
+    case processor  // 处理器（重采样、混音、限幅、AGC 等）
+    case sink       // 输出端（文件写入、电平表、旁路 Tap 等）
+}
+
+// MARK: - AudioRenderContext
+/// 单个处理量子（quantum）的渲染上下文
+@_spi(Benchmarks) public struct AudioRenderContext {
+    /// 本量子的帧数
+    public let frameCount: Int
+    /// 本量子起始样本序号
+    public let sampleTime: Int64
+    /// 本量子捕获时刻（mach_absolute_time）
+    let hostTime: UInt64
+    /// 图的采样率
+    let sampleRate: Double
+    /// 阶段计时器（未挂载统计时为 nil）
+    var timer: PipelineStageTimer? = nil
+}
+
+// MARK: - AudioNode
+/// 处理图节点基类
+///
+/// 每个节点拥有自己的输出块；输入直接读取上游节点的输出块，不做拷贝。
+/// `process(_:)` 在渲染线程（或调度器工作线程）调用，实现中不得加锁、分配内存或写日志。
+@_spi(Benchmarks) public class AudioNode {
+    
+    // MARK: - Properties
+    let name: String
+    let role: AudioNodeRole
+    let output: AudioBlock
+    
+    /// 上游节点，按连接顺序排列（由 AudioGraph.compile() 填充，渲染期间只读）
+    internal(set) var inputs: [AudioNode] = []
+    /// 节点在图中的索引（由 AudioGraph 分配）
+    internal(set) var graphIndex: Int = -1
+    /// 断流 / 溢出报告目标（加入处理图时设为图的会话监测）
+    internal(set) var xruns: XrunMonitor = .shared
+    /// 调度器计时时计入的统计阶段（nil 表示节点自行计时或不计时）
+    var statsStage: PipelineStage?
+    /// 引擎追踪中的事件名（类别为节点角色）
+    let traceName: TraceName
+    /// 节点持有的引擎内存（加入处理图时记入会话账户）
+    private(set) var memoryLedger = MemoryLedger()
+    
+    // MARK: - Initialization
+    
+    init(name: String, role: AudioNodeRole, channels: Int, maxFrames: Int, sampleRate: Double) {
+        self.name = name
+        self.role = role
+        self.output = AudioBlock(channels: channels, frameCapacity: maxFrames, sampleRate: sampleRate)
+        self.traceName = TraceName(name, category: role.rawValue)
+        memoryLedger.add(output.allocatedBytes, tag: .blocks)
+        switch role {
+        case .source: self.statsStage = .ingest
+        case .processor: self.statsStage = .process
+        case .sink: self.statsStage = .analysis
+        }
+    }
+    
+    // MARK: - Overridable
+    
+    /// 处理一个量子（子类必须重写）
+    func process(_ context: AudioRenderContext) {
+        fatalError("Subclasses must implement process(_:)")
+    }
+    
+    /// 重置内部状态（重新开始录制时调用）
+    func reset() {
+        output.frameCount = 0
+    }
+    
+    // MARK: - Helpers
+    
+    /// 登记子类自行分配的缓冲区（在初始化时调用）
+    func recordAllocation(_ bytes: Int, tag: MemoryTag) {
+        memoryLedger.add(bytes, tag: tag)
+    }
+    
+    /// 第 index 个输入的输出块
+    @inline(__always)
+    func input(_ index: Int) -> AudioBlock {
+        return inputs[index].output
+    }
+    
+    /// 将输出块的时间信息与上下文对齐
+    @inline(__always)
+    func stampOutput(_ context: AudioRenderContext, frames: Int) {
+        output.frameCount = frames
+        output.sampleTime = context.sampleTime
+        output.hostTime = context.hostTime
+    }
+}
@@ -0,0 +1,146 @@
+import Foundation
+import CoreAudio
+import AudioToolbox
+
+// MARK: - ChannelLayout
+/// 声道布局 - 每个声道的 CoreAudio 标签
+///
+/// 来源优先级：设备的 kAudioDevicePropertyPreferredChannelLayout → 按声道数推断的默认布局。
+@_spi(Benchmarks) public struct ChannelLayout: Equatable, CustomStringConvertible {
+    
+    // MARK: - Properties
+    let labels: [AudioChannelLabel]
+    
+    var channelCount: Int {
+        return labels.count
+    }
+    
+    // MARK: - Presets
+    static let mono = ChannelLayout(labels: [kAudioChannelLabel_Mono])
+    static let stereo = ChannelLayout(labels: [kAudioChannelLabel_Left, kAudioChannelLabel_Right])
+    static let quadraphonic = ChannelLayout(labels: [
+        kAudioChannelLabel_Left, kAudioChannelLabel_Right,
+        kAudioChannelLabel_LeftSurround, kAudioChannelLabel_RightSurround
+    ])
+    /// 5.1（MPEG 5.1 A：L R C LFE Ls Rs）
+    static let surround51 = ChannelLayout(labels: [
+        kAudioChannelLabel_Left, kAudioChannelLabel_Right, kAudioChannelLabel_Center,
+        kAudioChannelLabel_LFEScreen, kAudioChannelLabel_LeftSurround, kAudioChannelLabel_RightSurround
+    ])
+    /// 7.1（MPEG 7.1 C：L R C LFE Ls Rs Rls Rrs）
+    static let surround71 = ChannelLayout(labels: [
+        kAudioChannelLabel_Left, kAudioChannelLabel_Right, kAudioChannelLabel_Center,
+        kAudioChannelLabel_LFEScreen, kAudioChannelLabel_LeftSurround, kAudioChannelLabel_RightSurround,
+        kAudioChannelLabel_RearSurroundLeft, kAudioChannelLabel_RearSurroundRight
+    ])
+    
+    // MARK: - Initialization
+    
+    init(labels: [AudioChannelLabel]) {
+        self.labels = labels
+    }
+    
+    /// 按声道数推断默认布局（未知声道数使用离散声道）
+    init(channelCount: Int) {
+        switch channelCount {
+        case 1: self = .mono
+        case 2: self = .stereo
+        case 4: self = .quadraphonic
+        case 6: self = .surround51
+        case 8: self = .surround71
+        default:
+            self.labels = (0..<max(channelCount, 1)).map { kAudioChannelLabel_Discrete_0 | AudioChannelLabel($0) }
+        }
+    }
+    
+    /// 从流格式推断
+    init(format: AudioStreamBasicDescription) {
+        self.init(channelCount: Int(format.mChannelsPerFrame))
+    }
+    
+    /// 解析 CoreAudio AudioChannelLayout（支持声道描述、位图与布局标签三种形式）
+    init(audioChannelLayout pointer: UnsafePointer<AudioChannelLayout>) {
+        let tag = pointer.pointee.mChannelLayoutTag
+        
+        if tag == kAudioChannelLayoutTag_UseChannelDescriptions {
+            let count = Int(pointer.pointee.mNumberChannelDescriptions)
+            let offset = MemoryLayout<AudioChannelLayout>.offset(of: \AudioChannelLayout.mChannelDescriptions) ?? 0
+            let descriptions = (UnsafeRawPointer(pointer) + offset).assumingMemoryBound(to: AudioChannelDescription.self)
+            self.labels = (0..<count).map { descriptions[$0].mChannelLabel }
+        } else if tag == kAudioChannelLayoutTag_UseChannelBitmap {
+            // 位图第 n 位对应标签 n + 1（L、R、C、LFE、Ls、Rs ...）
+            let bitmap = pointer.pointee.mChannelBitmap.rawValue
+            self.labels = (0..<32).filter { bitmap & (1 << $0) != 0 }.map { AudioChannelLabel($0 + 1) }
+        } else {
+            self = ChannelLayout.layout(forTag: tag)
+        }
+    }
+    
+    // MARK: - Discovery
+    
+    /// 读取设备的首选声道布局，与声道数不符时按声道数推断
+    static func discover(deviceID: AudioObjectID, scope: AudioObjectPropertyScope, channelCount: Int) -> ChannelLayout {
+        let fallback = ChannelLayout(channelCount: channelCount)
+        guard deviceID != 0 else { return fallback }
+        
+        var address = AudioObjectPropertyAddress(
+            mSelector: kAudioDevicePropertyPreferredChannelLayout,
+            mScope: scope,
+            mElement: kAudioObjectPropertyElementMain
+        )
+        var dataSize: UInt32 = 0
+        guard AudioObjectGetPropertyDataSize(deviceID, &address, 0, nil, &dataSize) == noErr,
+              Int(dataSize) >= MemoryLayout<AudioChannelLayout>.size else {
+            return fallback
+        }
+        
+        let raw = UnsafeMutableRawPointer.allocate(byteCount: Int(dataSize), alignment: MemoryLayout<AudioChannelLayout>.alignment)
+        defer { raw.deallocate() }
+        guard AudioObjectGetPropertyData(deviceID, &address, 0, nil, &dataSize, raw) == noErr else {
+            return fallback
+        }
+        
+        let layout = ChannelLayout(audioChannelLayout: raw.assumingMemoryBound(to: AudioChannelLayout.self))
+        guard layout.channelCount == channelCount else {
+            Logger.shared.warning("⚠️ 设备声道布局(\(layout.channelCount)声道)与流格式(\(channelCount)声道)不一致，使用默认布局")
+            return fallback
+        }
+        return layout
+    }
+    
+    // MARK: - Helpers
+    
+    private static func layout(forTag tag: AudioChannelLayoutTag) -> ChannelLayout {
+        switch tag {
+        case kAudioChannelLayoutTag_Mono:
+            return .mono
+        case kAudioChannelLayoutTag_Stereo, kAudioChannelLayoutTag_StereoHeadphones:
+            return .stereo
+        case kAudioChannelLayoutTag_Quadraphonic:
+            return .quadraphonic
+        case kAudioChannelLayoutTag_MPEG_5_1_A:
+            return .surround51
+        case kAudioChannelLayoutTag_MPEG_5_1_C:
+            return ChannelLayout(labels: [
+                kAudioChannelLabel_Left, kAudioChannelLabel_Center, kAudioChannelLabel_Right,
+                kAudioChannelLabel_LeftSurround, kAudioChannelLabel_RightSurround, kAudioChannelLabel_LFEScreen
+            ])
+        case kAudioChannelLayoutTag_MPEG_7_1_C:
+            return .surround71
+        default:
+            // 布局标签低 16 位为声道数
+            return ChannelLayout(channelCount: Int(tag & 0xFFFF))
+        }
+    }
+    
+    public var description: String {
+        switch self {
+        case .mono: return "mono"
+        case .stereo: return "stereo"
+        case .quadraphonic: return "quad"
+        case .surround51: return "5.1"
+        case .surround71: return "7.1"
+        default: return "\(channelCount)ch"
+        }
+    }
+}
@@ -0,0 +1,227 @@
+import Foundation
+import Accelerate
+import CoreAudio
+
+// MARK: - ChannelMixMatrix
+/// 声道混合矩阵 - 任意输入声道到输出声道的线性映射
+///
+/// 系数按 [输出][输入] 行优先存储。创建时把非零系数整理成逐输出声道的抽头列表，
+/// 渲染时每个抽头是一次 vDSP 向量乘加，源数据可以是交错（带步长）或非交错。
+struct ChannelMixMatrix: CustomStringConvertible {
+    
+    // MARK: - Types
+    private struct Tap {
+        let input: Int
+        let gain: Float
+    }
+    
+    // MARK: - Properties
+    let inputChannels: Int
+    let outputChannels: Int
+    let coefficients: [Float]
+    private let taps: [[Tap]]
+    
+    /// 是否为恒等映射（可直接拷贝）
+    let isIdentity: Bool
+    
+    // MARK: - Initialization
+    
+    /// 自定义矩阵
+    /// - Parameter coefficients: outputChannels × inputChannels 个系数，行优先
+    init(inputChannels: Int, outputChannels: Int, coefficients: [Float]) {
+        precondition(coefficients.count == inputChannels * outputChannels, "混合矩阵系数数量与声道数不匹配")
+        self.inputChannels = inputChannels
+        self.outputChannels = outputChannels
+        self.coefficients = coefficients
+        
+        var taps: [[Tap]] = []
+        var identity = inputChannels == outputChannels
+        for o in 0..<outputChannels {
+            var row: [Tap] = []
+            for i in 0..<inputChannels {
+                let gain = coefficients[o * inputChannels + i]
+                if gain != 0 {
+                    row.append(Tap(input: i, gain: gain))
+                }
+                if (i == o && gain != 1) || (i != o && gain != 0) {
+                    identity = false
+                }
+            }
+            taps.append(row)
+        }
+        self.taps = taps
+        self.isIdentity = identity
+    }
+    
+    /// 恒等矩阵
+    static func identity(channels: Int) -> ChannelMixMatrix {
+        var coefficients = [Float](repeating: 0, count: channels * channels)
+        for c in 0..<channels {
+            coefficients[c * channels + c] = 1
+        }
+        return ChannelMixMatrix(inputChannels: channels, outputChannels: channels, coefficients: coefficients)
+    }
+    
+    /// 按声道标签生成标准上/下混矩阵
+    ///
+    /// - 同名声道直接映射；
+    /// - 输出缺少的声道折叠到左右：中置与环绕 -3dB（0.7071），LFE 丢弃；
+    /// - 输出为单声道时取左右折叠结果的平均；
+    /// - 含离散/未知标签时按声道序号一一映射；
+    /// - normalize 为 true 时，行系数之和超过 1 的输出声道整体缩放，避免下混削波。
+    static func standard(from input: ChannelLayout, to output: ChannelLayout, normalize: Bool = true) -> ChannelMixMatrix {
+        let inCount = input.channelCount
+        let outCount = output.channelCount
+        if input == output {
+            return .identity(channels: inCount)
+        }
+        
+        var coefficients = [Float](repeating: 0, count: inCount * outCount)
+        let hasUnknown = (input.labels + output.labels).contains { !isPositional($0) }
+        
+        if hasUnknown {
+            for c in 0..<min(inCount, outCount) {
+                coefficients[c * inCount + c] = 1
+            }
+        } else {
+            let outputLabels = Set(output.labels)
+            let outputHasFront = outputLabels.contains(kAudioChannelLabel_Left) && outputLabels.contains(kAudioChannelLabel_Right)
+            for (o, lo) in output.labels.enumerated() {
+                for (i, li) in input.labels.enumerated() {
+                    let gain: Float
+                    if li == lo {
+                        gain = 1
+                    } else if outputLabels.contains(li) {
+                        gain = 0
+                    } else if lo == kAudioChannelLabel_Left {
+                        gain = foldGain(li).left
+                    } else if lo == kAudioChannelLabel_Right {
+                        gain = foldGain(li).right
+                    } else if !outputHasFront && (lo == kAudioChannelLabel_Mono || lo == kAudioChannelLabel_Center) {
+                        let fold = foldGain(li)
+                        gain = 0.5 * (fold.left + fold.right)
+                    } else {
+                        gain = 0
+                    }
+                    coefficients[o * inCount + i] = gain
+                }
+            }
+        }
+        
+        if normalize {
+            for o in 0..<outCount {
+                var sum: Float = 0
+                for i in 0..<inCount {
+                    sum += abs(coefficients[o * inCount + i])
+                }
+                if sum > 1 {
+                    for i in 0..<inCount {
+                        coefficients[o * inCount + i] /= sum
+                    }
+                }
+            }
+        }
+        
+        return ChannelMixMatrix(inputChannels: inCount, outputChannels: outCount, coefficients: coefficients)
+    }
+    
+    // MARK: - Rendering
+    
+    /// 交错输入 → 非交错块
+    func apply(interleaved source: UnsafePointer<Float>, frames: Int, into block: AudioBlock) {
+        let n = min(frames, block.frameCapacity)
+        mix(frames: n, source: { (source + $0, inputChannels) }, destination: { block.channel($0) })
+        block.frameCount = n
+    }
+    
+    /// 非交错输入（逐声道指针）→ 非交错块
+    func apply(planar source: UnsafePointer<UnsafePointer<Float>>, frames: Int, into block: AudioBlock) {
+        let n = min(frames, block.frameCapacity)
+        mix(frames: n, source: { (source[$0], 1) }, destination: { block.channel($0) })
+        block.frameCount = n
+    }
+    
+    /// AudioBufferList 视图（交错或非交错，按声道步长读取）→ 非交错块
+    func apply(_ view: AudioBufferListView, frames: Int, into block: AudioBlock) {
+        let n = min(frames, view.frameCount, block.frameCapacity)
+        mix(frames: n, source: { (view.channel($0), view.stride($0)) }, destination: { block.channel($0) })
+        block.frameCount = n
+    }
+    
+    /// 非交错块 → 非交错块
+    func apply(_ input: AudioBlock, into output: AudioBlock, frames: Int) {
+        let n = min(frames, input.frameCount, output.frameCapacity)
+        mix(frames: n, source: { (UnsafePointer(input.channel($0)), 1) }, destination: { output.channel($0) })
+        output.frameCount = n
+    }
+    
+    /// 交错输入 → 逐声道目标指针
+    func apply(interleaved source: UnsafePointer<Float>, frames: Int, into destinations: UnsafePointer<UnsafeMutablePointer<Float>>) {
+        mix(frames: frames, source: { (source + $0, inputChannels) }, destination: { destinations[$0] })
+    }
+    
+    /// AudioBufferList 视图 → 逐声道目标指针
+    func apply(_ view: AudioBufferListView, frames: Int, into destinations: UnsafePointer<UnsafeMutablePointer<Float>>) {
+        mix(frames: min(frames, view.frameCount), source: { (view.channel($0), view.stride($0)) }, destination: { destinations[$0] })
+    }
+    
+    /// - Parameter source: 输入声道序号 → (起始指针, 样本步长)
+    private func mix(frames: Int,
+                     source: (Int) -> (UnsafePointer<Float>, Int),
+                     destination: (Int) -> UnsafeMutablePointer<Float>) {
+        guard frames > 0 else { return }
+        let n = vDSP_Length(frames)
+        
+        for o in 0..<outputChannels {
+            let dst = destination(o)
+            let row = taps[o]
+            guard let first = row.first else {
+                vDSP_vclr(dst, 1, n)
+                continue
+            }
+            var gain = first.gain
+            let (firstSource, firstStride) = source(first.input)
+            vDSP_vsmul(firstSource, vDSP_Stride(firstStride), &gain, dst, 1, n)
+            for tap in row.dropFirst() {
+                var tapGain = tap.gain
+                let (tapSource, tapStride) = source(tap.input)
+                vDSP_vsma(tapSource, vDSP_Stride(tapStride), &tapGain, dst, 1, dst, 1, n)
+            }
+        }
+    }
+    
+    // MARK: - Helpers
+    
+    /// 是否为有空间位置含义的标签（离散/未知标签返回 false）
+    private static func isPositional(_ label: AudioChannelLabel) -> Bool {
+        return label != kAudioChannelLabel_Unknown
+            && label != kAudioChannelLabel_Unused
+            && (label & kAudioChannelLabel_Discrete) != kAudioChannelLabel_Discrete
+    }
+    
+    /// 折叠到左右声道的增益
+    private static func foldGain(_ label: AudioChannelLabel) -> (left: Float, right: Float) {
+        let minus3dB: Float = 0.70710677
+        switch label {
+        case kAudioChannelLabel_Left, kAudioChannelLabel_LeftWide, kAudioChannelLabel_LeftCenter:
+            return (1, 0)
+        case kAudioChannelLabel_Right, kAudioChannelLabel_RightWide, kAudioChannelLabel_RightCenter:
+            return (0, 1)
+        case kAudioChannelLabel_Mono:
+            return (1, 1)
+        case kAudioChannelLabel_Center, kAudioChannelLabel_CenterSurround:
+            return (minus3dB, minus3dB)
+        case kAudioChannelLabel_LeftSurround, kAudioChannelLabel_LeftSurroundDirect, kAudioChannelLabel_RearSurroundLeft:
+            return (minus3dB, 0)
+        case kAudioChannelLabel_RightSurround, kAudioChannelLabel_RightSurroundDirect, kAudioChannelLabel_RearSurroundRight:
+            return (0, minus3dB)
+        default:
+            // LFE 及其他标签不参与折叠
+            return (0, 0)
+        }
+    }
+    
+    var description: String {
+        return "\(inputChannels)→\(outputChannels)\(isIdentity ? " (identity)" : "")"
+    }
+}
@@ -0,0 +1,88 @@
+import Foundation
+
+// MARK: - Biquad
+/// 双二阶滤波器（转置直接 II 型，逐声道独立状态）
+///
+/// 系数按 RBJ Audio EQ Cookbook 计算并对 a0 归一化。状态在静音输入下按极点指数衰减，
+/// 需要在 `DenormalScope` 内运行以免衰减到非规格化区间后变慢。
+@_spi(Benchmarks) public struct Biquad {
+    
+    // MARK: - Coefficients
+    public struct Coefficients {
+        let b0: Float
+        let b1: Float
+        let b2: Float
+        let a1: Float
+        let a2: Float
+        
+        /// 二阶低通
+        public static func lowPass(frequency: Double, q: Double = 0.7071, sampleRate: Double) -> Coefficients {
+            let w0 = 2 * Double.pi * frequency / sampleRate
+            let alpha = sin(w0) / (2 * q)
+            let cosW0 = cos(w0)
+            let a0 = 1 + alpha
+            return Coefficients(
+                b0: Float((1 - cosW0) / 2 / a0),
+                b1: Float((1 - cosW0) / a0),
+                b2: Float((1 - cosW0) / 2 / a0),
+                a1: Float(-2 * cosW0 / a0),
+                a2: Float((1 - alpha) / a0)
+            )
+        }
+        
+        /// 二阶高通
+        static func highPass(frequency: Double, q: Double = 0.7071, sampleRate: Double) -> Coefficients {
+            let w0 = 2 * Double.pi * frequency / sampleRate
+            let alpha = sin(w0) / (2 * q)
+            let cosW0 = cos(w0)
+            let a0 = 1 + alpha
+            return Coefficients(
+                b0: Float((1 + cosW0) / 2 / a0),
+                b1: Float(-(1 + cosW0) / a0),
+                b2: Float((1 + cosW0) / 2 / a0),
+                a1: Float(-2 * cosW0 / a0),
+                a2: Float((1 - alpha) / a0)
+            )
+        }
+    }
+    
+    // MARK: - Properties
+    let coefficients: Coefficients
+    private var z1: Float = 0
+    private var z2: Float = 0
+    
+    // MARK: - Initialization
+    
+    public init(_ coefficients: Coefficients) {
+        self.coefficients = coefficients
+    }
+    
+    // MARK: - Processing
+    
+    /// 处理 frames 个样本（source 与 destination 可以相同）
+    public mutating func process(_ source: UnsafePointer<Float>, _ destination: UnsafeMutablePointer<Float>, frames: Int) {
+        let c = coefficients
+        var s1 = z1
+        var s2 = z2
+        for i in 0..<frames {
+            let x = source[i]
+            let y = c.b0 * x + s1
+            s1 = c.b1 * x - c.a1 * y + s2
+            s2 = c.b2 * x - c.a2 * y
+            destination[i] = y
+        }
+        z1 = s1
+        z2 = s2
+    }
+    
+    /// 直接设置内部状态（基准测试用来模拟衰减尾部）
+    public mutating func setState(_ value: Float) {
+        z1 = value
+        z2 = value
+    }
+    
+    mutating func reset() {
+        z1 = 0
+        z2 = 0
+    }
+}
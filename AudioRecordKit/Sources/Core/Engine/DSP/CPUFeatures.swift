@@ -0,0 +1,54 @@
+import Foundation
+import Darwin
+
+// MARK: - CPUFeatures
+/// 运行时 CPU 特性（通过 sysctl hw.optional.* 检测，进程内只检测一次）
+@_spi(Benchmarks) public struct CPUFeatures: OptionSet, CustomStringConvertible {
+    public let rawValue: UInt32
+    
+    public init(rawValue: UInt32) {
+        self.rawValue = rawValue
+    }
+    
+    static let sse2 = CPUFeatures(rawValue: 1 << 0)
+    static let avx = CPUFeatures(rawValue: 1 << 1)
+    static let avx2 = CPUFeatures(rawValue: 1 << 2)
+    static let avx512f = CPUFeatures(rawValue: 1 << 3)
+    static let neon = CPUFeatures(rawValue: 1 << 8)
+    
+    /// 当前 CPU 的特性
+    public static let current: CPUFeatures = detect()
+    
+    public var description: String {
+        var names: [String] = []
+        if contains(.sse2) { names.append("SSE2") }
+        if contains(.avx) { names.append("AVX") }
+        if contains(.avx2) { names.append("AVX2") }
+        if contains(.avx512f) { names.append("AVX-512F") }
+        if contains(.neon) { names.append("NEON") }
+        return names.isEmpty ? "none" : names.joined(separator: " ")
+    }
+    
+    // MARK: - Detection
+    
+    private static func detect() -> CPUFeatures {
+        var features: CPUFeatures = []
+        #if arch(x86_64)
+        // x86_64 基线包含 SSE2
+        features.insert(.sse2)
+        if sysctlFlag("hw.optional.avx1_0") { features.insert(.avx) }
+        if sysctlFlag("hw.optional.avx2_0") { features.insert(.avx2) }
+        if sysctlFlag("hw.optional.avx512f") { features.insert(.avx512f) }
+        #elseif arch(arm64)
+        // arm64 基线包含 Advanced SIMD
+        features.insert(.neon)
+        #endif
+        return features
+    }
+    
+    private static func sysctlFlag(_ name: String) -> Bool {
+        var value: Int32 = 0
+        var size = MemoryLayout<Int32>.size
+        return sysctlbyname(name, &value, &size, nil, 0) == 0 && value != 0
+    }
+}
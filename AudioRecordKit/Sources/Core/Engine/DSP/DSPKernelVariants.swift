@@ -0,0 +1,155 @@
+import Foundation
+import Accelerate
+
+// MARK: - 内核签名
+/// Float32 → Int16（先限幅到 [-1, 1]，乘 32767 后向零取整）
+@_spi(Benchmarks) public typealias ConvertInt16Kernel = (_ source: UnsafePointer<Float>, _ destination: UnsafeMutablePointer<Int16>, _ count: Int) -> Void
+/// destination += source × gain
+@_spi(Benchmarks) public typealias MultiplyAddKernel = (_ source: UnsafePointer<Float>, _ gain: Float, _ destination: UnsafeMutablePointer<Float>, _ count: Int) -> Void
+/// 一次遍历求峰值（绝对值最大）与平方和
+@_spi(Benchmarks) public typealias PeakSumSquaresKernel = (_ source: UnsafePointer<Float>, _ count: Int) -> (peak: Float, sumSquares: Float)
+
+// MARK: - ScalarDSPKernels
+/// 标量参考实现 - 其他变体以它为准做交叉校验
+enum ScalarDSPKernels {
+    
+    static func convertInt16(_ source: UnsafePointer<Float>, _ destination: UnsafeMutablePointer<Int16>, _ count: Int) {
+        for i in 0..<max(count, 0) {
+            destination[i] = Int16(min(max(source[i], -1.0), 1.0) * 32767.0)
+        }
+    }
+    
+    static func multiplyAdd(_ source: UnsafePointer<Float>, _ gain: Float, _ destination: UnsafeMutablePointer<Float>, _ count: Int) {
+        for i in 0..<max(count, 0) {
+            destination[i] = destination[i] + source[i] * gain
+        }
+    }
+    
+    static func peakSumSquares(_ source: UnsafePointer<Float>, _ count: Int) -> (peak: Float, sumSquares: Float) {
+        var peak: Float = 0
+        var sum: Float = 0
+        for i in 0..<max(count, 0) {
+            let sample = source[i]
+            peak = max(peak, abs(sample))
+            sum += sample * sample
+        }
+        return (peak, sum)
+    }
+}
+
+// MARK: - DSPVector
+/// 可用于 SIMD 内核的 Float 向量类型（4/8/16 通道）
+protocol DSPVector: SIMD where Scalar == Float {
+    associatedtype Int16Vector: SIMD where Int16Vector.Scalar == Int16
+    /// 各通道向零取整并截断为 Int16
+    func truncatedInt16() -> Int16Vector
+}
+
+extension SIMD4: DSPVector where Scalar == Float {
+    @inline(__always)
+    func truncatedInt16() -> SIMD4<Int16> {
+        return SIMD4<Int16>(truncatingIfNeeded: SIMD4<Int32>(self, rounding: .towardZero))
+    }
+}
+
+extension SIMD8: DSPVector where Scalar == Float {
+    @inline(__always)
+    func truncatedInt16() -> SIMD8<Int16> {
+        return SIMD8<Int16>(truncatingIfNeeded: SIMD8<Int32>(self, rounding: .towardZero))
+    }
+}
+
+extension SIMD16: DSPVector where Scalar == Float {
+    @inline(__always)
+    func truncatedInt16() -> SIMD16<Int16> {
+        return SIMD16<Int16>(truncatingIfNeeded: SIMD16<Int32>(self, rounding: .towardZero))
+    }
+}
+
+// MARK: - SIMDDSPKernels
+/// 向量宽度作为泛型参数的 SIMD 实现
+///
+/// 每个宽度由编译器按基线指令集生成独立的特化版本；不足一个向量的尾部交给标量实现。
+/// 非对齐读写，调用方无需对齐缓冲区。
+enum SIMDDSPKernels<V: DSPVector> {
+    
+    static func convertInt16(_ source: UnsafePointer<Float>, _ destination: UnsafeMutablePointer<Int16>, _ count: Int) {
+        let lower = V(repeating: -1.0)
+        let upper = V(repeating: 1.0)
+        let scale = V(repeating: 32767.0)
+        var i = 0
+        while i + V.scalarCount <= count {
+            let v = UnsafeRawPointer(source + i).loadUnaligned(as: V.self)
+            let quantized = (v.clamped(lowerBound: lower, upperBound: upper) * scale).truncatedInt16()
+            UnsafeMutableRawPointer(destination + i).storeBytes(of: quantized, as: V.Int16Vector.self)
+            i += V.scalarCount
+        }
+        ScalarDSPKernels.convertInt16(source + i, destination + i, count - i)
+    }
+    
+    static func multiplyAdd(_ source: UnsafePointer<Float>, _ gain: Float, _ destination: UnsafeMutablePointer<Float>, _ count: Int) {
+        let g = V(repeating: gain)
+        var i = 0
+        while i + V.scalarCount <= count {
+            let s = UnsafeRawPointer(source + i).loadUnaligned(as: V.self)
+            let d = UnsafeRawPointer(destination + i).loadUnaligned(as: V.self)
+            UnsafeMutableRawPointer(destination + i).storeBytes(of: d + s * g, as: V.self)
+            i += V.scalarCount
+        }
+        ScalarDSPKernels.multiplyAdd(source + i, gain, destination + i, count - i)
+    }
+    
+    static func peakSumSquares(_ source: UnsafePointer<Float>, _ count: Int) -> (peak: Float, sumSquares: Float) {
+        var peak = V(repeating: 0)
+        var sum = V(repeating: 0)
+        var i = 0
+        while i + V.scalarCount <= count {
+            let v = UnsafeRawPointer(source + i).loadUnaligned(as: V.self)
+            peak = pointwiseMax(peak, pointwiseMax(v, -v))
+            sum += v * v
+            i += V.scalarCount
+        }
+        let tail = ScalarDSPKernels.peakSumSquares(source + i, count - i)
+        return (max(peak.max(), tail.peak), sum.sum() + tail.sumSquares)
+    }
+}
+
+// MARK: - AccelerateDSPKernels
+/// vDSP 实现（Accelerate 内部再按 CPU 选择指令集）
+enum AccelerateDSPKernels {
+    
+    /// 限幅与缩放的分段长度（栈上临时缓冲区）
+    private static let chunkFrames = 256
+    
+    static func convertInt16(_ source: UnsafePointer<Float>, _ destination: UnsafeMutablePointer<Int16>, _ count: Int) {
+        var low: Float = -1.0
+        var high: Float = 1.0
+        var scale: Float = 32767.0
+        withUnsafeTemporaryAllocation(of: Float.self, capacity: chunkFrames) { scratch in
+            let buffer = scratch.baseAddress!
+            var offset = 0
+            while offset < count {
+                let n = vDSP_Length(min(chunkFrames, count - offset))
+                vDSP_vclip(source + offset, 1, &low, &high, buffer, 1, n)
+                vDSP_vsmul(buffer, 1, &scale, buffer, 1, n)
+                vDSP_vfix16(buffer, 1, destination + offset, 1, n)
+                offset += Int(n)
+            }
+        }
+    }
+    
+    static func multiplyAdd(_ source: UnsafePointer<Float>, _ gain: Float, _ destination: UnsafeMutablePointer<Float>, _ count: Int) {
+        guard count > 0 else { return }
+        var g = gain
+        vDSP_vsma(source, 1, &g, destination, 1, destination, 1, vDSP_Length(count))
+    }
+    
+    static func peakSumSquares(_ source: UnsafePointer<Float>, _ count: Int) -> (peak: Float, sumSquares: Float) {
+        guard count > 0 else { return (0, 0) }
+        var peak: Float = 0
+        var sum: Float = 0
+        vDSP_maxmgv(source, 1, &peak, vDSP_Length(count))
+        vDSP_svesq(source, 1, &sum, vDSP_Length(count))
+        return (peak, sum)
+    }
+}
@@ -0,0 +1,242 @@
+import Foundation
+
+// MARK: - DSPKernelISA
+/// 内核变体（实现方式与向量宽度）
+///
+/// SIMD 变体按 `SIMDn<Float>` 的通道数区分，和其余代码一样按编译目标的基线指令集生成
+/// （x86_64 为 SSE2，arm64 为 NEON），宽于寄存器的向量由编译器拆成多个寄存器展开。
+/// Swift 不支持按函数指定目标特性，因此这里没有 AVX2 / AVX-512 专用代码。
+@_spi(Benchmarks) public enum DSPKernelISA: String, CaseIterable {
+    /// 标量参考实现
+    case scalar
+    /// SIMD4<Float>（一个 128 位寄存器）
+    case simd4
+    /// SIMD8<Float>（两路 128 位展开）
+    case simd8
+    /// SIMD16<Float>（四路 128 位展开）
+    case simd16
+    /// Accelerate vDSP（Accelerate 内部再按 CPU 选择指令集）
+    case accelerate
+    
+    /// 在给定 CPU 上是否可用
+    ///
+    /// 所有变体都只用基线指令集，x86_64 与 arm64 上均可用；保留该判断以便将来加入
+    /// 需要特定 CPU 特性的变体。
+    func isSupported(on features: CPUFeatures) -> Bool {
+        switch self {
+        case .scalar, .accelerate:
+            return true
+        case .simd4, .simd8, .simd16:
+            return !features.isDisjoint(with: [.sse2, .neon])
+        }
+    }
+}
+
+// MARK: - DSPKernel
+/// 单个 DSP 内核的全部变体与选中的实现
+///
+/// 变体按优先级排列，创建时选出当前 CPU 支持的第一个（可被环境变量覆盖），之后不再改变。
+/// 渲染代码应在初始化时取出 `function` 保存，IO 线程上直接调用。
+@_spi(Benchmarks) public final class DSPKernel<Function> {
+    
+    // MARK: - Properties
+    public let name: String
+    /// 全部变体（按优先级）
+    let variants: [(isa: DSPKernelISA, function: Function)]
+    /// 选中的变体
+    public let selectedISA: DSPKernelISA
+    /// 选中的实现
+    let function: Function
+    
+    // MARK: - Initialization
+    
+    /// - Parameter variants: 按优先级排列，必须包含 `.scalar`
+    init(name: String, variants: [(isa: DSPKernelISA, function: Function)]) {
+        precondition(variants.contains { $0.isa == .scalar }, "DSP 内核 \(name) 缺少标量实现")
+        self.name = name
+        self.variants = variants
+        let isa = DSPKernels.resolve(kernel: name, candidates: variants.map { $0.isa })
+        self.selectedISA = isa
+        self.function = variants.first { $0.isa == isa }!.function
+    }
+    
+    // MARK: - Variants
+    
+    /// 标量参考实现
+    var reference: Function {
+        return variant(.scalar)!
+    }
+    
+    /// 指定变体（不存在时返回 nil，不检查 CPU 是否支持）
+    func variant(_ isa: DSPKernelISA) -> Function? {
+        return variants.first { $0.isa == isa }?.function
+    }
+    
+    /// 当前 CPU 支持的变体
+    public var supportedVariants: [(isa: DSPKernelISA, function: Function)] {
+        return variants.filter { $0.isa.isSupported(on: CPUFeatures.current) }
+    }
+}
+
+// MARK: - DSPKernels
+/// DSP 内核注册表
+///
+/// 每个内核在第一次访问时按 CPU 特性选定实现。设置环境变量 `AUDIORECORD_DSP_KERNELS`
+/// 可以强制选择变体（用于测试与对比）：
+/// - `scalar`：所有内核使用该指令集（不存在或不支持时回退为默认选择）；
+/// - `int16=simd8,meter=scalar`：按内核名称单独指定（指令集为 scalar / simd4 / simd8 / simd16 / accelerate）；两种写法可以混用。
+@_spi(Benchmarks) public enum DSPKernels {
+    
+    static let overrideVariable = "AUDIORECORD_DSP_KERNELS"
+    
+    // MARK: - Kernels
+    
+    /// Float32 → Int16 量化
+    public static let convertInt16 = DSPKernel<ConvertInt16Kernel>(name: "int16", variants: [
+        (.accelerate, AccelerateDSPKernels.convertInt16),
+        (.simd8, SIMDDSPKernels<SIMD8<Float>>.convertInt16),
+        (.simd16, SIMDDSPKernels<SIMD16<Float>>.convertInt16),
+        (.simd4, SIMDDSPKernels<SIMD4<Float>>.convertInt16),
+        (.scalar, ScalarDSPKernels.convertInt16)
+    ])
+    
+    /// 乘加（混音）
+    public static let multiplyAdd = DSPKernel<MultiplyAddKernel>(name: "mix", variants: [
+        (.accelerate, AccelerateDSPKernels.multiplyAdd),
+        (.simd8, SIMDDSPKernels<SIMD8<Float>>.multiplyAdd),
+        (.simd16, SIMDDSPKernels<SIMD16<Float>>.multiplyAdd),
+        (.simd4, SIMDDSPKernels<SIMD4<Float>>.multiplyAdd),
+        (.scalar, ScalarDSPKernels.multiplyAdd)
+    ])
+    
+    /// 峰值 + 平方和（电平表）
+    ///
+    /// vDSP 需要两次遍历，单次遍历的 SIMD 版本优先。
+    public static let peakSumSquares = DSPKernel<PeakSumSquaresKernel>(name: "meter", variants: [
+        (.simd8, SIMDDSPKernels<SIMD8<Float>>.peakSumSquares),
+        (.simd16, SIMDDSPKernels<SIMD16<Float>>.peakSumSquares),
+        (.simd4, SIMDDSPKernels<SIMD4<Float>>.peakSumSquares),
+        (.accelerate, AccelerateDSPKernels.peakSumSquares),
+        (.scalar, ScalarDSPKernels.peakSumSquares)
+    ])
+    
+    /// 所有内核的名称与选中的变体
+    public static var selection: [(kernel: String, isa: DSPKernelISA)] {
+        return [
+            (convertInt16.name, convertInt16.selectedISA),
+            (multiplyAdd.name, multiplyAdd.selectedISA),
+            (peakSumSquares.name, peakSumSquares.selectedISA)
+        ]
+    }
+    
+    // MARK: - Resolution
+    
+    /// 环境变量中的覆盖设置（全局指令集, 按内核指定）
+    private static let overrides: (global: DSPKernelISA?, perKernel: [String: DSPKernelISA]) = {
+        guard let value = ProcessInfo.processInfo.environment[overrideVariable], !value.isEmpty else {
+            return (nil, [:])
+        }
+        var global: DSPKernelISA?
+        var perKernel: [String: DSPKernelISA] = [:]
+        for entry in value.split(separator: ",") {
+            let parts = entry.split(separator: "=", maxSplits: 1).map { $0.trimmingCharacters(in: .whitespaces) }
+            if parts.count == 2, let isa = DSPKernelISA(rawValue: parts[1]) {
+                perKernel[parts[0]] = isa
+            } else if parts.count == 1, let isa = DSPKernelISA(rawValue: parts[0]) {
+                global = isa
+            } else {
+                Logger.shared.warning("⚠️ \(overrideVariable): 无法识别 \"\(entry)\"")
+            }
+        }
+        return (global, perKernel)
+    }()
+    
+    static func resolve(kernel: String, candidates: [DSPKernelISA]) -> DSPKernelISA {
+        let features = CPUFeatures.current
+        let fallback = candidates.first { $0.isSupported(on: features) } ?? .scalar
+        
+        if let requested = overrides.perKernel[kernel] ?? overrides.global {
+            if candidates.contains(requested) && requested.isSupported(on: features) {
+                Logger.shared.info("🧮 DSP 内核 \(kernel): \(requested.rawValue)（\(overrideVariable) 指定）")
+                return requested
+            }
+            Logger.shared.warning("⚠️ DSP 内核 \(kernel): \(requested.rawValue) 不可用（CPU: \(features)），使用 \(fallback.rawValue)")
+            return fallback
+        }
+        
+        Logger.shared.info("🧮 DSP 内核 \(kernel): \(fallback.rawValue)（CPU: \(features)）")
+        return fallback
+    }
+}
+
+// MARK: - Verification
+extension DSPKernels {
+    
+    /// 用标量参考实现交叉校验当前 CPU 支持的所有变体
+    ///
+    /// 量化与峰值要求逐位一致；累加顺序不同的乘加与平方和按相对误差比较。
+    /// - Returns: 不一致的描述，全部通过时为空
+    public static func verify(length: Int = 1027) -> [String] {
+        var failures: [String] = []
+        let count = max(length, 1)
+        
+        // 覆盖限幅边界、正负零与小于一个向量的尾部
+        let source = UnsafeMutablePointer<Float>.allocate(capacity: count)
+        let addend = UnsafeMutablePointer<Float>.allocate(capacity: count)
+        let expected = UnsafeMutablePointer<Float>.allocate(capacity: count)
+        let actual = UnsafeMutablePointer<Float>.allocate(capacity: count)
+        let expected16 = UnsafeMutablePointer<Int16>.allocate(capacity: count)
+        let actual16 = UnsafeMutablePointer<Int16>.allocate(capacity: count)
+        defer {
+            source.deallocate()
+            addend.deallocate()
+            expected.deallocate()
+            actual.deallocate()
+            expected16.deallocate()
+            actual16.deallocate()
+        }
+        for i in 0..<count {
+            source[i] = 1.5 * sin(Float(i) * 0.37)
+            addend[i] = cos(Float(i) * 0.11)
+        }
+        let edges: [Float] = [1.0, -1.0, 0.0, -0.0, 1.0001, -1.0001, 0.5, -0.5]
+        for (i, value) in edges.enumerated() where i < count {
+            source[i] = value
+        }
+        
+        // Float32 → Int16
+        convertInt16.reference(source, expected16, count)
+        for (isa, function) in convertInt16.supportedVariants where isa != .scalar {
+            function(source, actual16, count)
+            if let index = (0..<count).first(where: { actual16[$0] != expected16[$0] }) {
+                failures.append("\(convertInt16.name)/\(isa.rawValue): [\(index)] \(actual16[index]) ≠ \(expected16[index])")
+            }
+        }
+        
+        // 乘加
+        let gain: Float = 0.6
+        expected.update(from: addend, count: count)
+        multiplyAdd.reference(source, gain, expected, count)
+        for (isa, function) in multiplyAdd.supportedVariants where isa != .scalar {
+            actual.update(from: addend, count: count)
+            function(source, gain, actual, count)
+            if let index = (0..<count).first(where: { abs(actual[$0] - expected[$0]) > 1e-6 * max(1, abs(expected[$0])) }) {
+                failures.append("\(multiplyAdd.name)/\(isa.rawValue): [\(index)] \(actual[index]) ≠ \(expected[index])")
+            }
+        }
+        
+        // 峰值 + 平方和
+        let reference = peakSumSquares.reference(source, count)
+        for (isa, function) in peakSumSquares.supportedVariants where isa != .scalar {
+            let result = function(source, count)
+            if result.peak != reference.peak {
+                failures.append("\(peakSumSquares.name)/\(isa.rawValue): peak \(result.peak) ≠ \(reference.peak)")
+            }
+            if abs(result.sumSquares - reference.sumSquares) > 1e-4 * max(1, reference.sumSquares) {
+                failures.append("\(peakSumSquares.name)/\(isa.rawValue): sumSquares \(result.sumSquares) ≠ \(reference.sumSquares)")
+            }
+        }
+        
+        return failures
+    }
+}
@@ -0,0 +1,94 @@
+import Foundation
+import Darwin
+
+// MARK: - DenormalScope
+/// 非规格化数保护 - 在 DSP 执行期间开启 flush-to-zero / denormals-are-zero
+///
+/// 递归结构（双二阶滤波器、包络跟随、释放衰减）在静音段会衰减进非规格化区间，
+/// x86 上每个样本的开销可能放大 10~100 倍。引擎在每个块的处理期间开启 FTZ/DAZ，
+/// 处理结束后恢复调用方（宿主代码）的浮点环境。
+///
+/// - x86_64：MXCSR 的 FTZ（bit 15）与 DAZ（bit 6）；
+/// - arm64：FPCR 的 FZ（bit 24），同时作用于输入与输出。
+@_spi(Benchmarks) public enum DenormalScope {
+    
+    #if arch(x86_64)
+    private static let flushBits: UInt32 = 0x8040
+    #elseif arch(arm64)
+    private static let flushBits: UInt64 = 0x0100_0000
+    #endif
+    
+    /// 在 body 执行期间开启 FTZ/DAZ，结束后恢复原浮点环境
+    ///
+    /// 当前线程已开启时不再切换（引擎工作线程常驻开启）。
+    @inline(__always)
+    public static func run<T>(_ body: () throws -> T) rethrows -> T {
+        var saved = fenv_t()
+        fegetenv(&saved)
+        if isFlushing(saved) {
+            return try body()
+        }
+        var flushing = saved
+        enable(&flushing)
+        fesetenv(&flushing)
+        defer { fesetenv(&saved) }
+        return try body()
+    }
+    
+    /// 在 body 执行期间关闭 FTZ/DAZ（基准测试对照组）
+    public static func runWithoutFlush<T>(_ body: () throws -> T) rethrows -> T {
+        var saved = fenv_t()
+        fegetenv(&saved)
+        var plain = saved
+        disable(&plain)
+        fesetenv(&plain)
+        defer { fesetenv(&saved) }
+        return try body()
+    }
+    
+    /// 为当前线程常驻开启（只用于引擎自有的线程，例如图调度工作线程）
+    static func enableForCurrentThread() {
+        var env = fenv_t()
+        fegetenv(&env)
+        enable(&env)
+        fesetenv(&env)
+    }
+    
+    /// 当前线程是否已开启
+    static var isEnabled: Bool {
+        var env = fenv_t()
+        fegetenv(&env)
+        return isFlushing(env)
+    }
+    
+    // MARK: - Private Methods
+    
+    @inline(__always)
+    private static func isFlushing(_ env: fenv_t) -> Bool {
+        #if arch(x86_64)
+        return env.__mxcsr & flushBits == flushBits
+        #elseif arch(arm64)
+        return env.__fpcr & flushBits == flushBits
+        #else
+        return true
+        #endif
+    }
+    
+    @inline(__always)
+    private static func enable(_ env: inout fenv_t) {
+        #if arch(x86_64)
+        env.__mxcsr |= flushBits
+        #elseif arch(arm64)
+        env.__fpcr |= flushBits
+        #endif
+    }
+    
+    @inline(__always)
+    private static func disable(_ env: inout fenv_t) {
+        #if arch(x86_64)
+        env.__mxcsr &= ~flushBits
+        #elseif arch(arm64)
+        env.__fpcr &= ~flushBits
+        #endif
+    }
+}
@@ -0,0 +1,260 @@
+import Foundation
+import Darwin
+
+// MARK: - EngineArena
+/// 会话内存区 - 一个会话的定长引擎状态连续分配在同一块映射内存中
+///
+/// 处理图构建期间（`withCurrent(_:)` 作用域内）经 `EngineMemory.allocate` 分配的
+/// 输出块、环形缓冲区与暂存区从内存区按缓存行对齐顺序切分，不再分散在堆上；
+/// 容量不足时回退到堆分配。处理图释放时在 `drop(_:)` 作用域内析构节点，
+/// 属于内存区的块跳过逐个归还（不查登记表、不加锁），作用域结束时整体扣除；
+/// 比处理图活得久的节点之后经登记表归还，全部归还后一次性解除映射。
+/// 容量不小于 2MB 时在 x86_64 上优先使用 2MB 超级页，不可用时退回普通页。
+@_spi(Benchmarks) public final class EngineArena {
+    
+    // MARK: - Properties
+    let name: String
+    /// 映射大小（字节）
+    let capacity: Int
+    /// 是否由超级页支持
+    public let isHugePageBacked: Bool
+    
+    private let base: UnsafeMutableRawPointer
+    private let lock = NSLock()
+    private var offset = 0
+    /// 未归还的分配数，另加 1 表示内存区仍开放（`close()` 时扣除）
+    private let outstanding = AtomicInt64(1)
+    /// `drop(_:)` 作用域内跳过的分配数（只由丢弃线程访问）
+    private var droppedCount: Int64 = 0
+    private var isClosed = false
+    private var isUnmapped = false
+    /// 容量不足而回退到堆的字节数
+    private(set) var overflowBytes = 0
+    
+    /// 缓存行大小（Apple Silicon 为 128 字节）
+    static let cacheLineSize: Int = {
+        var size = 0
+        var length = MemoryLayout<Int>.size
+        if sysctlbyname("hw.cachelinesize", &size, &length, nil, 0) == 0 && size > 0 {
+            return size
+        }
+        return 128
+    }()
+    
+    static let hugePageSize = 2 * 1024 * 1024
+    /// VM_FLAGS_SUPERPAGE_SIZE_2MB（SUPERPAGE_SIZE_2MB << VM_FLAGS_SUPERPAGE_SHIFT），作为匿名映射的 fd 传入
+    private static let superpageFlags: Int32 = 2 << 16
+    
+    private let logger = Logger.shared
+    
+    // MARK: - Initialization
+    
+    /// - Parameters:
+    ///   - name: 会话名称（用于日志）
+    ///   - capacity: 期望容量（字节），按页或超级页向上取整
+    public init?(name: String, capacity: Int) {
+        self.name = name
+        var mapped: UnsafeMutableRawPointer?
+        var size = EngineArena.roundUp(max(capacity, 1), to: Int(getpagesize()))
+        var hugePages = false
+        
+        #if arch(x86_64)
+        if capacity >= EngineArena.hugePageSize {
+            let hugeSize = EngineArena.roundUp(capacity, to: EngineArena.hugePageSize)
+            let pointer = mmap(nil, hugeSize, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE, EngineArena.superpageFlags, 0)
+            if let pointer = pointer, pointer != MAP_FAILED {
+                mapped = pointer
+                size = hugeSize
+                hugePages = true
+            }
+        }
+        #endif
+        
+        if mapped == nil {
+            let pointer = mmap(nil, size, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE, -1, 0)
+            guard let pointer = pointer, pointer != MAP_FAILED else {
+                Logger.shared.warning("⚠️ EngineArena[\(name)]: 映射 \(size) 字节失败（errno \(errno)），改用堆分配")
+                return nil
+            }
+            mapped = pointer
+        }
+        
+        self.base = mapped!
+        self.capacity = size
+        self.isHugePageBacked = hugePages
+        EngineArena.register(self)
+    }
+    
+    deinit {
+        unmap()
+    }
+    
+    /// 按处理图形状估算容量：每个节点一个输出块，另加环形缓冲区与暂存区，每个分配预留一个缓存行
+    public static func estimatedCapacity(nodes: Int, channels: Int, maxFrames: Int, extraBytes: Int = 0) -> Int {
+        let block = channels * maxFrames * MemoryLayout<Float>.stride
+            + channels * MemoryLayout<UnsafeMutablePointer<Float>>.stride
+            + 2 * cacheLineSize
+        return nodes * block + extraBytes + 8 * cacheLineSize
+    }
+    
+    // MARK: - Scope
+    
+    private static let currentKey: pthread_key_t = {
+        var key = pthread_key_t()
+        pthread_key_create(&key, nil)
+        return key
+    }()
+    
+    /// 当前线程正在整体丢弃的内存区（`drop(_:)` 作用域）
+    private static let droppingKey: pthread_key_t = {
+        var key = pthread_key_t()
+        pthread_key_create(&key, nil)
+        return key
+    }()
+    
+    /// 当前线程正在使用的内存区
+    static var current: EngineArena? {
+        guard let pointer = pthread_getspecific(currentKey) else { return nil }
+        return Unmanaged<EngineArena>.fromOpaque(pointer).takeUnretainedValue()
+    }
+    
+    /// 在作用域内把当前线程的引擎分配切到本内存区（构建处理图时使用）
+    func withCurrent<T>(_ body: () throws -> T) rethrows -> T {
+        let previous = pthread_getspecific(EngineArena.currentKey)
+        pthread_setspecific(EngineArena.currentKey, Unmanaged.passUnretained(self).toOpaque())
+        defer { pthread_setspecific(EngineArena.currentKey, previous) }
+        return try body()
+    }
+    
+    // MARK: - Allocation
+    
+    /// 切分一段缓存行对齐的内存，容量不足时返回 nil（由调用方回退到堆）
+    func allocate(byteCount: Int, alignment: Int) -> UnsafeMutableRawPointer? {
+        RealtimeSafety.check(.lock, "EngineArena.allocate")
+        lock.lock()
+        defer { lock.unlock() }
+        guard !isClosed else { return nil }
+        let start = EngineArena.roundUp(offset, to: max(alignment, EngineArena.cacheLineSize))
+        guard start + byteCount <= capacity else {
+            if overflowBytes == 0 {
+                logger.warning("⚠️ EngineArena[\(name)]: 容量 \(capacity) 字节不足，后续分配回退到堆")
+            }
+            overflowBytes += byteCount
+            return nil
+        }
+        offset = start + byteCount
+        outstanding.increment()
+        return base + start
+    }
+    
+    /// 已切分的字节数（含对齐填充）
+    var usedBytes: Int {
+        RealtimeSafety.check(.lock, "EngineArena.usedBytes")
+        lock.lock()
+        defer { lock.unlock() }
+        return offset
+    }
+    
+    /// 映射是否仍然存在（全部分配归还且内存区关闭后为 false）
+    var isMapped: Bool {
+        RealtimeSafety.check(.lock, "EngineArena.isMapped")
+        lock.lock()
+        defer { lock.unlock() }
+        return !isUnmapped
+    }
+    
+    /// 会话结束：不再切分；所有分配归还后解除映射
+    func close() {
+        RealtimeSafety.check(.lock, "EngineArena.close")
+        lock.lock()
+        let wasClosed = isClosed
+        isClosed = true
+        lock.unlock()
+        guard !wasClosed else { return }
+        if outstanding.decrement() == 0 {
+            unmap()
+        }
+    }
+    
+    /// 整体丢弃：在作用域内析构持有本内存区分配的对象（处理图释放节点时使用），
+    /// 其间属于本内存区的块由 `forget(_:)` 跳过逐个归还，作用域结束时一次扣除并关闭内存区
+    func drop(_ body: () -> Void) {
+        let previous = pthread_getspecific(EngineArena.droppingKey)
+        pthread_setspecific(EngineArena.droppingKey, Unmanaged.passUnretained(self).toOpaque())
+        body()
+        pthread_setspecific(EngineArena.droppingKey, previous)
+        let dropped = droppedCount
+        droppedCount = 0
+        if dropped > 0 && outstanding.add(-dropped) == 0 {
+            // 此前已关闭，丢弃的就是最后的分配
+            unmap()
+        }
+        close()
+    }
+    
+    private func contains(_ pointer: UnsafeMutableRawPointer) -> Bool {
+        return pointer >= base && pointer < base + capacity
+    }
+    
+    /// 归还一个分配，返回是否为最后一个（且内存区已关闭）
+    private func releaseAllocation() -> Bool {
+        return outstanding.decrement() == 0
+    }
+    
+    private func unmap() {
+        RealtimeSafety.check(.lock, "EngineArena.unmap")
+        lock.lock()
+        let shouldUnmap = !isUnmapped
+        isUnmapped = true
+        lock.unlock()
+        guard shouldUnmap else { return }
+        EngineArena.unregister(self)
+        munmap(base, capacity)
+    }
+    
+    private static func roundUp(_ value: Int, to multiple: Int) -> Int {
+        return (value + multiple - 1) / multiple * multiple
+    }
+    
+    // MARK: - Registry
+    
+    /// 存活的内存区（释放指针时按地址查找所属内存区；登记表持有引用直到解除映射）
+    private static let registryLock = NSLock()
+    private static var arenas: [EngineArena] = []
+    
+    private static func register(_ arena: EngineArena) {
+        RealtimeSafety.check(.lock, "EngineArena.register")
+        registryLock.lock()
+        arenas.append(arena)
+        registryLock.unlock()
+    }
+    
+    private static func unregister(_ arena: EngineArena) {
+        RealtimeSafety.check(.lock, "EngineArena.unregister")
+        registryLock.lock()
+        arenas.removeAll { $0 === arena }
+        registryLock.unlock()
+    }
+    
+    /// 当前线程正在丢弃的内存区拥有该指针时记下并返回 true（不查登记表、不加锁），否则返回 false
+    static func forget(_ pointer: UnsafeMutableRawPointer) -> Bool {
+        guard let opaque = pthread_getspecific(droppingKey) else { return false }
+        let arena = Unmanaged<EngineArena>.fromOpaque(opaque).takeUnretainedValue()
+        guard arena.contains(pointer) else { return false }
+        arena.droppedCount += 1
+        return true
+    }
+    
+    /// 若指针属于某个内存区则归还给它并返回 true（不释放内存），否则返回 false
+    static func release(_ pointer: UnsafeMutableRawPointer) -> Bool {
+        RealtimeSafety.check(.lock, "EngineArena.release")
+        registryLock.lock()
+        let owner = arenas.first { $0.contains(pointer) }
+        registryLock.unlock()
+        guard let arena = owner else { return false }
+        if arena.releaseAllocation() {
+            arena.unmap()
+        }
+        return true
+    }
+}
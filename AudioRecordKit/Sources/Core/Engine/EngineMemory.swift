@@ -0,0 +1,284 @@
+import Foundation
+
+// MARK: - MemoryTag
+/// 引擎内存类别
+///
+/// 取值与 C API 的 `AudioRecordMemoryTag` 一致，不可调整。
+enum MemoryTag: Int, CaseIterable {
+    /// 节点输出块（AudioBlock）
+    case blocks = 0
+    /// 环形缓冲区（PlanarRingBuffer、写入器队列）
+    case rings = 1
+    /// 节点暂存区（写入器交错缓冲、混音增益表等）
+    case scratch = 2
+    /// 回调采集的字节环形缓冲区与暂存区
+    case capture = 3
+    /// 引擎追踪的线程缓冲区
+    case trace = 4
+    /// 诊断缓冲区（二进制日志队列、xrun 事件队列、延迟直方图）
+    case diagnostics = 5
+    
+    var name: String {
+        switch self {
+        case .blocks: return "blocks"
+        case .rings: return "rings"
+        case .scratch: return "scratch"
+        case .capture: return "capture"
+        case .trace: return "trace"
+        case .diagnostics: return "diagnostics"
+        }
+    }
+    
+    /// 是否可从会话内存区切分（采集、追踪与诊断缓冲区由单例长期持有，始终在堆上分配）
+    var isSessionScoped: Bool {
+        switch self {
+        case .blocks, .rings, .scratch: return true
+        case .capture, .trace, .diagnostics: return false
+        }
+    }
+}
+
+// MARK: - MemoryLedger
+/// 按类别累计的字节数（非线程安全，用于节点在初始化时登记自身分配）
+struct MemoryLedger {
+    
+    private(set) var bytes = [Int](repeating: 0, count: MemoryTag.allCases.count)
+    
+    var total: Int {
+        return bytes.reduce(0, +)
+    }
+    
+    mutating func add(_ count: Int, tag: MemoryTag) {
+        bytes[tag.rawValue] += count
+    }
+    
+    subscript(tag: MemoryTag) -> Int {
+        return bytes[tag.rawValue]
+    }
+}
+
+// MARK: - MemoryAccount
+/// 内存账户 - 按类别的原子字节计数与峰值
+///
+/// `global` 记录引擎全部分配（由 `EngineMemory.allocate` 自动记账）；
+/// 每个处理图持有一个会话账户，加入节点时收录节点登记的字节数，
+/// 处理图释放时账户随之注销。会话账户可带预算：建图前经 `EngineMemory.grant` 批准的字节
+/// 先记为预留，处理图编译后由节点的实际记账取代。计数只用原子操作，可在任意线程读取。
+@_spi(Benchmarks) public final class MemoryAccount {
+    
+    static let global = MemoryAccount(name: "global")
+    
+    // MARK: - Properties
+    let name: String
+    /// 账户预算（字节），0 表示不限制
+    let limitBytes: Int64
+    private let current = AtomicInt64Array(count: MemoryTag.allCases.count)
+    private let total = AtomicInt64()
+    private let peak = AtomicInt64()
+    private let reserved = AtomicInt64()
+    
+    // MARK: - Initialization
+    
+    init(name: String, limitBytes: Int64 = 0) {
+        self.name = name
+        self.limitBytes = max(0, limitBytes)
+    }
+    
+    // MARK: - Accounting
+    
+    func charge(_ bytes: Int, tag: MemoryTag) {
+        current.add(Int64(bytes), at: tag.rawValue)
+        peak.storeMax(total.add(Int64(bytes)))
+    }
+    
+    func release(_ bytes: Int, tag: MemoryTag) {
+        current.add(-Int64(bytes), at: tag.rawValue)
+        total.add(-Int64(bytes))
+    }
+    
+    /// 收录节点登记的全部字节
+    func adopt(_ ledger: MemoryLedger) {
+        for tag in MemoryTag.allCases where ledger[tag] > 0 {
+            charge(ledger[tag], tag: tag)
+        }
+    }
+    
+    /// 预留已批准、尚未分配的字节（计入预算，不计入统计）
+    func reserve(_ bytes: Int) {
+        reserved.add(Int64(bytes))
+    }
+    
+    /// 清除预留（处理图编译后节点已收录实际分配）
+    func settleReservations() {
+        reserved.store(0)
+    }
+    
+    // MARK: - Query
+    
+    var totalBytes: Int64 {
+        return total.value
+    }
+    
+    var peakBytes: Int64 {
+        return peak.value
+    }
+    
+    /// 占用预算的字节数（已记账 + 预留）
+    var committedBytes: Int64 {
+        return total.value + reserved.value
+    }
+    
+    func bytes(_ tag: MemoryTag) -> Int64 {
+        return current.load(tag.rawValue)
+    }
+}
+
+// MARK: - MemorySnapshot
+/// 引擎内存快照
+struct MemorySnapshot {
+    let totalBytes: Int64
+    let peakBytes: Int64
+    /// 0 表示不限制
+    let budgetBytes: Int64
+    /// 因预算不足而缩小分配的次数
+    let degradations: Int64
+    let tagBytes: [MemoryTag: Int64]
+    /// 存活的会话（处理图）及其字节数
+    let sessions: [(name: String, bytes: Int64)]
+}
+
+// MARK: - EngineMemory
+/// 引擎内存记账与预算
+///
+/// 引擎的长期缓冲区统一经 `allocate` / `deallocate` 分配并按类别记入全局账户；
+/// 录制器在分配可伸缩的缓冲区（麦克风环形缓冲区、回调采集缓冲区）之前调用
+/// `grant(requested:minimum:tag:what:)`，超出预算时缩小到可用空间（不低于下限），
+/// 以降级代替无限增长。渲染期间不分配，因此记账不在实时路径上。
+/// 处于会话内存区作用域（`EngineArena.withCurrent(_:)`）时，分配从内存区切分。
+enum EngineMemory {
+    
+    /// C API 内存统计结构体版本（AUDIO_RECORD_MEMORY_STATS_VERSION）
+    static let version: UInt32 = 1
+    
+    // MARK: - Budget
+    private static let budget = AtomicInt64()
+    private static let sessionBudget = AtomicInt64()
+    private static let degradations = AtomicInt64()
+    
+    /// 全局内存预算（字节），0 表示不限制
+    static var budgetBytes: Int64 {
+        get { return budget.value }
+        set { budget.store(max(0, newValue)) }
+    }
+    
+    /// 每个会话的内存预算（字节），0 表示不限制；之后创建的会话账户以此为预算
+    static var sessionBudgetBytes: Int64 {
+        get { return sessionBudget.value }
+        set { sessionBudget.store(max(0, newValue)) }
+    }
+    
+    /// 在预算内批准一次分配
+    /// - Parameters:
+    ///   - requested: 期望的字节数
+    ///   - minimum: 可接受的最小字节数（预算不足时也至少批准该值）
+    ///   - tag: 分配类别（用于日志）
+    ///   - what: 分配用途（用于日志）
+    ///   - session: 分配所属的会话账户，同时受其预算约束，批准的字节记为账户的预留
+    /// - Returns: 批准的字节数
+    static func grant(requested: Int, minimum: Int, tag: MemoryTag, what: String, session: MemoryAccount? = nil) -> Int {
+        var available = Int.max
+        let limit = budget.value
+        if limit > 0 {
+            available = Int(max(0, limit - MemoryAccount.global.totalBytes))
+        }
+        if let session = session, session.limitBytes > 0 {
+            available = min(available, Int(max(0, session.limitBytes - session.committedBytes)))
+        }
+        var granted = requested
+        if requested > available {
+            granted = max(minimum, available)
+            if granted < requested {
+                degradations.increment()
+                let sessionInfo = session.map { $0.limitBytes > 0 ? "，会话 \($0.name) 预算 \($0.limitBytes)，已占用 \($0.committedBytes)" : "" } ?? ""
+                Logger.shared.warning("⚠️ EngineMemory: 内存预算不足，\(what)[\(tag.name)] 由 \(requested) 字节缩小为 \(granted) 字节（预算 \(limit)，已用 \(MemoryAccount.global.totalBytes)\(sessionInfo)）")
+            }
+        }
+        session?.reserve(granted)
+        return granted
+    }
+    
+    // MARK: - Allocation
+    
+    /// 分配并记账；当前线程处于会话内存区作用域且类别属于会话时从内存区切分
+    static func allocate<T>(_ type: T.Type, capacity: Int, tag: MemoryTag) -> UnsafeMutablePointer<T> {
+        let byteCount = capacity * MemoryLayout<T>.stride
+        MemoryAccount.global.charge(byteCount, tag: tag)
+        if tag.isSessionScoped, let arena = EngineArena.current, let pointer = arena.allocate(byteCount: byteCount, alignment: MemoryLayout<T>.alignment) {
+            return pointer.bindMemory(to: T.self, capacity: capacity)
+        }
+        return UnsafeMutablePointer<T>.allocate(capacity: capacity)
+    }
+    
+    static func deallocate<T>(_ pointer: UnsafeMutablePointer<T>, capacity: Int, tag: MemoryTag) {
+        let raw = UnsafeMutableRawPointer(pointer)
+        if !EngineArena.forget(raw) && !EngineArena.release(raw) {
+            pointer.deallocate()
+        }
+        MemoryAccount.global.release(capacity * MemoryLayout<T>.stride, tag: tag)
+    }
+    
+    static func allocateRaw(byteCount: Int, alignment: Int, tag: MemoryTag) -> UnsafeMutableRawPointer {
+        MemoryAccount.global.charge(byteCount, tag: tag)
+        if tag.isSessionScoped, let arena = EngineArena.current, let pointer = arena.allocate(byteCount: byteCount, alignment: alignment) {
+            return pointer
+        }
+        return UnsafeMutableRawPointer.allocate(byteCount: byteCount, alignment: alignment)
+    }
+    
+    static func deallocateRaw(_ pointer: UnsafeMutableRawPointer, byteCount: Int, tag: MemoryTag) {
+        if !EngineArena.forget(pointer) && !EngineArena.release(pointer) {
+            pointer.deallocate()
+        }
+        MemoryAccount.global.release(byteCount, tag: tag)
+    }
+    
+    // MARK: - Sessions
+    private final class WeakAccount {
+        weak var account: MemoryAccount?
+        init(_ account: MemoryAccount) { self.account = account }
+    }
+    
+    private static let lock = NSLock()
+    private static var sessions: [WeakAccount] = []
+    
+    /// 创建并登记一个会话账户（预算取当前的 `sessionBudgetBytes`）
+    static func makeSessionAccount(name: String) -> MemoryAccount {
+        let account = MemoryAccount(name: name, limitBytes: sessionBudget.value)
+        lock.lock()
+        sessions.removeAll { $0.account == nil }
+        sessions.append(WeakAccount(account))
+        lock.unlock()
+        return account
+    }
+    
+    // MARK: - Snapshot
+    
+    static func snapshot() -> MemorySnapshot {
+        lock.lock()
+        let live = sessions.compactMap { $0.account }
+        lock.unlock()
+        let global = MemoryAccount.global
+        var tagBytes: [MemoryTag: Int64] = [:]
+        for tag in MemoryTag.allCases {
+            tagBytes[tag] = global.bytes(tag)
+        }
+        return MemorySnapshot(
+            totalBytes: global.totalBytes,
+            peakBytes: global.peakBytes,
+            budgetBytes: budget.value,
+            degradations: degradations.value,
+            tagBytes: tagBytes,
+            sessions: live.map { (name: $0.name, bytes: $0.totalBytes) }
+        )
+    }
+}
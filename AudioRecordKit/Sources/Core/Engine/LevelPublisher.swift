@@ -0,0 +1,63 @@
+import Foundation
+
+// MARK: - LevelPublisher
+/// 电平发布器 - 渲染线程写原子变量，主线程定时读取并回调
+///
+/// 在实时线程上每个量子 `DispatchQueue.main.async` 会分配派发块；这里渲染线程只调用
+/// `publish(_:)` 写入电平与序号，主线程定时器发现序号变化时才回调最新的电平。
+final class LevelPublisher {
+    
+    // MARK: - Properties
+    /// 默认回调间隔（约 30Hz，足够驱动电平表 UI）
+    static let defaultInterval: DispatchTimeInterval = .milliseconds(33)
+    
+    private let levelBits = AtomicInt64()
+    private let sequence = AtomicInt64()
+    private var lastSequence: Int64 = 0
+    private var timer: DispatchSourceTimer?
+    private let handler: (Float) -> Void
+    
+    // MARK: - Initialization
+    
+    /// - Parameters:
+    ///   - interval: 主线程检查间隔
+    ///   - handler: 电平回调（在主线程调用）
+    init(interval: DispatchTimeInterval = LevelPublisher.defaultInterval, handler: @escaping (Float) -> Void) {
+        self.handler = handler
+        let timer = DispatchSource.makeTimerSource(queue: .main)
+        timer.schedule(deadline: .now() + interval, repeating: interval, leeway: .milliseconds(5))
+        timer.setEventHandler { [weak self] in
+            self?.deliver()
+        }
+        timer.resume()
+        self.timer = timer
+    }
+    
+    deinit {
+        timer?.cancel()
+    }
+    
+    // MARK: - Publishing
+    
+    /// 发布一个电平值（渲染线程调用：不加锁、不分配）
+    @inline(__always)
+    func publish(_ level: Float) {
+        levelBits.storeFloat(level)
+        sequence.increment()
+    }
+    
+    /// 停止回调（之后发布的电平不再送达）
+    func cancel() {
+        timer?.cancel()
+        timer = nil
+    }
+    
+    // MARK: - Private
+    
+    private func deliver() {
+        let current = sequence.value
+        guard current != lastSequence else { return }
+        lastSequence = current
+        handler(levelBits.floatValue)
+    }
+}
@@ -0,0 +1,247 @@
+import Foundation
+import Accelerate
+
+// MARK: - MixerNode
+/// 混音节点 - 按每路增益叠加所有输入
+///
+/// 输入声道少于输出时复制该输入的最后一个声道；输入帧数不足一个量子时按静音处理。
+@_spi(Benchmarks) public final class MixerNode: AudioNode {
+    
+    // MARK: - Properties
+    private let gains: UnsafeMutablePointer<Float>
+    private let maxInputs: Int
+    private let multiplyAdd = DSPKernels.multiplyAdd.function
+    
+    // MARK: - Initialization
+    
+    public init(name: String, channels: Int, maxFrames: Int, sampleRate: Double, maxInputs: Int = 8) {
+        self.maxInputs = maxInputs
+        gains = EngineMemory.allocate(Float.self, capacity: maxInputs, tag: .scratch)
+        gains.initialize(repeating: 1.0, count: maxInputs)
+        super.init(name: name, role: .processor, channels: channels, maxFrames: maxFrames, sampleRate: sampleRate)
+        recordAllocation(maxInputs * MemoryLayout<Float>.stride, tag: .scratch)
+    }
+    
+    deinit {
+        EngineMemory.deallocate(gains, capacity: maxInputs, tag: .scratch)
+    }
+    
+    /// 设置第 index 路输入的增益（可在渲染期间调用，单次写入 Float）
+    public func setGain(_ gain: Float, forInput index: Int) {
+        guard index >= 0 && index < maxInputs else { return }
+        gains[index] = gain
+    }
+    
+    // MARK: - AudioNode
+    
+    override func process(_ context: AudioRenderContext) {
+        let frames = context.frameCount
+        output.clear(frames: frames)
+        
+        for index in 0..<min(inputs.count, maxInputs) {
+            let block = input(index)
+            let n = min(frames, block.frameCount)
+            guard n > 0 else { continue }
+            let gain = gains[index]
+            for c in 0..<output.channelCount {
+                let src = block.channel(min(c, block.channelCount - 1))
+                multiplyAdd(src, gain, output.channel(c), n)
+            }
+        }
+        stampOutput(context, frames: frames)
+    }
+}
+
+// MARK: - LimiterNode
+/// 峰值限幅节点 - 取代逐样本硬削波
+///
+/// 瞬时起音（超过阈值立即压低增益，保证不过冲），指数释放；
+/// 最后做一次硬限幅兜底。
+@_spi(Benchmarks) public final class LimiterNode: AudioNode {
+    
+    // MARK: - Properties
+    private let threshold: Float
+    private let releaseCoefficient: Float
+    private var gain: Float = 1.0
+    
+    // MARK: - Initialization
+    
+    /// - Parameters:
+    ///   - threshold: 线性阈值（0~1）
+    ///   - releaseMs: 释放时间（毫秒）
+    public init(name: String, channels: Int, maxFrames: Int, sampleRate: Double, threshold: Float = 0.98, releaseMs: Double = 80) {
+        self.threshold = threshold
+        self.releaseCoefficient = Float(1.0 - exp(-1.0 / (releaseMs * 0.001 * sampleRate)))
+        super.init(name: name, role: .processor, channels: channels, maxFrames: maxFrames, sampleRate: sampleRate)
+    }
+    
+    // MARK: - AudioNode
+    
+    override func process(_ context: AudioRenderContext) {
+        let source = input(0)
+        let frames = min(context.frameCount, source.frameCount)
+        let channels = output.channelCount
+        
+        for frame in 0..<frames {
+            var peak: Float = 0
+            for c in 0..<channels {
+                peak = max(peak, abs(source.channel(min(c, source.channelCount - 1))[frame]))
+            }
+            let target: Float = peak > threshold ? threshold / peak : 1.0
+            if target < gain {
+                gain = target
+            } else {
+                gain += (target - gain) * releaseCoefficient
+            }
+            for c in 0..<channels {
+                output.channel(c)[frame] = source.channel(min(c, source.channelCount - 1))[frame] * gain
+            }
+        }
+        
+        var low: Float = -1.0
+        var high: Float = 1.0
+        for c in 0..<channels {
+            vDSP_vclip(output.channel(c), 1, &low, &high, output.channel(c), 1, vDSP_Length(frames))
+        }
+        stampOutput(context, frames: frames)
+    }
+    
+    override func reset() {
+        super.reset()
+        gain = 1.0
+    }
+}
+
+// MARK: - AGCNode
+/// 自动增益控制节点
+///
+/// 以 RMS 包络跟踪输入电平，向目标电平缓慢收敛；增益限制在 [minGain, maxGain]，
+/// 低于噪声门限时保持当前增益，避免静音段把底噪拉高。
+@_spi(Benchmarks) public final class AGCNode: AudioNode {
+    
+    // MARK: - Properties
+    private let targetRMS: Float
+    private let minGain: Float
+    private let maxGain: Float
+    private let gateRMS: Float
+    /// 每个样本的保持系数 exp(-1/τ·fs)，每块按实际帧数取幂
+    private let retentionPerSample: Float
+    private var gain: Float = 1.0
+    
+    // MARK: - Initialization
+    
+    public init(name: String, channels: Int, maxFrames: Int, sampleRate: Double,
+                targetRMS: Float = 0.1, minGain: Float = 0.25, maxGain: Float = 8.0,
+                gateRMS: Float = 0.001, timeConstantMs: Double = 500) {
+        self.targetRMS = targetRMS
+        self.minGain = minGain
+        self.maxGain = maxGain
+        self.gateRMS = gateRMS
+        self.retentionPerSample = Float(exp(-1.0 / (timeConstantMs * 0.001 * sampleRate)))
+        super.init(name: name, role: .processor, channels: channels, maxFrames: maxFrames, sampleRate: sampleRate)
+    }
+    
+    // MARK: - AudioNode
+    
+    override func process(_ context: AudioRenderContext) {
+        let source = input(0)
+        let frames = min(context.frameCount, source.frameCount)
+        let n = vDSP_Length(frames)
+        
+        var sumSquares: Float = 0
+        for c in 0..<source.channelCount {
+            var channelSum: Float = 0
+            vDSP_svesq(source.channel(c), 1, &channelSum, n)
+            sumSquares += channelSum
+        }
+        let rms = frames > 0 ? sqrt(sumSquares / Float(frames * source.channelCount)) : 0
+        
+        if rms > gateRMS {
+            let desired = min(max(targetRMS / rms, minGain), maxGain)
+            // 时间常数按本块渲染的帧数折算，与量子大小无关
+            let smoothing = 1 - pow(retentionPerSample, Float(frames))
+            gain += (desired - gain) * smoothing
+        }
+        
+        var g = gain
+        for c in 0..<output.channelCount {
+            vDSP_vsmul(source.channel(min(c, source.channelCount - 1)), 1, &g, output.channel(c), 1, n)
+        }
+        stampOutput(context, frames: frames)
+    }
+    
+    override func reset() {
+        super.reset()
+        gain = 1.0
+    }
+}
+
+// MARK: - ResamplerNode
+/// 线性插值重采样节点
+///
+/// 跨量子保留上一块的最后一个样本与小数相位，保证块边界连续。
+/// 输出帧数随相位变化（约为输入帧数 × 输出采样率 / 输入采样率）。
+@_spi(Benchmarks) public final class ResamplerNode: AudioNode {
+    
+    // MARK: - Properties
+    private let step: Double
+    private var phase: Double = 0
+    private let lastSamples: UnsafeMutablePointer<Float>
+    private var hasHistory = false
+    
+    // MARK: - Initialization
+    
+    public init(name: String, channels: Int, maxInputFrames: Int, inputSampleRate: Double, outputSampleRate: Double) {
+        step = inputSampleRate / outputSampleRate
+        lastSamples = EngineMemory.allocate(Float.self, capacity: channels, tag: .scratch)
+        lastSamples.initialize(repeating: 0, count: channels)
+        let maxOutputFrames = Int((Double(maxInputFrames) / step).rounded(.up)) + 2
+        super.init(name: name, role: .processor, channels: channels, maxFrames: maxOutputFrames, sampleRate: outputSampleRate)
+        recordAllocation(channels * MemoryLayout<Float>.stride, tag: .scratch)
+    }
+    
+    deinit {
+        EngineMemory.deallocate(lastSamples, capacity: output.channelCapacity, tag: .scratch)
+    }
+    
+    // MARK: - AudioNode
+    
+    override func process(_ context: AudioRenderContext) {
+        let source = input(0)
+        let n = source.frameCount
+        guard n > 0 else {
+            stampOutput(context, frames: 0)
+            return
+        }
+        
+        // 首个量子没有历史样本，从 0 开始
+        var position = hasHistory ? phase : 0
+        var produced = 0
+        let channels = output.channelCount
+        while position < Double(n - 1) && produced < output.frameCapacity {
+            let index = Int(position.rounded(.down))
+            let fraction = Float(position - Double(index))
+            for c in 0..<channels {
+                let src = source.channel(min(c, source.channelCount - 1))
+                let a = index < 0 ? lastSamples[c] : src[index]
+                let b = src[index + 1]
+                output.channel(c)[produced] = a + (b - a) * fraction
+            }
+            produced += 1
+            position += step
+        }
+        
+        phase = position - Double(n)
+        for c in 0..<channels {
+            lastSamples[c] = source.channel(min(c, source.channelCount - 1))[n - 1]
+        }
+        hasHistory = true
+        stampOutput(context, frames: produced)
+    }
+    
+    override func reset() {
+        super.reset()
+        phase = 0
+        hasHistory = false
+    }
+}
@@ -0,0 +1,247 @@
+import Foundation
+
+// MARK: - LevelScale
+/// 电平换算方式
+@_spi(Benchmarks) public enum LevelScale {
+    /// 线性 RMS 乘以灵敏度后截断到 0~1
+    case linearRMS(sensitivity: Float)
+    /// RMS 转 dB，再把 [-floorDB, 0] 映射到 0~1
+    case decibel(floorDB: Float)
+    
+    func normalize(rms: Float) -> Float {
+        switch self {
+        case .linearRMS(let sensitivity):
+            return min(1.0, rms * sensitivity)
+        case .decibel(let floorDB):
+            let db = rms > 0 ? 20 * log10(rms) : -floorDB
+            return max(0, min(1, (db + floorDB) / floorDB))
+        }
+    }
+}
+
+// MARK: - MeterNode
+/// 电平表节点 - 计算峰值与 RMS
+///
+/// 测量值以原子变量发布，可在任意线程读取；设置了 `levelPublisher` 时每个量子发布一次归一化电平，
+/// 由发布器在主线程回调。
+@_spi(Benchmarks) public final class MeterNode: AudioNode {
+    
+    // MARK: - Properties
+    private let scale: LevelScale
+    private let peakBits = AtomicInt64()
+    private let rmsBits = AtomicInt64()
+    private let measure = DSPKernels.peakSumSquares.function
+    
+    /// 归一化电平发布器（在启动渲染前设置）
+    var levelPublisher: LevelPublisher?
+    
+    // MARK: - Initialization
+    
+    public init(name: String, channels: Int, maxFrames: Int, sampleRate: Double, scale: LevelScale) {
+        self.scale = scale
+        super.init(name: name, role: .sink, channels: channels, maxFrames: maxFrames, sampleRate: sampleRate)
+    }
+    
+    // MARK: - Measurements
+    
+    /// 最近一个量子的峰值（线性）
+    var peak: Float {
+        return peakBits.floatValue
+    }
+    
+    /// 最近一个量子的 RMS（线性）
+    var rms: Float {
+        return rmsBits.floatValue
+    }
+    
+    // MARK: - AudioNode
+    
+    override func process(_ context: AudioRenderContext) {
+        let source = input(0)
+        let frames = min(context.frameCount, source.frameCount)
+        guard frames > 0 else { return }
+        
+        var peakValue: Float = 0
+        var sumSquares: Float = 0
+        for c in 0..<source.channelCount {
+            let channelLevel = measure(source.channel(c), frames)
+            peakValue = max(peakValue, channelLevel.peak)
+            sumSquares += channelLevel.sumSquares
+        }
+        let rmsValue = sqrt(sumSquares / Float(frames * source.channelCount))
+        
+        peakBits.storeFloat(peakValue)
+        rmsBits.storeFloat(rmsValue)
+        levelPublisher?.publish(scale.normalize(rms: rmsValue))
+    }
+}
+
+// MARK: - FileWriterNode
+/// 文件写入节点 - 由采集管线把非交错块编码为文件格式后交给 AudioToolboxFileManager
+///
+/// 编码缓冲区在创建时按最大量子预分配，渲染期间不再分配。
+/// 写入开关关闭时（预热阶段）直接丢弃数据，打开后的下一个量子开始写入。
+/// 录制器使用异步模式：渲染线程只把编码后的块放入写入队列，由写入线程落盘；
+/// 队列写满时丢弃该块并上报 ringOverrun。离线回放与基准测试使用同步模式。
+@available(macOS 14.4, *)
+@_spi(Benchmarks) public final class FileWriterNode: AudioNode {
+    
+    // MARK: - Properties
+    private let fileManager: AudioToolboxFileManager
+    private let pipeline: CapturePipeline
+    private let scratch: UnsafeMutableRawPointer
+    private let scratchBytes: Int
+    private let maxFrames: Int
+    private let logger = Logger.shared
+    private let writing: AtomicInt64
+    /// 开关打开后第一次写入成功的时间（mach_absolute_time，0 表示尚未写入）
+    private let firstWriteHostTime: AtomicInt64?
+    /// 是否经写入线程异步落盘
+    private let asynchronous: Bool
+    private let writtenFrames = AtomicInt64()
+    private let writeErrors = AtomicInt64()
+    
+    /// 已写入的帧数
+    var framesWritten: Int64 {
+        return writtenFrames.value
+    }
+    /// 写入失败次数
+    var writeErrorCount: Int {
+        return Int(writeErrors.value)
+    }
+    
+    // MARK: - Initialization
+    
+    /// - Parameters:
+    ///   - isWriting: 初始写入开关（预热时为 false）
+    ///   - firstWriteHostTime: 记录第一次写入时间（由调用方在打开开关前清零）
+    ///   - queueBytes: 大于 0 时经写入线程异步落盘（IO 线程只入队），否则在渲染线程上同步写入
+    public init(name: String, fileManager: AudioToolboxFileManager, pipeline: CapturePipeline, maxFrames: Int, sampleRate: Double,
+                isWriting: Bool = true, firstWriteHostTime: AtomicInt64? = nil, queueBytes: Int = 0) {
+        self.fileManager = fileManager
+        self.writing = AtomicInt64(isWriting ? 1 : 0)
+        self.firstWriteHostTime = firstWriteHostTime
+        self.asynchronous = queueBytes > 0
+        self.pipeline = pipeline
+        self.maxFrames = maxFrames
+        let configuration = pipeline.configuration
+        let byteCapacity = maxFrames * configuration.channelCount * MemoryLayout<Float>.size
+        self.scratch = EngineMemory.allocateRaw(byteCount: byteCapacity, alignment: MemoryLayout<Float>.alignment, tag: .scratch)
+        self.scratch.initializeMemory(as: UInt8.self, repeating: 0, count: byteCapacity)
+        self.scratchBytes = byteCapacity
+        // 输出端不产生数据，输出块只占最小容量
+        super.init(name: name, role: .sink, channels: 1, maxFrames: 1, sampleRate: sampleRate)
+        recordAllocation(byteCapacity, tag: .scratch)
+        // 编码与写入分别计时
+        self.statsStage = nil
+        if asynchronous {
+            fileManager.startAsynchronousWrites(queueBytes: queueBytes, maxBlockBytes: byteCapacity) { [weak self] write, mark, success in
+                self?.completeWrite(write, startedAt: mark, success: success)
+            }
+        }
+    }
+    
+    deinit {
+        EngineMemory.deallocateRaw(scratch, byteCount: scratchBytes, tag: .scratch)
+    }
+    
+    // MARK: - Writing Gate
+    
+    /// 写入开关（任意线程设置，下一个量子生效）
+    public var isWriting: Bool {
+        get { return writing.value != 0 }
+        set { writing.store(newValue ? 1 : 0) }
+    }
+    
+    // MARK: - AudioNode
+    
+    override func process(_ context: AudioRenderContext) {
+        guard writing.value != 0 else { return }
+        let source = input(0)
+        let frames = min(context.frameCount, source.frameCount, maxFrames)
+        guard frames > 0 else { return }
+        
+        let encodeMark = context.timer.map { _ in StageMark.now() }
+        let byteCount = pipeline.encode(source, frames: frames, into: scratch)
+        if let timer = context.timer, let mark = encodeMark {
+            timer.add(.encode, since: mark)
+        }
+        
+        if asynchronous {
+            // 写入与端到端延迟由写入线程在落盘后记录
+            if !fileManager.enqueueEncodedPackets(scratch, byteCount: byteCount, frameCount: UInt32(frames),
+                                                  captureHostTime: context.hostTime, timed: context.timer != nil) {
+                xruns.report(.ringOverrun, origin: "writer", frames: Int64(frames))
+            }
+            return
+        }
+        
+        do {
+            let writeMark = context.timer.map { _ in StageMark.now() }
+            try fileManager.writeEncodedPackets(scratch, byteCount: byteCount, frameCount: UInt32(frames))
+            if let timer = context.timer, let mark = writeMark {
+                timer.add(.write, since: mark)
+                timer.completeWrite(captureHostTime: context.hostTime)
+            }
+            markWritten(frames: Int64(frames))
+        } catch {
+            writeErrors.increment()
+            xruns.report(.writeFailure, origin: "writer", frames: Int64(frames))
+            logger.record(.error, "FileWriterNode: 写入音频数据失败: {}", .int((error as NSError).code))
+        }
+    }
+    
+    override func reset() {
+        super.reset()
+        writtenFrames.store(0)
+        writeErrors.store(0)
+    }
+    
+    // MARK: - Private
+    
+    private func markWritten(frames: Int64) {
+        if let mark = firstWriteHostTime, mark.value == 0 {
+            mark.store(Int64(mach_absolute_time()))
+        }
+        writtenFrames.add(frames)
+    }
+    
+    /// 异步写入完成（写入线程调用）
+    private func completeWrite(_ write: AudioToolboxFileManager.EncodedWrite, startedAt mark: StageMark, success: Bool) {
+        guard success else {
+            writeErrors.increment()
+            xruns.report(.writeFailure, origin: "writer", frames: Int64(write.frameCount))
+            return
+        }
+        if write.timed {
+            let end = StageMark.now()
+            let stats = PipelineStats.shared
+            stats.record(.write, wallTicks: end.hostTime &- mark.hostTime, cpuNanoseconds: end.cpuNanoseconds &- mark.cpuNanoseconds)
+            if write.captureHostTime > 0 && write.captureHostTime <= end.hostTime {
+                stats.record(.endToEnd, wallTicks: end.hostTime - write.captureHostTime)
+            }
+        }
+        markWritten(frames: Int64(write.frameCount))
+    }
+}
+
+// MARK: - TapNode
+/// 旁路节点 - 把上游块交给外部闭包观察（不修改数据）
+@_spi(Benchmarks) public final class TapNode: AudioNode {
+    
+    // MARK: - Properties
+    private let handler: (AudioBlock, AudioRenderContext) -> Void
+    
+    // MARK: - Initialization
+    
+    public init(name: String, sampleRate: Double, handler: @escaping (AudioBlock, AudioRenderContext) -> Void) {
+        self.handler = handler
+        super.init(name: name, role: .sink, channels: 1, maxFrames: 1, sampleRate: sampleRate)
+    }
+    
+    // MARK: - AudioNode
+    
+    override func process(_ context: AudioRenderContext) {
+        handler(input(0), context)
+    }
+}
@@ -0,0 +1,169 @@
+import Foundation
+import CoreAudio
+
+// MARK: - PushSourceNode
+/// 推送式源节点
+///
+/// 由采集回调在 `AudioGraph.render` 之前同步写入（同一线程），
+/// 负责把采集格式转换为图内部的非交错块：交错数据解交错，
+/// 非交错数据在声道数一致时直接借用采集缓冲区（零拷贝）。
+@_spi(Benchmarks) public final class PushSourceNode: AudioNode {
+    
+    // MARK: - Properties
+    private var loadedFrames = 0
+    /// 采集管线（设置后交错数据的解交错由特化实例完成）
+    private let pipeline: CapturePipeline?
+    /// 输出声道布局
+    let outputLayout: ChannelLayout
+    /// 采集声道布局与输出不一致时的上/下混矩阵（在启动 IO 之前设置）
+    private(set) var inputMatrix: ChannelMixMatrix?
+    /// 采集 AudioBufferList 的声道视图（预分配，IO 线程复用）
+    private let bufferListView = AudioBufferListView()
+    
+    // MARK: - Initialization
+    
+    public init(name: String, channels: Int, maxFrames: Int, sampleRate: Double, pipeline: CapturePipeline? = nil, outputLayout: ChannelLayout? = nil) {
+        self.pipeline = pipeline
+        self.outputLayout = outputLayout ?? ChannelLayout(channelCount: channels)
+        super.init(name: name, role: .source, channels: channels, maxFrames: maxFrames, sampleRate: sampleRate)
+    }
+    
+    /// 声明采集端的声道布局（必须在启动 IO 回调之前调用）
+    ///
+    /// 与输出布局不同时，载入数据时一次完成解交错与上/下混。
+    func configureInput(layout: ChannelLayout) {
+        if layout == outputLayout {
+            inputMatrix = nil
+        } else {
+            inputMatrix = .standard(from: layout, to: outputLayout)
+        }
+    }
+    
+    // MARK: - Loading
+    
+    /// 载入交错 Float32 数据
+    public func load(interleaved source: UnsafePointer<Float>, channels: Int, frames: Int) {
+        output.restoreStorage()
+        if let matrix = inputMatrix, matrix.inputChannels == channels {
+            matrix.apply(interleaved: source, frames: frames, into: output)
+        } else if let pipeline = pipeline, pipeline.configuration.channelCount == channels {
+            pipeline.ingest(interleaved: source, frames: frames, into: output)
+        } else {
+            output.deinterleave(from: source, channels: channels, frames: frames)
+        }
+        loadedFrames = output.frameCount
+    }
+    
+    /// 载入 Float32 AudioBufferList（单个交错缓冲区或逐声道的非交错缓冲区）
+    ///
+    /// 非交错数据与输出声道数一致时，输出块直接借用采集缓冲区，
+    /// 下游的电平、混音与写入节点都读取同一份内存；借用在本次渲染内有效，下次载入时解除。
+    func load(bufferList: UnsafePointer<AudioBufferList>, frames: Int) {
+        let view = bufferListView
+        guard view.bind(bufferList) else {
+            output.restoreStorage()
+            loadedFrames = 0
+            return
+        }
+        
+        if view.bufferCount == 1 {
+            // 交错：保留特化管线的解交错路径
+            load(interleaved: view.channel(0), channels: view.stride(0), frames: min(frames, view.frameCount))
+            return
+        }
+        
+        output.restoreStorage()
+        let n = min(frames, view.frameCount)
+        if let matrix = inputMatrix, !matrix.isIdentity, matrix.inputChannels == view.channelCount {
+            matrix.apply(view, frames: n, into: output)
+        } else if !(view.isPlanar && view.channelCount == output.channelCapacity
+                    && output.borrow(channels: view.channelPointers, count: view.channelCount, frames: n)) {
+            output.copy(from: view, frames: n)
+        }
+        loadedFrames = output.frameCount
+    }
+    
+    // MARK: - AudioNode
+    
+    override func process(_ context: AudioRenderContext) {
+        // 载入的数据不足一个量子时补零（借用的外部缓冲区先拷入自有存储）
+        if loadedFrames < context.frameCount {
+            output.detach()
+            for c in 0..<output.channelCount {
+                (output.channel(c) + loadedFrames).update(repeating: 0, count: context.frameCount - loadedFrames)
+            }
+        }
+        stampOutput(context, frames: context.frameCount)
+        loadedFrames = 0
+    }
+    
+    override func reset() {
+        output.restoreStorage()
+        super.reset()
+        loadedFrames = 0
+    }
+}
+
+// MARK: - RingBufferSourceNode
+/// 环形缓冲源节点
+///
+/// 用于与图渲染线程异步的采集源（例如 AVAudioEngine 麦克风 Tap）：
+/// 生产者线程写入无锁环形缓冲区，渲染时按量子取出，不足部分补静音。
+@_spi(Benchmarks) public final class RingBufferSourceNode: AudioNode {
+    
+    // MARK: - Properties
+    private let ring: PlanarRingBuffer
+    /// 生产者写入过数据之后才把读取不足视为欠载（启动阶段的静音不计）
+    private let primed = AtomicInt64()
+    
+    // MARK: - Initialization
+    
+    public init(name: String, channels: Int, maxFrames: Int, sampleRate: Double, capacityFrames: Int) {
+        ring = PlanarRingBuffer(channels: channels, capacityFrames: capacityFrames)
+        super.init(name: name, role: .source, channels: channels, maxFrames: maxFrames, sampleRate: sampleRate)
+        recordAllocation(ring.allocatedBytes, tag: .rings)
+    }
+    
+    // MARK: - Producer
+    
+    /// 写入非交错 Float32 数据（生产者线程调用）
+    /// - Returns: 实际写入的帧数（缓冲区已满时丢弃剩余部分）
+    @discardableResult
+    public func write(channels: UnsafePointer<UnsafeMutablePointer<Float>>, channelCount: Int, frames: Int) -> Int {
+        let written = ring.write(channels: channels, sourceChannels: channelCount, frames: frames)
+        if written < frames {
+            xruns.report(.ringOverrun, origin: "ring", frames: Int64(frames - written))
+        }
+        if written > 0 && primed.value == 0 {
+            primed.store(1)
+        }
+        return written
+    }
+    
+    /// 当前缓冲的帧数
+    public var bufferedFrames: Int {
+        return ring.availableFrames
+    }
+    
+    /// 缓冲区容量（帧）
+    var capacityFrames: Int {
+        return ring.capacityFrames
+    }
+    
+    // MARK: - AudioNode
+    
+    override func process(_ context: AudioRenderContext) {
+        let read = ring.read(into: output, frames: context.frameCount)
+        let requested = min(context.frameCount, output.frameCapacity)
+        if read < requested && primed.value != 0 {
+            xruns.report(.ringUnderrun, origin: "ring", frames: Int64(requested - read), hostTime: context.hostTime)
+        }
+        stampOutput(context, frames: context.frameCount)
+    }
+    
+    override func reset() {
+        super.reset()
+        ring.reset()
+        primed.store(0)
+    }
+}
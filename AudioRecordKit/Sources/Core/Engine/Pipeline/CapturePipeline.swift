@@ -0,0 +1,251 @@
+import Foundation
+import CoreAudio
+
+// MARK: - CapturePipelineConfiguration
+/// 采集管线配置（在开始录制时确定，录制期间不变）
+@_spi(Benchmarks) public struct CapturePipelineConfiguration: CustomStringConvertible {
+    public let mode: CaptureMode
+    public let channelCount: Int
+    public let bitDepth: PipelineBitDepth
+    
+    /// 从文件格式构造，不支持的位深回退为 32 位浮点
+    public init(mode: CaptureMode, fileFormat: AudioStreamBasicDescription) {
+        self.mode = mode
+        self.channelCount = max(Int(fileFormat.mChannelsPerFrame), 1)
+        self.bitDepth = PipelineBitDepth(format: fileFormat) ?? .float32
+    }
+    
+    public init(mode: CaptureMode, channelCount: Int, bitDepth: PipelineBitDepth) {
+        self.mode = mode
+        self.channelCount = channelCount
+        self.bitDepth = bitDepth
+    }
+    
+    public var description: String {
+        return "\(mode.name)/\(channelCount)ch/\(bitDepth)"
+    }
+}
+
+// MARK: - CapturePipeline
+/// 采集管线 - 负责采集格式与图内部块、图内部块与文件格式之间的转换
+///
+/// 两个方法都在 IO 线程调用，实现中不得加锁或分配内存。
+@_spi(Benchmarks) public protocol CapturePipeline: AnyObject {
+    var configuration: CapturePipelineConfiguration { get }
+    /// 是否为编译期特化版本
+    var isSpecialized: Bool { get }
+    
+    /// 交错 Float32 采集数据 → 非交错块
+    func ingest(interleaved source: UnsafePointer<Float>, frames: Int, into block: AudioBlock)
+    
+    /// 非交错块 → 交错的文件格式字节
+    /// - Returns: 写入的字节数
+    func encode(_ block: AudioBlock, frames: Int, into destination: UnsafeMutableRawPointer) -> Int
+}
+
+// MARK: - SpecializedPipelineKernels
+/// 特化管线的内层循环
+///
+/// 声道布局与样本格式是泛型参数；函数总是内联，只由下面的具体管线类以具体类型调用，
+/// 因此每个类得到一份声道数与量化方式都是常量的单态化循环，运行时不经过见证表。
+enum SpecializedPipelineKernels {
+    
+    @inline(__always)
+    static func ingest<Layout: PipelineChannelLayout>(_ layout: Layout.Type, _ source: UnsafePointer<Float>, frames: Int, into block: AudioBlock) {
+        let n = min(frames, block.frameCapacity)
+        for c in 0..<Layout.channelCount {
+            let dst = block.channel(c)
+            var src = source + c
+            for i in 0..<n {
+                dst[i] = src.pointee
+                src += Layout.channelCount
+            }
+        }
+        block.frameCount = n
+    }
+    
+    @inline(__always)
+    static func encode<Layout: PipelineChannelLayout, Format: PipelineSampleFormat>(
+        _ layout: Layout.Type, _ format: Format.Type, _ block: AudioBlock, frames: Int, into destination: UnsafeMutableRawPointer
+    ) -> Int {
+        let n = min(frames, block.frameCount)
+        for c in 0..<Layout.channelCount {
+            let src = block.channel(c)
+            for i in 0..<n {
+                Format.store(src[i], to: destination, at: i * Layout.channelCount + c)
+            }
+        }
+        return n * Layout.channelCount * Format.bytesPerSample
+    }
+}
+
+// MARK: - Specialized Pipelines
+// 编译期特化的采集管线：{mono, stereo} × {f32, i16, i24}，每个组合一个具体类。
+// 采集模式不影响转换，只记录在配置中。由 `CapturePipelineFactory` 在开始录制时选择。
+
+final class MonoFloat32CapturePipeline: CapturePipeline {
+    let configuration: CapturePipelineConfiguration
+    let isSpecialized = true
+    
+    init(mode: CaptureMode) {
+        configuration = CapturePipelineConfiguration(mode: mode, channelCount: 1, bitDepth: .float32)
+    }
+    
+    func ingest(interleaved source: UnsafePointer<Float>, frames: Int, into block: AudioBlock) {
+        SpecializedPipelineKernels.ingest(MonoChannelLayout.self, source, frames: frames, into: block)
+    }
+    
+    func encode(_ block: AudioBlock, frames: Int, into destination: UnsafeMutableRawPointer) -> Int {
+        return SpecializedPipelineKernels.encode(MonoChannelLayout.self, Float32SampleFormat.self, block, frames: frames, into: destination)
+    }
+}
+
+final class MonoInt16CapturePipeline: CapturePipeline {
+    let configuration: CapturePipelineConfiguration
+    let isSpecialized = true
+    
+    init(mode: CaptureMode) {
+        configuration = CapturePipelineConfiguration(mode: mode, channelCount: 1, bitDepth: .int16)
+    }
+    
+    func ingest(interleaved source: UnsafePointer<Float>, frames: Int, into block: AudioBlock) {
+        SpecializedPipelineKernels.ingest(MonoChannelLayout.self, source, frames: frames, into: block)
+    }
+    
+    func encode(_ block: AudioBlock, frames: Int, into destination: UnsafeMutableRawPointer) -> Int {
+        return SpecializedPipelineKernels.encode(MonoChannelLayout.self, Int16SampleFormat.self, block, frames: frames, into: destination)
+    }
+}
+
+final class MonoInt24CapturePipeline: CapturePipeline {
+    let configuration: CapturePipelineConfiguration
+    let isSpecialized = true
+    
+    init(mode: CaptureMode) {
+        configuration = CapturePipelineConfiguration(mode: mode, channelCount: 1, bitDepth: .int24)
+    }
+    
+    func ingest(interleaved source: UnsafePointer<Float>, frames: Int, into block: AudioBlock) {
+        SpecializedPipelineKernels.ingest(MonoChannelLayout.self, source, frames: frames, into: block)
+    }
+    
+    func encode(_ block: AudioBlock, frames: Int, into destination: UnsafeMutableRawPointer) -> Int {
+        return SpecializedPipelineKernels.encode(MonoChannelLayout.self, Int24SampleFormat.self, block, frames: frames, into: destination)
+    }
+}
+
+final class StereoFloat32CapturePipeline: CapturePipeline {
+    let configuration: CapturePipelineConfiguration
+    let isSpecialized = true
+    
+    init(mode: CaptureMode) {
+        configuration = CapturePipelineConfiguration(mode: mode, channelCount: 2, bitDepth: .float32)
+    }
+    
+    func ingest(interleaved source: UnsafePointer<Float>, frames: Int, into block: AudioBlock) {
+        SpecializedPipelineKernels.ingest(StereoChannelLayout.self, source, frames: frames, into: block)
+    }
+    
+    func encode(_ block: AudioBlock, frames: Int, into destination: UnsafeMutableRawPointer) -> Int {
+        return SpecializedPipelineKernels.encode(StereoChannelLayout.self, Float32SampleFormat.self, block, frames: frames, into: destination)
+    }
+}
+
+final class StereoInt16CapturePipeline: CapturePipeline {
+    let configuration: CapturePipelineConfiguration
+    let isSpecialized = true
+    
+    init(mode: CaptureMode) {
+        configuration = CapturePipelineConfiguration(mode: mode, channelCount: 2, bitDepth: .int16)
+    }
+    
+    func ingest(interleaved source: UnsafePointer<Float>, frames: Int, into block: AudioBlock) {
+        SpecializedPipelineKernels.ingest(StereoChannelLayout.self, source, frames: frames, into: block)
+    }
+    
+    func encode(_ block: AudioBlock, frames: Int, into destination: UnsafeMutableRawPointer) -> Int {
+        return SpecializedPipelineKernels.encode(StereoChannelLayout.self, Int16SampleFormat.self, block, frames: frames, into: destination)
+    }
+}
+
+final class StereoInt24CapturePipeline: CapturePipeline {
+    let configuration: CapturePipelineConfiguration
+    let isSpecialized = true
+    
+    init(mode: CaptureMode) {
+        configuration = CapturePipelineConfiguration(mode: mode, channelCount: 2, bitDepth: .int24)
+    }
+    
+    func ingest(interleaved source: UnsafePointer<Float>, frames: Int, into block: AudioBlock) {
+        SpecializedPipelineKernels.ingest(StereoChannelLayout.self, source, frames: frames, into: block)
+    }
+    
+    func encode(_ block: AudioBlock, frames: Int, into destination: UnsafeMutableRawPointer) -> Int {
+        return SpecializedPipelineKernels.encode(StereoChannelLayout.self, Int24SampleFormat.self, block, frames: frames, into: destination)
+    }
+}
+
+// MARK: - GenericCapturePipeline
+/// 通用采集管线 - 声道数与格式在运行时判断
+///
+/// 用于特化组合之外的配置（例如多声道），也作为基准测试的对照组。
+final class GenericCapturePipeline: CapturePipeline {
+    
+    let configuration: CapturePipelineConfiguration
+    let isSpecialized = false
+    
+    init(configuration: CapturePipelineConfiguration) {
+        self.configuration = configuration
+    }
+    
+    func ingest(interleaved source: UnsafePointer<Float>, frames: Int, into block: AudioBlock) {
+        block.deinterleave(from: source, channels: configuration.channelCount, frames: frames)
+    }
+    
+    func encode(_ block: AudioBlock, frames: Int, into destination: UnsafeMutableRawPointer) -> Int {
+        let n = min(frames, block.frameCount)
+        let channels = configuration.channelCount
+        for i in 0..<n {
+            for c in 0..<channels {
+                let sample = block.channel(min(c, block.channelCount - 1))[i]
+                let index = i * channels + c
+                switch configuration.bitDepth {
+                case .float32:
+                    Float32SampleFormat.store(sample, to: destination, at: index)
+                case .int16:
+                    Int16SampleFormat.store(sample, to: destination, at: index)
+                case .int24:
+                    Int24SampleFormat.store(sample, to: destination, at: index)
+                }
+            }
+        }
+        return n * channels * configuration.bitDepth.bytesPerSample
+    }
+}
+
+// MARK: - CapturePipelineFactory
+/// 采集管线工厂 - 在开始录制时按配置选择特化实例
+@_spi(Benchmarks) public enum CapturePipelineFactory {
+    
+    /// 创建管线：{mono, stereo} × {f32, i16, i24} 使用特化实例，其余组合回退到通用管线
+    public static func make(_ configuration: CapturePipelineConfiguration) -> CapturePipeline {
+        let mode = configuration.mode
+        let pipeline: CapturePipeline
+        switch (configuration.channelCount, configuration.bitDepth) {
+        case (1, .float32): pipeline = MonoFloat32CapturePipeline(mode: mode)
+        case (1, .int16): pipeline = MonoInt16CapturePipeline(mode: mode)
+        case (1, .int24): pipeline = MonoInt24CapturePipeline(mode: mode)
+        case (2, .float32): pipeline = StereoFloat32CapturePipeline(mode: mode)
+        case (2, .int16): pipeline = StereoInt16CapturePipeline(mode: mode)
+        case (2, .int24): pipeline = StereoInt24CapturePipeline(mode: mode)
+        default: pipeline = GenericCapturePipeline(configuration: configuration)
+        }
+        Logger.shared.info("🧬 采集管线: \(configuration) - \(pipeline.isSpecialized ? "特化" : "通用")")
+        return pipeline
+    }
+    
+    /// 创建通用管线（基准测试对照组）
+    public static func makeGeneric(_ configuration: CapturePipelineConfiguration) -> CapturePipeline {
+        return GenericCapturePipeline(configuration: configuration)
+    }
+}
@@ -0,0 +1,133 @@
+import Foundation
+import CoreAudio
+
+// MARK: - PipelineSampleFormat
+/// 输出样本格式特征
+///
+/// 作为泛型参数传给 `SpecializedPipelineKernels`，每个具体管线类得到独立的内层循环，
+/// 运行时不再按样本判断格式。
+protocol PipelineSampleFormat {
+    static var name: String { get }
+    static var bitDepth: PipelineBitDepth { get }
+    static var bytesPerSample: Int { get }
+    
+    /// 把一个 Float32 样本编码写入 destination 的第 index 个样本位置
+    static func store(_ sample: Float, to destination: UnsafeMutableRawPointer, at index: Int)
+}
+
+/// 32 位浮点（直接写入）
+enum Float32SampleFormat: PipelineSampleFormat {
+    static let name = "f32"
+    static let bitDepth = PipelineBitDepth.float32
+    static let bytesPerSample = 4
+    
+    @inline(__always)
+    static func store(_ sample: Float, to destination: UnsafeMutableRawPointer, at index: Int) {
+        destination.assumingMemoryBound(to: Float.self)[index] = sample
+    }
+}
+
+/// 16 位整数（先限幅再量化）
+enum Int16SampleFormat: PipelineSampleFormat {
+    static let name = "i16"
+    static let bitDepth = PipelineBitDepth.int16
+    static let bytesPerSample = 2
+    
+    @inline(__always)
+    static func store(_ sample: Float, to destination: UnsafeMutableRawPointer, at index: Int) {
+        let clamped = min(max(sample, -1.0), 1.0)
+        destination.assumingMemoryBound(to: Int16.self)[index] = Int16(clamped * 32767.0)
+    }
+}
+
+/// 24 位整数（小端 3 字节紧凑排列）
+enum Int24SampleFormat: PipelineSampleFormat {
+    static let name = "i24"
+    static let bitDepth = PipelineBitDepth.int24
+    static let bytesPerSample = 3
+    
+    @inline(__always)
+    static func store(_ sample: Float, to destination: UnsafeMutableRawPointer, at index: Int) {
+        let clamped = min(max(sample, -1.0), 1.0)
+        let value = UInt32(bitPattern: Int32(clamped * 8388607.0))
+        let bytes = destination.assumingMemoryBound(to: UInt8.self) + index * 3
+        bytes[0] = UInt8(truncatingIfNeeded: value)
+        bytes[1] = UInt8(truncatingIfNeeded: value >> 8)
+        bytes[2] = UInt8(truncatingIfNeeded: value >> 16)
+    }
+}
+
+// MARK: - PipelineChannelLayout
+/// 声道布局特征（声道数在编译期固定）
+protocol PipelineChannelLayout {
+    static var name: String { get }
+    static var channelCount: Int { get }
+}
+
+enum MonoChannelLayout: PipelineChannelLayout {
+    static let name = "mono"
+    static let channelCount = 1
+}
+
+enum StereoChannelLayout: PipelineChannelLayout {
+    static let name = "stereo"
+    static let channelCount = 2
+}
+
+// MARK: - 运行时描述
+/// 采集模式（与 C API 的 AudioRecordMode 取值一致）
+@_spi(Benchmarks) public enum CaptureMode: Int32, CaseIterable {
+    case microphone = 0
+    case systemAudio = 1
+    case specificProcess = 2
+    case mixed = 3
+    
+    public var name: String {
+        switch self {
+        case .microphone: return "Microphone"
+        case .systemAudio: return "SystemAudio"
+        case .specificProcess: return "SpecificProcess"
+        case .mixed: return "Mixed"
+        }
+    }
+    
+    /// 是否包含 Process Tap 采集源
+    var usesProcessTap: Bool {
+        return self != .microphone
+    }
+    
+    /// 是否包含麦克风采集源
+    var usesMicrophone: Bool {
+        return self == .microphone || self == .mixed
+    }
+}
+
+/// 输出位深
+@_spi(Benchmarks) public enum PipelineBitDepth: CaseIterable {
+    case float32
+    case int16
+    case int24
+    
+    public var bitsPerChannel: UInt32 {
+        switch self {
+        case .float32: return 32
+        case .int16: return 16
+        case .int24: return 24
+        }
+    }
+    
+    public var bytesPerSample: Int {
+        return Int(bitsPerChannel / 8)
+    }
+    
+    /// 从文件格式推断位深，不支持的格式返回 nil
+    init?(format: AudioStreamBasicDescription) {
+        let isFloat = (format.mFormatFlags & kAudioFormatFlagIsFloat) != 0
+        switch (isFloat, format.mBitsPerChannel) {
+        case (true, 32): self = .float32
+        case (false, 16): self = .int16
+        case (false, 24): self = .int24
+        default: return nil
+        }
+    }
+}
@@ -0,0 +1,114 @@
+import Foundation
+
+// MARK: - PlanarRingBuffer
+/// 单生产者 / 单消费者无锁环形缓冲区（非交错 Float32）
+///
+/// 读写位置为单调递增的帧计数，用原子变量发布；
+/// 生产者只推进写位置，消费者只推进读位置，因此无需加锁。
+/// 写满时丢弃放不下的新数据（不会覆盖尚未读取的数据）。
+final class PlanarRingBuffer {
+    
+    // MARK: - Properties
+    let channelCount: Int
+    let capacityFrames: Int
+    
+    private let storage: UnsafeMutablePointer<Float>
+    private let writePosition = AtomicInt64()
+    private let readPosition = AtomicInt64()
+    
+    // MARK: - Initialization
+    
+    init(channels: Int, capacityFrames: Int) {
+        precondition(channels > 0 && capacityFrames > 0, "环形缓冲区容量必须大于0")
+        self.channelCount = channels
+        self.capacityFrames = capacityFrames
+        storage = EngineMemory.allocate(Float.self, capacity: channels * capacityFrames, tag: .rings)
+        storage.initialize(repeating: 0, count: channels * capacityFrames)
+    }
+    
+    deinit {
+        EngineMemory.deallocate(storage, capacity: channelCount * capacityFrames, tag: .rings)
+    }
+    
+    /// 缓冲区持有的字节数
+    var allocatedBytes: Int {
+        return channelCount * capacityFrames * MemoryLayout<Float>.stride
+    }
+    
+    // MARK: - Status
+    
+    /// 可读帧数
+    var availableFrames: Int {
+        return Int(writePosition.value - readPosition.value)
+    }
+    
+    /// 可写帧数
+    var freeFrames: Int {
+        return capacityFrames - availableFrames
+    }
+    
+    // MARK: - Producer
+    
+    /// 写入非交错数据（仅生产者线程调用）
+    ///
+    /// 源声道少于缓冲区声道时复制源的最后一个声道（单声道→立体声）。
+    /// - Returns: 实际写入的帧数
+    @discardableResult
+    func write(channels source: UnsafePointer<UnsafeMutablePointer<Float>>, sourceChannels: Int, frames: Int) -> Int {
+        guard sourceChannels > 0 else { return 0 }
+        let write = writePosition.value
+        let toWrite = min(frames, capacityFrames - Int(write - readPosition.value))
+        guard toWrite > 0 else { return 0 }
+        
+        let start = Int(write % Int64(capacityFrames))
+        let firstPart = min(toWrite, capacityFrames - start)
+        for c in 0..<channelCount {
+            let src = source[min(c, sourceChannels - 1)]
+            let dst = storage + c * capacityFrames
+            (dst + start).update(from: src, count: firstPart)
+            if toWrite > firstPart {
+                dst.update(from: src + firstPart, count: toWrite - firstPart)
+            }
+        }
+        writePosition.add(Int64(toWrite))
+        return toWrite
+    }
+    
+    // MARK: - Consumer
+    
+    /// 读取到音频块（仅消费者线程调用），不足部分补零
+    /// - Returns: 实际读取的帧数
+    @discardableResult
+    func read(into block: AudioBlock, frames: Int) -> Int {
+        let frames = min(frames, block.frameCapacity)
+        let read = readPosition.value
+        let toRead = min(frames, Int(writePosition.value - read))
+        
+        let start = Int(read % Int64(capacityFrames))
+        let firstPart = min(max(toRead, 0), capacityFrames - start)
+        for c in 0..<block.channelCount {
+            let src = storage + min(c, channelCount - 1) * capacityFrames
+            let dst = block.channel(c)
+            if toRead > 0 {
+                dst.update(from: src + start, count: firstPart)
+                if toRead > firstPart {
+                    (dst + firstPart).update(from: src, count: toRead - firstPart)
+                }
+            }
+            if frames > toRead {
+                (dst + max(toRead, 0)).update(repeating: 0, count: frames - max(toRead, 0))
+            }
+        }
+        if toRead > 0 {
+            readPosition.add(Int64(toRead))
+        }
+        block.frameCount = frames
+        return max(toRead, 0)
+    }
+    
+    /// 清空缓冲区（调用方需保证此时没有并发读写）
+    func reset() {
+        writePosition.store(0)
+        readPosition.store(0)
+    }
+}
@@ -28,8 +28,8 @@ class AggregateDeviceManager {
         let createAgg = unsafeBitCast(sym, to: CreateAggFn.self)
 
         // 获取系统默认输出设备 UID
-        guard let systemOutputID = readDefaultSystemOutputDeviceID(),
-              let outputUID = readDeviceUID(for: systemOutputID) else {
+        guard let systemOutputID = AggregateDeviceManager.readDefaultSystemOutputDeviceID(),
+              let outputUID = AggregateDeviceManager.readDeviceUID(for: systemOutputID) else {
             logger.error("AggregateDeviceManager: 无法获取系统默认输出设备 UID")
             return false
         }
@@ -242,7 +242,7 @@ class AggregateDeviceManager {
         return true
     }
     
-    private func readDefaultSystemOutputDeviceID() -> AudioDeviceID? {
+    static func readDefaultSystemOutputDeviceID() -> AudioDeviceID? {
         var address = AudioObjectPropertyAddress(
             mSelector: kAudioHardwarePropertyDefaultOutputDevice,
             mScope: kAudioObjectPropertyScopeGlobal,
@@ -254,7 +254,7 @@ class AggregateDeviceManager {
         return status == noErr ? deviceID : nil
     }
     
-    private func readDeviceUID(for deviceID: AudioDeviceID) -> String? {
+    static func readDeviceUID(for deviceID: AudioDeviceID) -> String? {
         var address = AudioObjectPropertyAddress(
             mSelector: kAudioDevicePropertyDeviceUID,
             mScope: kAudioObjectPropertyScopeGlobal,
@@ -22,62 +22,78 @@ func globalAudioCallback(
     
     let handler = Unmanaged<AudioCallbackHandler>.fromOpaque(clientData).takeUnretainedValue()
     
+    // Debug 构建下检查 IO 线程上的分配、加锁、文件 IO 与日志
+    RealtimeSafety.enterRealtime()
+    defer { RealtimeSafety.exitRealtime() }
+    
+    let traceSpan = EngineTrace.span(AudioCallbackHandler.callbackTraceName)
+    defer { traceSpan.end() }
+    
+    // 逐块阶段计时：采集延迟从设备时间戳算起
+    let timer = handler.stageTimer
+    let captureHostTime = inInputTime.pointee.mFlags.contains(.hostTimeValid) ? inInputTime.pointee.mHostTime : 0
+    timer.beginBlock(captureHostTime: captureHostTime)
+    
     // 处理音频数据
     let bufferList = inInputData.pointee
     let buffer = bufferList.mBuffers
     
-    // 添加详细的调试信息（减少频率避免日志过多）
-    // 使用全局变量来跟踪调用次数
-    struct CallCounter {
-        static var count = 0
-        static var lastNonZeroDataSize = UInt32(0)
-        static var nonZeroCount = 0
+    // 回调统计与限频日志（每个处理器独立计数，只在 IO 线程更新）
+    let callCount = handler.logSites.callback.callCount + 1
+    if buffer.mDataByteSize > 0 {
+        handler.lastNonZeroDataSize = buffer.mDataByteSize
+        handler.nonZeroCallbackCount += 1
     }
-    CallCounter.count += 1
     
-    // 前几次回调都记录详细信息
-    if CallCounter.count <= 5 {
-        handler.logger.info("🎧 音频回调[\(CallCounter.count)]: device=\(inDevice), dataSize=\(buffer.mDataByteSize), channels=\(bufferList.mNumberBuffers)")
+    // 前几次回调记录详细信息，之后每100次记录一次统计
+    if handler.logSites.callback.shouldLog() {
+        handler.logger.record(handler.logSites.callback, .info, "🎧 音频回调[{}]: device={}, dataSize={}, channels={}",
+                              .int(callCount), .uint(inDevice), .uint(buffer.mDataByteSize), .uint(bufferList.mNumberBuffers))
     }
-    
-    // 每100次回调记录一次统计信息
-    if CallCounter.count % 100 == 1 && CallCounter.count > 5 {
-        handler.logger.info("🎧 音频回调统计: 总调用次数=\(CallCounter.count), 非零数据次数=\(CallCounter.nonZeroCount)")
+    if handler.logSites.statistics.shouldLog() {
+        handler.logger.record(handler.logSites.statistics, .debug, "📊 音频回调统计: 总调用次数={}, 非零数据次数={}, 最后非零大小={}",
+                              .int(callCount), .int(handler.nonZeroCallbackCount), .uint(handler.lastNonZeroDataSize))
     }
     
-    // 记录非零数据大小的情况
-    if buffer.mDataByteSize > 0 {
-        CallCounter.lastNonZeroDataSize = buffer.mDataByteSize
-        CallCounter.nonZeroCount += 1
+    // 一直收不到数据时周期性警告
+    if handler.nonZeroCallbackCount == 0 && handler.logSites.noData.shouldLog() {
+        handler.logger.record(handler.logSites.noData, .warning, "⚠️ 警告: 已调用{}次音频回调，但从未收到有效数据！ 请检查Process Tap配置或目标应用是否在播放音频", .int(callCount))
     }
     
-    if CallCounter.count % 100 == 1 { // 每100次回调记录一次
-        handler.logger.debug("🎧 音频回调[\(CallCounter.count)]: device=\(inDevice), dataSize=\(buffer.mDataByteSize), channels=\(bufferList.mNumberBuffers)")
-        handler.logger.debug("📊 统计信息: 非零数据次数=\(CallCounter.nonZeroCount), 最后非零大小=\(CallCounter.lastNonZeroDataSize)")
-    }
+    // 根据 Tap 流格式计算帧数（多声道 Tap 不能按立体声推算）
+    let frameCount = handler.frameCount(of: bufferList)
     
-    // 如果连续1000次都是0数据，发出警告
-    if CallCounter.count % 1000 == 0 && CallCounter.nonZeroCount == 0 {
-        handler.logger.warning("⚠️ 警告: 已调用\(CallCounter.count)次音频回调，但从未收到有效数据！")
-        handler.logger.warning("💡 建议: 检查Process Tap配置或QQ音乐是否真的在播放音频")
+    // 采集时间线连续性检测
+    let inputTime = inInputTime.pointee
+    let sampleTime = inputTime.mFlags.contains(.sampleTimeValid) ? inputTime.mSampleTime : nil
+    if let gap = handler.timeline.advance(sampleTime: sampleTime, hostTime: captureHostTime, frames: Int(frameCount), sampleRate: handler.sampleRate) {
+        handler.xruns.report(.discontinuity, origin: "io", frames: gap)
     }
     
-    // 计算实际的帧数：使用正确的帧数计算
-    // 对于32位浮点格式，每帧4字节，但需要考虑声道数
-    let bytesPerSample = 4 // 32位浮点 = 4字节
-    // 注意：bufferList.mNumberBuffers 是缓冲区数量，不是声道数
-    // 对于交错格式，通常只有一个缓冲区包含所有声道数据
-    let totalSamples = Int(buffer.mDataByteSize) / bytesPerSample
-    // 从Process Tap获取的格式信息中获取声道数
-    // 这里需要从实际的音频格式中获取，暂时使用默认值2
-    let channels = 2 // TODO: 从实际的音频格式中获取声道数
-    let frameCount = UInt32(totalSamples / channels)
+    // 回调采集开启时记录原始输入块（关闭时只读一次原子标志）
+    handler.captureSource?.capture(bufferList: inInputData, frames: Int(frameCount), hostTime: captureHostTime, sampleTime: inputTime.mSampleTime)
+    
+    // 已挂载处理图时，由图完成电平与写入
+    if let graph = handler.processingGraph, let source = handler.graphSource {
+        let ingestMark = StageMark.now()
+        source.load(bufferList: inInputData, frames: Int(frameCount))
+        timer.add(.ingest, since: ingestMark)
+        graph.render(frameCount: Int(frameCount), hostTime: inInputTime.pointee.mHostTime)
+        handler.checkDeadline(elapsedNanoseconds: timer.endBlock(frames: Int(frameCount)), frames: Int(frameCount))
+        return noErr
+    }
     
     // 计算电平
-    handler.calculateAndReportLevel(from: bufferList, frameCount: frameCount)
+    let analysisMark = StageMark.now()
+    handler.calculateAndReportLevel(from: inInputData, frameCount: frameCount)
+    timer.add(.analysis, since: analysisMark)
     
     // 写入音频数据
-    handler.writeAudioData(from: bufferList, frameCount: frameCount)
+    let writeMark = StageMark.now()
+    handler.writeAudioData(from: inInputData, frameCount: frameCount)
+    timer.add(.write, since: writeMark)
+    timer.completeWrite(captureHostTime: captureHostTime)
+    handler.checkDeadline(elapsedNanoseconds: timer.endBlock(frames: Int(frameCount)), frames: Int(frameCount))
     
     return noErr
 }
@@ -91,11 +107,43 @@ class AudioCallbackHandler {
     let logger = Logger.shared
     private var audioFile: AVAudioFile?
     private var audioToolboxFileManager: AudioToolboxFileManager?
-    private var onLevel: ((Float) -> Void)?
+    private var levelPublisher: LevelPublisher?
     
     // 自定义回调（用于混音录制）
     private var customCallback: ((UnsafePointer<AudioBufferList>, UInt32) -> Void)?
     
+    // IO 输入流格式（由 Tap 流格式确定）
+    private(set) var inputFormat: AudioStreamBasicDescription?
+    private(set) var inputLayout: ChannelLayout?
+    
+    // 处理图（设置后 IO 回调直接驱动图渲染）
+    private(set) var processingGraph: AudioGraph?
+    private(set) var graphSource: PushSourceNode?
+    // 处理图中本路输入的混音增益（只用于回调采集的源声明）
+    private var graphMixGain: Float = 1.0
+    
+    // 回调采集源（创建回调时登记，移除处理图时注销）
+    private(set) var captureSource: CallbackCaptureSource?
+    
+    // 输入 AudioBufferList 的声道视图（交错与非交错共用，IO 线程复用）
+    private let inputView = AudioBufferListView()
+    
+    // 逐块阶段计时（汇总到 PipelineStats.shared）
+    let stageTimer = PipelineStageTimer()
+    
+    // 采集时间线（IO 线程独占）
+    var timeline = CaptureTimeline()
+    
+    // 断流 / 溢出报告目标（设置处理图或文件管理器时取其会话监测，需在启动 IO 回调之前）
+    private(set) var xruns: XrunMonitor = .shared
+    
+    // 回调日志限频与统计（IO 线程独占）
+    let logSites = CallbackLogSites()
+    var nonZeroCallbackCount: Int64 = 0
+    var lastNonZeroDataSize: UInt32 = 0
+    
+    static let callbackTraceName = TraceName("io.callback", category: "io")
+    
     // MARK: - Initialization
     
     init() {}
@@ -110,12 +158,14 @@ class AudioCallbackHandler {
     /// 设置 AudioToolbox 文件管理器
     func setAudioToolboxFileManager(_ manager: AudioToolboxFileManager) {
         self.audioToolboxFileManager = manager
+        self.xruns = manager.xruns
         logger.info("🎵 AudioCallbackHandler: 设置 AudioToolbox 文件管理器")
     }
     
-    /// 设置电平回调
+    /// 设置电平回调（在主线程调用；IO 线程只发布原子值）
     func setLevelCallback(_ callback: @escaping (Float) -> Void) {
-        self.onLevel = callback
+        levelPublisher?.cancel()
+        levelPublisher = LevelPublisher(handler: callback)
     }
     
     /// 设置自定义回调（用于混音录制）
@@ -124,9 +174,93 @@ class AudioCallbackHandler {
         logger.info("🎵 AudioCallbackHandler: 设置自定义回调（混音模式）")
     }
     
+    /// 设置 IO 输入流格式与声道布局（必须在启动 IO 回调之前调用）
+    ///
+    /// 已挂载处理图时，同时让源节点按该布局做上/下混。
+    func setInputFormat(_ format: AudioStreamBasicDescription, layout: ChannelLayout) {
+        self.inputFormat = format
+        self.inputLayout = layout
+        graphSource?.configureInput(layout: layout)
+        logger.info("🎵 AudioCallbackHandler: 输入格式 \(format.mChannelsPerFrame)声道 (\(layout)), 每帧 \(format.mBytesPerFrame) 字节")
+    }
+    
+    /// IO 采样率（未设置输入格式时按 48kHz）
+    var sampleRate: Double {
+        return inputFormat?.mSampleRate ?? 48000
+    }
+    
+    /// 回调耗时超过块时长时报告溢出（IO 线程调用）
+    func checkDeadline(elapsedNanoseconds: UInt64, frames: Int) {
+        guard frames > 0 else { return }
+        let budget = Double(frames) / sampleRate * 1e9
+        let elapsed = Double(elapsedNanoseconds)
+        if elapsed > budget {
+            xruns.report(.callbackOverrun, origin: "io", frames: Int64(((elapsed - budget) / 1e9 * sampleRate).rounded(.up)))
+        }
+    }
+    
+    /// 由缓冲区字节数推算帧数
+    ///
+    /// 优先使用流格式的每帧字节数（非交错格式下即单声道样本字节数）；
+    /// 未设置格式时按缓冲区自身的声道数和 Float32 推算。
+    @inline(__always)
+    func frameCount(of bufferList: AudioBufferList) -> UInt32 {
+        let buffer = bufferList.mBuffers
+        if let format = inputFormat, format.mBytesPerFrame > 0 {
+            return buffer.mDataByteSize / format.mBytesPerFrame
+        }
+        let channels = max(buffer.mNumberChannels, 1)
+        return buffer.mDataByteSize / (UInt32(MemoryLayout<Float>.size) * channels)
+    }
+    
+    /// 设置处理图（必须在启动 IO 回调之前调用）
+    /// - Parameters:
+    ///   - graph: 已编译的处理图
+    ///   - source: 图中接收 IO 数据的源节点
+    ///   - mixGain: 源节点在混音中的增益（回调回放时重建相同的混音）
+    func setProcessingGraph(_ graph: AudioGraph, source: PushSourceNode, mixGain: Float = 1.0) {
+        self.processingGraph = graph
+        self.graphSource = source
+        self.graphMixGain = mixGain
+        self.xruns = graph.xruns
+        graph.stageTimer = stageTimer
+        if let layout = inputLayout {
+            source.configureInput(layout: layout)
+        }
+        logger.info("🎵 AudioCallbackHandler: 设置处理图 \(graph.name)")
+    }
+    
+    /// 移除处理图（必须在停止 IO 回调之后调用）
+    func clearProcessingGraph() {
+        if let captureSource = captureSource {
+            CallbackCapture.shared.unregister(captureSource)
+            self.captureSource = nil
+        }
+        processingGraph?.shutdown()
+        processingGraph = nil
+        graphSource = nil
+        timeline.reset()
+        logger.logSuppressionSummary(logSites.all)
+        logSites.reset()
+        nonZeroCallbackCount = 0
+        lastNonZeroDataSize = 0
+        PipelineStats.shared.logSummary()
+        RealtimeSafety.logSummary()
+    }
+    
     /// 创建音频回调函数
     func createAudioCallback() -> (AudioDeviceIOProc, UnsafeMutableRawPointer) {
         logger.info("🎧 AudioCallbackHandler: 创建音频回调函数...")
+        RealtimeSafety.prepare()
+        // 追踪名在这里登记，避免首次回调时在 IO 线程上加锁
+        _ = AudioCallbackHandler.callbackTraceName
+        // 挂载了处理图时登记回调采集源，回放时按声明重建处理图
+        if let graph = processingGraph, let source = graphSource, captureSource == nil {
+            captureSource = CallbackCapture.shared.register(
+                name: source.name, role: .driver, graphName: graph.name, sampleRate: graph.sampleRate,
+                channels: source.output.channelCapacity, inputChannels: Int(inputFormat?.mChannelsPerFrame ?? 0), gain: graphMixGain
+            )
+        }
         // 创建 self 的不安全指针，用于传递给 C 回调函数
         let selfPointer = Unmanaged.passUnretained(self).toOpaque()
         logger.info("✅ 音频回调函数创建成功，客户端数据指针: \(selfPointer)")
@@ -144,44 +278,45 @@ class AudioCallbackHandler {
         
         pcm.frameLength = AVAudioFrameCount(frames)
         
-        let abl = bufferList.pointee
-        let channels = Int(asbd.mChannelsPerFrame)
-        let _ = Int(asbd.mBytesPerFrame) // 暂时未使用，但保留以备将来使用
-        
-        guard let src = abl.mBuffers.mData else { return nil }
+        // 交错与非交错输入都按声道视图的起始指针与步长读取
+        guard inputView.bind(bufferList) else { return nil }
+        let channels = min(Int(asbd.mChannelsPerFrame), inputView.channelCount, Int(format.channelCount))
         
         if let dst = pcm.floatChannelData {
-            let totalFrames = Int(frames)
+            let totalFrames = min(Int(frames), inputView.frameCount)
             for c in 0..<channels {
-                var s = src.assumingMemoryBound(to: Float.self).advanced(by: c)
+                var s = inputView.channel(c)
+                let stride = inputView.stride(c)
                 let d = dst[c]
                 for i in 0..<totalFrames {
                     d[i] = s.pointee
-                    s = s.advanced(by: channels)
+                    s = s.advanced(by: stride)
                 }
             }
         } else if let dst = pcm.int16ChannelData {
             // 将32位浮点数据转换为16位整数数据
-            let totalFrames = Int(frames)
+            let totalFrames = min(Int(frames), inputView.frameCount)
             for c in 0..<channels {
-                var s = src.assumingMemoryBound(to: Float.self).advanced(by: c)
+                var s = inputView.channel(c)
+                let stride = inputView.stride(c)
                 let d = dst[c]
                 for i in 0..<totalFrames {
                     // 将浮点数转换为16位整数：-1.0 到 1.0 映射到 -32768 到 32767
                     let floatValue = s.pointee
                     let int16Value = Int16(max(-1.0, min(1.0, floatValue)) * 32767.0)
                     d[i] = int16Value
-                    s = s.advanced(by: channels)
+                    s = s.advanced(by: stride)
                 }
             }
         } else if let dst = pcm.int32ChannelData {
-            let totalFrames = Int(frames)
+            let totalFrames = min(Int(frames), inputView.frameCount)
             for c in 0..<channels {
-                var s = src.assumingMemoryBound(to: Int32.self).advanced(by: c)
+                var s = UnsafeRawPointer(inputView.channel(c)).assumingMemoryBound(to: Int32.self)
+                let stride = inputView.stride(c)
                 let d = dst[c]
                 for i in 0..<totalFrames {
                     d[i] = s.pointee
-                    s = s.advanced(by: channels)
+                    s = s.advanced(by: stride)
                 }
             }
         }
@@ -191,32 +326,30 @@ class AudioCallbackHandler {
     
     // MARK: - Private Methods
     
-    func calculateAndReportLevel(from bufferList: AudioBufferList, frameCount: UInt32) {
-        guard let onLevel = onLevel else { 
+    func calculateAndReportLevel(from bufferList: UnsafePointer<AudioBufferList>, frameCount: UInt32) {
+        guard let levelPublisher = levelPublisher else { 
             // 如果没有设置电平回调，记录警告
             // logger.debug("⚠️ AudioCallbackHandler: 电平回调未设置")
             return 
         }
         
-        // 使用统一的工具类计算电平
-        let (_, _, normalizedLevel) = AudioUtils.calculateAudioLevel(from: bufferList, frameCount: frameCount)
+        // 使用统一的工具类计算电平（所有缓冲区的所有声道）
+        guard inputView.bind(bufferList) else { return }
+        let (_, _, normalizedLevel) = AudioUtils.calculateAudioLevel(from: inputView, frameCount: frameCount)
         
         // 只在电平有意义时输出日志（减少冗余）
         // logger.debug("AudioCallbackHandler: 电平 \(normalizedLevel)")
         
-        DispatchQueue.main.async {
-            onLevel(normalizedLevel)
-        }
+        levelPublisher.publish(normalizedLevel)
     }
-    
-     func writeAudioData(from bufferList: AudioBufferList, frameCount: UInt32) {
+     
+     func writeAudioData(from bufferList: UnsafePointer<AudioBufferList>, frameCount: UInt32) {
         guard frameCount > 0 else { return }
         
         // 如果设置了自定义回调（混音模式），则调用自定义回调
+        // 直接传递原始指针，非交错格式的后续缓冲区才不会丢失
         if let customCallback = customCallback {
-            withUnsafePointer(to: bufferList) { bufferListPointer in
-                customCallback(bufferListPointer, frameCount)
-            }
+            customCallback(bufferList, frameCount)
             return
         }
         
@@ -227,7 +360,10 @@ class AudioCallbackHandler {
                 // 成功写入，不再输出每次的日志（减少冗余）
                 return
             } catch {
-                logger.error("AudioCallbackHandler: AudioToolbox 写入失败: \(error.localizedDescription)")
+                logger.record(.error, "AudioCallbackHandler: AudioToolbox 写入失败: {}", .int((error as NSError).code))
+                if audioFile == nil {
+                    xruns.report(.writeFailure, origin: "writer", frames: Int64(frameCount))
+                }
                 // 如果 AudioToolbox 失败，回退到 AVAudioFile
             }
         }
@@ -246,42 +382,21 @@ class AudioCallbackHandler {
         // 调试：检查格式匹配
         logger.debug("AudioCallbackHandler: PCM缓冲区格式 - 声道数: \(audioFile.processingFormat.channelCount), 采样率: \(audioFile.processingFormat.sampleRate), 交错: \(audioFile.processingFormat.isInterleaved)")
         
-        // 处理交错和非交错格式
-        if bufferList.mNumberBuffers == 1 {
-            // 交错格式：所有声道数据在一个buffer中
-            let buffer = bufferList.mBuffers
-            logger.debug("AudioCallbackHandler: 检查buffer数据 - mData: \(buffer.mData != nil), mDataByteSize: \(buffer.mDataByteSize)")
-            guard buffer.mData != nil && buffer.mDataByteSize > 0 else { 
-                logger.warning("AudioCallbackHandler: buffer数据无效，跳过写入")
-                return 
-            }
-            
-            // 计算输入数据的实际声道数
-            let totalSamples = Int(buffer.mDataByteSize) / MemoryLayout<Float>.size
-            let inputChannels = totalSamples / Int(frameCount)
-            let outputChannels = Int(audioFile.processingFormat.channelCount)
-            
-            logger.debug("AudioCallbackHandler: 数据解析 - 总样本: \(totalSamples), 帧数: \(frameCount), 输入声道: \(inputChannels), 输出声道: \(outputChannels)")
-            
-            // 使用统一的工具类复制数据到PCM缓冲区
-            let success = AudioUtils.copyAudioDataToPCMBuffer(
-                from: bufferList,
-                to: pcmBuffer,
-                frameCount: frameCount,
-                inputChannels: inputChannels,
-                outputChannels: outputChannels
-            )
-            
-            if !success {
-                logger.warning("AudioCallbackHandler: 数据复制失败，跳过写入")
-                return
-            }
-        } else {
-            // 非交错格式：每个声道有独立的buffer
-            logger.debug("AudioCallbackHandler: 处理非交错格式，buffer数量: \(bufferList.mNumberBuffers)")
-            
-            // 暂时跳过非交错格式的处理，记录警告
-            logger.warning("AudioCallbackHandler: 非交错格式暂不支持，跳过数据写入")
+        // 交错格式：所有声道数据在一个buffer中；非交错格式：每个声道有独立的buffer
+        let bufferCount = bufferList.pointee.mNumberBuffers
+        let outputChannels = Int(audioFile.processingFormat.channelCount)
+        logger.debug("AudioCallbackHandler: 数据解析 - buffer数量: \(bufferCount), 帧数: \(frameCount), 输出声道: \(outputChannels)")
+        
+        // 使用统一的工具类复制数据到PCM缓冲区（按声道步长读取，两种格式都支持）
+        let success = AudioUtils.copyAudioDataToPCMBuffer(
+            from: bufferList,
+            to: pcmBuffer,
+            frameCount: frameCount,
+            outputChannels: outputChannels
+        )
+        
+        if !success {
+            logger.warning("AudioCallbackHandler: 数据复制失败，跳过写入")
             return
         }
         
@@ -301,4 +416,23 @@ class AudioCallbackHandler {
             logger.error("AudioCallbackHandler: AVAudioFile 写入失败: \(error.localizedDescription)")
         }
     }
-}
\ No newline at end of file
+}
+
+// MARK: - CallbackLogSites
+/// IO 回调中的限频日志点
+struct CallbackLogSites {
+    /// 前 5 次回调的详细信息
+    let callback = LogSite("io.callback", first: 5)
+    /// 每 100 次回调的统计
+    let statistics = LogSite("io.callback.stats", every: 100)
+    /// 一直没有有效数据的警告（每 1000 次空回调一次）
+    let noData = LogSite("io.callback.no-data", every: 1000)
+    
+    var all: [LogSite] {
+        return [callback, statistics, noData]
+    }
+    
+    func reset() {
+        all.forEach { $0.reset() }
+    }
+}
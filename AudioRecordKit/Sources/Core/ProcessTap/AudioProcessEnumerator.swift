@@ -14,83 +14,69 @@ class AudioProcessEnumerator {
     
     // MARK: - Public Methods
     
-    /// 获取所有可用的音频进程列表
+    /// 获取所有可用的音频进程列表（读取注册表缓存）
     func getAvailableAudioProcesses() -> [AudioProcessInfo] {
-        logger.info("🔍 AudioProcessEnumerator: 开始枚举可用音频进程...")
-        var results: [AudioProcessInfo] = []
-
+        return AudioProcessRegistry.shared.processes()
+    }
+    
+    /// 根据 PID 查找进程对象 ID（O(1)，包括被过滤的系统进程）
+    func findProcessObjectID(by pid: pid_t) -> AudioObjectID? {
+        return AudioProcessRegistry.shared.processObjectID(pid: pid)
+    }
+    
+    // MARK: - Resolving (AudioProcessRegistry)
+    
+    /// 读取 HAL 当前的进程对象列表
+    func readProcessObjectList() -> [AudioObjectID]? {
         var address = AudioObjectPropertyAddress(
             mSelector: kAudioHardwarePropertyProcessObjectList,
             mScope: kAudioObjectPropertyScopeGlobal,
             mElement: kAudioObjectPropertyElementMain
         )
-
+        
         // 读取列表大小
         var dataSize: UInt32 = 0
         var status = AudioObjectGetPropertyDataSize(AudioObjectID(kAudioObjectSystemObject), &address, 0, nil, &dataSize)
-        guard status == noErr, dataSize > 0 else {
+        guard status == noErr else {
             logger.error("❌ AudioProcessEnumerator: 读取进程对象列表大小失败: OSStatus=\(status)")
-            return []
+            return nil
         }
-
-        let count = Int(dataSize) / MemoryLayout<AudioObjectID>.size
-        logger.info("📊 发现 \(count) 个音频进程对象")
-
+        guard dataSize > 0 else { return [] }
+        
         // 读取进程对象ID数组
+        let count = Int(dataSize) / MemoryLayout<AudioObjectID>.size
         var objectIDs = [AudioObjectID](repeating: AudioObjectID(kAudioObjectUnknown), count: count)
         status = AudioObjectGetPropertyData(AudioObjectID(kAudioObjectSystemObject), &address, 0, nil, &dataSize, &objectIDs)
         guard status == noErr else {
             logger.error("❌ AudioProcessEnumerator: 读取进程对象列表失败: OSStatus=\(status)")
-            return []
-        }
-
-        logger.info("🔍 开始解析每个进程对象...")
-        for (index, oid) in objectIDs.enumerated() where oid != kAudioObjectUnknown {
-            guard let pid = readPID(for: oid) else { 
-                logger.debug("⚠️ 进程对象[\(index)] ID=\(oid): 无法读取PID，跳过")
-                continue 
-            }
-            
-            let (name, path) = readNameAndPath(for: pid)
-            
-            // 跳过被过滤的进程
-            if name.isEmpty {
-                logger.debug("⚠️ 进程对象[\(index)] PID=\(pid): 被过滤，跳过")
-                continue
-            }
-            
-            let bundleID = readBundleID(for: oid) ?? ""
-
-            // 进一步过滤：排除 Helper/Renderer/GPU 等辅助进程（如 Google Chrome Helper）
-            if isHelperApp(name: name, bundleID: bundleID, path: path) {
-                logger.debug("🧹 过滤 Helper 进程: name=\(name), bundle=\(bundleID), path=\(path)")
-                continue
-            }
-            let info = AudioProcessInfo(
-                pid: pid,
-                name: name,
-                bundleID: bundleID,
-                path: path,
-                processObjectID: oid
-            )
-            results.append(info)
-            logger.debug("✅ 进程对象[\(index)]: \(name) (PID: \(pid), Bundle: \(bundleID))")
+            return nil
         }
-
-        logger.info("🎉 AudioProcessEnumerator: 枚举完成，返回 \(results.count) 个可用音频进程")
+        return objectIDs.filter { $0 != kAudioObjectUnknown }
+    }
+    
+    /// 解析单个进程对象；被过滤（系统进程、Helper、非 Dock 应用）时返回 nil
+    func resolveRecordableProcess(objectID oid: AudioObjectID, pid: pid_t) -> AudioProcessInfo? {
+        let (name, path) = readNameAndPath(for: pid)
         
-        // 输出所有进程的详细信息
-        for (index, process) in results.enumerated() {
-            logger.info("   [\(index)] \(process.name) (PID: \(process.pid), Bundle: \(process.bundleID), 对象ID: \(process.processObjectID))")
+        // 跳过被过滤的进程
+        if name.isEmpty {
+            return nil
         }
         
-        return results
-    }
-    
-    /// 根据 PID 查找进程对象 ID
-    func findProcessObjectID(by pid: pid_t) -> AudioObjectID? {
-        let processes = getAvailableAudioProcesses()
-        return processes.first { $0.pid == pid }?.processObjectID
+        let bundleID = readBundleID(for: oid) ?? ""
+        
+        // 进一步过滤：排除 Helper/Renderer/GPU 等辅助进程（如 Google Chrome Helper）
+        if isHelperApp(name: name, bundleID: bundleID, path: path) {
+            logger.debug("🧹 过滤 Helper 进程: name=\(name), bundle=\(bundleID), path=\(path)")
+            return nil
+        }
+        return AudioProcessInfo(
+            pid: pid,
+            name: name,
+            bundleID: bundleID,
+            path: path,
+            processObjectID: oid
+        )
     }
     
     /// 解析系统混音 PID（coreaudiod 进程）
@@ -138,7 +124,7 @@ class AudioProcessEnumerator {
     
     // MARK: - Private Methods
     
-    private func readPID(for objectID: AudioObjectID) -> pid_t? {
+    func readPID(for objectID: AudioObjectID) -> pid_t? {
         var addr = AudioObjectPropertyAddress(
             mSelector: kAudioProcessPropertyPID,
             mScope: kAudioObjectPropertyScopeGlobal,
@@ -149,7 +135,7 @@ class AudioProcessEnumerator {
         let s = AudioObjectGetPropertyData(objectID, &addr, 0, nil, &size, &pid)
         return s == noErr && pid > 0 ? pid : nil
     }
-
+    
     private func readBundleID(for objectID: AudioObjectID) -> String? {
         var addr = AudioObjectPropertyAddress(
             mSelector: kAudioProcessPropertyBundleID,
@@ -164,7 +150,7 @@ class AudioProcessEnumerator {
         if s == noErr, let bid = cfstr as String?, !bid.isEmpty { return bid }
         return nil
     }
-
+    
     private func readNameAndPath(for pid: pid_t) -> (String, String) {
         let nameBuffer = UnsafeMutablePointer<Int8>.allocate(capacity: Int(MAXPATHLEN))
         let pathBuffer = UnsafeMutablePointer<Int8>.allocate(capacity: Int(MAXPATHLEN))
@@ -251,13 +237,13 @@ class AudioProcessEnumerator {
         
         return false
     }
-
+    
     /// 判断是否为浏览器/应用的 Helper、Renderer、GPU 等辅助进程
     private func isHelperApp(name: String, bundleID: String, path: String) -> Bool {
         let n = name.lowercased()
         let b = bundleID.lowercased()
         let p = path.lowercased()
-
+        
         // 保留 Chrome 主进程和音频服务进程，但过滤其他 Helper 进程
         if n == "google chrome" || b == "com.google.chrome" {
             logger.debug("✅ 保留 Chrome 主进程: name=\(name), bundle=\(bundleID)")
@@ -280,7 +266,7 @@ class AudioProcessEnumerator {
             logger.debug("✅ 保留 Firefox 主进程: name=\(name), bundle=\(bundleID)")
             return false
         }
-
+        
         // 常见关键字过滤（但排除主进程、Chrome 音频服务进程）
         let keywords = [" helper", "renderer", "gpu", "webhelper", "plugin", "(renderer)"]
         if keywords.contains(where: { n.contains($0) }) { 
@@ -297,7 +283,7 @@ class AudioProcessEnumerator {
             logger.debug("🚫 过滤 Helper/Plugin 进程: bundle=\(bundleID)")
             return true 
         }
-
+        
         // 路径特征：在 Helpers 目录下或以 Helper.app 结尾（但排除 Chrome 音频服务进程）
         if p.contains("/helpers/") || p.hasSuffix("helper.app") { 
             // 特殊处理：如果是 Chrome 音频服务进程，不过滤
@@ -308,7 +294,7 @@ class AudioProcessEnumerator {
             logger.debug("🚫 过滤 Helper 路径: path=\(path)")
             return true 
         }
-
+        
         // 具体特例：Google Chrome Helper 系列（但排除音频服务进程）
         if n.contains("google chrome helper") || b.contains("com.google.chrome.helper") { 
             // 如果已经是音频服务进程，不应该到这里，但为了安全起见再检查一次
@@ -318,7 +304,7 @@ class AudioProcessEnumerator {
             }
             return true 
         }
-
+        
         // WebKit/GPU 相关（已基本被系统路径过滤，但再兜底一次）
         if n.contains("webkit") && (n.contains("gpu") || n.contains("network") || n.contains("webcontent")) {
             return true
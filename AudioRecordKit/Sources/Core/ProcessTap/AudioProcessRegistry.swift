@@ -0,0 +1,300 @@
+import Foundation
+import Darwin
+import CoreAudio
+
+// MARK: - AudioProcessChange
+/// 进程列表的一次增量变化
+struct AudioProcessChange {
+    /// 新出现的可录制进程
+    let added: [AudioProcessInfo]
+    /// 已退出（或不再有音频对象）的可录制进程
+    let removed: [AudioProcessInfo]
+    /// 变化后的列表版本号
+    let generation: UInt64
+}
+
+// MARK: - AudioProcessDelta
+/// 某个版本号之后的累计变化
+struct AudioProcessDelta {
+    /// 新增的进程（调用方应先移除 removedPIDs，再加入这些进程）
+    let added: [AudioProcessInfo]
+    /// 已移除的 PID（可能包含调用方从未见过的进程）
+    let removedPIDs: [pid_t]
+    /// 当前列表版本号
+    let generation: UInt64
+    /// 请求的版本号已超出变化记录范围，added 为完整列表，调用方应整体替换
+    let isFullList: Bool
+}
+
+// MARK: - AudioProcessRegistry
+/// 音频进程注册表 - 缓存 HAL 的进程对象列表，随属性变化增量更新
+///
+/// 第一次访问时完整解析一次，并在系统对象上监听 `kAudioHardwarePropertyProcessObjectList`；
+/// 之后只解析新出现的进程对象（PID、名称、Bundle、过滤规则），退出的对象直接移除。
+/// 查询都在内部锁下读取缓存：按 PID 查找为 O(1)，不再触发 HAL 调用与逐进程日志。
+final class AudioProcessRegistry {
+    
+    static let shared = AudioProcessRegistry()
+    
+    // MARK: - Entry
+    private struct Entry {
+        let pid: pid_t
+        /// 可录制进程的信息（被过滤的进程为 nil，仍保留 PID → 对象映射）
+        let info: AudioProcessInfo?
+    }
+    
+    // MARK: - Properties
+    private let resolver = AudioProcessEnumerator()
+    private let logger = Logger.shared
+    private let queue = DispatchQueue(label: "com.audiorecordkit.process-registry", qos: .utility)
+    private let lock = NSLock()
+    
+    /// 以下状态由 lock 保护
+    private var entries: [AudioObjectID: Entry] = [:]
+    /// HAL 列表顺序（对外返回的列表保持该顺序）
+    private var order: [AudioObjectID] = []
+    private var objectByPID: [pid_t: AudioObjectID] = [:]
+    private var recordableCount = 0
+    private var generationValue: UInt64 = 0
+    /// 最近的变化记录（用于按版本号增量查询）
+    private var changeLog: [AudioProcessChange] = []
+    private static let changeLogCapacity = 64
+    
+    /// 以下状态只在 queue 上访问
+    private var listener: AudioObjectPropertyListenerBlock?
+    private var observers: [Int: (AudioProcessChange) -> Void] = [:]
+    private var nextObserverID = 1
+    
+    private static var listAddress = AudioObjectPropertyAddress(
+        mSelector: kAudioHardwarePropertyProcessObjectList,
+        mScope: kAudioObjectPropertyScopeGlobal,
+        mElement: kAudioObjectPropertyElementMain
+    )
+    
+    // MARK: - Initialization
+    
+    /// - Parameter listening: 为 false 时不读取 HAL、不监听变化，列表只经 `apply(objectIDs:resolve:)` 更新（测试用）
+    init(listening: Bool = true) {
+        guard listening else { return }
+        queue.sync {
+            refresh()
+            installListener()
+        }
+    }
+    
+    deinit {
+        if let listener = listener {
+            AudioObjectRemovePropertyListenerBlock(AudioObjectID(kAudioObjectSystemObject), &AudioProcessRegistry.listAddress, queue, listener)
+        }
+    }
+    
+    // MARK: - Queries
+    
+    /// 可录制的进程（HAL 列表顺序）
+    func processes() -> [AudioProcessInfo] {
+        RealtimeSafety.check(.lock, "AudioProcessRegistry.processes")
+        lock.lock()
+        defer { lock.unlock() }
+        return order.compactMap { entries[$0]?.info }
+    }
+    
+    /// 可录制进程数量
+    var count: Int {
+        RealtimeSafety.check(.lock, "AudioProcessRegistry.count")
+        lock.lock()
+        defer { lock.unlock() }
+        return recordableCount
+    }
+    
+    /// 列表版本号（每次变化递增）
+    var generation: UInt64 {
+        RealtimeSafety.check(.lock, "AudioProcessRegistry.generation")
+        lock.lock()
+        defer { lock.unlock() }
+        return generationValue
+    }
+    
+    /// 按 PID 查找可录制进程
+    func process(pid: pid_t) -> AudioProcessInfo? {
+        RealtimeSafety.check(.lock, "AudioProcessRegistry.process")
+        lock.lock()
+        defer { lock.unlock() }
+        return objectByPID[pid].flatMap { entries[$0]?.info }
+    }
+    
+    /// 按 PID 查找进程对象（包括被过滤的系统进程，如 coreaudiod）
+    ///
+    /// 缓存中没有时向 HAL 查询一次（进程刚启动、通知尚未到达）。
+    func processObjectID(pid: pid_t) -> AudioObjectID? {
+        RealtimeSafety.check(.lock, "AudioProcessRegistry.processObjectID")
+        lock.lock()
+        let cached = objectByPID[pid]
+        lock.unlock()
+        if let cached = cached {
+            return cached
+        }
+        return translatePID(pid)
+    }
+    
+    /// 自版本号 `generation` 之后的累计变化
+    ///
+    /// 版本号早于变化记录（或为 0）时返回完整列表并标记 `isFullList`。
+    func changes(since generation: UInt64) -> AudioProcessDelta {
+        RealtimeSafety.check(.lock, "AudioProcessRegistry.changes")
+        lock.lock()
+        defer { lock.unlock() }
+        if generation > 0 && generation >= generationValue {
+            return AudioProcessDelta(added: [], removedPIDs: [], generation: generationValue, isFullList: false)
+        }
+        guard generation > 0, let oldest = changeLog.first, oldest.generation <= generation + 1 else {
+            return AudioProcessDelta(
+                added: order.compactMap { entries[$0]?.info },
+                removedPIDs: [],
+                generation: generationValue,
+                isFullList: true
+            )
+        }
+        
+        var added: [pid_t: AudioProcessInfo] = [:]
+        var addedOrder: [pid_t] = []
+        var removed = Set<pid_t>()
+        for change in changeLog where change.generation > generation {
+            for process in change.removed {
+                removed.insert(process.pid)
+                added.removeValue(forKey: process.pid)
+            }
+            for process in change.added {
+                if added.updateValue(process, forKey: process.pid) == nil {
+                    addedOrder.append(process.pid)
+                }
+            }
+        }
+        return AudioProcessDelta(
+            added: addedOrder.compactMap { added[$0] },
+            removedPIDs: removed.sorted(),
+            generation: generationValue,
+            isFullList: false
+        )
+    }
+    
+    // MARK: - Observers
+    
+    /// 订阅列表变化（在主线程回调）
+    /// - Returns: 用于移除的标识
+    @discardableResult
+    func addObserver(_ handler: @escaping (AudioProcessChange) -> Void) -> Int {
+        return queue.sync {
+            let id = nextObserverID
+            nextObserverID += 1
+            observers[id] = handler
+            return id
+        }
+    }
+    
+    func removeObserver(_ id: Int) {
+        queue.sync {
+            _ = observers.removeValue(forKey: id)
+        }
+    }
+    
+    // MARK: - Updating (queue)
+    
+    private func installListener() {
+        let block: AudioObjectPropertyListenerBlock = { [weak self] _, _ in
+            self?.refresh()
+        }
+        let status = AudioObjectAddPropertyListenerBlock(AudioObjectID(kAudioObjectSystemObject), &AudioProcessRegistry.listAddress, queue, block)
+        if status == noErr {
+            listener = block
+        } else {
+            logger.warning("⚠️ AudioProcessRegistry: 无法监听进程列表变化 (OSStatus=\(status))，列表将不会自动更新")
+        }
+    }
+    
+    /// 读取对象列表并与缓存比较，只解析新对象
+    private func refresh() {
+        guard let objectIDs = resolver.readProcessObjectList() else { return }
+        let change = apply(objectIDs: objectIDs) { oid in
+            guard let pid = resolver.readPID(for: oid) else { return nil }
+            return (pid, resolver.resolveRecordableProcess(objectID: oid, pid: pid))
+        }
+        guard let change = change, !change.added.isEmpty || !change.removed.isEmpty else { return }
+        
+        logger.info("🔍 AudioProcessRegistry: 进程列表更新 +\(change.added.count) -\(change.removed.count)，共 \(count) 个可录制进程")
+        for process in change.added {
+            logger.debug("   + \(process.name) (PID: \(process.pid), Bundle: \(process.bundleID), 对象ID: \(process.processObjectID))")
+        }
+        for process in change.removed {
+            logger.debug("   - \(process.name) (PID: \(process.pid))")
+        }
+        
+        let handlers = Array(observers.values)
+        guard !handlers.isEmpty else { return }
+        DispatchQueue.main.async {
+            handlers.forEach { $0(change) }
+        }
+    }
+    
+    /// 用新的对象列表更新缓存并记下变化，只对未知对象调用 resolve
+    /// - Parameter resolve: 对象 → (PID, 可录制进程信息；被过滤时为 nil)，读不到 PID 时返回 nil
+    /// - Returns: 记下的变化（列表没有变化时为 nil）
+    @discardableResult
+    func apply(objectIDs: [AudioObjectID], resolve: (AudioObjectID) -> (pid: pid_t, info: AudioProcessInfo?)?) -> AudioProcessChange? {
+        RealtimeSafety.check(.lock, "AudioProcessRegistry.apply")
+        lock.lock()
+        let known = entries
+        lock.unlock()
+        
+        var resolved: [AudioObjectID: Entry] = [:]
+        for oid in objectIDs where known[oid] == nil {
+            guard let process = resolve(oid) else { continue }
+            resolved[oid] = Entry(pid: process.pid, info: process.info)
+        }
+        
+        let current = Set(objectIDs)
+        let removedIDs = known.keys.filter { !current.contains($0) }
+        guard !resolved.isEmpty || !removedIDs.isEmpty else { return nil }
+        
+        RealtimeSafety.check(.lock, "AudioProcessRegistry.apply")
+        lock.lock()
+        for oid in removedIDs {
+            if let entry = entries.removeValue(forKey: oid), objectByPID[entry.pid] == oid {
+                objectByPID.removeValue(forKey: entry.pid)
+            }
+        }
+        for (oid, entry) in resolved {
+            entries[oid] = entry
+            objectByPID[entry.pid] = oid
+        }
+        order = objectIDs.filter { entries[$0] != nil }
+        recordableCount = entries.values.reduce(0) { $0 + ($1.info == nil ? 0 : 1) }
+        generationValue += 1
+        let change = AudioProcessChange(
+            added: resolved.values.compactMap { $0.info },
+            removed: removedIDs.compactMap { known[$0]?.info },
+            generation: generationValue
+        )
+        changeLog.append(change)
+        if changeLog.count > AudioProcessRegistry.changeLogCapacity {
+            changeLog.removeFirst(changeLog.count - AudioProcessRegistry.changeLogCapacity)
+        }
+        lock.unlock()
+        return change
+    }
+    
+    private func translatePID(_ pid: pid_t) -> AudioObjectID? {
+        var address = AudioObjectPropertyAddress(
+            mSelector: kAudioHardwarePropertyTranslatePIDToProcessObject,
+            mScope: kAudioObjectPropertyScopeGlobal,
+            mElement: kAudioObjectPropertyElementMain
+        )
+        var qualifier = pid
+        var objectID = AudioObjectID(kAudioObjectUnknown)
+        var size = UInt32(MemoryLayout<AudioObjectID>.size)
+        let status = AudioObjectGetPropertyData(
+            AudioObjectID(kAudioObjectSystemObject), &address,
+            UInt32(MemoryLayout<pid_t>.size), &qualifier, &size, &objectID
+        )
+        return status == noErr && objectID != kAudioObjectUnknown ? objectID : nil
+    }
+}
@@ -1,23 +1,54 @@
 import Foundation
 import AudioToolbox
 import CoreAudio
+import Accelerate
 
 /// 使用 AudioToolbox API 的音频文件管理器
 /// 用于创建标准 WAV 文件，避免 AVAudioFile 的 FLLR 块问题
 @available(macOS 14.4, *)
-class AudioToolboxFileManager {
+@_spi(Benchmarks) public class AudioToolboxFileManager {
     
     // MARK: - Properties
     private let logger = Logger.shared
+    /// 本会话的断流 / 溢出监测（计数与旁路日志随文件开始与结束）
+    public let xruns: XrunMonitor
     private var audioFileID: AudioFileID?
     private var outputURL: URL?
     private var audioFormat: AudioStreamBasicDescription
     private var totalFramesWritten: UInt64 = 0
+    /// 非交错输入的声道视图（写入时复用）
+    private let sinkView = AudioBufferListView()
+    /// 磁盘空间监测（文件打开期间存在）
+    private var diskMonitor: DiskPressureMonitor?
+    /// 空间不足后的溢出文件（ALAC，浮点样本量化为 24 位），切换后写入改走 ExtAudioFileWriteAsync
+    private var spillFile: ExtAudioFileRef?
+    private let spillActive = AtomicInt64()
+    private var spillFramesWritten: Int64 = 0
+    /// 溢出文件路径（未切换时为 nil）
+    private(set) var spillURL: URL?
+    /// ALAC 相对同位深 PCM 的典型压缩比（用于预测剩余时间）
+    private static let spillCompressionRatio = 0.6
+    
+    private static let writeTraceName = TraceName("writer.write", category: "io")
+    
+    /// 异步写入：IO 线程把编码后的块放入队列，写入线程落盘（未启用时为 nil）
+    private var writeQueue: CaptureByteRing?
+    private var writeTimer: DispatchSourceTimer?
+    private var drainScratch: UnsafeMutableRawPointer?
+    private var drainScratchBytes = 0
+    private var writeCompletion: ((EncodedWrite, StageMark, Bool) -> Void)?
+    private let writerQueue = DispatchQueue(label: "com.audiorecordkit.writer", qos: .userInitiated)
+    /// 写入线程的检查间隔
+    private static let writeInterval: DispatchTimeInterval = .milliseconds(5)
     
     // MARK: - Initialization
     
-    init(audioFormat: AudioStreamBasicDescription) {
+    /// - Parameters:
+    ///   - audioFormat: 输入格式
+    ///   - xruns: 会话的断流监测（未指定时每个文件管理器独立一个）
+    public init(audioFormat: AudioStreamBasicDescription, xruns: XrunMonitor? = nil) {
         self.audioFormat = audioFormat
+        self.xruns = xruns ?? XrunMonitor(name: "file")
         logger.info("🎵 AudioToolboxFileManager: 初始化，格式 - 采样率: \(audioFormat.mSampleRate), 声道数: \(audioFormat.mChannelsPerFrame), 位深: \(audioFormat.mBitsPerChannel)")
     }
     
@@ -28,7 +59,7 @@ class AudioToolboxFileManager {
     // MARK: - Public Methods
     
     /// 创建音频文件
-    func createAudioFile(at url: URL) throws {
+    public func createAudioFile(at url: URL) throws {
         logger.info("📁 AudioToolboxFileManager: 创建音频文件: \(url.path)")
         
         // 确保目录存在
@@ -62,41 +93,58 @@ class AudioToolboxFileManager {
         }
         
         self.outputURL = url
+        xruns.beginRecording(fileURL: url)
+        startDiskMonitor(for: url, bytesPerSecond: wavFormat.mSampleRate * Double(wavFormat.mBytesPerFrame))
         logger.info("✅ AudioToolboxFileManager: 音频文件创建成功")
         logger.info("📊 文件格式: 采样率=\(wavFormat.mSampleRate), 声道数=\(wavFormat.mChannelsPerFrame), 位深=\(wavFormat.mBitsPerChannel)")
     }
     
     /// 写入音频数据
-    func writeAudioData(_ bufferList: AudioBufferList, frameCount: UInt32) throws {
+    ///
+    /// 输入为交错或非交错的 Float32 AudioBufferList；文件是交错格式，
+    /// 非交错输入只在这里交错一次。
+    func writeAudioData(_ bufferList: UnsafePointer<AudioBufferList>, frameCount: UInt32) throws {
+        RealtimeSafety.check(.fileIO, "AudioToolboxFileManager.writeAudioData")
         guard let fileID = audioFileID else {
-            logger.warning("⚠️ AudioToolboxFileManager: 文件未打开，跳过写入")
+            logger.record(.warning, "⚠️ AudioToolboxFileManager: 文件未打开，跳过写入")
             return
         }
         
         guard frameCount > 0 else {
-            logger.warning("⚠️ AudioToolboxFileManager: 帧数为0，跳过写入")
+            logger.record(.warning, "⚠️ AudioToolboxFileManager: 帧数为0，跳过写入")
             return
         }
         
         // 检查是否需要格式转换
-        let buffer = bufferList.mBuffers
         let isFloatFormat = (audioFormat.mFormatFlags & kAudioFormatFlagIsFloat) != 0
+        let outputChannels = Int(audioFormat.mChannelsPerFrame)
         
         let convertedData: Data
         if isFloatFormat {
-            // 32-bit Float 格式，直接使用原始数据
-            let dataSize = Int(buffer.mDataByteSize)
-            convertedData = Data(bytes: buffer.mData!, count: dataSize)
+            let buffer = bufferList.pointee.mBuffers
+            if bufferList.pointee.mNumberBuffers == 1 {
+                // 32-bit Float 交错格式，直接使用原始数据
+                guard let data = buffer.mData else { return }
+                convertedData = Data(bytes: data, count: Int(buffer.mDataByteSize))
+            } else {
+                // 非交错格式，按文件声道数交错
+                guard sinkView.bind(bufferList) else { return }
+                let frames = min(Int(frameCount), sinkView.frameCount)
+                var interleaved = Data(count: frames * outputChannels * MemoryLayout<Float>.size)
+                interleaved.withUnsafeMutableBytes { bytes in
+                    let dst = bytes.bindMemory(to: Float.self).baseAddress!
+                    for c in 0..<outputChannels {
+                        let sc = min(c, sinkView.channelCount - 1)
+                        vDSP_mmov(sinkView.channel(sc), dst + c, 1, vDSP_Length(frames), vDSP_Length(sinkView.stride(sc)), vDSP_Length(outputChannels))
+                    }
+                }
+                convertedData = interleaved
+            }
         } else {
             // 非 Float 格式，需要转换
-            let totalSamples = Int(buffer.mDataByteSize) / MemoryLayout<Float>.size
-            let inputChannels = totalSamples / Int(frameCount)
-            let outputChannels = Int(audioFormat.mChannelsPerFrame)
-            
             convertedData = try AudioUtils.convertFloat32ToInt16(
                 bufferList: bufferList,
                 frameCount: frameCount,
-                inputChannels: inputChannels,
                 outputChannels: outputChannels
             )
         }
@@ -106,6 +154,14 @@ class AudioToolboxFileManager {
         let ioNumBytes = UInt32(convertedData.count)
         
         // 使用 AudioFileWritePackets 写入数据
+        let span = EngineTrace.span(AudioToolboxFileManager.writeTraceName)
+        defer { span.end() }
+        if spillActive.value != 0 {
+            try convertedData.withUnsafeBytes { bytes in
+                try writeSpill(bytes.baseAddress!, byteCount: convertedData.count, frameCount: frameCount)
+            }
+            return
+        }
         let status = convertedData.withUnsafeBytes { bytes in
             AudioFileWritePackets(
                 fileID,
@@ -119,37 +175,272 @@ class AudioToolboxFileManager {
         }
         
         guard status == noErr else {
-            logger.error("❌ AudioToolboxFileManager: 写入数据失败 - \(status)")
+            logger.record(.error, "❌ AudioToolboxFileManager: 写入数据失败 - {}", .int(status))
             throw NSError(domain: "AudioToolboxFileManager", code: Int(status), userInfo: [
                 NSLocalizedDescriptionKey: "写入音频数据失败: \(status)"
             ])
         }
         
         totalFramesWritten += UInt64(inNumPackets)
+        diskMonitor?.bytesWritten.add(Int64(ioNumBytes))
         
         // 每50000帧记录一次（约1秒@48kHz），减少日志输出
         if totalFramesWritten % 50000 == 0 {
-            logger.info("📝 AudioToolboxFileManager: 已写入 \(totalFramesWritten) 帧")
+            logger.record(.info, "📝 AudioToolboxFileManager: 已写入 {} 帧", .uint(totalFramesWritten))
         }
     }
     
+    /// 写入已按文件格式编码的交错数据（由采集管线编码，不再做格式转换与拷贝）
+    ///
+    /// 同步写入文件；处理图中的写入器经 `enqueueEncodedPackets` 在写入线程上调用这里。
+    public func writeEncodedPackets(_ bytes: UnsafeRawPointer, byteCount: Int, frameCount: UInt32) throws {
+        RealtimeSafety.check(.fileIO, "AudioToolboxFileManager.writeEncodedPackets")
+        guard let fileID = audioFileID else {
+            logger.record(.warning, "⚠️ AudioToolboxFileManager: 文件未打开，跳过写入")
+            return
+        }
+        
+        guard frameCount > 0 else { return }
+        
+        var inNumPackets = frameCount
+        let span = EngineTrace.span(AudioToolboxFileManager.writeTraceName)
+        defer { span.end() }
+        if spillActive.value != 0 {
+            try writeSpill(bytes, byteCount: byteCount, frameCount: frameCount)
+            return
+        }
+        let status = AudioFileWritePackets(
+            fileID,
+            false,  // 不使用缓存
+            UInt32(byteCount),
+            nil,    // 包描述符（PCM 不需要）
+            Int64(totalFramesWritten),  // 起始包
+            &inNumPackets,
+            bytes
+        )
+        
+        guard status == noErr else {
+            logger.record(.error, "❌ AudioToolboxFileManager: 写入数据失败 - {}", .int(status))
+            throw NSError(domain: "AudioToolboxFileManager", code: Int(status), userInfo: [
+                NSLocalizedDescriptionKey: "写入音频数据失败: \(status)"
+            ])
+        }
+        
+        totalFramesWritten += UInt64(inNumPackets)
+        diskMonitor?.bytesWritten.add(Int64(byteCount))
+    }
+    
+    /// 文件格式
+    var fileFormat: AudioStreamBasicDescription {
+        return audioFormat
+    }
+    
     /// 关闭文件
-    func closeFile() {
+    ///
+    /// 先写完异步队列中的数据并停止磁盘监测（之后不会再切换到溢出文件），再关闭文件。
+    public func closeFile() {
+        stopAsynchronousWrites()
+        diskMonitor?.stop()
+        diskMonitor = nil
         if let fileID = audioFileID {
             AudioFileClose(fileID)
             audioFileID = nil
+            xruns.endRecording()
             logger.info("🔒 AudioToolboxFileManager: 文件已关闭，总共写入 \(totalFramesWritten) 帧")
         }
+        spillActive.store(0)
+        if let spill = spillFile {
+            // 释放时等待异步写入完成
+            ExtAudioFileDispose(spill)
+            spillFile = nil
+            logger.warning("⚠️ AudioToolboxFileManager: 溢出文件已关闭，写入 \(spillFramesWritten) 帧: \(spillURL?.lastPathComponent ?? "")")
+        }
         outputURL = nil
         totalFramesWritten = 0
+        spillFramesWritten = 0
     }
     
     /// 获取文件信息
-    func getFileInfo() -> (url: URL?, totalFrames: UInt64, duration: TimeInterval) {
+    public func getFileInfo() -> (url: URL?, totalFrames: UInt64, duration: TimeInterval) {
         let duration = totalFramesWritten > 0 ? Double(totalFramesWritten) / audioFormat.mSampleRate : 0.0
         return (outputURL, totalFramesWritten, duration)
     }
     
+    // MARK: - Asynchronous Writes
+    
+    /// 队列中每个块的记录头（后接 byteCount 字节的编码数据）
+    struct EncodedWrite {
+        var captureHostTime: UInt64
+        var byteCount: Int32
+        var frameCount: UInt32
+        /// 是否计入流水线统计
+        var timed: Bool
+        
+        static let size = MemoryLayout<EncodedWrite>.size
+    }
+    
+    /// 启用异步写入（建图时在主线程调用）
+    ///
+    /// 之后 `enqueueEncodedPackets` 只在 IO 线程上拷贝数据，写入线程每 5ms 把队列写入文件，
+    /// 每写完一块（或写入失败）在写入线程上调用 completion（参数为记录头、写入开始时刻、是否成功）。
+    /// - Parameters:
+    ///   - queueBytes: 队列容量（应能容纳写入线程一次停顿期间的数据）
+    ///   - maxBlockBytes: 单块编码数据的最大字节数
+    func startAsynchronousWrites(queueBytes: Int, maxBlockBytes: Int, completion: @escaping (EncodedWrite, StageMark, Bool) -> Void) {
+        stopAsynchronousWrites()
+        let queue = CaptureByteRing(capacity: queueBytes, tag: .rings)
+        let scratch = EngineMemory.allocateRaw(byteCount: maxBlockBytes, alignment: 16, tag: .scratch)
+        writerQueue.sync {
+            writeQueue = queue
+            drainScratch = scratch
+            drainScratchBytes = maxBlockBytes
+            writeCompletion = completion
+        }
+        let timer = DispatchSource.makeTimerSource(queue: writerQueue)
+        timer.schedule(deadline: .now() + AudioToolboxFileManager.writeInterval,
+                       repeating: AudioToolboxFileManager.writeInterval, leeway: .milliseconds(1))
+        timer.setEventHandler { [weak self] in
+            self?.drainWriteQueue()
+        }
+        timer.resume()
+        writeTimer = timer
+        logger.info("🧵 AudioToolboxFileManager: 异步写入已启用，队列 \(queueBytes / 1024)KB")
+    }
+    
+    /// 把编码后的块放入写入队列（IO 线程调用：不加锁、不分配、不做文件 IO）
+    /// - Returns: 队列已满或块过大时为 false（该块被丢弃）
+    @inline(__always)
+    func enqueueEncodedPackets(_ bytes: UnsafeRawPointer, byteCount: Int, frameCount: UInt32,
+                               captureHostTime: UInt64, timed: Bool) -> Bool {
+        guard let queue = writeQueue, byteCount <= drainScratchBytes else { return false }
+        let total = EncodedWrite.size + byteCount
+        guard queue.freeBytes >= total else { return false }
+        var header = EncodedWrite(captureHostTime: captureHostTime, byteCount: Int32(byteCount),
+                                  frameCount: frameCount, timed: timed)
+        withUnsafeBytes(of: &header) { raw in
+            queue.write(raw.baseAddress!, count: EncodedWrite.size, offset: 0)
+        }
+        queue.write(bytes, count: byteCount, offset: EncodedWrite.size)
+        queue.publish(total)
+        return true
+    }
+    
+    /// 写入队列中已发布的全部块（writerQueue 上调用）
+    private func drainWriteQueue() {
+        guard let queue = writeQueue, let scratch = drainScratch else { return }
+        var header = EncodedWrite(captureHostTime: 0, byteCount: 0, frameCount: 0, timed: false)
+        while queue.readableBytes >= EncodedWrite.size {
+            withUnsafeMutableBytes(of: &header) { raw in
+                queue.read(into: raw.baseAddress!, count: EncodedWrite.size, offset: 0)
+            }
+            let byteCount = Int(header.byteCount)
+            queue.read(into: scratch, count: byteCount, offset: EncodedWrite.size)
+            queue.consume(EncodedWrite.size + byteCount)
+            let mark = StageMark.now()
+            do {
+                try writeEncodedPackets(scratch, byteCount: byteCount, frameCount: header.frameCount)
+                writeCompletion?(header, mark, true)
+            } catch {
+                writeCompletion?(header, mark, false)
+            }
+        }
+    }
+    
+    /// 停止异步写入并写完队列中剩余的数据（调用前应已停止 IO 回调）
+    private func stopAsynchronousWrites() {
+        guard let timer = writeTimer else { return }
+        writeTimer = nil
+        timer.cancel()
+        writerQueue.sync {
+            drainWriteQueue()
+            writeQueue = nil
+            writeCompletion = nil
+            if let scratch = drainScratch {
+                EngineMemory.deallocateRaw(scratch, byteCount: drainScratchBytes, tag: .scratch)
+            }
+            drainScratch = nil
+            drainScratchBytes = 0
+        }
+    }
+    
+    // MARK: - Disk Pressure
+    
+    private func startDiskMonitor(for url: URL, bytesPerSecond: Double) {
+        spillURL = nil
+        let monitor = DiskPressureMonitor(fileURL: url, bytesPerSecond: bytesPerSecond) { [weak self] in
+            guard let self = self, let spill = self.beginSpill(nextTo: url) else { return nil }
+            return (spill.url, bytesPerSecond * spill.compressionRatio)
+        }
+        diskMonitor = monitor
+        monitor.start()
+    }
+    
+    /// 创建 CAF 溢出文件，之后的写入改写到这里（在监测队列上调用）
+    ///
+    /// 整数样本按原位深用 ALAC 无损压缩。ALAC 只接受整数样本，浮点样本由 ExtAudioFile 的转换器
+    /// 量化为 24 位整数后再压缩：量化噪声约 -144 dBFS，低于任何采集设备的底噪；超过满幅的值被截断，
+    /// 处理图在写入前已经过限幅，正常录音不会触及。这样浮点录音（默认格式）的溢出文件约为原大小的一半。
+    /// - Returns: 溢出文件与其相对 PCM 的预计大小比例
+    private func beginSpill(nextTo url: URL) -> (url: URL, compressionRatio: Double)? {
+        let spillURL = url.deletingPathExtension().appendingPathExtension("spill.caf")
+        let isFloat = audioFormat.mFormatFlags & kAudioFormatFlagIsFloat != 0
+        let sourceBits = isFloat ? 24 : Int(audioFormat.mBitsPerChannel)
+        var spillFormat = AudioStreamBasicDescription()
+        spillFormat.mSampleRate = audioFormat.mSampleRate
+        spillFormat.mFormatID = kAudioFormatAppleLossless
+        spillFormat.mChannelsPerFrame = audioFormat.mChannelsPerFrame
+        spillFormat.mFramesPerPacket = 4096
+        switch sourceBits {
+        case 16: spillFormat.mFormatFlags = kAppleLosslessFormatFlag_16BitSourceData
+        case 32: spillFormat.mFormatFlags = kAppleLosslessFormatFlag_32BitSourceData
+        default: spillFormat.mFormatFlags = kAppleLosslessFormatFlag_24BitSourceData
+        }
+        // 溢出文件不比原格式小时切换没有意义，交给监测器直接走警告 / 临界路径
+        let compressionRatio = AudioToolboxFileManager.spillCompressionRatio * Double(sourceBits) / Double(max(audioFormat.mBitsPerChannel, 1))
+        guard compressionRatio < 1.0 else { return nil }
+        
+        var file: ExtAudioFileRef?
+        var status = ExtAudioFileCreateWithURL(spillURL as CFURL, kAudioFileCAFType, &spillFormat, nil,
+                                               AudioFileFlags.eraseFile.rawValue, &file)
+        guard status == noErr, let spill = file else {
+            logger.error("❌ AudioToolboxFileManager: 创建溢出文件失败 - \(status)")
+            return nil
+        }
+        // 写入的数据已按文件格式编码，作为客户端格式交给编码器（浮点样本由转换器量化为 24 位）
+        var client = audioFormat
+        status = ExtAudioFileSetProperty(spill, kExtAudioFileProperty_ClientDataFormat,
+                                         UInt32(MemoryLayout<AudioStreamBasicDescription>.size), &client)
+        if status == noErr {
+            // 预先初始化异步写入的缓冲区，之后可在 IO 线程上调用
+            status = ExtAudioFileWriteAsync(spill, 0, nil)
+        }
+        guard status == noErr else {
+            logger.error("❌ AudioToolboxFileManager: 配置溢出文件失败 - \(status)")
+            ExtAudioFileDispose(spill)
+            return nil
+        }
+        
+        spillFile = spill
+        self.spillURL = spillURL
+        spillActive.store(1)
+        return (spillURL, compressionRatio)
+    }
+    
+    /// 写入溢出文件（不分配内存，由 ExtAudioFile 在后台编码落盘）
+    private func writeSpill(_ bytes: UnsafeRawPointer, byteCount: Int, frameCount: UInt32) throws {
+        guard let spill = spillFile else { return }
+        var list = AudioBufferList(mNumberBuffers: 1, mBuffers: AudioBuffer(
+            mNumberChannels: audioFormat.mChannelsPerFrame, mDataByteSize: UInt32(byteCount), mData: UnsafeMutableRawPointer(mutating: bytes)))
+        let status = ExtAudioFileWriteAsync(spill, frameCount, &list)
+        guard status == noErr else {
+            logger.record(.error, "❌ AudioToolboxFileManager: 写入溢出文件失败 - {}", .int(status))
+            throw NSError(domain: "AudioToolboxFileManager", code: Int(status), userInfo: [
+                NSLocalizedDescriptionKey: "写入溢出文件失败: \(status)"
+            ])
+        }
+        spillFramesWritten += Int64(frameCount)
+    }
+    
     // MARK: - Private Methods
     
     
@@ -60,8 +60,7 @@ final class CoreAudioProcessTapRecorder: BaseAudioRecorder {
     private func getTargetAppName() -> String? {
         guard let pid = targetPID else { return nil }
         
-        let processes = processEnumerator.getAvailableAudioProcesses()
-        return processes.first(where: { $0.pid == pid })?.name
+        return AudioProcessRegistry.shared.process(pid: pid)?.name
     }
     
     /// 使用Swift CoreAudio API进行录制（实验性）
@@ -129,7 +128,7 @@ final class CoreAudioProcessTapRecorder: BaseAudioRecorder {
         // 创建音频文件
         let fileURL = FileManagerUtils.shared.getRecordingFileURL(recordingMode: recordingMode, appName: getTargetAppName(), format: "wav")
         
-        audioToolboxFileManager = AudioToolboxFileManager(audioFormat: streamFormat)
+        audioToolboxFileManager = AudioToolboxFileManager(audioFormat: streamFormat, xruns: xruns)
         do {
             try audioToolboxFileManager?.createAudioFile(at: fileURL)
         } catch {
@@ -201,12 +200,15 @@ final class CoreAudioProcessTapRecorder: BaseAudioRecorder {
         
         do {
             // 创建 AudioToolbox 文件管理器
-            let audioToolboxManager = AudioToolboxFileManager(audioFormat: audioFormat)
+            let audioToolboxManager = AudioToolboxFileManager(audioFormat: audioFormat, xruns: xruns)
             try audioToolboxManager.createAudioFile(at: defaultURL)
             
             // 设置到回调处理器
             audioCallbackHandler.setAudioToolboxFileManager(audioToolboxManager)
             
+            // 构建处理图：Tap 源 → 电平表 / 文件写入
+            try installProcessingGraph(format: audioFormat, fileManager: audioToolboxManager)
+            
             // 保存引用以便后续清理
             self.audioToolboxFileManager = audioToolboxManager
             self.outputURL = defaultURL
@@ -224,6 +226,46 @@ final class CoreAudioProcessTapRecorder: BaseAudioRecorder {
         }
     }
     
+    /// 构建并挂载处理图
+    private func installProcessingGraph(format: AudioStreamBasicDescription, fileManager: AudioToolboxFileManager) throws {
+        let channels = Int(format.mChannelsPerFrame)
+        let sampleRate = format.mSampleRate
+        let maxFrames = AudioGraph.defaultMaxFramesPerQuantum
+        
+        // 开始录制时一次性选择特化管线
+        let mode: CaptureMode = targetPIDs.isEmpty ? .systemAudio : .specificProcess
+        let pipeline = CapturePipelineFactory.make(CapturePipelineConfiguration(mode: mode, fileFormat: format))
+        
+        // 写入队列按 2 秒申请，超出全局或会话内存预算时至少保留 0.25 秒（另留每块记录头的余量）
+        let memory = EngineMemory.makeSessionAccount(name: "ProcessTap")
+        let encodedBytesPerFrame = Int(format.mBytesPerFrame)
+        let writeQueueBytes = EngineMemory.grant(requested: Int(sampleRate) * 2 * encodedBytesPerFrame + 64 * 1024,
+                                                 minimum: Int(sampleRate / 4) * encodedBytesPerFrame + 64 * 1024,
+                                                 tag: .rings, what: "写入队列", session: memory)
+        
+        // 单链路图，串行执行即可；节点缓冲区连续分配在会话内存区中
+        let arena = EngineArena(name: "ProcessTap", capacity: EngineArena.estimatedCapacity(
+            nodes: 3, channels: channels, maxFrames: maxFrames, extraBytes: maxFrames * channels * MemoryLayout<Float>.stride))
+        let graph = AudioGraph(name: "ProcessTap", sampleRate: sampleRate, maxFramesPerQuantum: maxFrames, workerCount: 0, arena: arena,
+                               xruns: fileManager.xruns, memory: memory)
+        let (source, meter) = try graph.withArena {
+            let source = graph.add(PushSourceNode(name: "tap", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate, pipeline: pipeline))
+            let meter = graph.add(MeterNode(name: "meter", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate, scale: .decibel(floorDB: 96)))
+            let writer = graph.add(FileWriterNode(name: "writer", fileManager: fileManager, pipeline: pipeline, maxFrames: maxFrames, sampleRate: sampleRate,
+                                                  queueBytes: writeQueueBytes))
+            try graph.connect(source, to: meter)
+            try graph.connect(source, to: writer)
+            try graph.compile()
+            return (source, meter)
+        }
+        
+        meter.levelPublisher = LevelPublisher { [weak self] level in
+            self?.callOnLevel(level)
+        }
+        
+        audioCallbackHandler.setProcessingGraph(graph, source: source)
+    }
+    
     private func continueRecordingProcess() {
         
         // 设置音频文件到回调处理器
@@ -231,10 +273,7 @@ final class CoreAudioProcessTapRecorder: BaseAudioRecorder {
             audioCallbackHandler.setAudioFile(audioFile)
         }
         
-        // 设置电平回调
-        audioCallbackHandler.setLevelCallback { [weak self] level in
-            self?.callOnLevel(level)
-        }
+        // 电平由处理图的电平表节点发布（installProcessingGraph），回调处理器不再单独计算
         
         // 对于系统音频录制，优先尝试Swift API，否则使用C API
         DispatchQueue.global(qos: .userInitiated).async { [weak self] in
@@ -282,6 +321,10 @@ final class CoreAudioProcessTapRecorder: BaseAudioRecorder {
     
     // MARK: - Public Methods
     
+    override var memoryAccount: MemoryAccount? {
+        return audioCallbackHandler.processingGraph?.memory
+    }
+    
     /// 获取所有可用的音频进程列表
     func getAvailableAudioProcesses() -> [AudioProcessInfo] {
         return processEnumerator.getAvailableAudioProcesses()
@@ -473,6 +516,11 @@ final class CoreAudioProcessTapRecorder: BaseAudioRecorder {
             // 步骤 5: 设置 IO 回调并启动
             let t5 = Date()
             logger.info("🎧 步骤5: 开始设置IO回调并启动设备...")
+            // 按 Tap 流格式与聚合设备的声道布局协商输入，多声道 Tap 在源节点下混到文件声道
+            if let format = tapManager.streamFormat {
+                let layout = ChannelLayout.discover(deviceID: aggManager.deviceID, scope: kAudioObjectPropertyScopeInput, channelCount: Int(format.mChannelsPerFrame))
+                audioCallbackHandler.setInputFormat(format, layout: layout)
+            }
             let (callback, clientData) = audioCallbackHandler.createAudioCallback()
             guard aggManager.setupIOProcAndStart(callback: callback, clientData: clientData) else {
                 let errorMsg = "❌ 步骤5失败: 安装IO回调或启动失败"
@@ -508,6 +556,9 @@ final class CoreAudioProcessTapRecorder: BaseAudioRecorder {
         processTapManager?.destroyProcessTap()
         processTapManager = nil
         
+        // IO 回调已停止，回收处理图
+        audioCallbackHandler.clearProcessingGraph()
+        
         logger.info("CoreAudioProcessTapRecorder: 停止与清理完成")
     }
     
@@ -0,0 +1,290 @@
+import Foundation
+import Darwin
+
+// MARK: - DiskPressureLevel
+/// 磁盘空间压力等级
+///
+/// 取值与 C API 的 `AudioRecordDiskPressure` 一致，不可调整。
+enum DiskPressureLevel: Int, Comparable {
+    /// 剩余空间充足
+    case normal = 0
+    /// 预计剩余录制时间低于警告阈值（已切换到溢出文件）
+    case low = 1
+    /// 预计剩余录制时间低于临界阈值，数据即将丢失
+    case critical = 2
+    
+    var name: String {
+        switch self {
+        case .normal: return "normal"
+        case .low: return "low"
+        case .critical: return "critical"
+        }
+    }
+    
+    static func < (lhs: DiskPressureLevel, rhs: DiskPressureLevel) -> Bool {
+        return lhs.rawValue < rhs.rawValue
+    }
+}
+
+// MARK: - DiskPressureEvent
+/// 一次压力等级变化
+struct DiskPressureEvent {
+    let level: DiskPressureLevel
+    /// 卷上的可用字节数（不含已为录音文件预留的空间）
+    let freeBytes: Int64
+    /// 按当前写入速率预计还能录制的秒数
+    let secondsRemaining: Double
+    let fileURL: URL
+    /// 溢出文件（整数样本为 ALAC 压缩，浮点样本为 Float32 LPCM；未切换时为 nil）
+    let spillURL: URL?
+}
+
+// MARK: - DiskPressurePolicy
+/// 磁盘空间策略
+struct DiskPressurePolicy {
+    /// 预计剩余时间低于该值时切换到溢出文件并发出 low 事件（秒）
+    var warningSeconds: Double = 600
+    /// 预计剩余时间低于该值时发出 critical 事件（秒）
+    var criticalSeconds: Double = 60
+    /// 每次为录音文件预留的空间（字节），0 表示不预留
+    var preallocationBytes: Int64 = 64 * 1024 * 1024
+    /// 空间不足时切换到溢出文件
+    var spillEnabled = true
+}
+
+// MARK: - DiskPressureMonitor
+/// 录音文件的磁盘空间监测
+///
+/// 后台队列每秒检查一次：录音文件写到预留区的一半时再按整块预留下一段（F_PREALLOCATE，
+/// 先尝试连续分配），并用卷的可用空间与预留余量除以写入速率预测剩余录制时间。
+/// 写入速率取标称速率与实测可用空间下降速率中的较大者，因此其他进程占用磁盘也会提前报警。
+/// 预计时间低于警告阈值时调用溢出回调（由文件管理器切换到溢出文件），并通知观察者；
+/// 写入线程只做原子计数，监测不在实时路径上。
+final class DiskPressureMonitor {
+    
+    // MARK: - Policy
+    private static let policyLock = NSLock()
+    private static var currentPolicy = DiskPressurePolicy()
+    
+    /// 全局策略（对之后开始的录制生效；阈值对进行中的录制下一次检查即生效）
+    static var policy: DiskPressurePolicy {
+        get {
+            policyLock.lock()
+            defer { policyLock.unlock() }
+            return currentPolicy
+        }
+        set {
+            policyLock.lock()
+            currentPolicy = newValue
+            policyLock.unlock()
+        }
+    }
+    
+    // MARK: - Observers
+    private static let observerLock = NSLock()
+    private static var observers: [Int: (DiskPressureEvent) -> Void] = [:]
+    private static var nextObserverID = 1
+    
+    /// 添加观察者（在主线程回调）
+    static func addObserver(_ handler: @escaping (DiskPressureEvent) -> Void) -> Int {
+        observerLock.lock()
+        defer { observerLock.unlock() }
+        let id = nextObserverID
+        nextObserverID += 1
+        observers[id] = handler
+        return id
+    }
+    
+    static func removeObserver(_ id: Int) {
+        observerLock.lock()
+        observers.removeValue(forKey: id)
+        observerLock.unlock()
+    }
+    
+    private static func publish(_ event: DiskPressureEvent) {
+        observerLock.lock()
+        let handlers = Array(observers.values)
+        observerLock.unlock()
+        guard !handlers.isEmpty else { return }
+        DispatchQueue.main.async {
+            handlers.forEach { $0(event) }
+        }
+    }
+    
+    // MARK: - Properties
+    private static let checkInterval: DispatchTimeInterval = .seconds(1)
+    /// 实测下降速率的平滑系数
+    private static let rateSmoothing = 0.2
+    
+    let fileURL: URL
+    /// 写入线程累加的已写入字节数
+    let bytesWritten = AtomicInt64()
+    
+    private let queue = DispatchQueue(label: "com.audiorecordkit.diskpressure", qos: .utility)
+    private var timer: DispatchSourceTimer?
+    private var descriptor: Int32 = -1
+    private var nominalBytesPerSecond: Double
+    private var observedBytesPerSecond: Double = 0
+    private var lastFreeBytes: Int64 = -1
+    private var lastCheckTime: UInt64 = 0
+    private var preallocatedEnd: Int64 = 0
+    private var level: DiskPressureLevel = .normal
+    private var spillURL: URL?
+    /// 切换到溢出文件，返回溢出文件与新的标称写入速率（失败返回 nil）
+    private let spill: () -> (url: URL, bytesPerSecond: Double)?
+    private let logger = Logger.shared
+    
+    // MARK: - Initialization
+    
+    /// - Parameters:
+    ///   - fileURL: 已创建的录音文件
+    ///   - bytesPerSecond: 标称写入速率
+    ///   - spill: 空间不足时切换到溢出文件（在监测队列上调用）
+    init(fileURL: URL, bytesPerSecond: Double, spill: @escaping () -> (url: URL, bytesPerSecond: Double)?) {
+        self.fileURL = fileURL
+        self.nominalBytesPerSecond = max(bytesPerSecond, 1)
+        self.spill = spill
+    }
+    
+    deinit {
+        // 正常情况下文件管理器已调用 stop()；这里只兜底释放资源，不同步到监测队列
+        timer?.cancel()
+        if descriptor >= 0 {
+            close(descriptor)
+        }
+    }
+    
+    // MARK: - Lifecycle
+    
+    func start() {
+        queue.sync {
+            descriptor = open(fileURL.path, O_RDWR)
+            if descriptor < 0 {
+                logger.warning("⚠️ DiskPressureMonitor: 无法打开 \(fileURL.lastPathComponent)（errno \(errno)），只监测可用空间")
+            }
+            preallocateIfNeeded()
+            check()
+            let timer = DispatchSource.makeTimerSource(queue: queue)
+            timer.schedule(deadline: .now() + DiskPressureMonitor.checkInterval, repeating: DiskPressureMonitor.checkInterval)
+            timer.setEventHandler { [weak self] in
+                self?.preallocateIfNeeded()
+                self?.check()
+            }
+            timer.resume()
+            self.timer = timer
+        }
+    }
+    
+    /// 停止监测（关闭录音文件之前调用）：返回后不再检查、不再调用溢出回调，并释放未用完的预留空间
+    ///
+    /// 在监测队列上同步执行，会等待进行中的检查结束。
+    func stop() {
+        queue.sync {
+            timer?.cancel()
+            timer = nil
+            guard descriptor >= 0 else { return }
+            var info = stat()
+            if preallocatedEnd > 0 && fstat(descriptor, &info) == 0 {
+                // 截到当前逻辑长度只归还末尾的预留块；之后 AudioFile 关闭时写入的头部与剩余数据照常扩展文件
+                ftruncate(descriptor, info.st_size)
+            }
+            close(descriptor)
+            descriptor = -1
+        }
+    }
+    
+    // MARK: - Preallocation
+    
+    private func preallocateIfNeeded() {
+        let extent = DiskPressureMonitor.policy.preallocationBytes
+        guard descriptor >= 0, extent > 0 else { return }
+        let written = bytesWritten.value
+        guard written + extent / 2 >= preallocatedEnd else { return }
+        
+        var store = fstore_t(fst_flags: UInt32(F_ALLOCATECONTIG | F_ALLOCATEALL), fst_posmode: F_PEOFPOSMODE,
+                             fst_offset: 0, fst_length: off_t(extent), fst_bytesalloc: 0)
+        var result = fcntl(descriptor, F_PREALLOCATE, &store)
+        if result < 0 {
+            // 没有足够的连续空间时退回非连续分配
+            store.fst_flags = UInt32(F_ALLOCATEALL)
+            result = fcntl(descriptor, F_PREALLOCATE, &store)
+        }
+        if result < 0 {
+            logger.warning("⚠️ DiskPressureMonitor: 预留 \(extent / 1_048_576)MB 失败（errno \(errno)）")
+            return
+        }
+        preallocatedEnd = max(preallocatedEnd, written) + Int64(store.fst_bytesalloc)
+    }
+    
+    // MARK: - Check
+    
+    private func check() {
+        var volume = statfs()
+        let status = descriptor >= 0 ? fstatfs(descriptor, &volume) : statfs(fileURL.deletingLastPathComponent().path, &volume)
+        guard status == 0 else { return }
+        let freeBytes = Int64(volume.f_bavail) * Int64(volume.f_bsize)
+        let now = mach_absolute_time()
+        
+        // 可用空间的实测下降速率（包含其他进程的写入）
+        if lastFreeBytes >= 0, now > lastCheckTime {
+            let seconds = Double(PipelineStats.nanoseconds(fromHostTicks: now - lastCheckTime)) / 1e9
+            observedBytesPerSecond = DiskPressureMonitor.smoothedDeclineRate(observedBytesPerSecond, previousFreeBytes: lastFreeBytes,
+                                                                             freeBytes: freeBytes, seconds: seconds)
+        }
+        lastFreeBytes = freeBytes
+        lastCheckTime = now
+        
+        let policy = DiskPressureMonitor.policy
+        let (secondsRemaining, newLevel) = DiskPressureMonitor.predict(
+            freeBytes: freeBytes,
+            reserveBytes: max(0, preallocatedEnd - bytesWritten.value),
+            bytesPerSecond: max(nominalBytesPerSecond, observedBytesPerSecond),
+            policy: policy
+        )
+        
+        if newLevel >= .low && spillURL == nil && policy.spillEnabled {
+            if let result = spill() {
+                spillURL = result.url
+                nominalBytesPerSecond = max(result.bytesPerSecond, 1)
+                // 换成溢出文件后预留区不再增长
+                preallocatedEnd = 0
+                logger.warning("⚠️ DiskPressureMonitor: 可用空间 \(freeBytes / 1_048_576)MB，预计 \(Int(secondsRemaining))s，切换到溢出文件 \(result.url.lastPathComponent)")
+            }
+        }
+        
+        guard newLevel != level else { return }
+        level = newLevel
+        let event = DiskPressureEvent(level: newLevel, freeBytes: freeBytes, secondsRemaining: secondsRemaining,
+                                      fileURL: fileURL, spillURL: spillURL)
+        switch newLevel {
+        case .normal:
+            logger.info("💾 DiskPressureMonitor: 磁盘空间恢复，可用 \(freeBytes / 1_048_576)MB")
+        case .low:
+            logger.warning("⚠️ DiskPressureMonitor: 磁盘空间不足，可用 \(freeBytes / 1_048_576)MB，预计还能录制 \(Int(secondsRemaining))s")
+        case .critical:
+            logger.error("❌ DiskPressureMonitor: 磁盘空间即将耗尽，可用 \(freeBytes / 1_048_576)MB，预计还能录制 \(Int(secondsRemaining))s")
+        }
+        DiskPressureMonitor.publish(event)
+    }
+    
+    // MARK: - Prediction
+    
+    /// 按可用空间与预留余量预测剩余录制时间与压力等级
+    static func predict(freeBytes: Int64, reserveBytes: Int64, bytesPerSecond: Double,
+                        policy: DiskPressurePolicy) -> (secondsRemaining: Double, level: DiskPressureLevel) {
+        let secondsRemaining = Double(freeBytes + reserveBytes) / max(bytesPerSecond, 1)
+        if secondsRemaining < policy.criticalSeconds {
+            return (secondsRemaining, .critical)
+        }
+        if secondsRemaining < policy.warningSeconds {
+            return (secondsRemaining, .low)
+        }
+        return (secondsRemaining, .normal)
+    }
+    
+    /// 把一次检查间隔内的可用空间下降折入平滑后的下降速率（空间增加按 0 计）
+    static func smoothedDeclineRate(_ previous: Double, previousFreeBytes: Int64, freeBytes: Int64, seconds: Double) -> Double {
+        let decline = max(0, Double(previousFreeBytes - freeBytes)) / max(seconds, 1e-3)
+        return previous + (decline - previous) * rateSmoothing
+    }
+}
@@ -0,0 +1,110 @@
+import Foundation
+import CoreAudio
+
+// MARK: - ProcessLevelMeter
+/// 多进程电平计 - 每个进程一个槽位，只计算峰值与 RMS
+///
+/// 由 IO 线程调用 `accumulate`（不加锁、不分配）；每个槽位累计满 `decimationFrames` 帧后
+/// 把峰值与 RMS 以 Float 位模式写入原子数组，`snapshot()` 可在任意线程读取。
+/// 不写文件、不做格式转换，也不在 IO 线程上回调。
+@_spi(Benchmarks) public final class ProcessLevelMeter {
+    
+    /// 默认统计窗口（48kHz 下约 21ms，足够界面以 30~60Hz 刷新）
+    public static let defaultDecimationFrames = 1024
+    
+    // MARK: - Accumulator
+    private struct Accumulator {
+        var peak: Float = 0
+        var sumSquares: Float = 0
+        var samples = 0
+        var frames = 0
+    }
+    
+    // MARK: - Properties
+    let pids: [pid_t]
+    let decimationFrames: Int
+    
+    private let measure = DSPKernels.peakSumSquares.function
+    /// 只在 IO 线程访问
+    private let accumulators: UnsafeMutablePointer<Accumulator>
+    private let peaks: AtomicInt64Array
+    private let rmsValues: AtomicInt64Array
+    private let publishes = AtomicInt64()
+    
+    // MARK: - Initialization
+    
+    public init(pids: [pid_t], decimationFrames: Int = ProcessLevelMeter.defaultDecimationFrames) {
+        self.pids = pids
+        self.decimationFrames = max(decimationFrames, 1)
+        accumulators = UnsafeMutablePointer<Accumulator>.allocate(capacity: max(pids.count, 1))
+        accumulators.initialize(repeating: Accumulator(), count: max(pids.count, 1))
+        peaks = AtomicInt64Array(count: pids.count)
+        rmsValues = AtomicInt64Array(count: pids.count)
+    }
+    
+    deinit {
+        accumulators.deinitialize(count: max(pids.count, 1))
+        accumulators.deallocate()
+    }
+    
+    // MARK: - IO Thread
+    
+    /// 累计一个槽位的交错样本
+    /// - Parameters:
+    ///   - slot: 槽位（与 pids 下标对应）
+    ///   - samples: 交错 Float32 样本
+    ///   - count: 样本数（帧数 × 声道数）
+    ///   - channels: 声道数
+    @inline(__always)
+    func accumulate(slot: Int, samples: UnsafePointer<Float>, count: Int, channels: Int) {
+        guard slot >= 0, slot < pids.count, count > 0 else { return }
+        let level = measure(samples, count)
+        let accumulator = accumulators + slot
+        accumulator.pointee.peak = max(accumulator.pointee.peak, level.peak)
+        accumulator.pointee.sumSquares += level.sumSquares
+        accumulator.pointee.samples += count
+        accumulator.pointee.frames += count / max(channels, 1)
+        
+        guard accumulator.pointee.frames >= decimationFrames else { return }
+        let rms = sqrt(accumulator.pointee.sumSquares / Float(accumulator.pointee.samples))
+        peaks.store(Int64(accumulator.pointee.peak.bitPattern), at: slot)
+        rmsValues.store(Int64(rms.bitPattern), at: slot)
+        accumulator.pointee = Accumulator()
+        publishes.increment()
+    }
+    
+    /// 累计一个 IO 周期的输入
+    ///
+    /// 聚合设备的输入流依次为子设备的输入流与各个 Tap 的流，Tap 排在最后，
+    /// 因此从末尾对齐：最后 `pids.count` 个缓冲区依次对应各槽位。
+    public func accumulate(_ inputData: UnsafePointer<AudioBufferList>) {
+        let buffers = UnsafeMutableAudioBufferListPointer(UnsafeMutablePointer(mutating: inputData))
+        let offset = buffers.count - pids.count
+        for slot in 0..<pids.count {
+            let index = offset + slot
+            guard index >= 0 else { continue }
+            let buffer = buffers[index]
+            guard let data = buffer.mData else { continue }
+            let count = Int(buffer.mDataByteSize) / MemoryLayout<Float>.size
+            accumulate(slot: slot, samples: data.assumingMemoryBound(to: Float.self), count: count, channels: Int(buffer.mNumberChannels))
+        }
+    }
+    
+    // MARK: - Snapshot
+    
+    /// 所有槽位最近一次发布的电平
+    func snapshot() -> [AudioProcessLevel] {
+        return pids.enumerated().map { slot, pid in
+            AudioProcessLevel(
+                pid: pid,
+                peak: Float(bitPattern: UInt32(truncatingIfNeeded: peaks.load(slot))),
+                rms: Float(bitPattern: UInt32(truncatingIfNeeded: rmsValues.load(slot)))
+            )
+        }
+    }
+    
+    /// 累计发布次数（所有槽位）
+    public var publishCount: Int64 {
+        return publishes.value
+    }
+}
@@ -0,0 +1,212 @@
+import Foundation
+import CoreAudio
+import AudioToolbox
+
+// MARK: - ProcessLevelMonitor
+/// 多进程电平监控 - 为进程选择界面提供每个进程的实时电平
+///
+/// 每个进程一个单进程 Tap，全部挂到同一个私有聚合设备上，只安装一个 IO 回调；
+/// 回调里按 Tap 顺序把各自的缓冲区交给 `ProcessLevelMeter` 计算峰值与 RMS。
+/// 不创建录制器、不写文件、不做格式转换，Tap 关闭漂移补偿以免引入重采样。
+///
+/// 未指定 PID 时监控注册表中的全部可录制进程，进程列表变化时重建 Tap 集合。
+/// `start` / `stop` 可在任意线程调用，与进程列表变化触发的重建一起在私有串行队列上执行。
+@available(macOS 14.4, *)
+final class ProcessLevelMonitor {
+    
+    static let shared = ProcessLevelMonitor()
+    
+    // MARK: - Properties
+    private let logger = Logger.shared
+    private let ioQueue = DispatchQueue(label: "com.audiorecordkit.process-levels", qos: .userInitiated)
+    /// 串行执行 start / stop / 重建
+    private let controlQueue = DispatchQueue(label: "com.audiorecordkit.process-levels.control", qos: .userInitiated)
+    
+    /// meter 由 lock 保护（snapshot 可在任意线程调用）
+    private let lock = NSLock()
+    private var meter: ProcessLevelMeter?
+    
+    /// 以下状态只在 controlQueue 上访问
+    private var tapIDs: [AudioObjectID] = []
+    private var aggregateDeviceID = AudioObjectID(kAudioObjectUnknown)
+    private var ioProcID: AudioDeviceIOProcID?
+    private var requestedPIDs: [pid_t]?
+    private var decimationFrames = ProcessLevelMeter.defaultDecimationFrames
+    private var registryObserverID: Int?
+    
+    private init() {}
+    
+    // MARK: - Public Methods
+    
+    /// 是否正在监控
+    var isRunning: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return meter != nil
+    }
+    
+    /// 开始监控
+    /// - Parameters:
+    ///   - pids: 要监控的进程，nil 表示全部可录制进程（并跟随进程列表变化）
+    ///   - decimationFrames: 统计窗口帧数
+    func start(pids: [pid_t]? = nil, decimationFrames: Int = ProcessLevelMeter.defaultDecimationFrames) throws {
+        try controlQueue.sync {
+            stopMonitoring()
+            requestedPIDs = pids
+            self.decimationFrames = decimationFrames
+            try build()
+            
+            if pids == nil {
+                registryObserverID = AudioProcessRegistry.shared.addObserver { [weak self] _ in
+                    self?.controlQueue.async {
+                        self?.rebuild()
+                    }
+                }
+            }
+        }
+    }
+    
+    /// 停止监控并释放所有 Tap
+    func stop() {
+        controlQueue.sync {
+            stopMonitoring()
+        }
+    }
+    
+    /// 各进程最近一个统计窗口的电平（未监控时为空）
+    func snapshot() -> [AudioProcessLevel] {
+        lock.lock()
+        let current = meter
+        lock.unlock()
+        return current?.snapshot() ?? []
+    }
+    
+    // MARK: - Private Methods (controlQueue)
+    
+    private func stopMonitoring() {
+        if let id = registryObserverID {
+            AudioProcessRegistry.shared.removeObserver(id)
+            registryObserverID = nil
+        }
+        teardown()
+        requestedPIDs = nil
+    }
+    
+    private func rebuild() {
+        // 停止之后才执行的重建请求直接忽略
+        guard registryObserverID != nil else { return }
+        teardown()
+        do {
+            try build()
+        } catch {
+            logger.warning("⚠️ ProcessLevelMonitor: 进程列表变化后重建失败: \(error.localizedDescription)")
+        }
+    }
+    
+    private func build() throws {
+        let registry = AudioProcessRegistry.shared
+        let processes = requestedPIDs.map { $0.compactMap { registry.process(pid: $0) } } ?? registry.processes()
+        guard !processes.isEmpty else {
+            throw NSError(domain: "ProcessLevelMonitor", code: -1, userInfo: [NSLocalizedDescriptionKey: "没有可监控的进程"])
+        }
+        
+        // 1. 每个进程一个立体声混音 Tap
+        var tapUIDs: [String] = []
+        var monitored: [pid_t] = []
+        for process in processes {
+            let description = CATapDescription(stereoMixdownOfProcesses: [AudioObjectID(process.processObjectID)])
+            description.uuid = UUID()
+            description.isPrivate = true
+            description.muteBehavior = .unmuted
+            var tapID = AudioObjectID(kAudioObjectUnknown)
+            let status = AudioHardwareCreateProcessTap(description, &tapID)
+            guard status == noErr, tapID != kAudioObjectUnknown else {
+                logger.warning("⚠️ ProcessLevelMonitor: 无法为 \(process.name) (PID: \(process.pid)) 创建Tap: OSStatus=\(status)")
+                continue
+            }
+            tapIDs.append(tapID)
+            tapUIDs.append(description.uuid.uuidString)
+            monitored.append(process.pid)
+        }
+        guard !tapIDs.isEmpty else {
+            teardown()
+            throw NSError(domain: "ProcessLevelMonitor", code: -2, userInfo: [NSLocalizedDescriptionKey: "所有进程的Tap都创建失败"])
+        }
+        
+        // 2. 所有 Tap 挂到一个私有聚合设备上，以系统默认输出设备为主设备（时钟源）
+        guard let outputID = AggregateDeviceManager.readDefaultSystemOutputDeviceID(),
+              let outputUID = AggregateDeviceManager.readDeviceUID(for: outputID) else {
+            teardown()
+            throw NSError(domain: "ProcessLevelMonitor", code: -3, userInfo: [NSLocalizedDescriptionKey: "无法获取系统默认输出设备"])
+        }
+        let description: [String: Any] = [
+            kAudioAggregateDeviceNameKey: "AudioRecordKit Level Monitor",
+            kAudioAggregateDeviceUIDKey: UUID().uuidString,
+            kAudioAggregateDeviceMainSubDeviceKey: outputUID,
+            kAudioAggregateDeviceIsPrivateKey: true,
+            kAudioAggregateDeviceIsStackedKey: false,
+            kAudioAggregateDeviceTapAutoStartKey: true,
+            kAudioAggregateDeviceSubDeviceListKey: [
+                [kAudioSubDeviceUIDKey: outputUID]
+            ],
+            kAudioAggregateDeviceTapListKey: tapUIDs.map { uid in
+                [kAudioSubTapUIDKey: uid, kAudioSubTapDriftCompensationKey: false] as [String: Any]
+            }
+        ]
+        var deviceID = AudioObjectID(kAudioObjectUnknown)
+        let aggregateStatus = AudioHardwareCreateAggregateDevice(description as CFDictionary, &deviceID)
+        guard aggregateStatus == noErr, deviceID != kAudioObjectUnknown else {
+            teardown()
+            throw NSError(domain: NSOSStatusErrorDomain, code: Int(aggregateStatus), userInfo: [NSLocalizedDescriptionKey: "聚合设备创建失败"])
+        }
+        aggregateDeviceID = deviceID
+        
+        // 3. 单个 IO 回调：只做电平累计
+        let levelMeter = ProcessLevelMeter(pids: monitored, decimationFrames: decimationFrames)
+        var procID: AudioDeviceIOProcID?
+        let createStatus = AudioDeviceCreateIOProcIDWithBlock(&procID, deviceID, ioQueue) { _, inputData, _, _, _ in
+            levelMeter.accumulate(inputData)
+        }
+        guard createStatus == noErr, let procID = procID else {
+            teardown()
+            throw NSError(domain: NSOSStatusErrorDomain, code: Int(createStatus), userInfo: [NSLocalizedDescriptionKey: "IO回调创建失败"])
+        }
+        ioProcID = procID
+        
+        let startStatus = AudioDeviceStart(deviceID, procID)
+        guard startStatus == noErr else {
+            teardown()
+            throw NSError(domain: NSOSStatusErrorDomain, code: Int(startStatus), userInfo: [NSLocalizedDescriptionKey: "聚合设备启动失败"])
+        }
+        
+        lock.lock()
+        meter = levelMeter
+        lock.unlock()
+        logger.info("📶 ProcessLevelMonitor: 开始监控 \(monitored.count) 个进程的电平")
+    }
+    
+    private func teardown() {
+        lock.lock()
+        let wasRunning = meter != nil
+        meter = nil
+        lock.unlock()
+        
+        if let procID = ioProcID {
+            AudioDeviceStop(aggregateDeviceID, procID)
+            AudioDeviceDestroyIOProcID(aggregateDeviceID, procID)
+            ioProcID = nil
+        }
+        if aggregateDeviceID != kAudioObjectUnknown {
+            AudioHardwareDestroyAggregateDevice(aggregateDeviceID)
+            aggregateDeviceID = AudioObjectID(kAudioObjectUnknown)
+        }
+        for tapID in tapIDs {
+            AudioHardwareDestroyProcessTap(tapID)
+        }
+        tapIDs.removeAll()
+        
+        if wasRunning {
+            logger.info("📶 ProcessLevelMonitor: 已停止电平监控")
+        }
+    }
+}
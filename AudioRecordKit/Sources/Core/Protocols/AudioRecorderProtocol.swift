@@ -7,6 +7,8 @@ protocol AudioRecorderProtocol: AnyObject {
     
     // MARK: - Properties
     var isRunning: Bool { get }
+    /// 已预热（设备已运行、文件已创建），等待开始写入
+    var isArmed: Bool { get }
     var recordingMode: RecordingMode { get }
     var currentFormat: AudioFormat { get }
     
@@ -17,8 +19,16 @@ protocol AudioRecorderProtocol: AnyObject {
     var onPlaybackComplete: (() -> Void)? { get set }
     
     // MARK: - Recording Methods
+    /// 预热：完成开始录制前的全部准备，之后 startRecording 只打开写入开关
+    func prepareRecording() async throws
     func startRecording()
     func stopRecording()
+    /// 最近一次启动的各阶段耗时
+    var startupTimings: AudioRecordStartupTimings { get }
+    /// 当前会话的内存账户（未建处理图时为 nil）
+    var memoryAccount: MemoryAccount? { get }
+    /// 本录制器的断流 / 溢出监测（计数在每次开始录制时清零，停止后仍可读取）
+    var xruns: XrunMonitor { get }
     
     // MARK: - Playback Methods
     func playRecording(at url: URL)
@@ -29,16 +39,17 @@ protocol AudioRecorderProtocol: AnyObject {
 }
 
 /// 音频录制器基础类
-class BaseAudioRecorder: NSObject, AudioRecorderProtocol {
+@_spi(Benchmarks) public class BaseAudioRecorder: NSObject, AudioRecorderProtocol {
     
     // MARK: - Properties
-    var isRunning = false
+    public internal(set) var isRunning = false
+    var isArmed = false
     let recordingMode: RecordingMode
     private(set) var currentFormat: AudioFormat = .m4a
     
     // Protected properties for subclasses
     var audioFile: AVAudioFile?
-    var outputURL: URL?
+    public internal(set) var outputURL: URL?
     
     // Playback
     private var player: AVAudioPlayer?
@@ -51,6 +62,16 @@ class BaseAudioRecorder: NSObject, AudioRecorderProtocol {
     let fileManager = FileManagerUtils.shared
     let levelMonitor = LevelMonitor()
     
+    // Startup timing（mach_absolute_time）
+    var prepareNanoseconds: UInt64 = 0
+    var startRequestHostTime: UInt64 = 0
+    var writingEnabledHostTime: UInt64 = 0
+    /// 开始写入后第一帧落盘的时间，由录制线程写入
+    let firstFrameHostTime = AtomicInt64()
+    
+    /// 断流 / 溢出监测（传给文件管理器与处理图）
+    let xruns: XrunMonitor
+    
     // MARK: - Callbacks
     var onLevel: ((Float) -> Void)?
     var onStatus: ((String) -> Void)?
@@ -79,18 +100,23 @@ class BaseAudioRecorder: NSObject, AudioRecorderProtocol {
     }
     
     // MARK: - Initialization
-    init(mode: RecordingMode) {
+    public init(mode: RecordingMode) {
         self.recordingMode = mode
+        self.xruns = XrunMonitor(name: mode.rawValue)
         super.init()
         // 不在初始化时设置播放引擎，只在需要时设置
     }
     
     // MARK: - Abstract Methods (to be overridden)
-    func startRecording() {
+    func prepareRecording() async throws {
+        throw AudioRecordError.notSupported("\(recordingMode.rawValue) 模式不支持预热")
+    }
+    
+    public func startRecording() {
         fatalError("Subclasses must implement startRecording()")
     }
     
-    func stopRecording() {
+    public func stopRecording() {
         guard isRunning else {
             logger.warning("没有正在进行的录制")
             return
@@ -127,6 +153,39 @@ class BaseAudioRecorder: NSObject, AudioRecorderProtocol {
         onStatus?("录制已停止")
     }
     
+    // MARK: - Memory
+    /// 子类在构建处理图后返回其会话账户
+    var memoryAccount: MemoryAccount? {
+        return nil
+    }
+    
+    // MARK: - Startup Timing
+    public var startupTimings: AudioRecordStartupTimings {
+        let firstFrame = UInt64(max(firstFrameHostTime.value, 0))
+        return AudioRecordStartupTimings(
+            prepareNanoseconds: prepareNanoseconds,
+            startNanoseconds: BaseAudioRecorder.nanoseconds(from: startRequestHostTime, to: writingEnabledHostTime),
+            firstFrameNanoseconds: BaseAudioRecorder.nanoseconds(from: startRequestHostTime, to: firstFrame)
+        )
+    }
+    
+    /// 开始计时（startRecording 入口调用）
+    func markStartRequested() {
+        startRequestHostTime = mach_absolute_time()
+        writingEnabledHostTime = 0
+        firstFrameHostTime.store(0)
+    }
+    
+    /// 写入开关已打开
+    func markWritingEnabled() {
+        writingEnabledHostTime = mach_absolute_time()
+    }
+    
+    static func nanoseconds(from start: UInt64, to end: UInt64) -> UInt64 {
+        guard start > 0, end > start else { return 0 }
+        return PipelineStats.nanoseconds(fromHostTicks: end - start)
+    }
+    
     // MARK: - Configuration
     func setAudioFormat(_ format: AudioFormat) {
         currentFormat = format
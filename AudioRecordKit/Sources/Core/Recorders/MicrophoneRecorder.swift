@@ -3,72 +3,131 @@ import AVFoundation
 
 /// 麦克风录制器
 @MainActor
-class MicrophoneRecorder: BaseAudioRecorder {
+@_spi(Benchmarks) public class MicrophoneRecorder: BaseAudioRecorder {
     
     // MARK: - Properties
     private let engine = AVAudioEngine()
     private let recordMixer = AVAudioMixerNode()
     private var mixerFormat: AVAudioFormat?
     private var totalFramesWritten: AVAudioFrameCount = 0
-    private var lastStatsLogTime: TimeInterval = 0
+    // 写入开关：预热期间引擎已运行但 Tap 不写文件
+    private let writing = AtomicInt64()
+    // Tap 回调中的限频日志：统计每10秒一次，写入错误前5次之后每秒最多一次
+    private let statsLog = LogSite("mic.stats", perSecond: 0.1)
+    private let writeErrorLog = LogSite("mic.write-error", first: 5, perSecond: 1)
     // 调试用：强制使用PCM(WAV)参数写入，验证输入链路（与输入buffer格式一致，避免编码干扰）
     private let forcePCMForDebug: Bool = true
     
     // MARK: - Initialization
-    override init(mode: RecordingMode) {
+    public override init(mode: RecordingMode) {
         super.init(mode: .microphone)
     }
     
     // MARK: - Recording Implementation
-    override func startRecording() {
+    override func prepareRecording() async throws {
+        guard !isRunning, !isArmed else { return }
+        do {
+            try arm()
+            onStatus?("录制已准备就绪 (麦克风)")
+        } catch {
+            abortStart()
+            throw error
+        }
+    }
+    
+    public override func startRecording() {
         guard !isRunning else {
             logger.warning("录制已在进行中")
             return
         }
+        markStartRequested()
+        
+        if !isArmed {
+            do {
+                try arm()
+            } catch {
+                let errorMsg = "录制启动失败: \(error.localizedDescription)"
+                onStatus?(errorMsg)
+                logger.error("麦克风录制启动失败: \(error.localizedDescription)")
+                abortStart()
+                
+                // Check for permission issues
+                if error.localizedDescription.contains("permission") || 
+                   error.localizedDescription.contains("权限") ||
+                   error.localizedDescription.contains("denied") {
+                    onStatus?("需要麦克风权限才能录制，请在系统设置中允许")
+                }
+                return
+            }
+        }
+        
+        // 引擎已在运行，打开写入开关即可
+        writing.store(1)
+        markWritingEnabled()
+        isArmed = false
+        
+        // Start monitoring
+        levelMonitor.startMonitoring(source: .recording(engine: engine))
+        
+        isRunning = true
+        onStatus?("正在录制麦克风...")
+    }
+    
+    /// 预热：搭图、创建文件、安装 Tap 并启动引擎，写入开关保持关闭
+    private func arm() throws {
+        let begin = mach_absolute_time()
+        writing.store(0)
         
         // 若使用PCM调试写入，强制使用 .wav 扩展名，避免后续读取/播放因扩展名与容器不符报错
         let targetExtension = forcePCMForDebug ? "wav" : currentFormat.fileExtension
         let url = fileManager.getRecordingFileURL(recordingMode: recordingMode, format: targetExtension)
         logger.info("开始录制，模式: \(recordingMode.rawValue), 格式: \(currentFormat.rawValue)")
         
-        do {
-            // 打印可用麦克风输入设备信息，帮助诊断“有缓冲但为静音”的情况
-            logAvailableAudioInputDevices()
-
-            // 1) 搭建图
-            setupAudioEngine()
-            
-            // 2) 使用 inputNode 原生格式创建文件（最稳妥）
-            let inputFormat = engine.inputNode.inputFormat(forBus: 0)
-            try createAudioFileForInput(at: url, inputFormat: inputFormat)
-            
-            // 3) 在 inputNode 安装 tap（旁路抓取麦克风PCM）
-            installMicrophoneRecordingTap()
-            
-            // 4) 启动引擎（确保节点实际输出格式稳定）
-            try startAudioEngine()
-            
-            // Start monitoring
-            levelMonitor.startMonitoring(source: .recording(engine: engine))
-            
-            isRunning = true
-            onStatus?("正在录制麦克风...")
-            
-        } catch {
-            let errorMsg = "录制启动失败: \(error.localizedDescription)"
-            onStatus?(errorMsg)
-            logger.error("麦克风录制启动失败: \(error.localizedDescription)")
-            
-            // Check for permission issues
-            if error.localizedDescription.contains("permission") || 
-               error.localizedDescription.contains("权限") ||
-               error.localizedDescription.contains("denied") {
-                onStatus?("需要麦克风权限才能录制，请在系统设置中允许")
-            }
-        }
+        // 打印可用麦克风输入设备信息，帮助诊断“有缓冲但为静音”的情况
+        logAvailableAudioInputDevices()
+        
+        // 1) 搭建图
+        setupAudioEngine()
+        
+        // 2) 使用 inputNode 原生格式创建文件（最稳妥）
+        let inputFormat = engine.inputNode.inputFormat(forBus: 0)
+        try createAudioFileForInput(at: url, inputFormat: inputFormat)
+        
+        // 3) 在 inputNode 安装 tap（旁路抓取麦克风PCM）
+        installMicrophoneRecordingTap()
+        
+        // 4) 启动引擎（确保节点实际输出格式稳定）
+        try startAudioEngine()
+        
+        isArmed = true
+        prepareNanoseconds = BaseAudioRecorder.nanoseconds(from: begin, to: mach_absolute_time())
+        logger.info("麦克风录制预热完成，耗时: \(String(format: "%.1f", Double(prepareNanoseconds) / 1e6))ms")
+    }
+    
+    /// 启动失败或取消预热：停止引擎
+    private func abortStart() {
+        writing.store(0)
+        isArmed = false
+        engine.inputNode.removeTap(onBus: 0)
+        engine.mainMixerNode.removeTap(onBus: 0)
+        engine.stop()
     }
     
-    override func stopRecording() {
+    public override func stopRecording() {
+        writing.store(0)
+        
+        // 预热后未开始录制：停止引擎并删除空文件
+        if isArmed && !isRunning {
+            abortStart()
+            audioFile = nil
+            if let url = outputURL {
+                try? FileManager.default.removeItem(at: url)
+                outputURL = nil
+            }
+            logger.info("已取消预热的麦克风录制")
+            return
+        }
+        
         // Stop microphone recording specific components
         if isRunning {
             engine.inputNode.removeTap(onBus: 0)
@@ -76,6 +135,9 @@ class MicrophoneRecorder: BaseAudioRecorder {
             engine.stop()
             logger.info("麦克风录制引擎已停止")
         }
+        logger.logSuppressionSummary([writeErrorLog])
+        statsLog.reset()
+        writeErrorLog.reset()
         
         // Call parent implementation
         super.stopRecording()
@@ -100,7 +162,7 @@ class MicrophoneRecorder: BaseAudioRecorder {
         engine.connect(input, to: engine.mainMixerNode, format: inputFormat)
         logger.info("已连接麦克风输入到主混音器")
     }
-
+    
     private func logAvailableAudioInputDevices() {
         let session = AVCaptureDevice.DiscoverySession(
             deviceTypes: [.builtInMicrophone, .externalUnknown],
@@ -128,7 +190,7 @@ class MicrophoneRecorder: BaseAudioRecorder {
         let inputFormat = engine.inputNode.inputFormat(forBus: 0)
         try createAudioFileForInput(at: url, inputFormat: inputFormat)
     }
-
+    
     private func createAudioFileForInput(at url: URL, inputFormat: AVAudioFormat) throws {
         let sampleRate = inputFormat.sampleRate
         let channels = Int(inputFormat.channelCount)
@@ -169,12 +231,18 @@ class MicrophoneRecorder: BaseAudioRecorder {
         input.installTap(onBus: 0, bufferSize: 4096, format: inputFormat) { [weak self] buffer, time in
             guard let self = self, let file = self.audioFile else { return }
             
+            // 预热期间只让引擎运行，不写文件
+            guard self.writing.value != 0 else { return }
+            
             // Write to audio file
             do {
                 try file.write(from: buffer)
+                if self.firstFrameHostTime.value == 0 {
+                    self.firstFrameHostTime.store(Int64(mach_absolute_time()))
+                }
                 self.totalFramesWritten += buffer.frameLength
             } catch {
-                self.logger.error("写入麦克风音频失败: \(error.localizedDescription)")
+                self.logger.log(self.writeErrorLog, .error, "写入麦克风音频失败: \(error.localizedDescription)")
             }
             
             // Calculate and update level
@@ -183,11 +251,7 @@ class MicrophoneRecorder: BaseAudioRecorder {
             // 不再输出每次的电平日志（减少冗余）
             
             // 统计日志：每10秒打印一次累计帧数
-            let now = CFAbsoluteTimeGetCurrent()
-            if now - self.lastStatsLogTime > 10.0 {
-                self.lastStatsLogTime = now
-                logger.info("📊 麦克风录制统计: 累计写入 \(self.totalFramesWritten) 帧")
-            }
+            self.logger.log(self.statsLog, .info, "📊 麦克风录制统计: 累计写入 \(self.totalFramesWritten) 帧")
             Task { @MainActor in self.onLevel?(level) }
         }
         
@@ -210,7 +274,7 @@ class MicrophoneRecorder: BaseAudioRecorder {
         try engine.start()
         logger.info("麦克风录制引擎启动成功")
     }
-
+    
     private func getSafeInputFormat() -> AVAudioFormat {
         let raw = engine.inputNode.inputFormat(forBus: 0)
         let sampleRate = raw.sampleRate
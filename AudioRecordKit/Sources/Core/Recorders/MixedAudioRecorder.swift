@@ -18,18 +18,22 @@ class MixedAudioRecorder: BaseAudioRecorder {
     
     // 麦克风录制组件 (AVAudioEngine)
     private let micEngine = AVAudioEngine()
-    private var micTapCallCount = 0  // 麦克风Tap回调计数器
+    // 麦克风Tap回调的限频日志（每个录制器独立计数）
+    private let micTapLog = LogSite("mic.tap", first: 5, every: 100)
+    private let micWriteLog = LogSite("mic.write", every: 100)
     
     // 音频格式
     private var commonFormat: AudioStreamBasicDescription?
     private var targetSampleRate: Double = 48000.0  // 采样率（动态检测）
     
-    // 混音缓冲区 - 使用环形缓冲区存储麦克风数据
-    private var micRingBuffer: [Float] = []
-    private var maxRingBufferSize = 192000  // 2秒的缓冲区（48000 * 2声道 * 2秒），会根据实际采样率调整
-    private var micWritePosition = 0
-    private var micReadPosition = 0
-    private let bufferLock = NSLock()
+    // 处理图：系统音频(推送源) + 麦克风(环形缓冲源 → 自动增益) → 混音 → 限幅 → 电平表 / 文件写入
+    private var processingGraph: AudioGraph?
+    private var systemSource: PushSourceNode?
+    private var micSource: RingBufferSourceNode?
+    private var micCaptureSource: CallbackCaptureSource?
+    private var writerNode: FileWriterNode?
+    private let systemGain: Float = 0.6
+    private let micGain: Float = 0.4
     
     // 文件管理
     private var audioToolboxFileManager: AudioToolboxFileManager?
@@ -61,50 +65,62 @@ class MixedAudioRecorder: BaseAudioRecorder {
         }
     }
     
+    override var memoryAccount: MemoryAccount? {
+        return processingGraph?.memory
+    }
+    
     // MARK: - Recording Implementation
     
+    override func prepareRecording() async throws {
+        guard !isRunning, !isArmed else { return }
+        do {
+            try await arm()
+            onStatus?("录制已准备就绪 (系统音频 + 麦克风混音)")
+        } catch {
+            abortStart()
+            throw error
+        }
+    }
+    
     override func startRecording() {
         guard !isRunning else {
             logger.warning("录制已在进行中")
             return
         }
+        markStartRequested()
+        
+        // 已预热：只打开写入开关，下一个 IO 周期开始落盘
+        if isArmed {
+            beginWriting()
+            return
+        }
         
         logger.info("🚀 开始融合录音 (系统音频 + 麦克风)")
         
         // 使用 Task 而不是 Task.detached，保持 MainActor 上下文
         Task { @MainActor in
             do {
-                // 1. 设置统一的音频格式
-                try setupCommonAudioFormat()
-                
-                // 2. 创建输出文件
-                try createOutputFile()
-                
-                // 3. 启动麦克风录制 (AVAudioEngine) - 在主线程
-                try startMicrophoneCapture()
-                logger.info("✅ 麦克风引擎已启动，准备启动系统音频捕获...")
-                
-                // 4. 启动系统音频录制 (Process Tap)
-                try await startSystemAudioCapture()
-                
-                isRunning = true
-                onStatus?("正在录制 (系统音频 + 麦克风混音)...")
-                logger.info("✅ 融合录音启动成功")
-                
+                try await arm()
+                beginWriting()
             } catch {
                 let errorMsg = "融合录音启动失败: \(error.localizedDescription)"
                 logger.error(errorMsg)
                 onStatus?(errorMsg)
-                cleanup()
+                abortStart()
             }
         }
     }
     
     override func stopRecording() {
         logger.info("🛑 停止融合录音")
+        let armedOnly = isArmed && !isRunning
+        isArmed = false
         
         // 停止麦克风录制
         stopMicrophoneCapture()
+        logger.logSuppressionSummary([micTapLog, micWriteLog])
+        micTapLog.reset()
+        micWriteLog.reset()
         
         // 停止系统音频录制
         stopSystemAudioCapture()
@@ -116,9 +132,64 @@ class MixedAudioRecorder: BaseAudioRecorder {
         // 清理资源
         cleanup()
         
+        // 预热后未开始录制：删除空的输出文件
+        if armedOnly, let url = outputURL {
+            try? FileManager.default.removeItem(at: url)
+            outputURL = nil
+            logger.info("🗑️ 已取消预热的录制")
+            return
+        }
+        
         super.stopRecording()
     }
     
+    // MARK: - Private Methods - Arming
+    
+    /// 预热：格式、输出文件、处理图、麦克风引擎与 Process Tap 全部就绪，写入开关保持关闭
+    private func arm() async throws {
+        let begin = mach_absolute_time()
+        
+        // 1. 设置统一的音频格式
+        try setupCommonAudioFormat()
+        
+        // 2. 创建输出文件
+        try createOutputFile()
+        
+        // 3. 构建处理图
+        try buildProcessingGraph()
+        
+        // 4. 启动麦克风录制 (AVAudioEngine) - 在主线程
+        try startMicrophoneCapture()
+        logger.info("✅ 麦克风引擎已启动，准备启动系统音频捕获...")
+        
+        // 5. 启动系统音频录制 (Process Tap)
+        try await startSystemAudioCapture()
+        
+        isArmed = true
+        prepareNanoseconds = BaseAudioRecorder.nanoseconds(from: begin, to: mach_absolute_time())
+        logger.info("✅ 融合录音预热完成，耗时: \(String(format: "%.1f", Double(prepareNanoseconds) / 1e6))ms")
+    }
+    
+    /// 打开写入开关（设备已在运行）
+    private func beginWriting() {
+        writerNode?.isWriting = true
+        markWritingEnabled()
+        isArmed = false
+        isRunning = true
+        onStatus?("正在录制 (系统音频 + 麦克风混音)...")
+        logger.info("✅ 融合录音启动成功")
+    }
+    
+    /// 启动失败：停止已启动的设备并释放资源
+    private func abortStart() {
+        isArmed = false
+        stopMicrophoneCapture()
+        stopSystemAudioCapture()
+        audioToolboxFileManager?.closeFile()
+        audioToolboxFileManager = nil
+        cleanup()
+    }
+    
     // MARK: - Private Methods - Setup
     
     private func setupCommonAudioFormat() throws {
@@ -162,12 +233,87 @@ class MixedAudioRecorder: BaseAudioRecorder {
         outputURL = fileURL
         
         // 创建 AudioToolbox 文件管理器
-        audioToolboxFileManager = AudioToolboxFileManager(audioFormat: format)
+        audioToolboxFileManager = AudioToolboxFileManager(audioFormat: format, xruns: xruns)
         try audioToolboxFileManager?.createAudioFile(at: fileURL)
         
         logger.info("📁 创建输出文件: \(fileName)")
     }
     
+    /// 构建混音处理图
+    private func buildProcessingGraph() throws {
+        guard let fileManager = audioToolboxFileManager, let format = commonFormat else {
+            throw NSError(domain: "MixedAudioRecorder", code: -7,
+                         userInfo: [NSLocalizedDescriptionKey: "输出文件未创建"])
+        }
+        
+        let channels = 2
+        let sampleRate = targetSampleRate
+        let maxFrames = AudioGraph.defaultMaxFramesPerQuantum
+        
+        // 开始录制时一次性选择特化管线
+        let pipeline = CapturePipelineFactory.make(CapturePipelineConfiguration(mode: .mixed, fileFormat: format))
+        
+        // 2秒的麦克风缓冲区；超出全局或会话内存预算时缩小，但至少保留 0.25 秒（麦克风 Tap 约每 100ms 写入一次）
+        let memory = EngineMemory.makeSessionAccount(name: "Mixed")
+        let bytesPerFrame = channels * MemoryLayout<Float>.stride
+        let micRingBytes = EngineMemory.grant(requested: Int(sampleRate) * 2 * bytesPerFrame,
+                                              minimum: Int(sampleRate / 4) * bytesPerFrame,
+                                              tag: .rings, what: "麦克风环形缓冲区", session: memory)
+        // 写入队列同样按 2 秒申请，至少 0.25 秒（另留每块记录头的余量）
+        let encodedBytesPerFrame = Int(format.mBytesPerFrame)
+        let writeQueueBytes = EngineMemory.grant(requested: Int(sampleRate) * 2 * encodedBytesPerFrame + 64 * 1024,
+                                                 minimum: Int(sampleRate / 4) * encodedBytesPerFrame + 64 * 1024,
+                                                 tag: .rings, what: "写入队列", session: memory)
+        
+        // 节点缓冲区连续分配在会话内存区中，处理图释放时一次性归还
+        let arena = EngineArena(name: "Mixed", capacity: EngineArena.estimatedCapacity(
+            nodes: 7, channels: channels, maxFrames: maxFrames, extraBytes: micRingBytes + maxFrames * bytesPerFrame))
+        // 节点较少，在 IO 线程上串行执行即可，避免跨线程唤醒开销
+        let graph = AudioGraph(name: "Mixed", sampleRate: sampleRate, maxFramesPerQuantum: maxFrames, workerCount: 0, arena: arena,
+                               xruns: fileManager.xruns, memory: memory)
+        let (system, mic, mixer, meter, writer) = try graph.withArena {
+            let system = graph.add(PushSourceNode(name: "system", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate, pipeline: pipeline))
+            let mic = graph.add(RingBufferSourceNode(name: "mic", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate,
+                                                     capacityFrames: micRingBytes / bytesPerFrame))
+            // 麦克风电平随设备与距离差异很大，混音前先拉到目标电平，再按固定比例与系统音频混合
+            let agc = graph.add(AGCNode(name: "agc", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate))
+            let mixer = graph.add(MixerNode(name: "mixer", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate))
+            let limiter = graph.add(LimiterNode(name: "limiter", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate))
+            let meter = graph.add(MeterNode(name: "meter", channels: channels, maxFrames: maxFrames, sampleRate: sampleRate,
+                                            scale: .linearRMS(sensitivity: 3.0)))
+            // 预热期间设备已运行，写入开关在开始录制时打开
+            let writer = graph.add(FileWriterNode(name: "writer", fileManager: fileManager, pipeline: pipeline, maxFrames: maxFrames, sampleRate: sampleRate,
+                                                  isWriting: false, firstWriteHostTime: firstFrameHostTime, queueBytes: writeQueueBytes))
+            
+            try graph.connect(system, to: mixer)
+            try graph.connect(mic, to: agc)
+            try graph.connect(agc, to: mixer)
+            try graph.connect(mixer, to: limiter)
+            try graph.connect(limiter, to: meter)
+            try graph.connect(limiter, to: writer)
+            try graph.compile()
+            return (system, mic, mixer, meter, writer)
+        }
+        
+        // 混音比例：60% 系统音频 + 40% 麦克风
+        mixer.setGain(systemGain, forInput: 0)
+        mixer.setGain(micGain, forInput: 1)
+        
+        meter.levelPublisher = LevelPublisher { [weak self] level in
+            self?.onLevel?(level)
+        }
+        
+        processingGraph = graph
+        systemSource = system
+        micSource = mic
+        writerNode = writer
+        // 麦克风在 Tap 线程上写入环形缓冲源，回调采集时单独登记
+        micCaptureSource = CallbackCapture.shared.register(name: mic.name, role: .ring, graphName: graph.name,
+                                                           sampleRate: sampleRate, channels: channels, gain: micGain,
+                                                           ringCapacityFrames: mic.capacityFrames)
+        logger.info("🧩 混音处理图已构建: \(Int(sampleRate))Hz, 立体声")
+    }
+    
     // MARK: - System Audio Capture (Process Tap)
     
     private func startSystemAudioCapture() async throws {
@@ -199,21 +345,18 @@ class MixedAudioRecorder: BaseAudioRecorder {
                          userInfo: [NSLocalizedDescriptionKey: "创建聚合设备失败"])
         }
         
-        // 创建音频回调处理器
-        systemAudioCallback = AudioCallbackHandler()
-        
-        // 设置电平回调（重要！否则没有电平显示）
-        systemAudioCallback?.setLevelCallback { [weak self] level in
-            // 注意：这里的电平是系统音频的电平，混音后的电平在 updateLevel 中计算
-            // 但为了有显示，先使用系统音频的电平
-            DispatchQueue.main.async {
-                self?.onLevel?(level)
-            }
+        // 创建音频回调处理器，IO 回调直接驱动处理图（混音、电平与写入都在图中完成）
+        guard let graph = processingGraph, let system = systemSource else {
+            throw NSError(domain: "MixedAudioRecorder", code: -7,
+                         userInfo: [NSLocalizedDescriptionKey: "处理图未构建"])
         }
+        systemAudioCallback = AudioCallbackHandler()
+        systemAudioCallback?.setProcessingGraph(graph, source: system, mixGain: systemGain)
         
-        // 设置自定义回调，将系统音频数据写入缓冲区
-        systemAudioCallback?.setCustomCallback { [weak self] bufferList, frameCount in
-            self?.handleSystemAudioData(bufferList: bufferList, frameCount: frameCount)
+        // 按 Tap 流格式与聚合设备的声道布局协商输入，多声道 Tap 在源节点下混到立体声
+        if let format = tapManager.streamFormat {
+            let layout = ChannelLayout.discover(deviceID: aggManager.deviceID, scope: kAudioObjectPropertyScopeInput, channelCount: Int(format.mChannelsPerFrame))
+            systemAudioCallback?.setInputFormat(format, layout: layout)
         }
         
         // 启动 IO 回调
@@ -233,6 +376,7 @@ class MixedAudioRecorder: BaseAudioRecorder {
         processTapManager?.destroyProcessTap()
         processTapManager = nil
         
+        systemAudioCallback?.clearProcessingGraph()
         systemAudioCallback = nil
         
         logger.info("✅ 系统音频捕获已停止")
@@ -261,11 +405,11 @@ class MixedAudioRecorder: BaseAudioRecorder {
         let bufferSize: AVAudioFrameCount = 4096
         inputNode.installTap(onBus: 0, bufferSize: bufferSize, format: inputFormat) { [weak self] buffer, time in
             guard let self = self else { return }
-            self.micTapCallCount += 1
-            if self.micTapCallCount <= 5 || self.micTapCallCount % 100 == 0 {
-                self.logger.info("🎤 麦克风Tap回调[\(self.micTapCallCount)]: frameLength=\(buffer.frameLength), channels=\(buffer.format.channelCount)")
+            if self.micTapLog.shouldLog() {
+                self.logger.record(self.micTapLog, .info, "🎤 麦克风Tap回调[{}]: frameLength={}, channels={}",
+                                   .int(self.micTapLog.callCount), .uint(buffer.frameLength), .uint(buffer.format.channelCount))
             }
-            self.handleMicrophoneData(buffer: buffer)
+            self.handleMicrophoneData(buffer: buffer, time: time)
         }
         logger.info("⏱️ 在inputNode上安装数据Tap完成，耗时: \(String(format: "%.2f", Date().timeIntervalSince(startTime)))秒")
         
@@ -299,46 +443,16 @@ class MixedAudioRecorder: BaseAudioRecorder {
         }
     }
     
-    // MARK: - Audio Data Handling & Mixing
+    // MARK: - Audio Data Handling
     
-    /// 处理系统音频数据
-    private func handleSystemAudioData(bufferList: UnsafePointer<AudioBufferList>, frameCount: UInt32) {
-        // 调试日志
-        struct CallCounter {
-            static var count = 0
-        }
-        CallCounter.count += 1
-        if CallCounter.count <= 5 {
-            logger.info("🔊 handleSystemAudioData 被调用[\(CallCounter.count)]: frameCount=\(frameCount)")
-        }
-        
-        guard frameCount > 0 else { return }
-        
-        let ablPointer = UnsafePointer<AudioBufferList>(bufferList)
-        let buffer = ablPointer.pointee.mBuffers
-        
-        guard let data = buffer.mData else { 
-            logger.warning("⚠️ 系统音频数据为空")
-            return 
-        }
-        
-        // 将系统音频数据转换为 Float 数组
-        let floatData = data.assumingMemoryBound(to: Float.self)
-        let sampleCount = Int(frameCount * 2)  // 立体声
-        let systemData = Array(UnsafeBufferPointer(start: floatData, count: sampleCount))
-        
-        // 直接混音并写入
-        mixAndWriteAudio(systemData: systemData, frameCount: frameCount)
-    }
-    
-    /// 处理麦克风数据 - 写入环形缓冲区
-    private func handleMicrophoneData(buffer: AVAudioPCMBuffer) {
+    /// 处理麦克风数据 - 写入处理图的环形缓冲源（系统音频由 IO 回调直接推入处理图）
+    private func handleMicrophoneData(buffer: AVAudioPCMBuffer, time: AVAudioTime) {
         guard let channelData = buffer.floatChannelData else { 
             logger.warning("⚠️ 麦克风数据为空，无法处理")
             return 
         }
         
-        let frameCount = buffer.frameLength
+        let frameCount = Int(buffer.frameLength)
         let channelCount = Int(buffer.format.channelCount)
         
         guard frameCount > 0 else {
@@ -346,153 +460,19 @@ class MixedAudioRecorder: BaseAudioRecorder {
             return
         }
         
-        bufferLock.lock()
-        defer { bufferLock.unlock() }
+        guard let micSource = micSource else { return }
         
-        // 确保缓冲区已初始化（根据实际采样率调整大小）
-        if micRingBuffer.isEmpty {
-            // 根据实际采样率计算缓冲区大小：2秒的数据
-            maxRingBufferSize = Int(targetSampleRate) * 2 * 2  // 采样率 * 2声道 * 2秒
-            micRingBuffer = [Float](repeating: 0, count: maxRingBufferSize)
-            logger.info("🎤 环形缓冲区已初始化，大小: \(maxRingBufferSize)（基于\(targetSampleRate)Hz采样率）")
-        }
+        micCaptureSource?.capture(channels: channelData, channelCount: channelCount, frames: frameCount,
+                                  hostTime: time.isHostTimeValid ? time.hostTime : 0,
+                                  sampleTime: time.isSampleTimeValid ? Double(time.sampleTime) : 0)
         
-        // 将麦克风数据写入环形缓冲区
-        for frame in 0..<Int(frameCount) {
-            for channel in 0..<2 {  // 总是写入立体声
-                let sample: Float
-                if channelCount == 1 {
-                    // 单声道：两个声道使用相同数据
-                    sample = channelData[0][frame]
-                } else {
-                    // 立体声：使用对应声道
-                    sample = channelData[min(channel, channelCount - 1)][frame]
-                }
-                
-                micRingBuffer[micWritePosition] = sample
-                micWritePosition = (micWritePosition + 1) % maxRingBufferSize
-            }
-        }
-        
-        let samplesWritten = Int(frameCount) * 2  // 立体声
-        let available = (micWritePosition - micReadPosition + maxRingBufferSize) % maxRingBufferSize
+        // 单声道时两个声道使用相同数据；缓冲区已满时丢弃放不下的部分
+        let written = micSource.write(channels: channelData, channelCount: channelCount, frames: frameCount)
         
         // 每100次回调记录一次状态
-        struct CallCounter {
-            static var count = 0
-        }
-        CallCounter.count += 1
-        if CallCounter.count % 100 == 1 {
-            logger.debug("🎤 写入麦克风数据: 帧数=\(frameCount), 样本=\(samplesWritten), 缓冲区可用=\(available)")
-        }
-    }
-    
-    /// 混音并写入文件
-    private func mixAndWriteAudio(systemData: [Float], frameCount: UInt32) {
-        let sampleCount = systemData.count
-        guard sampleCount > 0 else { 
-            logger.warning("⚠️ 系统音频样本数为0")
-            return 
-        }
-        
-        // 调试日志
-        struct MixCallCounter {
-            static var count = 0
-        }
-        MixCallCounter.count += 1
-        if MixCallCounter.count <= 5 {
-            logger.info("🎵 mixAndWriteAudio 被调用[\(MixCallCounter.count)]: sampleCount=\(sampleCount)")
-        }
-        
-        // 从环形缓冲区读取麦克风数据
-        var micData = [Float](repeating: 0, count: sampleCount)
-        
-        bufferLock.lock()
-        
-        // 初始化环形缓冲区（如果需要）
-        if micRingBuffer.isEmpty {
-            micRingBuffer = [Float](repeating: 0, count: maxRingBufferSize)
-        }
-        
-        // 检查可用数据量
-        let availableSamples = (micWritePosition - micReadPosition + maxRingBufferSize) % maxRingBufferSize
-        
-        if availableSamples >= sampleCount {
-            // 有足够的麦克风数据，读取
-            for i in 0..<sampleCount {
-                micData[i] = micRingBuffer[micReadPosition]
-                micReadPosition = (micReadPosition + 1) % maxRingBufferSize
-            }
-        } else {
-            // 麦克风数据不足，用静音填充
-            logger.debug("⚠️ 麦克风数据不足: 需要\(sampleCount), 可用\(availableSamples)")
-            // micData 已经初始化为0（静音）
-            
-            // 读取可用的数据
-            for i in 0..<min(sampleCount, availableSamples) {
-                micData[i] = micRingBuffer[micReadPosition]
-                micReadPosition = (micReadPosition + 1) % maxRingBufferSize
-            }
-        }
-        
-        bufferLock.unlock()
-        
-        // 混音
-        var mixedData = [Float](repeating: 0, count: sampleCount)
-        for i in 0..<sampleCount {
-            // 混音算法：60% 系统音频 + 40% 麦克风
-            mixedData[i] = systemData[i] * 0.6 + micData[i] * 0.4
-            
-            // 防止削波（clipping）
-            mixedData[i] = max(-1.0, min(1.0, mixedData[i]))
-        }
-        
-        // 写入文件
-        writeToFile(mixedData: mixedData, frameCount: frameCount)
-    }
-    
-    /// 写入混音数据到文件
-    private func writeToFile(mixedData: [Float], frameCount: UInt32) {
-        guard let fileManager = audioToolboxFileManager else { return }
-        
-        // 创建 AudioBufferList
-        var mixedData = mixedData
-        let dataSize = mixedData.count * MemoryLayout<Float>.size
-        
-        mixedData.withUnsafeMutableBytes { rawBufferPointer in
-            guard let baseAddress = rawBufferPointer.baseAddress else { return }
-            
-            let bufferList = AudioBufferList(
-                mNumberBuffers: 1,
-                mBuffers: AudioBuffer(
-                    mNumberChannels: 2,
-                    mDataByteSize: UInt32(dataSize),
-                    mData: baseAddress
-                )
-            )
-            
-            do {
-                try fileManager.writeAudioData(bufferList, frameCount: frameCount)
-            } catch {
-                logger.error("写入音频数据失败: \(error.localizedDescription)")
-            }
-        }
-        
-        // 更新电平显示（在闭包外，避免重叠访问）
-        updateLevel(from: mixedData)
-    }
-    
-    /// 计算并更新电平
-    private func updateLevel(from samples: [Float]) {
-        guard !samples.isEmpty else { return }
-        
-        // 计算 RMS
-        let sumOfSquares = samples.reduce(0) { $0 + $1 * $1 }
-        let rms = sqrt(sumOfSquares / Float(samples.count))
-        let normalizedLevel = min(1.0, rms * 3.0)  // 提高灵敏度
-        
-        DispatchQueue.main.async {
-            self.onLevel?(normalizedLevel)
+        if micWriteLog.shouldLog() {
+            logger.record(micWriteLog, .debug, "🎤 写入麦克风数据: 帧数={}, 写入={}, 缓冲区可用={}",
+                          .int(frameCount), .int(written), .int(micSource.bufferedFrames))
         }
     }
     
@@ -501,8 +481,7 @@ class MixedAudioRecorder: BaseAudioRecorder {
     private func getTargetAppName() -> String? {
         guard let pid = targetPID else { return nil }
         
-        let processes = processEnumerator.getAvailableAudioProcesses()
-        return processes.first(where: { $0.pid == pid })?.name
+        return AudioProcessRegistry.shared.process(pid: pid)?.name
     }
     
     private func resolveProcessObjectIDs() async throws -> [AudioObjectID] {
@@ -530,11 +509,15 @@ class MixedAudioRecorder: BaseAudioRecorder {
     }
     
     private func cleanup() {
-        bufferLock.lock()
-        micRingBuffer.removeAll()
-        micWritePosition = 0
-        micReadPosition = 0
-        bufferLock.unlock()
+        processingGraph?.shutdown()
+        processingGraph = nil
+        systemSource = nil
+        micSource = nil
+        if let micCaptureSource = micCaptureSource {
+            CallbackCapture.shared.unregister(micCaptureSource)
+            self.micCaptureSource = nil
+        }
+        writerNode = nil
     }
 }
 
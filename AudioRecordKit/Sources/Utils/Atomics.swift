@@ -0,0 +1,154 @@
+import Foundation
+import Darwin
+import AudioRecordKitAtomics
+
+// MARK: - AtomicInt64
+/// 无锁 64 位原子整数
+///
+/// 基于 C11 stdatomic（AudioRecordKitAtomics）实现，可在音频回调线程中使用（不加锁、不分配内存）。
+/// 存储单独分配在堆上，保证地址稳定且 8 字节对齐。
+@_spi(Benchmarks) public final class AtomicInt64 {
+    
+    // MARK: - Properties
+    private let storage: UnsafeMutablePointer<Int64>
+    
+    // MARK: - Initialization
+    
+    public init(_ initialValue: Int64 = 0) {
+        storage = UnsafeMutablePointer<Int64>.allocate(capacity: 1)
+        storage.initialize(to: initialValue)
+    }
+    
+    deinit {
+        storage.deallocate()
+    }
+    
+    // MARK: - Public Methods
+    
+    /// 当前值（带内存屏障）
+    public var value: Int64 {
+        return ark_atomic_load_i64(storage)
+    }
+    
+    /// 原子加法，返回相加后的新值
+    @discardableResult
+    public func add(_ delta: Int64) -> Int64 {
+        return ark_atomic_add_i64(storage, delta)
+    }
+    
+    @discardableResult
+    public func increment() -> Int64 {
+        return add(1)
+    }
+    
+    @discardableResult
+    func decrement() -> Int64 {
+        return add(-1)
+    }
+    
+    /// 比较并交换，成功返回 true
+    func compareExchange(expected: Int64, desired: Int64) -> Bool {
+        return ark_atomic_compare_exchange_i64(storage, expected, desired)
+    }
+    
+    /// 原子交换，返回旧值
+    @discardableResult
+    func exchange(_ newValue: Int64) -> Int64 {
+        return ark_atomic_exchange_i64(storage, newValue)
+    }
+    
+    /// 原子写入
+    public func store(_ newValue: Int64) {
+        ark_atomic_store_i64(storage, newValue)
+    }
+    
+    /// 仅当候选值更大时写入（用于最大值统计）
+    func storeMax(_ candidate: Int64) {
+        while true {
+            let current = value
+            if candidate <= current || compareExchange(expected: current, desired: candidate) {
+                return
+            }
+        }
+    }
+}
+
+// MARK: - AtomicInt64Array
+/// 定长无锁原子整数数组（例如处理图节点的依赖计数器）
+final class AtomicInt64Array {
+    
+    // MARK: - Properties
+    let count: Int
+    private let storage: UnsafeMutablePointer<Int64>
+    private let tag: MemoryTag?
+    
+    // MARK: - Initialization
+    
+    /// - Parameter tag: 记账类别（nil 表示不记入引擎内存，例如内存账户自身的计数器）
+    init(count: Int, initialValue: Int64 = 0, tag: MemoryTag? = nil) {
+        self.count = count
+        self.tag = tag
+        if let tag = tag {
+            storage = EngineMemory.allocate(Int64.self, capacity: max(count, 1), tag: tag)
+        } else {
+            storage = UnsafeMutablePointer<Int64>.allocate(capacity: max(count, 1))
+        }
+        storage.initialize(repeating: initialValue, count: max(count, 1))
+    }
+    
+    deinit {
+        if let tag = tag {
+            EngineMemory.deallocate(storage, capacity: max(count, 1), tag: tag)
+        } else {
+            storage.deallocate()
+        }
+    }
+    
+    // MARK: - Public Methods
+    
+    func load(_ index: Int) -> Int64 {
+        return ark_atomic_load_i64(storage + index)
+    }
+    
+    @discardableResult
+    func add(_ delta: Int64, at index: Int) -> Int64 {
+        return ark_atomic_add_i64(storage + index, delta)
+    }
+    
+    func compareExchange(expected: Int64, desired: Int64, at index: Int) -> Bool {
+        return ark_atomic_compare_exchange_i64(storage + index, expected, desired)
+    }
+    
+    /// 原子写入第 index 个元素
+    func store(_ newValue: Int64, at index: Int) {
+        ark_atomic_store_i64(storage + index, newValue)
+    }
+    
+    /// 非原子批量写入，仅可在没有并发访问者时调用（例如每个量子开始前的重置）
+    func resetUnsynchronized(_ values: UnsafeBufferPointer<Int64>) {
+        for i in 0..<min(count, values.count) {
+            storage[i] = values[i]
+        }
+        ark_atomic_thread_fence()
+    }
+    
+    /// 非原子全部置为同一值，仅可在没有并发访问者时调用
+    func fillUnsynchronized(_ value: Int64) {
+        storage.update(repeating: value, count: count)
+        ark_atomic_thread_fence()
+    }
+}
+
+// MARK: - Float 位模式辅助
+extension AtomicInt64 {
+    
+    /// 以位模式原子写入 Float（用于跨线程发布电平等测量值）
+    func storeFloat(_ newValue: Float) {
+        store(Int64(newValue.bitPattern))
+    }
+    
+    /// 以位模式原子读取 Float
+    var floatValue: Float {
+        return Float(bitPattern: UInt32(truncatingIfNeeded: value))
+    }
+}
@@ -5,7 +5,7 @@ import ScreenCaptureKit
 import CoreAudio
 
 /// 音频工具类
-class AudioUtils {
+@_spi(Benchmarks) public class AudioUtils {
     static let shared = AudioUtils()
     
     private let logger = Logger.shared
@@ -228,69 +228,37 @@ class AudioUtils {
     // MARK: - 音频数据转换工具
     
     /// 转换32位浮点数据为16位整数数据
-    static func convertFloat32ToInt16(bufferList: AudioBufferList, frameCount: UInt32, inputChannels: Int, outputChannels: Int) throws -> Data {
-        guard bufferList.mNumberBuffers == 1 else {
-            throw AudioDataConversionError.unsupportedBufferCount(bufferList.mNumberBuffers)
-        }
-        
-        let buffer = bufferList.mBuffers
-        guard let srcData = buffer.mData else {
+    ///
+    /// 输入可以是交错或非交错（每声道一个缓冲区）的 AudioBufferList，输出为交错 Int16。
+    /// 单声道输入复制到所有输出声道；其余情况按声道序号对应，多出的输出声道保持静音。
+    static func convertFloat32ToInt16(bufferList: UnsafePointer<AudioBufferList>, frameCount: UInt32, outputChannels: Int) throws -> Data {
+        let view = AudioBufferListView()
+        guard view.bind(bufferList) else {
             throw AudioDataConversionError.emptyInputData
         }
         
-        let frameCountInt = Int(frameCount)
-        let totalSamples = Int(buffer.mDataByteSize) / MemoryLayout<Float>.size
+        let inputChannels = view.channelCount
+        let frameCountInt = min(Int(frameCount), view.frameCount)
         
-        Logger.shared.info("🔄 数据转换: 输入声道=\(inputChannels), 输出声道=\(outputChannels), 帧数=\(frameCountInt)")
+        Logger.shared.info("🔄 数据转换: 输入声道=\(inputChannels)\(view.isPlanar && view.bufferCount > 1 ? "(非交错)" : ""), 输出声道=\(outputChannels), 帧数=\(frameCountInt)")
         
         // 创建输出数据缓冲区
         let outputBytesPerFrame = outputChannels * MemoryLayout<Int16>.size
         let outputDataSize = frameCountInt * outputBytesPerFrame
         var outputData = Data(count: outputDataSize)
         
-        let srcFloatData = srcData.assumingMemoryBound(to: Float.self)
-        
         outputData.withUnsafeMutableBytes { outputBytes in
             let dstInt16Data = outputBytes.bindMemory(to: Int16.self)
             
-            if inputChannels == 1 && outputChannels == 2 {
-                // 单声道转立体声
+            for channel in 0..<outputChannels {
+                guard inputChannels == 1 || channel < inputChannels else { continue }
+                let sourceChannel = min(channel, inputChannels - 1)
+                let src = view.channel(sourceChannel)
+                let stride = view.stride(sourceChannel)
                 for frame in 0..<frameCountInt {
-                    if frame < totalSamples {
-                        let monoValue = srcFloatData[frame]
-                        let int16Value = Int16(max(-1.0, min(1.0, monoValue)) * 32767.0)
-                        dstInt16Data[frame * 2] = int16Value      // 左声道
-                        dstInt16Data[frame * 2 + 1] = int16Value  // 右声道
-                    }
+                    let floatValue = src[frame * stride]
+                    dstInt16Data[frame * outputChannels + channel] = Int16(max(-1.0, min(1.0, floatValue)) * 32767.0)
                 }
-                Logger.shared.debug("🔄 单声道转立体声完成")
-            } else if inputChannels == outputChannels {
-                // 声道数匹配：直接转换
-                for frame in 0..<frameCountInt {
-                    for channel in 0..<outputChannels {
-                        let srcIndex = frame * inputChannels + channel
-                        if srcIndex < totalSamples {
-                            let floatValue = srcFloatData[srcIndex]
-                            let int16Value = Int16(max(-1.0, min(1.0, floatValue)) * 32767.0)
-                            dstInt16Data[frame * outputChannels + channel] = int16Value
-                        }
-                    }
-                }
-                Logger.shared.debug("🔄 直接转换完成")
-            } else {
-                // 其他情况：尝试交错格式解析
-                let channelDataSize = min(totalSamples / inputChannels, frameCountInt)
-                for frame in 0..<channelDataSize {
-                    for channel in 0..<min(outputChannels, inputChannels) {
-                        let srcIndex = frame * inputChannels + channel
-                        if srcIndex < totalSamples {
-                            let floatValue = srcFloatData[srcIndex]
-                            let int16Value = Int16(max(-1.0, min(1.0, floatValue)) * 32767.0)
-                            dstInt16Data[frame * outputChannels + channel] = int16Value
-                        }
-                    }
-                }
-                Logger.shared.debug("🔄 交错格式解析完成")
             }
         }
         
@@ -298,111 +266,58 @@ class AudioUtils {
     }
     
     /// 复制音频数据到PCM缓冲区（支持多种格式）
+    ///
+    /// 输入可以是交错或非交错的 Float32 AudioBufferList，按声道布局做上/下混。
     static func copyAudioDataToPCMBuffer(
-        from bufferList: AudioBufferList,
+        from bufferList: UnsafePointer<AudioBufferList>,
         to pcmBuffer: AVAudioPCMBuffer,
         frameCount: UInt32,
-        inputChannels: Int,
         outputChannels: Int
     ) -> Bool {
-        guard bufferList.mNumberBuffers == 1 else {
-            Logger.shared.warning("⚠️ 不支持多缓冲区格式")
+        let view = AudioBufferListView()
+        guard view.bind(bufferList) else {
+            Logger.shared.warning("⚠️ 输入数据为空")
             return false
         }
         
-        let buffer = bufferList.mBuffers
-        guard let srcData = buffer.mData, buffer.mDataByteSize > 0 else {
-            Logger.shared.warning("⚠️ 输入数据为空")
+        let inputChannels = view.channelCount
+        let frameCountInt = min(Int(frameCount), view.frameCount, Int(pcmBuffer.frameCapacity))
+        guard outputChannels > 0, frameCountInt > 0 else {
+            Logger.shared.warning("⚠️ 声道数或帧数无效")
             return false
         }
         
-        let frameCountInt = Int(frameCount)
-        let totalSamples = Int(buffer.mDataByteSize) / MemoryLayout<Float>.size
-        
         Logger.shared.debug("🔄 PCM缓冲区数据复制: 输入声道=\(inputChannels), 输出声道=\(outputChannels), 帧数=\(frameCountInt)")
         
+        // 按声道布局生成上/下混矩阵（单声道→立体声、5.1→立体声等）
+        let matrix = ChannelMixMatrix.standard(
+            from: ChannelLayout(channelCount: inputChannels),
+            to: ChannelLayout(channelCount: outputChannels)
+        )
+        
         if let dstChannelData = pcmBuffer.floatChannelData {
-            // 输出格式是32位浮点
-            let srcFloatData = srcData.assumingMemoryBound(to: Float.self)
-            
-            if inputChannels == 1 && outputChannels == 2 {
-                // 单声道转立体声
-                for frame in 0..<frameCountInt {
-                    if frame < totalSamples {
-                        let monoValue = srcFloatData[frame]
-                        dstChannelData[0][frame] = monoValue  // 左声道
-                        dstChannelData[1][frame] = monoValue  // 右声道
-                    }
-                }
-                Logger.shared.debug("🔄 单声道转立体声完成")
-            } else if inputChannels == outputChannels {
-                // 声道数匹配：直接复制
-                for frame in 0..<frameCountInt {
-                    for channel in 0..<outputChannels {
-                        let srcIndex = frame * inputChannels + channel
-                        if srcIndex < totalSamples {
-                            dstChannelData[channel][frame] = srcFloatData[srcIndex]
-                        }
-                    }
-                }
-                Logger.shared.debug("🔄 直接复制完成")
-            } else {
-                // 其他情况：尝试交错格式解析
-                let channelDataSize = min(totalSamples / inputChannels, frameCountInt)
-                for frame in 0..<channelDataSize {
-                    for channel in 0..<min(outputChannels, inputChannels) {
-                        let srcIndex = frame * inputChannels + channel
-                        if srcIndex < totalSamples {
-                            dstChannelData[channel][frame] = srcFloatData[srcIndex]
-                        }
-                    }
-                }
-                Logger.shared.debug("🔄 交错格式解析完成")
-            }
-            
+            // 输出格式是32位浮点：直接混合到目标声道
+            matrix.apply(view, frames: frameCountInt, into: dstChannelData)
             pcmBuffer.frameLength = UInt32(frameCountInt)
+            Logger.shared.debug("🔄 声道混合完成: \(matrix)")
             return true
             
         } else if let dstChannelData = pcmBuffer.int16ChannelData {
-            // 输出格式是16位整数
-            let srcFloatData = srcData.assumingMemoryBound(to: Float.self)
-            
-            if inputChannels == 1 && outputChannels == 2 {
-                // 单声道转立体声
-                for frame in 0..<frameCountInt {
-                    if frame < totalSamples {
-                        let monoValue = Int16(srcFloatData[frame] * 32767.0)
-                        dstChannelData[0][frame] = monoValue  // 左声道
-                        dstChannelData[1][frame] = monoValue  // 右声道
-                    }
-                }
-                Logger.shared.debug("🔄 单声道转立体声完成")
-            } else if inputChannels == outputChannels {
-                // 声道数匹配：直接转换
-                for frame in 0..<frameCountInt {
-                    for channel in 0..<outputChannels {
-                        let srcIndex = frame * inputChannels + channel
-                        if srcIndex < totalSamples {
-                            dstChannelData[channel][frame] = Int16(srcFloatData[srcIndex] * 32767.0)
-                        }
-                    }
-                }
-                Logger.shared.debug("🔄 直接转换完成")
-            } else {
-                // 其他情况：尝试交错格式解析
-                let channelDataSize = min(totalSamples / inputChannels, frameCountInt)
-                for frame in 0..<channelDataSize {
-                    for channel in 0..<min(outputChannels, inputChannels) {
-                        let srcIndex = frame * inputChannels + channel
-                        if srcIndex < totalSamples {
-                            dstChannelData[channel][frame] = Int16(srcFloatData[srcIndex] * 32767.0)
-                        }
-                    }
-                }
-                Logger.shared.debug("🔄 交错格式解析完成")
+            // 输出格式是16位整数：先混合到临时浮点缓冲区再量化
+            let scratchCount = frameCountInt * outputChannels
+            let scratch = EngineMemory.allocate(Float.self, capacity: scratchCount, tag: .scratch)
+            defer { EngineMemory.deallocate(scratch, capacity: scratchCount, tag: .scratch) }
+            var channelPointers = (0..<outputChannels).map { scratch + $0 * frameCountInt }
+            channelPointers.withUnsafeMutableBufferPointer { pointers in
+                matrix.apply(view, frames: frameCountInt, into: pointers.baseAddress!)
             }
             
+            let convert = DSPKernels.convertInt16.function
+            for channel in 0..<outputChannels {
+                convert(channelPointers[channel], dstChannelData[channel], frameCountInt)
+            }
             pcmBuffer.frameLength = UInt32(frameCountInt)
+            Logger.shared.debug("🔄 声道混合并转换完成: \(matrix)")
             return true
         }
         
@@ -410,25 +325,27 @@ class AudioUtils {
         return false
     }
     
-    /// 计算音频电平（从AudioBufferList）
-    static func calculateAudioLevel(from bufferList: AudioBufferList, frameCount: UInt32) -> (maxLevel: Float, rmsLevel: Float, normalizedLevel: Float) {
-        let buffer = bufferList.mBuffers
-        guard let data = buffer.mData, buffer.mDataByteSize > 0 else {
+    /// 计算音频电平（从已绑定的 AudioBufferList 视图）
+    ///
+    /// 交错与非交错数据都按声道步长直接读取，不做拷贝。
+    public static func calculateAudioLevel(from view: AudioBufferListView, frameCount: UInt32) -> (maxLevel: Float, rmsLevel: Float, normalizedLevel: Float) {
+        let frames = min(Int(frameCount), view.frameCount)
+        guard view.channelCount > 0, frames > 0 else {
             return (0.0, 0.0, 0.0)
         }
         
-        let samples = data.assumingMemoryBound(to: Float.self)
-        let sampleCount = Int(buffer.mDataByteSize) / MemoryLayout<Float>.size
-        
+        let sampleCount = frames * view.channelCount
         var maxLevel: Float = 0.0
         var sumSquares: Float = 0.0
         
-        for i in 0..<sampleCount {
-            let sample = abs(samples[i])
-            if sample > maxLevel {
-                maxLevel = sample
-            }
-            sumSquares += sample * sample
+        for channel in 0..<view.channelCount {
+            var channelMax: Float = 0.0
+            var channelSum: Float = 0.0
+            let stride = vDSP_Stride(view.stride(channel))
+            vDSP_maxmgv(view.channel(channel), stride, &channelMax, vDSP_Length(frames))
+            vDSP_svesq(view.channel(channel), stride, &channelSum, vDSP_Length(frames))
+            maxLevel = max(maxLevel, channelMax)
+            sumSquares += channelSum
         }
         
         // 计算 RMS
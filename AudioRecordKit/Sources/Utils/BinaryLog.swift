@@ -0,0 +1,263 @@
+import Foundation
+import Darwin
+
+// MARK: - LogArgument
+/// 二进制日志参数（定长，不持有引用）
+enum LogArgument {
+    case none
+    case signed(Int64)
+    case unsigned(UInt64)
+    case float(Double)
+    
+    @inline(__always)
+    static func int<T: BinaryInteger>(_ value: T) -> LogArgument {
+        return .signed(Int64(truncatingIfNeeded: value))
+    }
+    
+    @inline(__always)
+    static func uint<T: BinaryInteger>(_ value: T) -> LogArgument {
+        return .unsigned(UInt64(truncatingIfNeeded: value))
+    }
+    
+    @inline(__always)
+    static func double<T: BinaryFloatingPoint>(_ value: T) -> LogArgument {
+        return .float(Double(value))
+    }
+    
+    var formatted: String {
+        switch self {
+        case .none: return ""
+        case .signed(let value): return String(value)
+        case .unsigned(let value): return String(value)
+        case .float(let value): return String(format: "%.3f", value)
+        }
+    }
+}
+
+// MARK: - BinaryLogRecord
+/// 定长日志记录：格式串、源位置都是静态字符串，记录时只拷贝指针
+struct BinaryLogRecord {
+    var hostTime: UInt64
+    var level: LogLevel
+    var format: StaticString
+    var file: StaticString
+    var function: StaticString
+    var line: UInt32
+    var arguments: (LogArgument, LogArgument, LogArgument, LogArgument)
+    /// 限频日志点自上次输出以来抑制的条数
+    var suppressed: Int64 = 0
+    
+    /// 把 `{}` 依次替换为参数
+    func formattedMessage() -> String {
+        let args = [arguments.0, arguments.1, arguments.2, arguments.3]
+        var result = ""
+        var next = 0
+        var remainder = Substring(format.description)
+        while let range = remainder.range(of: "{}") {
+            result += remainder[..<range.lowerBound]
+            result += next < args.count ? args[next].formatted : "{}"
+            next += 1
+            remainder = remainder[range.upperBound...]
+        }
+        result += remainder
+        if suppressed > 0 {
+            result += " (此前抑制 \(suppressed) 条)"
+        }
+        return result
+    }
+}
+
+// MARK: - BinaryLogRing
+/// 单线程写入、后台线程读取的日志环形队列（SPSC）
+///
+/// 队列满时丢弃新记录并计数，不阻塞写入线程。所属线程退出后队列回到空闲列表，
+/// 由下一个领取的线程继续写入（同一时刻仍只有一个写入者）。
+final class BinaryLogRing {
+    
+    static let capacity = 1024
+    
+    private let records = EngineMemory.allocate(BinaryLogRecord.self, capacity: BinaryLogRing.capacity, tag: .diagnostics)
+    private let head = AtomicInt64()
+    private let tail = AtomicInt64()
+    let dropped = AtomicInt64()
+    /// 是否被某个线程持有
+    private let owned = AtomicInt64()
+    
+    /// 由当前线程领取（不加锁、不分配）
+    /// - Returns: 队列已被其他线程持有时为 false
+    func claim() -> Bool {
+        return owned.compareExchange(expected: 0, desired: 1)
+    }
+    
+    /// 归还到空闲列表（线程退出时由 TLS 析构函数调用）
+    func release() {
+        owned.store(0)
+    }
+    
+    var isFree: Bool {
+        return owned.value == 0
+    }
+    
+    deinit {
+        EngineMemory.deallocate(records, capacity: BinaryLogRing.capacity, tag: .diagnostics)
+    }
+    
+    /// 写入一条记录（只由所属线程调用）
+    @inline(__always)
+    func push(_ record: BinaryLogRecord) {
+        let position = tail.value
+        guard position - head.value < Int64(BinaryLogRing.capacity) else {
+            dropped.increment()
+            return
+        }
+        (records + Int(position % Int64(BinaryLogRing.capacity))).initialize(to: record)
+        tail.store(position + 1)
+    }
+    
+    /// 取出全部已发布的记录（只由后台线程调用）
+    func drain(into output: inout [BinaryLogRecord]) {
+        let end = tail.value
+        var position = head.value
+        while position < end {
+            output.append(records[Int(position % Int64(BinaryLogRing.capacity))])
+            position += 1
+        }
+        head.store(position)
+    }
+}
+
+// MARK: - BinaryLog
+/// 热路径日志：按线程分配环形队列，由 Logger 的后台队列定期格式化并写出
+///
+/// 每次记录只做一次 TLS 读取、一次 mach_absolute_time 和一次定长拷贝，不加锁、不分配、
+/// 不格式化。线程第一次记录时从空闲列表领取队列：处理图编译时为渲染线程预留
+/// （`reserveRings(_:)`），实时线程上领取不加锁、不分配；没有空闲队列时才新建并登记。
+/// 线程退出时队列经 TLS 析构函数归还，队列总数不超过同时存活的记录线程数。
+enum BinaryLog {
+    
+    /// 队列总数上限（超出后新线程的记录被丢弃）
+    static let maxRings = 256
+    
+    private static let lock = NSLock()
+    private static var rings: [BinaryLogRing] = []
+    /// 与 rings 相同顺序的无锁视图：先写槽位再发布 slotCount
+    private static let slots: UnsafeMutablePointer<Unmanaged<BinaryLogRing>?> = {
+        let pointer = UnsafeMutablePointer<Unmanaged<BinaryLogRing>?>.allocate(capacity: maxRings)
+        pointer.initialize(repeating: nil, count: maxRings)
+        return pointer
+    }()
+    private static let slotCount = AtomicInt64()
+    private static let ringKey: pthread_key_t = {
+        var key = pthread_key_t()
+        pthread_key_create(&key) { pointer in
+            Unmanaged<BinaryLogRing>.fromOpaque(pointer).takeUnretainedValue().release()
+        }
+        return key
+    }()
+    
+    @inline(__always)
+    static func push(_ record: BinaryLogRecord) {
+        currentRing()?.push(record)
+    }
+    
+    /// 保证至少有 count 个空闲队列（处理图编译时在非实时线程上调用）
+    static func reserveRings(_ count: Int) {
+        RealtimeSafety.check(.lock, "BinaryLog.reserveRings")
+        lock.lock()
+        defer { lock.unlock() }
+        var missing = count - rings.filter { $0.isFree }.count
+        while missing > 0, appendRing() != nil {
+            missing -= 1
+        }
+    }
+    
+    /// 已创建的队列数（空闲与被持有的合计）
+    static var ringCount: Int {
+        return Int(slotCount.value)
+    }
+    
+    /// 取出所有线程的记录（按时间排序）与累计丢弃数
+    static func drain() -> (records: [BinaryLogRecord], dropped: Int64) {
+        RealtimeSafety.check(.lock, "BinaryLog.drain")
+        lock.lock()
+        let snapshot = rings
+        lock.unlock()
+        
+        var records: [BinaryLogRecord] = []
+        var dropped: Int64 = 0
+        for ring in snapshot {
+            ring.drain(into: &records)
+            dropped += ring.dropped.exchange(0)
+        }
+        if snapshot.count > 1 {
+            records.sort { $0.hostTime < $1.hostTime }
+        }
+        return (records, dropped)
+    }
+    
+    @inline(__always)
+    private static func currentRing() -> BinaryLogRing? {
+        if let pointer = pthread_getspecific(ringKey) {
+            return Unmanaged<BinaryLogRing>.fromOpaque(pointer).takeUnretainedValue()
+        }
+        return claimRing()
+    }
+    
+    /// 为当前线程领取空闲队列；没有空闲队列时新建（加锁、分配，只应发生在非实时线程上）
+    private static func claimRing() -> BinaryLogRing? {
+        let count = Int(slotCount.value)
+        for index in 0..<count {
+            guard let ring = slots[index]?.takeUnretainedValue(), ring.claim() else { continue }
+            pthread_setspecific(ringKey, Unmanaged.passUnretained(ring).toOpaque())
+            return ring
+        }
+        
+        RealtimeSafety.check(.lock, "BinaryLog.claimRing")
+        lock.lock()
+        let ring = appendRing()
+        lock.unlock()
+        guard let ring = ring, ring.claim() else { return nil }
+        pthread_setspecific(ringKey, Unmanaged.passUnretained(ring).toOpaque())
+        return ring
+    }
+    
+    /// 新建一个空闲队列（调用方持有锁）
+    private static func appendRing() -> BinaryLogRing? {
+        guard rings.count < maxRings else { return nil }
+        let ring = BinaryLogRing()
+        slots[rings.count] = Unmanaged.passUnretained(ring)
+        rings.append(ring)
+        slotCount.store(Int64(rings.count))
+        return ring
+    }
+}
+
+// MARK: - Logger 热路径
+extension Logger {
+    
+    /// 实时线程可用的日志：格式串中的 `{}` 依次替换为参数，格式化推迟到后台队列
+    ///
+    /// ```swift
+    /// logger.record(.info, "🎧 音频回调[{}]: dataSize={}", .int(count), .uint(size))
+    /// ```
+    @inline(__always)
+    func record(_ level: LogLevel,
+                _ format: StaticString,
+                _ a0: LogArgument = .none,
+                _ a1: LogArgument = .none,
+                _ a2: LogArgument = .none,
+                _ a3: LogArgument = .none,
+                file: StaticString = #fileID,
+                function: StaticString = #function,
+                line: UInt = #line) {
+        BinaryLog.push(BinaryLogRecord(
+            hostTime: mach_absolute_time(),
+            level: level,
+            format: format,
+            file: file,
+            function: function,
+            line: UInt32(truncatingIfNeeded: line),
+            arguments: (a0, a1, a2, a3)
+        ))
+    }
+}
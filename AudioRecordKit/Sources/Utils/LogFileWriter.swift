@@ -0,0 +1,82 @@
+import Foundation
+
+// MARK: - LogFileWriter
+/// 日志文件写入器 - 保持文件句柄打开并缓冲写入
+///
+/// 按日期滚动文件（audiorecord_yyyy-MM-dd.log）；缓冲超过阈值、日期变化或 `flush()`（停止录制、进程退出）时落盘。
+/// 不是线程安全的，只在 Logger 的日志队列上使用。
+final class LogFileWriter {
+    
+    /// 缓冲超过该字节数时立即落盘
+    static let flushThreshold = 64 * 1024
+    
+    // MARK: - Properties
+    private let directory: URL
+    private var handle: FileHandle?
+    private var currentDay = ""
+    private var buffer = Data()
+    
+    private static let dayFormatter: DateFormatter = {
+        let formatter = DateFormatter()
+        formatter.dateFormat = "yyyy-MM-dd"
+        return formatter
+    }()
+    
+    // MARK: - Initialization
+    
+    init(directory: URL) {
+        self.directory = directory
+        buffer.reserveCapacity(LogFileWriter.flushThreshold * 2)
+    }
+    
+    deinit {
+        flush()
+        handle?.closeFile()
+    }
+    
+    // MARK: - Public Methods
+    
+    /// 某一天的日志文件
+    static func fileURL(in directory: URL, for date: Date) -> URL {
+        return directory.appendingPathComponent("audiorecord_\(dayFormatter.string(from: date)).log")
+    }
+    
+    /// 追加一行（不含换行符）
+    func append(_ line: String, date: Date) {
+        let day = LogFileWriter.dayFormatter.string(from: date)
+        if day != currentDay {
+            flush()
+            reopen(day: day, date: date)
+        }
+        buffer.append(contentsOf: line.utf8)
+        buffer.append(0x0A)
+        if buffer.count >= LogFileWriter.flushThreshold {
+            flush()
+        }
+    }
+    
+    /// 把缓冲写入文件
+    func flush() {
+        guard !buffer.isEmpty else { return }
+        handle?.write(buffer)
+        buffer.removeAll(keepingCapacity: true)
+    }
+    
+    // MARK: - Private Methods
+    
+    private func reopen(day: String, date: Date) {
+        handle?.closeFile()
+        handle = nil
+        currentDay = day
+        let url = LogFileWriter.fileURL(in: directory, for: date)
+        if !FileManager.default.fileExists(atPath: url.path) {
+            FileManager.default.createFile(atPath: url.path, contents: nil)
+        }
+        guard let fileHandle = try? FileHandle(forWritingTo: url) else {
+            Logger.fallback("❌ 无法打开日志文件: \(url.path)")
+            return
+        }
+        fileHandle.seekToEndOfFile()
+        handle = fileHandle
+    }
+}
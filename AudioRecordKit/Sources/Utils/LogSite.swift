@@ -0,0 +1,171 @@
+import Foundation
+import Darwin
+
+// MARK: - LogSite
+/// 限频日志点 - 每个调用点一个实例，状态全部是原子量，可在多个线程上并发判断
+///
+/// 三种策略可以组合：
+/// - `first`：前 N 次调用全部输出；
+/// - `every`：之后每 N 次调用输出一次（第 first + N、first + 2N … 次）；
+/// - `perSecond`：无论上述条件如何，输出频率不超过每秒 X 次。
+///
+/// `first` 与 `every` 都为 0 时只受 `perSecond` 限制。被跳过的调用计入抑制数，
+/// 下一次输出时附带"此前抑制 N 条"。
+///
+/// 实例应随会话（录制器、回调处理器）创建，不同会话互不影响：
+/// ```swift
+/// private let callbackLog = LogSite("io.callback", first: 5, every: 100)
+/// if callbackLog.shouldLog() { logger.record(callbackLog, .info, "🎧 回调[{}]", .int(callbackLog.callCount)) }
+/// ```
+final class LogSite {
+    
+    // MARK: - Properties
+    let name: String
+    let first: Int64
+    let every: Int64
+    /// 两次输出之间的最小间隔（mach_absolute_time 单位，0 表示不限）
+    private let minimumIntervalTicks: UInt64
+    
+    private let calls = AtomicInt64()
+    private let emitted = AtomicInt64()
+    private let suppressedTotal = AtomicInt64()
+    private let suppressedSinceLast = AtomicInt64()
+    private let lastEmitTicks = AtomicInt64()
+    
+    private static let ticksPerSecond: Double = {
+        var info = mach_timebase_info_data_t()
+        mach_timebase_info(&info)
+        return 1e9 * Double(info.denom) / Double(info.numer)
+    }()
+    
+    // MARK: - Initialization
+    
+    /// - Parameters:
+    ///   - name: 日志点名称（用于抑制汇总）
+    ///   - first: 前 N 次全部输出
+    ///   - every: 之后每 N 次输出一次（0 表示之后不再输出；first 与 every 都为 0 时每次都输出）
+    ///   - perSecond: 每秒最多输出次数（0 表示不限）
+    init(_ name: String, first: Int = 0, every: Int = 0, perSecond: Double = 0) {
+        self.name = name
+        self.first = Int64(first)
+        self.every = Int64(every)
+        self.minimumIntervalTicks = perSecond > 0 ? UInt64(LogSite.ticksPerSecond / perSecond) : 0
+    }
+    
+    // MARK: - Decision
+    
+    /// 记一次调用并判断是否输出（实时安全：只有原子操作）
+    @inline(__always)
+    func shouldLog() -> Bool {
+        let n = calls.increment()
+        let selected: Bool
+        if first == 0 && every == 0 {
+            selected = true
+        } else if n <= first {
+            selected = true
+        } else {
+            selected = every > 0 && (n - first) % every == 0
+        }
+        guard selected, admitRate() else {
+            suppressedTotal.increment()
+            suppressedSinceLast.increment()
+            return false
+        }
+        emitted.increment()
+        return true
+    }
+    
+    /// 取出自上次输出以来被抑制的次数（输出时调用）
+    @inline(__always)
+    func takeSuppressed() -> Int64 {
+        return suppressedSinceLast.exchange(0)
+    }
+    
+    @inline(__always)
+    private func admitRate() -> Bool {
+        guard minimumIntervalTicks > 0 else { return true }
+        let now = Int64(bitPattern: mach_absolute_time())
+        let last = lastEmitTicks.value
+        if last != 0 && UInt64(now &- last) < minimumIntervalTicks {
+            return false
+        }
+        // 并发调用只让一个线程通过
+        return lastEmitTicks.compareExchange(expected: last, desired: now)
+    }
+    
+    // MARK: - Counters
+    
+    /// 调用总次数
+    var callCount: Int64 {
+        return calls.value
+    }
+    
+    /// 输出次数
+    var emittedCount: Int64 {
+        return emitted.value
+    }
+    
+    /// 抑制总次数
+    var suppressedCount: Int64 {
+        return suppressedTotal.value
+    }
+    
+    /// 重新开始计数（新一次录制开始时调用）
+    func reset() {
+        calls.store(0)
+        emitted.store(0)
+        suppressedTotal.store(0)
+        suppressedSinceLast.store(0)
+        lastEmitTicks.store(0)
+    }
+    
+    /// 抑制汇总（无抑制时为 nil）
+    var summary: String? {
+        let suppressed = suppressedCount
+        guard suppressed > 0 else { return nil }
+        return "\(name): 调用 \(callCount) 次, 输出 \(emittedCount) 次, 抑制 \(suppressed) 次"
+    }
+}
+
+// MARK: - Logger 限频日志
+extension Logger {
+    
+    /// 限频的热路径日志（调用方先用 `site.shouldLog()` 判断，避免无谓地准备参数）
+    @inline(__always)
+    func record(_ site: LogSite,
+                _ level: LogLevel,
+                _ format: StaticString,
+                _ a0: LogArgument = .none,
+                _ a1: LogArgument = .none,
+                _ a2: LogArgument = .none,
+                _ a3: LogArgument = .none,
+                file: StaticString = #fileID,
+                function: StaticString = #function,
+                line: UInt = #line) {
+        BinaryLog.push(BinaryLogRecord(
+            hostTime: mach_absolute_time(),
+            level: level,
+            format: format,
+            file: file,
+            function: function,
+            line: UInt32(truncatingIfNeeded: line),
+            arguments: (a0, a1, a2, a3),
+            suppressed: site.takeSuppressed()
+        ))
+    }
+    
+    /// 限频的字符串日志（非实时线程）：被抑制时不会构造消息
+    func log(_ site: LogSite, _ level: LogLevel, _ message: @autoclosure () -> String, file: String = #file, function: String = #function, line: Int = #line) {
+        guard site.shouldLog() else { return }
+        let suppressed = site.takeSuppressed()
+        let text = suppressed > 0 ? "\(message()) (此前抑制 \(suppressed) 条)" : message()
+        log(level, text, file: file, function: function, line: line)
+    }
+    
+    /// 输出一组日志点的抑制汇总
+    func logSuppressionSummary(_ sites: [LogSite]) {
+        let lines = sites.compactMap { $0.summary }
+        guard !lines.isEmpty else { return }
+        info("🔇 限频日志汇总: \(lines.joined(separator: "; "))")
+    }
+}
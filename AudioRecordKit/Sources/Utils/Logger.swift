@@ -37,12 +37,17 @@ enum LogLevel: String, CaseIterable {
 }
 
 /// 日志工具类
-class Logger {
-    static let shared = Logger()
+@_spi(Benchmarks) public class Logger {
+    public static let shared = Logger()
     
     private let osLog = OSLog(subsystem: "com.audiorecordmac", category: "AudioRecord")
     private let fileManager = FileManager.default
     private let logQueue = DispatchQueue(label: "com.audiorecordmac.logger", qos: .utility)
+    /// 持久文件句柄与写缓冲（仅在 logQueue 上访问；缓冲满 64KB、停止录制或进程退出时落盘）
+    private lazy var fileWriter = LogFileWriter(directory: logDirectory)
+    /// 定期取出热路径二进制日志（只进入写缓冲，不单独落盘）
+    private var drainTimer: DispatchSourceTimer?
+    private static let drainInterval: DispatchTimeInterval = .milliseconds(100)
     
     private var logDirectory: URL {
         // 使用沙盒容器中的 Documents 目录
@@ -51,16 +56,18 @@ class Logger {
     }
     
     private var logFileURL: URL {
-        let dateFormatter = DateFormatter()
-        dateFormatter.dateFormat = "yyyy-MM-dd"
-        let dateString = dateFormatter.string(from: Date())
-        return logDirectory.appendingPathComponent("audiorecord_\(dateString).log")
+        return LogFileWriter.fileURL(in: logDirectory, for: Date())
     }
     
     private init() {
         // 尝试恢复之前保存的安全作用域书签
         restoreSecurityScopedBookmark()
         setupLogDirectory()
+        startDrainTimer()
+        // 进程退出时写出缓冲中的剩余日志
+        atexit {
+            Logger.shared.flush()
+        }
     }
     
     private func restoreSecurityScopedBookmark() {
@@ -105,34 +112,71 @@ class Logger {
     
     
     /// 记录日志
+    ///
+    /// 调用方只捕获时间与消息，格式化、统一日志、stdout 与文件输出都在日志队列上完成。
+    /// 实时线程请使用 `record(_:_:...)`。
     func log(_ level: LogLevel, _ message: String, file: String = #file, function: String = #function, line: Int = #line) {
-        let fileName = URL(fileURLWithPath: file).lastPathComponent
-        let timestamp = DateFormatter.logTimestamp.string(from: Date())
-        let logMessage = "[\(timestamp)] \(level.emoji) [\(level.rawValue)] [\(fileName):\(line)] \(function): \(message)"
+        RealtimeSafety.check(.logging, "Logger.log")
+        let date = Date()
+        logQueue.async { [weak self] in
+            self?.emit(level, message, file: URL(fileURLWithPath: file).lastPathComponent, function: function, line: line, date: date)
+        }
+    }
+    
+    /// 立即取出热路径日志并把文件缓冲落盘
+    func flush() {
+        logQueue.sync {
+            drainBinaryLog()
+            fileWriter.flush()
+        }
+    }
+    
+    // MARK: - Output (logQueue)
+    
+    private func emit(_ level: LogLevel, _ message: String, file: String, function: String, line: Int, date: Date) {
+        let timestamp = DateFormatter.logTimestamp.string(from: date)
+        let logMessage = "[\(timestamp)] \(level.emoji) [\(level.rawValue)] [\(file):\(line)] \(function): \(message)"
         
         // 控制台输出（同时写入统一日志与stdout，便于CLI调试）
         os_log("%{public}@", log: osLog, type: level.osLogType, logMessage)
         print(logMessage)
         
-        // 文件输出
-        logQueue.async { [weak self] in
-            self?.writeToFile(logMessage)
-        }
+        // 文件输出（进入写缓冲，满阈值时整块落盘）
+        fileWriter.append(logMessage, date: date)
     }
     
-    private func writeToFile(_ message: String) {
-        let logEntry = message + "\n"
-        
-        if fileManager.fileExists(atPath: logFileURL.path) {
-            // 追加到现有文件
-            if let fileHandle = try? FileHandle(forWritingTo: logFileURL) {
-                fileHandle.seekToEndOfFile()
-                fileHandle.write(logEntry.data(using: .utf8) ?? Data())
-                fileHandle.closeFile()
-            }
-        } else {
-            // 创建新文件
-            try? logEntry.write(to: logFileURL, atomically: true, encoding: .utf8)
+    /// 日志文件本身不可用时的兜底输出：写统一日志与 stderr，不经过文件缓冲
+    static func fallback(_ message: String) {
+        os_log("%{public}@", log: fallbackLog, type: .error, message)
+        FileHandle.standardError.write(Data((message + "\n").utf8))
+    }
+    
+    private static let fallbackLog = OSLog(subsystem: "com.audiorecordmac", category: "AudioRecord")
+    
+    private func startDrainTimer() {
+        let timer = DispatchSource.makeTimerSource(queue: logQueue)
+        timer.schedule(deadline: .now() + Logger.drainInterval, repeating: Logger.drainInterval)
+        timer.setEventHandler { [weak self] in
+            self?.drainBinaryLog()
+        }
+        timer.resume()
+        drainTimer = timer
+    }
+    
+    /// 格式化热路径日志（按记录时刻换算为墙钟时间）
+    private func drainBinaryLog() {
+        let (records, dropped) = BinaryLog.drain()
+        guard !records.isEmpty || dropped > 0 else { return }
+        let nowDate = Date()
+        let nowTicks = mach_absolute_time()
+        for record in records {
+            let age = nowTicks > record.hostTime ? PipelineStats.nanoseconds(fromHostTicks: nowTicks - record.hostTime) : 0
+            let date = nowDate.addingTimeInterval(-Double(age) / 1e9)
+            let file = URL(fileURLWithPath: record.file.description).lastPathComponent
+            emit(record.level, record.formattedMessage(), file: file, function: record.function.description, line: Int(record.line), date: date)
+        }
+        if dropped > 0 {
+            emit(.warning, "⚠️ 热路径日志队列已满，丢弃 \(dropped) 条", file: "Logger.swift", function: #function, line: #line, date: nowDate)
         }
     }
     
@@ -171,19 +215,19 @@ class Logger {
 
 // MARK: - 便捷方法
 extension Logger {
-    func debug(_ message: String, file: String = #file, function: String = #function, line: Int = #line) {
+    public func debug(_ message: String, file: String = #file, function: String = #function, line: Int = #line) {
         log(.debug, message, file: file, function: function, line: line)
     }
     
-    func info(_ message: String, file: String = #file, function: String = #function, line: Int = #line) {
+    public func info(_ message: String, file: String = #file, function: String = #function, line: Int = #line) {
         log(.info, message, file: file, function: function, line: line)
     }
     
-    func warning(_ message: String, file: String = #file, function: String = #function, line: Int = #line) {
+    public func warning(_ message: String, file: String = #file, function: String = #function, line: Int = #line) {
         log(.warning, message, file: file, function: function, line: line)
     }
     
-    func error(_ message: String, file: String = #file, function: String = #function, line: Int = #line) {
+    public func error(_ message: String, file: String = #file, function: String = #function, line: Int = #line) {
         log(.error, message, file: file, function: function, line: line)
     }
     
@@ -0,0 +1,161 @@
+import XCTest
+@testable import AudioRecordKit
+
+/// 处理图：拓扑排序与连接校验，多线程调度与串行执行的输出必须逐位相同
+@available(macOS 14.4, *)
+final class AudioGraphTests: XCTestCase {
+    
+    private let channels = 2
+    private let framesPerQuantum = 256
+    private let quanta = 64
+    private let branches = 3
+    /// 较低的采样率让每个量子的截止时间足够长，调度抖动不会在测试中触发超时
+    private let sampleRate = 1000.0
+    
+    // MARK: - Fixtures
+    
+    /// 三路环形缓冲源各自经过自动增益后混音、限幅，输出由旁路节点复制出来
+    private func renderBranches(workerCount: Int) throws -> (samples: [Float], workers: Int, overruns: Int64) {
+        let xruns = XrunMonitor(name: "graph-tests", parent: nil)
+        let graph = AudioGraph(name: "AudioGraphTests", sampleRate: sampleRate, maxFramesPerQuantum: framesPerQuantum,
+                               workerCount: workerCount, xruns: xruns)
+        defer { graph.shutdown() }
+        
+        let total = quanta * framesPerQuantum
+        let captured = UnsafeMutablePointer<Float>.allocate(capacity: total * channels)
+        captured.initialize(repeating: 0, count: total * channels)
+        defer { captured.deallocate() }
+        
+        let mixer = graph.add(MixerNode(name: "mixer", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate))
+        var sources: [RingBufferSourceNode] = []
+        for branch in 0..<branches {
+            let source = graph.add(RingBufferSourceNode(name: "source-\(branch)", channels: channels, maxFrames: framesPerQuantum,
+                                                        sampleRate: sampleRate, capacityFrames: framesPerQuantum * 4))
+            let agc = graph.add(AGCNode(name: "agc-\(branch)", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate))
+            try graph.connect(source, to: agc)
+            try graph.connect(agc, to: mixer)
+            sources.append(source)
+        }
+        let limiter = graph.add(LimiterNode(name: "limiter", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate))
+        let tap = graph.add(TapNode(name: "tap", sampleRate: sampleRate) { block, context in
+            let offset = Int(context.sampleTime)
+            for c in 0..<self.channels {
+                (captured + c * total + offset).update(from: block.channel(c), count: block.frameCount)
+            }
+        })
+        try graph.connect(mixer, to: limiter)
+        try graph.connect(limiter, to: tap)
+        try graph.compile()
+        for branch in 0..<branches {
+            mixer.setGain(1.0 / Float(branches), forInput: branch)
+        }
+        
+        let storage = UnsafeMutablePointer<Float>.allocate(capacity: framesPerQuantum * channels)
+        let pointers = UnsafeMutablePointer<UnsafeMutablePointer<Float>>.allocate(capacity: channels)
+        defer {
+            storage.deallocate()
+            pointers.deallocate()
+        }
+        for c in 0..<channels {
+            pointers[c] = storage + c * framesPerQuantum
+        }
+        
+        for quantum in 0..<quanta {
+            for (branch, source) in sources.enumerated() {
+                let amplitude = 0.1 + 0.3 * Float(branch)
+                for c in 0..<channels {
+                    for i in 0..<framesPerQuantum {
+                        let n = Float(quantum * framesPerQuantum + i)
+                        pointers[c][i] = amplitude * sin(n * 0.01 * Float(branch + 1) + Float(c))
+                    }
+                }
+                source.write(channels: pointers, channelCount: channels, frames: framesPerQuantum)
+            }
+            graph.render(frameCount: framesPerQuantum)
+        }
+        
+        let samples = Array(UnsafeBufferPointer(start: captured, count: total * channels))
+        return (samples, graph.workerCount, xruns.count(of: .callbackOverrun))
+    }
+    
+    /// 不渲染的小图（串行、独立的断流监测）
+    private func makeGraph() -> AudioGraph {
+        return AudioGraph(name: "AudioGraphTests.topology", sampleRate: sampleRate, maxFramesPerQuantum: framesPerQuantum,
+                          workerCount: 0, xruns: XrunMonitor(name: "graph-topology-tests", parent: nil))
+    }
+    
+    // MARK: - Topology
+    
+    func testExecutionOrderFollowsEdges() throws {
+        let graph = makeGraph()
+        defer { graph.shutdown() }
+        // 按与数据流相反的顺序加入节点，排序结果不能依赖加入顺序
+        let tap = graph.add(TapNode(name: "tap", sampleRate: sampleRate) { _, _ in })
+        let limiter = graph.add(LimiterNode(name: "limiter", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate))
+        let mixer = graph.add(MixerNode(name: "mixer", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate))
+        let agc = graph.add(AGCNode(name: "agc", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate))
+        let source = graph.add(PushSourceNode(name: "source", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate))
+        try graph.connect(source, to: agc)
+        try graph.connect(agc, to: mixer)
+        try graph.connect(mixer, to: limiter)
+        try graph.connect(limiter, to: tap)
+        try graph.compile()
+        
+        XCTAssertTrue(graph.isCompiled)
+        XCTAssertEqual(graph.executionOrder.map { $0.name }, ["source", "agc", "mixer", "limiter", "tap"])
+        XCTAssertTrue(mixer.inputs.first === agc, "编译后节点的输入应为其上游节点")
+    }
+    
+    func testCycleIsRejected() throws {
+        let graph = makeGraph()
+        defer { graph.shutdown() }
+        let source = graph.add(PushSourceNode(name: "source", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate))
+        let mixer = graph.add(MixerNode(name: "mixer", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate))
+        let limiter = graph.add(LimiterNode(name: "limiter", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate))
+        try graph.connect(source, to: mixer)
+        try graph.connect(mixer, to: limiter)
+        try graph.connect(limiter, to: mixer)
+        
+        XCTAssertThrowsError(try graph.compile()) { error in
+            guard case AudioGraphError.cycleDetected(let names) = error else {
+                return XCTFail("应报告环路，实际为 \(error)")
+            }
+            XCTAssertEqual(Set(names), ["mixer", "limiter"], "环路应只包含环上的节点")
+        }
+        XCTAssertFalse(graph.isCompiled)
+    }
+    
+    func testInvalidConnectionsAreRejected() throws {
+        let graph = makeGraph()
+        defer { graph.shutdown() }
+        let source = graph.add(PushSourceNode(name: "source", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate))
+        let limiter = graph.add(LimiterNode(name: "limiter", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate))
+        let tap = graph.add(TapNode(name: "tap", sampleRate: sampleRate) { _, _ in })
+        let stranger = LimiterNode(name: "stranger", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate)
+        
+        XCTAssertThrowsError(try graph.connect(tap, to: limiter), "输出端节点不能作为上游")
+        XCTAssertThrowsError(try graph.connect(limiter, to: source), "源节点不能有上游")
+        XCTAssertThrowsError(try graph.connect(limiter, to: stranger), "未加入图的节点不能连接")
+        
+        try graph.connect(source, to: limiter)
+        try graph.connect(limiter, to: tap)
+        try graph.compile()
+        XCTAssertThrowsError(try graph.connect(source, to: tap)) { error in
+            guard case AudioGraphError.alreadyCompiled = error else {
+                return XCTFail("编译后连接应报告 alreadyCompiled，实际为 \(error)")
+            }
+        }
+    }
+    
+    // MARK: - Scheduler
+    
+    func testParallelRenderMatchesSerial() throws {
+        let serial = try renderBranches(workerCount: 0)
+        let parallel = try renderBranches(workerCount: 2)
+        XCTAssertEqual(serial.workers, 0)
+        XCTAssertEqual(parallel.workers, 2, "三路并行的图应启用两个工作线程")
+        XCTAssertEqual(parallel.overruns, 0)
+        XCTAssertEqual(serial.samples, parallel.samples, "多线程调度的输出必须与串行执行逐位一致")
+        XCTAssertTrue(serial.samples.contains { $0 != 0 })
+    }
+}
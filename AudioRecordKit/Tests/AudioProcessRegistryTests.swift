@@ -0,0 +1,165 @@
+import XCTest
+import CoreAudio
+@testable import AudioRecordKit
+
+/// 进程注册表：按版本号取增量变化，以及 C API 的单块进程列表布局
+@available(macOS 14.4, *)
+final class AudioProcessRegistryTests: XCTestCase {
+    
+    // MARK: - Fixtures
+    
+    /// 对象 ID 为 3 的倍数的进程不可录制（模拟被过滤的系统进程）
+    private func resolve(_ objectID: AudioObjectID) -> (pid: pid_t, info: AudioProcessInfo?)? {
+        let pid = pid_t(1000 + objectID)
+        guard objectID % 3 != 0 else { return (pid, nil) }
+        return (pid, AudioProcessInfo(pid: pid, name: "Process \(objectID)", bundleID: "com.example.process\(objectID)",
+                                      path: "/Applications/Process\(objectID).app", processObjectID: objectID))
+    }
+    
+    /// 不读取 HAL 的注册表，列表只经 `apply` 更新
+    private func makeRegistry(_ objectIDs: [AudioObjectID]) -> AudioProcessRegistry {
+        let registry = AudioProcessRegistry(listening: false)
+        registry.apply(objectIDs: objectIDs, resolve: resolve)
+        return registry
+    }
+    
+    // MARK: - Changes
+    
+    func testFullListAndUnchangedGeneration() {
+        let registry = AudioProcessRegistry(listening: false)
+        let empty = registry.changes(since: 0)
+        XCTAssertTrue(empty.isFullList)
+        XCTAssertTrue(empty.added.isEmpty)
+        XCTAssertEqual(empty.generation, 0)
+        
+        let change = registry.apply(objectIDs: [1, 2, 3], resolve: resolve)
+        XCTAssertEqual(change?.generation, 1)
+        XCTAssertEqual(Set(change?.added.map { $0.pid } ?? []), [1001, 1002], "不可录制的进程不应出现在变化中")
+        XCTAssertEqual(registry.count, 2)
+        XCTAssertEqual(registry.process(pid: 1002)?.name, "Process 2")
+        XCTAssertNil(registry.process(pid: 1003))
+        
+        let full = registry.changes(since: 0)
+        XCTAssertTrue(full.isFullList)
+        XCTAssertEqual(full.added.map { $0.pid }, [1001, 1002], "完整列表按对象列表顺序排列")
+        XCTAssertEqual(full.generation, 1)
+        
+        XCTAssertNil(registry.apply(objectIDs: [1, 2, 3], resolve: resolve), "列表没有变化时不应推进版本号")
+        let current = registry.changes(since: 1)
+        XCTAssertFalse(current.isFullList)
+        XCTAssertTrue(current.added.isEmpty && current.removedPIDs.isEmpty)
+        XCTAssertEqual(current.generation, 1)
+        XCTAssertTrue(registry.changes(since: 5).added.isEmpty, "调用方的版本号不应晚于当前版本")
+    }
+    
+    func testIncrementalChanges() {
+        let registry = makeRegistry([1, 2, 3])
+        registry.apply(objectIDs: [1, 2, 4], resolve: resolve)
+        registry.apply(objectIDs: [1, 4, 5], resolve: resolve)
+        XCTAssertEqual(registry.generation, 3)
+        
+        let delta = registry.changes(since: 1)
+        XCTAssertFalse(delta.isFullList)
+        XCTAssertEqual(delta.generation, 3)
+        XCTAssertEqual(Set(delta.added.map { $0.pid }), [1004, 1005])
+        XCTAssertEqual(delta.removedPIDs, [1002], "被过滤的进程退出时不应报告移除")
+        
+        let latest = registry.changes(since: 2)
+        XCTAssertEqual(latest.added.map { $0.pid }, [1005])
+        XCTAssertEqual(latest.removedPIDs, [1002])
+        XCTAssertEqual(registry.processes().map { $0.pid }, [1001, 1004, 1005])
+    }
+    
+    func testAddedThenRemovedIsReportedAsRemoval() {
+        let registry = makeRegistry([1])
+        registry.apply(objectIDs: [1, 2], resolve: resolve)
+        registry.apply(objectIDs: [1], resolve: resolve)
+        
+        let delta = registry.changes(since: 1)
+        XCTAssertTrue(delta.added.isEmpty, "期间出现又退出的进程不应作为新增返回")
+        XCTAssertEqual(delta.removedPIDs, [1002])
+    }
+    
+    func testTooOldGenerationReturnsFullList() {
+        let registry = makeRegistry([1])
+        // 超过变化记录容量的版本数
+        for round in 0..<70 {
+            registry.apply(objectIDs: round % 2 == 0 ? [1, 2] : [1], resolve: resolve)
+        }
+        XCTAssertEqual(registry.generation, 71)
+        
+        let delta = registry.changes(since: 1)
+        XCTAssertTrue(delta.isFullList, "变化记录已不覆盖请求的版本时应返回完整列表")
+        XCTAssertEqual(delta.added.map { $0.pid }, [1001])
+        XCTAssertTrue(delta.removedPIDs.isEmpty)
+        
+        let recent = registry.changes(since: 69)
+        XCTAssertFalse(recent.isFullList)
+        XCTAssertTrue(recent.added.isEmpty)
+        XCTAssertEqual(recent.removedPIDs, [1002])
+    }
+    
+    // MARK: - Packed C List
+    
+    func testPackedProcessListLayout() throws {
+        // 与 AudioRecordSDK.h 中的 C 结构体一致（64 位）
+        XCTAssertEqual(MemoryLayout<CAudioProcessInfo>.offset(of: \.pid), 0)
+        XCTAssertEqual(MemoryLayout<CAudioProcessInfo>.offset(of: \.name), 8)
+        XCTAssertEqual(MemoryLayout<CAudioProcessInfo>.offset(of: \.bundleID), 16)
+        XCTAssertEqual(MemoryLayout<CAudioProcessInfo>.offset(of: \.path), 24)
+        XCTAssertEqual(MemoryLayout<CAudioProcessInfo>.stride, 32)
+        XCTAssertEqual(MemoryLayout<CAudioProcessList>.offset(of: \.processes), 0)
+        XCTAssertEqual(MemoryLayout<CAudioProcessList>.offset(of: \.count), 8)
+        XCTAssertEqual(MemoryLayout<CAudioProcessList>.offset(of: \.removedCount), 12)
+        XCTAssertEqual(MemoryLayout<CAudioProcessList>.offset(of: \.removedPIDs), 16)
+        XCTAssertEqual(MemoryLayout<CAudioProcessList>.offset(of: \.generation), 24)
+        XCTAssertEqual(MemoryLayout<CAudioProcessList>.offset(of: \.isFullList), 32)
+        XCTAssertEqual(MemoryLayout<CAudioProcessList>.stride, 40)
+        
+        let processes = [
+            AudioProcessInfo(pid: 501, name: "Music", bundleID: "com.apple.Music", path: "/System/Applications/Music.app"),
+            AudioProcessInfo(pid: 502, name: "会议", bundleID: "", path: "")
+        ]
+        let base = try XCTUnwrap(makePackedProcessList(processes, removedPIDs: [7, 9, 11], generation: 42, isFullList: false))
+        defer { free(base) }
+        let list = base.load(as: CAudioProcessList.self)
+        XCTAssertEqual(list.count, 2)
+        XCTAssertEqual(list.removedCount, 3)
+        XCTAssertEqual(list.generation, 42)
+        XCTAssertFalse(list.isFullList)
+        
+        let infos = try XCTUnwrap(list.processes)
+        XCTAssertEqual(UnsafeMutableRawPointer(infos), base + MemoryLayout<CAudioProcessList>.stride, "进程数组紧跟在列表头之后")
+        XCTAssertEqual(infos[0].pid, 501)
+        XCTAssertEqual(infos[0].name.map { String(cString: $0) }, "Music")
+        XCTAssertEqual(infos[0].bundleID.map { String(cString: $0) }, "com.apple.Music")
+        XCTAssertEqual(infos[0].path.map { String(cString: $0) }, "/System/Applications/Music.app")
+        XCTAssertEqual(infos[1].name.map { String(cString: $0) }, "会议", "非 ASCII 名称应按 UTF-8 保存")
+        XCTAssertEqual(infos[1].bundleID.map { String(cString: $0) }, "", "空字符串也应有指针")
+        
+        let pids = try XCTUnwrap(list.removedPIDs)
+        XCTAssertEqual(Array(UnsafeBufferPointer(start: pids, count: 3)), [7, 9, 11])
+        XCTAssertEqual(UnsafeRawPointer(pids), UnsafeRawPointer(base + MemoryLayout<CAudioProcessList>.stride + 2 * MemoryLayout<CAudioProcessInfo>.stride))
+        
+        // 字符串池在同一块分配内，调用方一次 free 即可释放
+        let stringBytes = processes.reduce(0) { $0 + $1.name.utf8.count + $1.bundleID.utf8.count + $1.path.utf8.count + 3 }
+        let end = UnsafeRawPointer(pids + 3) + stringBytes
+        for info in [infos[0], infos[1]] {
+            for string in [info.name, info.bundleID, info.path] {
+                let pointer = UnsafeRawPointer(try XCTUnwrap(string))
+                XCTAssertGreaterThanOrEqual(pointer, UnsafeRawPointer(pids + 3))
+                XCTAssertLessThan(pointer, end)
+            }
+        }
+    }
+    
+    func testPackedEmptyListHasNilArrays() throws {
+        let base = try XCTUnwrap(makePackedProcessList([], removedPIDs: [], generation: 3, isFullList: true))
+        defer { free(base) }
+        let list = base.load(as: CAudioProcessList.self)
+        XCTAssertEqual(list.count, 0)
+        XCTAssertNil(list.processes)
+        XCTAssertNil(list.removedPIDs)
+        XCTAssertTrue(list.isFullList)
+    }
+}
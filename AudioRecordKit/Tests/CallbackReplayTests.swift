@@ -0,0 +1,101 @@
+import XCTest
+@testable import AudioRecordKit
+
+/// 回调采集与回放：同一采集文件回放两次必须得到逐位相同的输出
+@available(macOS 14.4, *)
+final class CallbackReplayTests: XCTestCase {
+    
+    private let sampleRate = 48000.0
+    private let channels = 2
+    private let framesPerQuantum = 512
+    private let quanta = 200
+    private let ringCapacityFrames = 4096
+    
+    private var directory: URL!
+    
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent("CallbackReplayTests-\(UUID().uuidString)")
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+    }
+    
+    override func tearDownWithError() throws {
+        if let directory = directory {
+            try? FileManager.default.removeItem(at: directory)
+        }
+    }
+    
+    // MARK: - Fixtures
+    
+    /// 采集一段合成的混合录制：每个量子先写一块麦克风、再来一块系统音频
+    private func captureSyntheticMix(to url: URL) throws {
+        let capture = CallbackCapture.shared
+        try capture.start(url: url, compressed: true)
+        let system = capture.register(name: "system", role: .driver, graphName: "ReplayTests", sampleRate: sampleRate,
+                                      channels: channels, gain: 0.6)
+        let mic = capture.register(name: "mic", role: .ring, graphName: "ReplayTests", sampleRate: sampleRate,
+                                   channels: channels, gain: 0.4, ringCapacityFrames: ringCapacityFrames)
+        defer {
+            capture.unregister(system)
+            capture.unregister(mic)
+        }
+        
+        let storage = UnsafeMutablePointer<Float>.allocate(capacity: framesPerQuantum * channels)
+        let pointers = UnsafeMutablePointer<UnsafeMutablePointer<Float>>.allocate(capacity: channels)
+        defer {
+            storage.deallocate()
+            pointers.deallocate()
+        }
+        for c in 0..<channels {
+            pointers[c] = storage + c * framesPerQuantum
+        }
+        
+        var hostTime: UInt64 = 1_000_000
+        let quantumTicks = PipelineStats.hostTicks(fromNanoseconds: UInt64(Double(framesPerQuantum) / sampleRate * 1e9))
+        for quantum in 0..<quanta {
+            let start = quantum * framesPerQuantum
+            fill(pointers, start: start, frequency: 220, amplitude: 0.05)
+            mic.capture(channels: pointers, channelCount: channels, frames: framesPerQuantum, hostTime: hostTime, sampleTime: Double(start))
+            fill(pointers, start: start, frequency: 1000, amplitude: 0.8)
+            system.capture(channels: pointers, channelCount: channels, frames: framesPerQuantum, hostTime: hostTime, sampleTime: Double(start))
+            hostTime += quantumTicks
+        }
+        capture.stop()
+    }
+    
+    private func fill(_ pointers: UnsafeMutablePointer<UnsafeMutablePointer<Float>>, start: Int, frequency: Double, amplitude: Float) {
+        for c in 0..<channels {
+            for i in 0..<framesPerQuantum {
+                let phase = 2 * Double.pi * frequency * Double(start + i) / sampleRate + Double(c)
+                pointers[c][i] = amplitude * Float(sin(phase))
+            }
+        }
+    }
+    
+    // MARK: - Tests
+    
+    func testReplayIsDeterministic() throws {
+        let url = directory.appendingPathComponent("mix.arcb")
+        try captureSyntheticMix(to: url)
+        
+        let replay = try CallbackReplay(url: url)
+        let ring = replay.trace.declarations.first { $0.role == .ring }
+        XCTAssertEqual(ring?.ringCapacityFrames, ringCapacityFrames, "环形缓冲区容量应随源声明写入采集文件")
+        
+        let first = try replay.run(timing: .asFastAsPossible)
+        let second = try CallbackReplay(url: url).run(timing: .asFastAsPossible)
+        XCTAssertEqual(first.frames, Int64(quanta * framesPerQuantum))
+        XCTAssertEqual(first.outputHash, second.outputHash, "相同输入的两次回放输出必须逐位一致")
+        XCTAssertEqual(first.xruns, second.xruns)
+        XCTAssertEqual(first.xruns[.ringUnderrun], 0)
+    }
+    
+    func testReplayDoesNotTouchProcessCounters() throws {
+        let url = directory.appendingPathComponent("counters.arcb")
+        try captureSyntheticMix(to: url)
+        
+        let before = XrunKind.allCases.map { XrunMonitor.shared.count(of: $0) }
+        _ = try CallbackReplay(url: url).run(timing: .asFastAsPossible)
+        let after = XrunKind.allCases.map { XrunMonitor.shared.count(of: $0) }
+        XCTAssertEqual(before, after, "回放在独立的监测上计数，不应改动进程级计数")
+    }
+}
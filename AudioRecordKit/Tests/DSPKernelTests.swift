@@ -0,0 +1,106 @@
+import XCTest
+@testable import AudioRecordKit
+
+/// DSP 内核变体与标量参考实现的交叉校验
+final class DSPKernelTests: XCTestCase {
+    
+    /// 覆盖空输入、小于一个向量的尾部与多个向量宽度的余数
+    private let lengths = [0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 64, 255, 1027]
+    
+    /// 限幅边界、正负零、超出范围与极小值
+    private let edges: [Float] = [1.0, -1.0, 0.0, -0.0, 1.0001, -1.0001, 0.5, -0.5, 2.0, -2.0, 1e-30, -1e-30,
+                                  0.99999, -0.99999, .greatestFiniteMagnitude]
+    
+    private func makeSignal(_ count: Int, phase: Float) -> [Float] {
+        var signal = (0..<count).map { 1.5 * sin(Float($0) * 0.37 + phase) }
+        for (i, value) in edges.enumerated() where i < count {
+            signal[i] = value
+        }
+        return signal
+    }
+    
+    func testEveryKernelHasAScalarReference() {
+        XCTAssertNotNil(DSPKernels.convertInt16.variant(.scalar))
+        XCTAssertNotNil(DSPKernels.multiplyAdd.variant(.scalar))
+        XCTAssertNotNil(DSPKernels.peakSumSquares.variant(.scalar))
+    }
+    
+    func testSelectedVariantIsSupported() {
+        for (kernel, isa) in DSPKernels.selection {
+            XCTAssertTrue(isa.isSupported(on: CPUFeatures.current), "\(kernel) 选中了不可用的变体 \(isa.rawValue)")
+        }
+    }
+    
+    func testConvertInt16MatchesReferenceBitExact() {
+        let kernel = DSPKernels.convertInt16
+        for count in lengths {
+            let source = makeSignal(count, phase: 0)
+            var expected = [Int16](repeating: 0, count: count)
+            kernel.reference(source, &expected, count)
+            for (isa, function) in kernel.supportedVariants {
+                // 末尾多留一个哨兵，检查不会越界写入
+                var actual = [Int16](repeating: 0x5A5A, count: count + 1)
+                function(source, &actual, count)
+                XCTAssertEqual(Array(actual[0..<count]), expected, "\(kernel.name)/\(isa.rawValue) n=\(count)")
+                XCTAssertEqual(actual[count], 0x5A5A, "\(kernel.name)/\(isa.rawValue) n=\(count) 越界写入")
+            }
+        }
+    }
+    
+    func testMultiplyAddMatchesReference() {
+        let kernel = DSPKernels.multiplyAdd
+        for count in lengths {
+            let source = makeSignal(count, phase: 0).map { min(max($0, -4), 4) }
+            let addend = makeSignal(count, phase: 1.3).map { min(max($0, -4), 4) }
+            for gain: Float in [0, 0.6, -1, 1] {
+                var expected = addend
+                kernel.reference(source, gain, &expected, count)
+                for (isa, function) in kernel.supportedVariants {
+                    var actual = addend + [42]
+                    function(source, gain, &actual, count)
+                    for i in 0..<count {
+                        XCTAssertEqual(actual[i], expected[i], accuracy: 1e-6 * max(1, abs(expected[i])),
+                                       "\(kernel.name)/\(isa.rawValue) n=\(count) gain=\(gain) [\(i)]")
+                    }
+                    XCTAssertEqual(actual[count], 42, "\(kernel.name)/\(isa.rawValue) n=\(count) 越界写入")
+                }
+            }
+        }
+    }
+    
+    func testPeakSumSquaresMatchesReference() {
+        let kernel = DSPKernels.peakSumSquares
+        for count in lengths {
+            let source = makeSignal(count, phase: 0.7).map { min(max($0, -4), 4) }
+            let reference = kernel.reference(source, count)
+            for (isa, function) in kernel.supportedVariants {
+                let result = function(source, count)
+                XCTAssertEqual(result.peak, reference.peak, "\(kernel.name)/\(isa.rawValue) n=\(count) peak")
+                XCTAssertEqual(result.sumSquares, reference.sumSquares, accuracy: 1e-4 * max(1, reference.sumSquares),
+                               "\(kernel.name)/\(isa.rawValue) n=\(count) sumSquares")
+            }
+        }
+    }
+    
+    func testUnalignedBuffers() {
+        // 从奇数偏移开始，确认非对齐读写
+        let count = 257
+        let padded = makeSignal(count + 1, phase: 0.2)
+        padded.withUnsafeBufferPointer { buffer in
+            let source = buffer.baseAddress! + 1
+            var expected = [Int16](repeating: 0, count: count)
+            DSPKernels.convertInt16.reference(source, &expected, count)
+            let reference = DSPKernels.peakSumSquares.reference(source, count)
+            for (isa, function) in DSPKernels.convertInt16.supportedVariants {
+                var actual = [Int16](repeating: 0, count: count + 1)
+                actual.withUnsafeMutableBufferPointer { destination in
+                    function(source, destination.baseAddress! + 1, count)
+                }
+                XCTAssertEqual(Array(actual[1...]), expected, "int16/\(isa.rawValue) 非对齐")
+            }
+            for (isa, function) in DSPKernels.peakSumSquares.supportedVariants {
+                XCTAssertEqual(function(source, count).peak, reference.peak, "meter/\(isa.rawValue) 非对齐")
+            }
+        }
+    }
+}
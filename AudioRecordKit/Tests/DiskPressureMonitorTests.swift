@@ -0,0 +1,106 @@
+import XCTest
+@testable import AudioRecordKit
+
+/// 磁盘空间监测：剩余录制时间预测、实测下降速率平滑，以及空间不足时只切换一次溢出文件
+@available(macOS 14.4, *)
+final class DiskPressureMonitorTests: XCTestCase {
+    
+    private var directory: URL!
+    private var savedPolicy = DiskPressurePolicy()
+    
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent("DiskPressureMonitorTests-\(UUID().uuidString)")
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        savedPolicy = DiskPressureMonitor.policy
+    }
+    
+    override func tearDownWithError() throws {
+        DiskPressureMonitor.policy = savedPolicy
+        if let directory = directory {
+            try? FileManager.default.removeItem(at: directory)
+        }
+    }
+    
+    // MARK: - Prediction
+    
+    func testPredictionUsesFreeSpaceAndReserve() {
+        let policy = DiskPressurePolicy(warningSeconds: 600, criticalSeconds: 60)
+        let rate = 1_000_000.0
+        
+        let plenty = DiskPressureMonitor.predict(freeBytes: 1_000_000_000, reserveBytes: 0, bytesPerSecond: rate, policy: policy)
+        XCTAssertEqual(plenty.secondsRemaining, 1000, accuracy: 1e-9)
+        XCTAssertEqual(plenty.level, .normal)
+        
+        let low = DiskPressureMonitor.predict(freeBytes: 300_000_000, reserveBytes: 0, bytesPerSecond: rate, policy: policy)
+        XCTAssertEqual(low.level, .low)
+        let reserved = DiskPressureMonitor.predict(freeBytes: 300_000_000, reserveBytes: 400_000_000, bytesPerSecond: rate, policy: policy)
+        XCTAssertEqual(reserved.secondsRemaining, 700, accuracy: 1e-9, "预留区中未写入的部分也可用于录制")
+        XCTAssertEqual(reserved.level, .normal)
+        
+        let critical = DiskPressureMonitor.predict(freeBytes: 59_000_000, reserveBytes: 0, bytesPerSecond: rate, policy: policy)
+        XCTAssertEqual(critical.level, .critical)
+        XCTAssertEqual(DiskPressureMonitor.predict(freeBytes: 60_000_000, reserveBytes: 0, bytesPerSecond: rate, policy: policy).level, .low,
+                       "恰好等于临界阈值时不算临界")
+        XCTAssertEqual(DiskPressureMonitor.predict(freeBytes: 0, reserveBytes: 0, bytesPerSecond: 0, policy: policy).level, .critical,
+                       "没有可用空间时为临界，速率为 0 也不应除零")
+    }
+    
+    func testObservedDeclineRateIsSmoothed() {
+        // 2 秒内下降 20MB，实测 10MB/s，按 0.2 的系数折入
+        let first = DiskPressureMonitor.smoothedDeclineRate(0, previousFreeBytes: 100_000_000, freeBytes: 80_000_000, seconds: 2)
+        XCTAssertEqual(first, 2_000_000, accuracy: 1e-6)
+        let second = DiskPressureMonitor.smoothedDeclineRate(first, previousFreeBytes: 80_000_000, freeBytes: 60_000_000, seconds: 2)
+        XCTAssertEqual(second, 3_600_000, accuracy: 1e-6)
+        
+        let recovered = DiskPressureMonitor.smoothedDeclineRate(second, previousFreeBytes: 60_000_000, freeBytes: 90_000_000, seconds: 1)
+        XCTAssertEqual(recovered, second * 0.8, accuracy: 1e-6, "空间增加按下降 0 计，速率逐渐回落")
+        
+        // 实测速率高于标称速率时以实测为准（其他进程占用磁盘也会提前报警）
+        let policy = DiskPressurePolicy(warningSeconds: 600, criticalSeconds: 60)
+        let nominal = 100_000.0
+        let observed = 10_000_000.0
+        let prediction = DiskPressureMonitor.predict(freeBytes: 1_000_000_000, reserveBytes: 0,
+                                                     bytesPerSecond: max(nominal, observed), policy: policy)
+        XCTAssertEqual(prediction.secondsRemaining, 100, accuracy: 1e-9)
+        XCTAssertEqual(prediction.level, .low)
+    }
+    
+    // MARK: - Spill
+    
+    func testLowSpaceSpillsOnce() throws {
+        // 任何卷都达不到的警告阈值，第一次检查就判定空间不足
+        DiskPressureMonitor.policy = DiskPressurePolicy(warningSeconds: .greatestFiniteMagnitude, criticalSeconds: 0,
+                                                        preallocationBytes: 0, spillEnabled: true)
+        let fileURL = directory.appendingPathComponent("take.caf")
+        XCTAssertTrue(FileManager.default.createFile(atPath: fileURL.path, contents: nil))
+        let spillURL = directory.appendingPathComponent("take-spill.caf")
+        
+        var spills = 0
+        let monitor = DiskPressureMonitor(fileURL: fileURL, bytesPerSecond: 192_000) {
+            spills += 1
+            return (spillURL, 192_000)
+        }
+        monitor.start()
+        XCTAssertEqual(spills, 1, "start() 同步执行第一次检查")
+        // 定时检查仍为 low，但已经切换过，不应再次调用
+        Thread.sleep(forTimeInterval: 1.5)
+        monitor.stop()
+        XCTAssertEqual(spills, 1, "每次录制只切换一次溢出文件")
+    }
+    
+    func testSpillDisabledByPolicy() throws {
+        DiskPressureMonitor.policy = DiskPressurePolicy(warningSeconds: .greatestFiniteMagnitude, criticalSeconds: 0,
+                                                        preallocationBytes: 0, spillEnabled: false)
+        let fileURL = directory.appendingPathComponent("nospill.caf")
+        XCTAssertTrue(FileManager.default.createFile(atPath: fileURL.path, contents: nil))
+        
+        var spills = 0
+        let monitor = DiskPressureMonitor(fileURL: fileURL, bytesPerSecond: 192_000) {
+            spills += 1
+            return nil
+        }
+        monitor.start()
+        monitor.stop()
+        XCTAssertEqual(spills, 0)
+    }
+}
@@ -0,0 +1,99 @@
+import XCTest
+@testable import AudioRecordKit
+
+/// 会话内存区：缓存行对齐切分、容量不足回退、分配路由，以及关闭 / 整体丢弃后的解除映射时机
+@available(macOS 14.4, *)
+final class EngineArenaTests: XCTestCase {
+    
+    // MARK: - Fixtures
+    
+    private func makeArena(capacity: Int = 64 * 1024) throws -> EngineArena {
+        return try XCTUnwrap(EngineArena(name: "EngineArenaTests", capacity: capacity))
+    }
+    
+    // MARK: - Allocation
+    
+    func testAllocationsAreCacheLineAligned() throws {
+        let arena = try makeArena(capacity: 1000)
+        let line = EngineArena.cacheLineSize
+        XCTAssertEqual(arena.capacity % Int(getpagesize()), 0, "容量按页向上取整")
+        
+        let first = try XCTUnwrap(arena.allocate(byteCount: 3, alignment: 1))
+        let second = try XCTUnwrap(arena.allocate(byteCount: 10, alignment: 8))
+        XCTAssertEqual(Int(bitPattern: first) % line, 0)
+        XCTAssertEqual(Int(bitPattern: second) % line, 0)
+        XCTAssertEqual(first.distance(to: second), line, "小分配之间只隔一个缓存行")
+        XCTAssertEqual(arena.usedBytes, line + 10)
+        
+        XCTAssertNil(arena.allocate(byteCount: arena.capacity, alignment: 16), "容量不足时由调用方回退到堆")
+        XCTAssertEqual(arena.overflowBytes, arena.capacity)
+        XCTAssertEqual(arena.usedBytes, line + 10, "失败的分配不占用空间")
+        
+        XCTAssertTrue(EngineArena.release(first))
+        XCTAssertTrue(EngineArena.release(second))
+        arena.close()
+        XCTAssertFalse(arena.isMapped, "全部归还且关闭后解除映射")
+        XCTAssertFalse(EngineArena.release(first), "解除映射后指针不再属于任何内存区")
+    }
+    
+    func testEngineMemoryRoutesSessionTagsToCurrentArena() throws {
+        let arena = try makeArena()
+        let outside = EngineMemory.allocate(Float.self, capacity: 64, tag: .blocks)
+        XCTAssertEqual(arena.usedBytes, 0, "作用域外的分配不进入内存区")
+        
+        let (block, diagnostics) = arena.withCurrent {
+            (EngineMemory.allocate(Float.self, capacity: 256, tag: .blocks),
+             EngineMemory.allocate(Int64.self, capacity: 16, tag: .diagnostics))
+        }
+        XCTAssertEqual(arena.usedBytes, 256 * MemoryLayout<Float>.stride, "只有会话范围的类别从内存区切分")
+        XCTAssertNil(EngineArena.current, "作用域结束后恢复")
+        
+        EngineMemory.deallocate(outside, capacity: 64, tag: .blocks)
+        EngineMemory.deallocate(diagnostics, capacity: 16, tag: .diagnostics)
+        EngineMemory.deallocate(block, capacity: 256, tag: .blocks)
+        XCTAssertTrue(arena.isMapped, "内存区仍开放")
+        arena.close()
+        XCTAssertFalse(arena.isMapped)
+    }
+    
+    // MARK: - Lifecycle
+    
+    func testCloseWaitsForOutstandingAllocations() throws {
+        let arena = try makeArena()
+        let block = arena.withCurrent { EngineMemory.allocate(Float.self, capacity: 128, tag: .rings) }
+        arena.close()
+        XCTAssertTrue(arena.isMapped, "仍有未归还的分配时保持映射")
+        XCTAssertNil(arena.allocate(byteCount: 16, alignment: 16), "关闭后不再切分")
+        
+        EngineMemory.deallocate(block, capacity: 128, tag: .rings)
+        XCTAssertFalse(arena.isMapped, "最后一个分配归还时解除映射")
+    }
+    
+    func testDropSkipsOwnedBlocksAndKeepsSurvivors() throws {
+        let arena = try makeArena()
+        let (dropped, survivor) = arena.withCurrent {
+            (EngineMemory.allocate(Float.self, capacity: 512, tag: .blocks),
+             EngineMemory.allocate(Float.self, capacity: 512, tag: .scratch))
+        }
+        arena.drop {
+            EngineMemory.deallocate(dropped, capacity: 512, tag: .blocks)
+        }
+        XCTAssertTrue(arena.isMapped, "比处理图活得久的分配仍在使用")
+        
+        EngineMemory.deallocate(survivor, capacity: 512, tag: .scratch)
+        XCTAssertFalse(arena.isMapped, "存活的分配归还后解除映射")
+    }
+    
+    func testDropOfEverythingUnmapsImmediately() throws {
+        let arena = try makeArena()
+        let blocks = arena.withCurrent {
+            (0..<4).map { _ in EngineMemory.allocate(Float.self, capacity: 256, tag: .blocks) }
+        }
+        arena.drop {
+            for block in blocks {
+                EngineMemory.deallocate(block, capacity: 256, tag: .blocks)
+            }
+        }
+        XCTAssertFalse(arena.isMapped)
+    }
+}
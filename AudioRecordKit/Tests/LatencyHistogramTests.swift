@@ -0,0 +1,98 @@
+import XCTest
+@testable import AudioRecordKit
+
+/// 延迟直方图：桶映射的误差界、分位数摘要与基线重置
+@available(macOS 14.4, *)
+final class LatencyHistogramTests: XCTestCase {
+    
+    // MARK: - Fixtures
+    
+    /// 覆盖精确区间、各个 2 的幂边界与上限附近的取值
+    private var probeValues: [UInt64] {
+        var values = Array(UInt64(0)..<64)
+        for exponent in 5..<40 {
+            let power = UInt64(1) << UInt64(exponent)
+            values += [power - 1, power, power + 1, power + power / 3]
+        }
+        values.append(LatencyHistogram.maxTrackableValue)
+        return values
+    }
+    
+    // MARK: - Bucket Math
+    
+    func testSmallValuesAreExact() {
+        for value in UInt64(0)..<32 {
+            let index = LatencyHistogram.index(of: value)
+            XCTAssertEqual(LatencyHistogram.highestEquivalentValue(at: index), Int64(value), "\(value) 以下应逐一计数")
+        }
+        XCTAssertEqual(LatencyHistogram.index(of: 32), LatencyHistogram.index(of: 33), "32 起每个桶覆盖两个值")
+    }
+    
+    func testBucketsBoundRelativeError() {
+        var previousIndex = -1
+        for value in probeValues.sorted() {
+            let index = LatencyHistogram.index(of: value)
+            XCTAssertGreaterThanOrEqual(index, previousIndex, "桶序号应随取值单调不减")
+            XCTAssertLessThan(index, LatencyHistogram.bucketCount)
+            previousIndex = index
+            
+            let highest = LatencyHistogram.highestEquivalentValue(at: index)
+            XCTAssertGreaterThanOrEqual(highest, Int64(value), "桶上界不应小于落入的值 \(value)")
+            XCTAssertLessThanOrEqual(Double(highest - Int64(value)), Double(value) / 16, "\(value) 的相对误差应不超过 1/16")
+        }
+        XCTAssertEqual(LatencyHistogram.index(of: LatencyHistogram.maxTrackableValue), LatencyHistogram.bucketCount - 1)
+        XCTAssertEqual(LatencyHistogram.index(of: UInt64.max), LatencyHistogram.bucketCount - 1, "超出上限的值计入最后一个桶")
+    }
+    
+    // MARK: - Summary
+    
+    func testSummaryOfUniformValues() {
+        let histogram = LatencyHistogram()
+        XCTAssertEqual(histogram.summary().count, 0)
+        for value in 1...1000 {
+            histogram.record(Int64(value))
+        }
+        let summary = histogram.summary()
+        XCTAssertEqual(summary.count, 1000)
+        XCTAssertEqual(summary.mean, 500.5, accuracy: 1e-9)
+        XCTAssertEqual(summary.max, 1000)
+        XCTAssertGreaterThanOrEqual(summary.p50, 500)
+        XCTAssertLessThanOrEqual(Double(summary.p50), 500 * (1 + 1.0 / 16))
+        XCTAssertGreaterThanOrEqual(summary.p99, 990)
+        XCTAssertLessThanOrEqual(summary.p99, 1000)
+        XCTAssertEqual(summary.p999, 1000, "分位数不应超过实际最大值")
+    }
+    
+    func testNegativeAndOversizedValues() {
+        let histogram = LatencyHistogram()
+        histogram.record(-5)
+        histogram.record(0)
+        XCTAssertEqual(histogram.summary().max, 0, "负值按 0 计")
+        XCTAssertEqual(histogram.summary().mean, 0)
+        
+        histogram.record(Int64(LatencyHistogram.maxTrackableValue) * 4)
+        let summary = histogram.summary()
+        XCTAssertEqual(summary.count, 3)
+        XCTAssertEqual(summary.max, Int64(LatencyHistogram.maxTrackableValue) * 4, "最大值按原值记录")
+        XCTAssertEqual(summary.p999, Int64(LatencyHistogram.maxTrackableValue), "超出上限的值在分位数中按上限计")
+    }
+    
+    func testResetStartsFromBaseline() {
+        let histogram = LatencyHistogram()
+        for _ in 0..<100 {
+            histogram.record(1_000_000)
+        }
+        histogram.reset()
+        XCTAssertEqual(histogram.count, 0)
+        XCTAssertEqual(histogram.summary().count, 0, "重置后的摘要不应包含旧样本")
+        
+        for value in [10, 20, 30] as [Int64] {
+            histogram.record(value)
+        }
+        let summary = histogram.summary()
+        XCTAssertEqual(summary.count, 3)
+        XCTAssertEqual(summary.mean, 20, accuracy: 1e-9)
+        XCTAssertEqual(summary.max, 30, "重置应清零最大值")
+        XCTAssertEqual(summary.p50, 20)
+    }
+}
@@ -0,0 +1,126 @@
+import XCTest
+@testable import AudioRecordKit
+
+/// 热路径日志：限频日志点的取舍、环形队列的领取与复用
+@available(macOS 14.4, *)
+final class LoggingTests: XCTestCase {
+    
+    // MARK: - Fixtures
+    
+    private func makeRecord(_ value: Int, of total: Int) -> BinaryLogRecord {
+        return BinaryLogRecord(hostTime: UInt64(value), level: .info, format: "value {} of {}", file: #fileID, function: #function,
+                               line: 1, arguments: (.int(value), .int(total), .none, .none))
+    }
+    
+    /// 在一个新线程上记一条日志并等待线程退出（TLS 析构函数在退出时归还队列）
+    private func logOnExitingThread() {
+        var thread: pthread_t?
+        let status = pthread_create(&thread, nil, { _ in
+            Logger.shared.record(.debug, "LoggingTests thread {}", .uint(pthread_mach_thread_np(pthread_self())))
+            return nil
+        }, nil)
+        XCTAssertEqual(status, 0)
+        if let thread = thread {
+            pthread_join(thread, nil)
+        }
+    }
+    
+    // MARK: - LogSite
+    
+    func testFirstThenEvery() {
+        let site = LogSite("tests.first-every", first: 3, every: 10)
+        var emitted: [Int] = []
+        for call in 1...30 {
+            if site.shouldLog() {
+                emitted.append(call)
+                if call == 13 {
+                    XCTAssertEqual(site.takeSuppressed(), 9, "第 13 次输出应带上第 4 到 12 次的抑制数")
+                }
+            }
+        }
+        XCTAssertEqual(emitted, [1, 2, 3, 13, 23])
+        XCTAssertEqual(site.callCount, 30)
+        XCTAssertEqual(site.emittedCount, 5)
+        XCTAssertEqual(site.suppressedCount, 25)
+        XCTAssertEqual(site.takeSuppressed(), 16, "第 13 次之后抑制的次数")
+        XCTAssertEqual(site.summary, "tests.first-every: 调用 30 次, 输出 5 次, 抑制 25 次")
+    }
+    
+    func testUnlimitedSiteAlwaysLogs() {
+        let site = LogSite("tests.unlimited")
+        for _ in 0..<100 {
+            XCTAssertTrue(site.shouldLog())
+        }
+        XCTAssertEqual(site.suppressedCount, 0)
+        XCTAssertNil(site.summary, "没有抑制时不输出汇总")
+    }
+    
+    func testPerSecondLimitAndReset() {
+        let site = LogSite("tests.per-second", perSecond: 1)
+        XCTAssertTrue(site.shouldLog(), "第一次调用总是输出")
+        for _ in 0..<100 {
+            XCTAssertFalse(site.shouldLog(), "一秒内的后续调用应被抑制")
+        }
+        XCTAssertEqual(site.emittedCount, 1)
+        XCTAssertEqual(site.suppressedCount, 100)
+        
+        site.reset()
+        XCTAssertEqual(site.callCount, 0)
+        XCTAssertNil(site.summary)
+        XCTAssertTrue(site.shouldLog(), "重置后重新开始计时")
+    }
+    
+    // MARK: - BinaryLogRing
+    
+    func testRingClaimIsExclusive() {
+        let ring = BinaryLogRing()
+        XCTAssertTrue(ring.isFree)
+        XCTAssertTrue(ring.claim())
+        XCTAssertFalse(ring.isFree)
+        XCTAssertFalse(ring.claim(), "已被持有的队列不能再次领取")
+        ring.release()
+        XCTAssertTrue(ring.isFree)
+        XCTAssertTrue(ring.claim(), "归还后可由下一个线程领取")
+    }
+    
+    func testRingDropsWhenFullAndReusesSlots() {
+        let ring = BinaryLogRing()
+        let total = BinaryLogRing.capacity + 6
+        for value in 0..<total {
+            ring.push(makeRecord(value, of: total))
+        }
+        XCTAssertEqual(ring.dropped.value, 6, "队列满时丢弃新记录并计数")
+        
+        var records: [BinaryLogRecord] = []
+        ring.drain(into: &records)
+        XCTAssertEqual(records.count, BinaryLogRing.capacity)
+        XCTAssertEqual(records.first?.formattedMessage(), "value 0 of \(total)")
+        XCTAssertEqual(records.last?.formattedMessage(), "value \(BinaryLogRing.capacity - 1) of \(total)")
+        
+        // 取出后槽位回绕复用
+        records.removeAll()
+        for value in 0..<10 {
+            ring.push(makeRecord(value, of: 10))
+        }
+        ring.drain(into: &records)
+        XCTAssertEqual(records.map { $0.hostTime }, (0..<10).map { UInt64($0) })
+        XCTAssertEqual(ring.dropped.value, 6)
+        
+        var suppressed = makeRecord(1, of: 2)
+        suppressed.suppressed = 4
+        XCTAssertEqual(suppressed.formattedMessage(), "value 1 of 2 (此前抑制 4 条)")
+    }
+    
+    // MARK: - BinaryLog
+    
+    func testExitedThreadsReturnTheirRings() {
+        // 先让一个线程领取并归还队列，之后的线程应复用空闲队列而不是新建
+        logOnExitingThread()
+        let before = BinaryLog.ringCount
+        for _ in 0..<20 {
+            logOnExitingThread()
+        }
+        // 留一个余量给并发的后台线程（例如日志队列本身）第一次记录
+        XCTAssertLessThanOrEqual(BinaryLog.ringCount, before + 1, "依次退出的线程应复用同一个队列")
+    }
+}
@@ -0,0 +1,171 @@
+import XCTest
+import AudioToolbox
+@testable import AudioRecordKit
+
+/// 渲染线程上的实时安全检查：录制器形状的处理图在实时线程上渲染时不应有违规
+@available(macOS 14.4, *)
+final class RealtimeSafetyTests: XCTestCase {
+    
+    private let sampleRate = 48000.0
+    private let channels = 2
+    private let framesPerQuantum = 512
+    private let quanta = 400
+    
+    private var directory: URL!
+    
+    override func setUpWithError() throws {
+        try XCTSkipUnless(RealtimeSafety.isEnabled, "实时安全检查只在 Debug 构建中启用")
+        RealtimeSafety.prepare()
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent("RealtimeSafetyTests-\(UUID().uuidString)")
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+    }
+    
+    override func tearDownWithError() throws {
+        if let directory = directory {
+            try? FileManager.default.removeItem(at: directory)
+        }
+    }
+    
+    // MARK: - Fixtures
+    
+    private var fileFormat: AudioStreamBasicDescription {
+        let bytesPerFrame = UInt32(channels * MemoryLayout<Int16>.size)
+        return AudioStreamBasicDescription(
+            mSampleRate: sampleRate,
+            mFormatID: kAudioFormatLinearPCM,
+            mFormatFlags: kAudioFormatFlagIsSignedInteger | kAudioFormatFlagIsPacked,
+            mBytesPerPacket: bytesPerFrame,
+            mFramesPerPacket: 1,
+            mBytesPerFrame: bytesPerFrame,
+            mChannelsPerFrame: UInt32(channels),
+            mBitsPerChannel: 16,
+            mReserved: 0
+        )
+    }
+    
+    /// 与混合录制相同的图：推送源 + 环形缓冲源 → 自动增益 → 混音 → 限幅 → 电平 / 写入
+    private func makeGraph(fileManager: AudioToolboxFileManager, queueBytes: Int, workerCount: Int = 0) throws
+        -> (graph: AudioGraph, system: PushSourceNode, mic: RingBufferSourceNode, writer: FileWriterNode, meter: MeterNode) {
+        let format = fileFormat
+        let pipeline = CapturePipelineFactory.make(CapturePipelineConfiguration(mode: .mixed, fileFormat: format))
+        let graph = AudioGraph(name: "RealtimeSafetyTests", sampleRate: sampleRate, maxFramesPerQuantum: framesPerQuantum, workerCount: workerCount,
+                               xruns: fileManager.xruns)
+        let system = graph.add(PushSourceNode(name: "system", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate, pipeline: pipeline))
+        let mic = graph.add(RingBufferSourceNode(name: "mic", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate,
+                                                 capacityFrames: framesPerQuantum * 8))
+        let agc = graph.add(AGCNode(name: "agc", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate))
+        let mixer = graph.add(MixerNode(name: "mixer", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate))
+        let limiter = graph.add(LimiterNode(name: "limiter", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate))
+        let meter = graph.add(MeterNode(name: "meter", channels: channels, maxFrames: framesPerQuantum, sampleRate: sampleRate,
+                                        scale: .linearRMS(sensitivity: 3.0)))
+        let writer = graph.add(FileWriterNode(name: "writer", fileManager: fileManager, pipeline: pipeline, maxFrames: framesPerQuantum,
+                                              sampleRate: sampleRate, isWriting: false, queueBytes: queueBytes))
+        try graph.connect(system, to: mixer)
+        try graph.connect(mic, to: agc)
+        try graph.connect(agc, to: mixer)
+        try graph.connect(mixer, to: limiter)
+        try graph.connect(limiter, to: meter)
+        try graph.connect(limiter, to: writer)
+        try graph.compile()
+        mixer.setGain(0.6, forInput: 0)
+        mixer.setGain(0.4, forInput: 1)
+        return (graph, system, mic, writer, meter)
+    }
+    
+    /// 在标记为实时的当前线程上渲染，麦克风数据在渲染之间（非实时）写入
+    private func render(_ graph: AudioGraph, system: PushSourceNode, mic: RingBufferSourceNode, quanta: Int) {
+        let samples = framesPerQuantum * channels
+        let interleaved = UnsafeMutablePointer<Float>.allocate(capacity: samples)
+        let planar = UnsafeMutablePointer<Float>.allocate(capacity: samples)
+        let planarChannels = UnsafeMutablePointer<UnsafeMutablePointer<Float>>.allocate(capacity: channels)
+        defer {
+            interleaved.deallocate()
+            planar.deallocate()
+            planarChannels.deallocate()
+        }
+        for i in 0..<samples {
+            interleaved[i] = 0.5 * sin(Float(i) * 0.05)
+            planar[i] = 0.25 * cos(Float(i) * 0.03)
+        }
+        for c in 0..<channels {
+            planarChannels[c] = planar + c * framesPerQuantum
+        }
+        
+        for _ in 0..<quanta {
+            mic.write(channels: planarChannels, channelCount: channels, frames: framesPerQuantum)
+            RealtimeSafety.enterRealtime()
+            system.load(interleaved: interleaved, channels: channels, frames: framesPerQuantum)
+            graph.render(frameCount: framesPerQuantum)
+            RealtimeSafety.exitRealtime()
+        }
+    }
+    
+    private func violationReport() -> String {
+        return RealtimeSafety.violations().map { $0.description }.joined(separator: "\n")
+    }
+    
+    // MARK: - Tests
+    
+    func testRecorderGraphRendersWithoutViolations() throws {
+        let fileManager = AudioToolboxFileManager(audioFormat: fileFormat)
+        let (graph, system, mic, writer, meter) = try makeGraph(fileManager: fileManager, queueBytes: 1 << 20)
+        let levels = AtomicInt64()
+        meter.levelPublisher = LevelPublisher { _ in levels.increment() }
+        try fileManager.createAudioFile(at: directory.appendingPathComponent("async.wav"))
+        
+        // 与预热相同：写入开关关闭时先渲染，再打开开关
+        render(graph, system: system, mic: mic, quanta: 4)
+        writer.isWriting = true
+        RealtimeSafety.reset()
+        
+        render(graph, system: system, mic: mic, quanta: quanta)
+        let count = RealtimeSafety.violationCount
+        
+        graph.shutdown()
+        fileManager.closeFile()
+        XCTAssertEqual(count, 0, "实时线程违规:\n\(violationReport())")
+        XCTAssertEqual(writer.writeErrorCount, 0)
+        XCTAssertEqual(writer.framesWritten, Int64(quanta * framesPerQuantum))
+        
+        // 电平在主线程上送达
+        let delivered = expectation(description: "level")
+        DispatchQueue.main.asyncAfter(deadline: .now() + .milliseconds(100)) {
+            if levels.value > 0 {
+                delivered.fulfill()
+            }
+        }
+        wait(for: [delivered], timeout: 1)
+    }
+    
+    func testSynchronousWriterIsReportedAsFileIO() throws {
+        let fileManager = AudioToolboxFileManager(audioFormat: fileFormat)
+        let (graph, system, mic, writer, _) = try makeGraph(fileManager: fileManager, queueBytes: 0)
+        try fileManager.createAudioFile(at: directory.appendingPathComponent("sync.wav"))
+        writer.isWriting = true
+        RealtimeSafety.reset()
+        
+        render(graph, system: system, mic: mic, quanta: 4)
+        let fileIO = RealtimeSafety.count(of: .fileIO)
+        
+        graph.shutdown()
+        fileManager.closeFile()
+        RealtimeSafety.reset()
+        XCTAssertEqual(fileIO, 4, "渲染线程上的同步写入应逐块记录为文件 IO")
+    }
+    
+    func testParallelGraphDoesNotBlockIOThread() throws {
+        let fileManager = AudioToolboxFileManager(audioFormat: fileFormat)
+        let (graph, system, mic, _, _) = try makeGraph(fileManager: fileManager, queueBytes: 1 << 20, workerCount: 1)
+        XCTAssertEqual(graph.workerCount, 1)
+        render(graph, system: system, mic: mic, quanta: 4)
+        RealtimeSafety.reset()
+        
+        render(graph, system: system, mic: mic, quanta: quanta)
+        let blocking = RealtimeSafety.count(of: .blocking)
+        let count = RealtimeSafety.violationCount
+        
+        graph.shutdown()
+        XCTAssertEqual(blocking, 0, "IO 线程不应等待工作线程")
+        XCTAssertEqual(count, 0, "实时线程违规:\n\(violationReport())")
+    }
+}
@@ -0,0 +1,198 @@
+import XCTest
+@testable import AudioRecordKit
+
+/// 环形缓冲区与声道混合：回绕、满时丢弃、欠载补零，以及标准上/下混系数
+@available(macOS 14.4, *)
+final class RingBufferTests: XCTestCase {
+    
+    private let sampleRate = 48000.0
+    
+    // MARK: - Fixtures
+    
+    /// 逐声道的源数据：第 c 声道第 i 帧为 (start + i) + 1000 * c
+    private final class PlanarSource {
+        let channels: Int
+        let frames: Int
+        let storage: UnsafeMutablePointer<Float>
+        let pointers: UnsafeMutablePointer<UnsafeMutablePointer<Float>>
+        
+        init(channels: Int, frames: Int) {
+            self.channels = channels
+            self.frames = frames
+            storage = UnsafeMutablePointer<Float>.allocate(capacity: channels * frames)
+            storage.initialize(repeating: 0, count: channels * frames)
+            pointers = UnsafeMutablePointer<UnsafeMutablePointer<Float>>.allocate(capacity: channels)
+            for c in 0..<channels {
+                pointers[c] = storage + c * frames
+            }
+        }
+        
+        deinit {
+            storage.deallocate()
+            pointers.deallocate()
+        }
+        
+        func fill(start: Int) {
+            for c in 0..<channels {
+                for i in 0..<frames {
+                    pointers[c][i] = Float(start + i + 1000 * c)
+                }
+            }
+        }
+    }
+    
+    private func samples(_ block: AudioBlock, channel: Int) -> [Float] {
+        return Array(UnsafeBufferPointer(start: block.channel(channel), count: block.frameCount))
+    }
+    
+    // MARK: - PlanarRingBuffer
+    
+    func testPlanarRingWrapsAround() {
+        let ring = PlanarRingBuffer(channels: 2, capacityFrames: 8)
+        let source = PlanarSource(channels: 2, frames: 5)
+        let block = AudioBlock(channels: 2, frameCapacity: 8, sampleRate: sampleRate)
+        
+        // 每轮写 5 帧读 5 帧，第二轮起跨越末尾分两段拷贝
+        for round in 0..<4 {
+            source.fill(start: round * 5)
+            XCTAssertEqual(ring.write(channels: source.pointers, sourceChannels: 2, frames: 5), 5)
+            XCTAssertEqual(ring.availableFrames, 5)
+            XCTAssertEqual(ring.freeFrames, 3)
+            XCTAssertEqual(ring.read(into: block, frames: 5), 5)
+            XCTAssertEqual(samples(block, channel: 0), (0..<5).map { Float(round * 5 + $0) }, "第 \(round) 轮左声道")
+            XCTAssertEqual(samples(block, channel: 1), (0..<5).map { Float(round * 5 + $0 + 1000) }, "第 \(round) 轮右声道")
+            XCTAssertEqual(ring.availableFrames, 0)
+        }
+    }
+    
+    func testPlanarRingDropsWhenFullAndZeroFillsUnderrun() {
+        let ring = PlanarRingBuffer(channels: 1, capacityFrames: 8)
+        let source = PlanarSource(channels: 1, frames: 6)
+        let block = AudioBlock(channels: 1, frameCapacity: 8, sampleRate: sampleRate)
+        
+        source.fill(start: 0)
+        XCTAssertEqual(ring.write(channels: source.pointers, sourceChannels: 1, frames: 6), 6)
+        source.fill(start: 6)
+        XCTAssertEqual(ring.write(channels: source.pointers, sourceChannels: 1, frames: 6), 2, "写满时只写入剩余空间，多余的新数据丢弃")
+        XCTAssertEqual(ring.freeFrames, 0)
+        XCTAssertEqual(ring.write(channels: source.pointers, sourceChannels: 1, frames: 6), 0)
+        
+        XCTAssertEqual(ring.read(into: block, frames: 8), 8)
+        XCTAssertEqual(samples(block, channel: 0), (0..<8).map { Float($0) }, "已写入的数据不应被覆盖")
+        
+        source.fill(start: 100)
+        ring.write(channels: source.pointers, sourceChannels: 1, frames: 3)
+        XCTAssertEqual(ring.read(into: block, frames: 8), 3)
+        XCTAssertEqual(block.frameCount, 8, "欠载时仍输出请求的帧数")
+        XCTAssertEqual(samples(block, channel: 0), [100, 101, 102, 0, 0, 0, 0, 0], "不足部分应补零")
+        
+        ring.write(channels: source.pointers, sourceChannels: 1, frames: 4)
+        ring.reset()
+        XCTAssertEqual(ring.availableFrames, 0)
+        XCTAssertEqual(ring.freeFrames, 8)
+    }
+    
+    func testPlanarRingDuplicatesMonoSource() {
+        let ring = PlanarRingBuffer(channels: 2, capacityFrames: 16)
+        let source = PlanarSource(channels: 1, frames: 4)
+        let block = AudioBlock(channels: 2, frameCapacity: 4, sampleRate: sampleRate)
+        source.fill(start: 7)
+        ring.write(channels: source.pointers, sourceChannels: 1, frames: 4)
+        ring.read(into: block, frames: 4)
+        XCTAssertEqual(samples(block, channel: 0), [7, 8, 9, 10])
+        XCTAssertEqual(samples(block, channel: 1), samples(block, channel: 0), "单声道源应复制到两个声道")
+    }
+    
+    // MARK: - ChannelMixMatrix
+    
+    func testIdentityDetection() {
+        XCTAssertTrue(ChannelMixMatrix.identity(channels: 2).isIdentity)
+        XCTAssertTrue(ChannelMixMatrix.standard(from: .stereo, to: .stereo).isIdentity)
+        XCTAssertFalse(ChannelMixMatrix(inputChannels: 2, outputChannels: 2, coefficients: [0, 1, 1, 0]).isIdentity)
+        XCTAssertFalse(ChannelMixMatrix(inputChannels: 2, outputChannels: 2, coefficients: [1, 0, 0, 0.5]).isIdentity)
+        XCTAssertFalse(ChannelMixMatrix.standard(from: .stereo, to: .mono).isIdentity)
+    }
+    
+    func testStereoToMonoAveragesChannels() {
+        let matrix = ChannelMixMatrix.standard(from: .stereo, to: .mono)
+        XCTAssertEqual(matrix.coefficients, [0.5, 0.5])
+        
+        let interleaved: [Float] = [1, 0, 0.5, 0.5, -1, 1]
+        let block = AudioBlock(channels: 1, frameCapacity: 4, sampleRate: sampleRate)
+        interleaved.withUnsafeBufferPointer { matrix.apply(interleaved: $0.baseAddress!, frames: 3, into: block) }
+        XCTAssertEqual(block.frameCount, 3)
+        XCTAssertEqual(samples(block, channel: 0), [0.5, 0.5, 0])
+    }
+    
+    func testSurroundFoldDownIsNormalized() {
+        let raw = ChannelMixMatrix.standard(from: .surround51, to: .stereo, normalize: false)
+        let minus3dB: Float = 0.70710677
+        // 5.1 顺序 L R C LFE Ls Rs：中置与环绕 -3dB 折叠，LFE 丢弃
+        XCTAssertEqual(raw.coefficients, [1, 0, minus3dB, 0, minus3dB, 0,
+                                          0, 1, minus3dB, 0, 0, minus3dB])
+        
+        let normalized = ChannelMixMatrix.standard(from: .surround51, to: .stereo)
+        for o in 0..<2 {
+            let row = normalized.coefficients[(o * 6)..<(o * 6 + 6)]
+            XCTAssertEqual(row.reduce(0, +), 1, accuracy: 1e-5, "下混后每个输出声道的系数之和不应超过 1")
+        }
+        XCTAssertEqual(normalized.coefficients[0], 1 / (1 + 2 * minus3dB), accuracy: 1e-6)
+        XCTAssertEqual(normalized.coefficients[3], 0, "LFE 不参与下混")
+    }
+    
+    func testDiscreteLayoutsMapByIndex() {
+        let matrix = ChannelMixMatrix.standard(from: ChannelLayout(channelCount: 3), to: .stereo)
+        XCTAssertEqual(matrix.coefficients, [1, 0, 0,
+                                             0, 1, 0], "离散声道按序号一一映射，多出的声道丢弃")
+    }
+    
+    func testBlockToBlockApply() {
+        let matrix = ChannelMixMatrix(inputChannels: 2, outputChannels: 2, coefficients: [0, 1, 0.5, 0.5])
+        let input = AudioBlock(channels: 2, frameCapacity: 4, sampleRate: sampleRate)
+        let output = AudioBlock(channels: 2, frameCapacity: 4, sampleRate: sampleRate)
+        for i in 0..<4 {
+            input.channel(0)[i] = Float(i)
+            input.channel(1)[i] = 10
+        }
+        input.frameCount = 4
+        matrix.apply(input, into: output, frames: 4)
+        XCTAssertEqual(samples(output, channel: 0), [10, 10, 10, 10], "左输出只取右输入")
+        XCTAssertEqual(samples(output, channel: 1), [5, 5.5, 6, 6.5])
+    }
+    
+    // MARK: - CaptureByteRing
+    
+    func testByteRingPublishesOffsetWritesAndWraps() {
+        let ring = CaptureByteRing(capacity: 16, tag: .diagnostics)
+        let header: [UInt8] = [0xA0, 0xA1]
+        let payload: [UInt8] = Array(1...8)
+        
+        // 先写负载再在前面补记录头，一次发布
+        payload.withUnsafeBytes { ring.write($0.baseAddress!, count: payload.count, offset: header.count) }
+        header.withUnsafeBytes { ring.write($0.baseAddress!, count: header.count, offset: 0) }
+        XCTAssertEqual(ring.readableBytes, 0, "发布前消费者不可见")
+        ring.publish(header.count + payload.count)
+        XCTAssertEqual(ring.readableBytes, 10)
+        XCTAssertEqual(ring.freeBytes, 6)
+        
+        var output = [UInt8](repeating: 0, count: 10)
+        output.withUnsafeMutableBytes { ring.read(into: $0.baseAddress!, count: 10, offset: 0) }
+        XCTAssertEqual(output, header + payload)
+        ring.consume(10)
+        
+        // 第二条记录从偏移 10 开始，跨越末尾
+        let wrapped: [UInt8] = Array(20..<32)
+        wrapped.withUnsafeBytes { ring.write($0.baseAddress!, count: wrapped.count, offset: 0) }
+        ring.publish(wrapped.count)
+        var tail = [UInt8](repeating: 0, count: 4)
+        tail.withUnsafeMutableBytes { ring.read(into: $0.baseAddress!, count: 4, offset: 8) }
+        XCTAssertEqual(tail, [28, 29, 30, 31], "带偏移的读取应跨过末尾回到开头")
+        var all = [UInt8](repeating: 0, count: wrapped.count)
+        all.withUnsafeMutableBytes { ring.read(into: $0.baseAddress!, count: wrapped.count, offset: 0) }
+        XCTAssertEqual(all, wrapped)
+        
+        ring.reset()
+        XCTAssertEqual(ring.readableBytes, 0)
+        XCTAssertEqual(ring.freeBytes, 16)
+    }
+}
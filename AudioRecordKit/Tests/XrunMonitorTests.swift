@@ -0,0 +1,120 @@
+import XCTest
+@testable import AudioRecordKit
+
+/// 断流监测：会话计数与上级转报、旁路日志内容、事件队列溢出，以及采集时间线的跳变检测
+@available(macOS 14.4, *)
+final class XrunMonitorTests: XCTestCase {
+    
+    private var directory: URL!
+    
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent("XrunMonitorTests-\(UUID().uuidString)")
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+    }
+    
+    override func tearDownWithError() throws {
+        if let directory = directory {
+            try? FileManager.default.removeItem(at: directory)
+        }
+    }
+    
+    // MARK: - Fixtures
+    
+    /// 私有的上级实例，不改动进程级计数
+    private func makeMonitors(capacity: Int = 256) -> (session: XrunMonitor, parent: XrunMonitor) {
+        let parent = XrunMonitor(name: "tests-parent", parent: nil)
+        return (XrunMonitor(name: "tests-session", capacity: capacity, parent: parent), parent)
+    }
+    
+    private func sidecarLines(for fileURL: URL) throws -> [String] {
+        let text = try String(contentsOf: fileURL.appendingPathExtension("xruns.log"), encoding: .utf8)
+        return text.split(separator: "\n").map(String.init)
+    }
+    
+    // MARK: - Counters
+    
+    func testCountsAreForwardedToParent() {
+        let (session, parent) = makeMonitors()
+        session.report(.ringOverrun, origin: "mic-ring", frames: 128)
+        session.report(.ringOverrun, origin: "mic-ring", frames: 64)
+        session.report(.discontinuity, origin: "io", frames: -3)
+        
+        XCTAssertEqual(session.count(of: .ringOverrun), 2)
+        XCTAssertEqual(session.frames(of: .ringOverrun), 192)
+        XCTAssertEqual(session.frames(of: .discontinuity), -3, "重叠以负帧数累计")
+        XCTAssertEqual(session.count(of: .writeFailure), 0)
+        XCTAssertEqual(parent.count(of: .ringOverrun), 2, "会话事件应转报给上级实例")
+        XCTAssertEqual(parent.frames(of: .ringOverrun), 192)
+        XCTAssertEqual(session.droppedEventCount, 0, "没有旁路日志与观察者时不排队事件")
+        
+        session.resetCounters()
+        XCTAssertEqual(session.count(of: .ringOverrun), 0)
+        XCTAssertEqual(session.frames(of: .discontinuity), 0)
+        XCTAssertEqual(parent.count(of: .ringOverrun), 2, "会话清零不影响上级计数")
+    }
+    
+    // MARK: - Sidecar
+    
+    func testSidecarRecordsEventsAndSummary() throws {
+        let (session, _) = makeMonitors()
+        let fileURL = directory.appendingPathComponent("take.wav")
+        session.report(.writeFailure, origin: "writer", frames: 7)
+        session.beginRecording(fileURL: fileURL)
+        XCTAssertEqual(session.count(of: .writeFailure), 0, "开始录制时清零本会话计数")
+        
+        session.report(.ringOverrun, origin: "mic-ring", frames: 128)
+        session.report(.writeFailure, origin: "writer", frames: 64)
+        session.endRecording()
+        
+        let lines = try sidecarLines(for: fileURL)
+        let events = lines.filter { !$0.hasPrefix("#") }
+        XCTAssertEqual(events.count, 2)
+        XCTAssertTrue(events[0].hasSuffix(" ring-overrun mic-ring frames=128"), events[0])
+        XCTAssertTrue(events[1].hasSuffix(" write-failure writer frames=64"), events[1])
+        let summary = try XCTUnwrap(lines.last { $0.hasPrefix("# summary ") }, "结束录制时应写入汇总行")
+        XCTAssertTrue(summary.contains("ring-overrun=1/128f"), summary)
+        XCTAssertTrue(summary.contains("write-failure=1/64f"), summary)
+        XCTAssertTrue(summary.hasSuffix("dropped=0"), summary)
+    }
+    
+    func testFullQueueDropsEventsButKeepsCounts() throws {
+        let (session, _) = makeMonitors(capacity: 4)
+        let fileURL = directory.appendingPathComponent("overflow.wav")
+        session.beginRecording(fileURL: fileURL)
+        // 后台首次取出在 200ms 之后，这里的事件全部积压在队列中
+        for _ in 0..<10 {
+            session.report(.ringUnderrun, origin: "mic-ring", frames: 32)
+        }
+        XCTAssertEqual(session.droppedEventCount, 6)
+        XCTAssertEqual(session.count(of: .ringUnderrun), 10, "队列满时计数仍然准确")
+        session.endRecording()
+        
+        let lines = try sidecarLines(for: fileURL)
+        XCTAssertEqual(lines.filter { !$0.hasPrefix("#") }.count, 4)
+        XCTAssertTrue(lines.last?.hasSuffix("dropped=6") ?? false, lines.last ?? "")
+    }
+    
+    // MARK: - CaptureTimeline
+    
+    func testTimelineDetectsSampleTimeGaps() {
+        var timeline = CaptureTimeline()
+        XCTAssertNil(timeline.advance(sampleTime: 0, hostTime: 0, frames: 512, sampleRate: 48000))
+        XCTAssertNil(timeline.advance(sampleTime: 512, hostTime: 0, frames: 512, sampleRate: 48000))
+        XCTAssertEqual(timeline.advance(sampleTime: 1124, hostTime: 0, frames: 512, sampleRate: 48000), 100, "缺失的帧数")
+        XCTAssertEqual(timeline.advance(sampleTime: 1626, hostTime: 0, frames: 512, sampleRate: 48000), -10, "重叠为负数")
+        
+        timeline.reset()
+        XCTAssertNil(timeline.advance(sampleTime: 99_999, hostTime: 0, frames: 512, sampleRate: 48000), "重置后第一块不比较")
+    }
+    
+    func testTimelineFallsBackToHostTime() {
+        var timeline = CaptureTimeline()
+        let start = PipelineStats.hostTicks(fromNanoseconds: 1_000_000_000)
+        let tenMilliseconds = PipelineStats.hostTicks(fromNanoseconds: 10_000_000)
+        XCTAssertNil(timeline.advance(sampleTime: nil, hostTime: start, frames: 480, sampleRate: 48000))
+        XCTAssertNil(timeline.advance(sampleTime: nil, hostTime: start + tenMilliseconds, frames: 480, sampleRate: 48000))
+        // 间隔 30ms，比 10ms 的块长多出 20ms
+        let gap = timeline.advance(sampleTime: nil, hostTime: start + 4 * tenMilliseconds, frames: 480, sampleRate: 48000)
+        XCTAssertEqual(Double(gap ?? 0), 960, accuracy: 1)
+    }
+}